@@ -1,5 +1,8 @@
 #version 330
 
+// Feature defines are inserted after the version line (see ShaderManager::GetVariant):
+// FEATURE_FLASHLIGHT, FEATURE_FOG
+
 // Input vertex attributes (from vertex shader)
 in vec3 fragPosition;
 in vec2 fragTexCoord;
@@ -10,28 +13,20 @@ in vec3 fragNormal;
 uniform sampler2D texture0;
 uniform vec4 colDiffuse;
 
-// Lighting uniforms
-uniform vec3 viewPos;
-uniform vec3 lightPos;
-uniform vec3 lightColor;
-uniform float lightIntensity;
-uniform vec3 ambientColor;
-uniform float ambientIntensity;
-
-// Flashlight uniforms
-uniform vec3 flashlightPos;
-uniform vec3 flashlightDir;
-uniform vec3 flashlightColor;
-uniform float flashlightIntensity;
-uniform float flashlightCutoff;
-uniform float flashlightOuterCutoff;
-uniform int flashlightEnabled;
-
-// Fog uniforms
-uniform vec3 fogColor;
-uniform float fogDensity;
-uniform float fogStart;
-uniform float fogEnd;
+// Per-frame camera, sun, fog and flashlight (ShaderManager, std140)
+layout(std140) uniform FrameBlock {
+    vec4 viewPos;          // xyz
+    vec4 lightPos;         // xyz (sun)
+    vec4 lightColor;       // rgb, w = intensity
+    vec4 ambientColor;     // rgb, w = intensity
+    vec4 fogColor;         // rgb, w = density
+    vec4 fogRange;         // x = start, y = end
+    vec4 flashlightPos;    // xyz, w = 1 when on
+    vec4 flashlightDir;    // xyz, w = intensity
+    vec4 flashlightColor;  // rgb
+    vec4 flashlightCone;   // x = cos(inner), y = cos(outer)
+    vec4 frameTime;        // x = seconds
+} frame;
 
 // Output fragment color
 out vec4 finalColor;
@@ -45,59 +40,65 @@ void main()
     vec3 color = texelColor.rgb * colDiffuse.rgb * fragColor.rgb;
     
     // Ambient lighting
-    vec3 ambient = ambientColor * ambientIntensity;
+    vec3 ambient = frame.ambientColor.rgb * frame.ambientColor.w;
     
     // Diffuse lighting (directional light)
     vec3 normal = normalize(fragNormal);
-    vec3 lightDir = normalize(lightPos - fragPosition);
+    vec3 lightDir = normalize(frame.lightPos.xyz - fragPosition);
     float diff = max(dot(normal, lightDir), 0.0);
-    vec3 diffuse = lightColor * diff * lightIntensity;
+    vec3 diffuse = frame.lightColor.rgb * diff * frame.lightColor.w;
     
     // Specular lighting
-    vec3 viewDir = normalize(viewPos - fragPosition);
+    vec3 viewDir = normalize(frame.viewPos.xyz - fragPosition);
     vec3 reflectDir = reflect(-lightDir, normal);
     float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32.0);
-    vec3 specular = lightColor * spec * 0.3;
+    vec3 specular = frame.lightColor.rgb * spec * 0.3;
     
     // Start with ambient + diffuse + specular
     vec3 result = (ambient + diffuse + specular) * color;
     
+#ifdef FEATURE_FLASHLIGHT
     // Flashlight (spotlight effect)
-    if (flashlightEnabled == 1) {
-        vec3 flashDir = normalize(flashlightPos - fragPosition);
-        float theta = dot(flashDir, normalize(-flashlightDir));
-        float epsilon = flashlightCutoff - flashlightOuterCutoff;
-        float intensity = clamp((theta - flashlightOuterCutoff) / epsilon, 0.0, 1.0);
+    {
+        vec3 flashDir = normalize(frame.flashlightPos.xyz - fragPosition);
+        float theta = dot(flashDir, normalize(-frame.flashlightDir.xyz));
+        float epsilon = frame.flashlightCone.x - frame.flashlightCone.y;
+        float intensity = clamp((theta - frame.flashlightCone.y) / epsilon, 0.0, 1.0);
         
-        if (theta > flashlightOuterCutoff) {
+        if (theta > frame.flashlightCone.y) {
             // Calculate attenuation
-            float distance = length(flashlightPos - fragPosition);
+            float distance = length(frame.flashlightPos.xyz - fragPosition);
             float attenuation = 1.0 / (1.0 + 0.09 * distance + 0.032 * distance * distance);
             
             // Flashlight diffuse
             float flashDiff = max(dot(normal, flashDir), 0.0);
-            vec3 flashDiffuse = flashlightColor * flashDiff * flashlightIntensity * intensity * attenuation;
+            vec3 flashDiffuse = frame.flashlightColor.rgb * flashDiff * frame.flashlightDir.w * intensity * attenuation;
             
             // Flashlight specular
             vec3 flashReflect = reflect(-flashDir, normal);
             float flashSpec = pow(max(dot(viewDir, flashReflect), 0.0), 32.0);
-            vec3 flashSpecular = flashlightColor * flashSpec * 0.5 * intensity * attenuation;
+            vec3 flashSpecular = frame.flashlightColor.rgb * flashSpec * 0.5 * intensity * attenuation;
             
             result += (flashDiffuse + flashSpecular) * color;
         }
     }
+#endif
     
+#ifdef FEATURE_FOG
     // Fog calculation (exponential)
-    float distance = length(viewPos - fragPosition);
+    float distance = length(frame.viewPos.xyz - fragPosition);
     float fogFactor = 0.0;
     
+    float fogStart = frame.fogRange.x;
+    float fogEnd = frame.fogRange.y;
     if (distance > fogStart) {
         fogFactor = (distance - fogStart) / (fogEnd - fogStart);
         fogFactor = clamp(fogFactor, 0.0, 1.0);
         fogFactor = fogFactor * fogFactor; // Squared for smoother transition
     }
     
-    result = mix(result, fogColor, fogFactor * fogDensity);
+    result = mix(result, frame.fogColor.rgb, fogFactor * frame.fogColor.w);
+#endif
     
     // Output final color
     finalColor = vec4(result, texelColor.a * colDiffuse.a * fragColor.a);
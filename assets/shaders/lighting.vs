@@ -1,11 +1,18 @@
 #version 330
 
+// Feature defines are inserted after the version line (see ShaderManager::GetVariant)
+
 // Input vertex attributes
 in vec3 vertexPosition;
 in vec2 vertexTexCoord;
 in vec3 vertexNormal;
 in vec4 vertexColor;
 
+#ifdef FEATURE_INSTANCING
+// Per-instance model matrix (DrawMeshInstanced)
+in mat4 instanceTransform;
+#endif
+
 // Input uniform values
 uniform mat4 mvp;
 uniform mat4 matModel;
@@ -20,11 +27,19 @@ out vec3 fragNormal;
 void main()
 {
     // Send vertex attributes to fragment shader
-    fragPosition = vec3(matModel * vec4(vertexPosition, 1.0));
     fragTexCoord = vertexTexCoord;
     fragColor = vertexColor;
+    
+#ifdef FEATURE_INSTANCING
+    // mvp holds only view * projection for instanced draws
+    fragPosition = vec3(instanceTransform * vec4(vertexPosition, 1.0));
+    fragNormal = normalize(mat3(instanceTransform) * vertexNormal);
+    gl_Position = mvp * vec4(fragPosition, 1.0);
+#else
+    fragPosition = vec3(matModel * vec4(vertexPosition, 1.0));
     fragNormal = normalize(vec3(matNormal * vec4(vertexNormal, 1.0)));
     
     // Calculate final vertex position
     gl_Position = mvp * vec4(vertexPosition, 1.0);
-}
\ No newline at end of file
+#endif
+}
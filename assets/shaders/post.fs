@@ -0,0 +1,59 @@
+#version 330
+
+// Input vertex attributes (from vertex shader)
+in vec2 fragTexCoord;
+in vec4 fragColor;
+
+// Resolved scene colour (PostProcessManager)
+uniform sampler2D texture0;
+
+uniform vec2 resolution;
+uniform float time;
+
+// Overlay amounts, 0 = off
+uniform float vignette;           // Edge darkening
+uniform float flashlightGlow;     // Warm flashlight bloom
+uniform float damagePulse;        // Low-health red pulse
+uniform float grain;              // Film grain amplitude
+
+// Colour grading
+uniform float exposure;
+uniform float contrast;
+uniform float saturation;
+uniform vec3 tint;
+
+out vec4 finalColor;
+
+const vec3 GLOW_COLOR = vec3(1.0, 0.96, 0.78);
+const vec3 DAMAGE_COLOR = vec3(0.71, 0.0, 0.0);
+
+float Hash(vec2 p) {
+    p = fract(p * vec2(123.34, 456.21));
+    p += dot(p, p + 45.32);
+    return fract(p.x * p.y);
+}
+
+void main() {
+    vec2 uv = gl_FragCoord.xy / resolution;
+    vec3 color = texture(texture0, fragTexCoord).rgb;
+
+    // Grading first, so the overlays keep their colours
+    color *= exposure;
+    color = (color - 0.5) * contrast + 0.5;
+    float luma = dot(color, vec3(0.299, 0.587, 0.114));
+    color = mix(vec3(luma), color, saturation) * tint;
+
+    // Vignette: dark bands over the outer fifth top/bottom and sixth left/right
+    float bandV = max(1.0 - uv.y / 0.2, 1.0 - (1.0 - uv.y) / 0.2);
+    float bandH = max(1.0 - uv.x / (1.0 / 6.0), 1.0 - (1.0 - uv.x) / (1.0 / 6.0));
+    float darkV = clamp(bandV, 0.0, 1.0) * 0.47 * vignette;
+    float darkH = clamp(bandH, 0.0, 1.0) * 0.39 * vignette;
+    color *= (1.0 - darkV) * (1.0 - darkH);
+
+    color = mix(color, GLOW_COLOR, flashlightGlow);
+    color = mix(color, DAMAGE_COLOR, damagePulse);
+
+    color += (Hash(gl_FragCoord.xy + fract(time) * 100.0) - 0.5) * grain;
+
+    finalColor = vec4(clamp(color, 0.0, 1.0), 1.0);
+}
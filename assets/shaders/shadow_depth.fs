@@ -0,0 +1,9 @@
+#version 330
+
+// Depth only; the colour output is discarded (no draw buffer)
+out vec4 finalColor;
+
+void main()
+{
+    finalColor = vec4(1.0);
+}
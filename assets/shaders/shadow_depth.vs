@@ -0,0 +1,11 @@
+#version 330
+
+// Shadow map depth pass (static casters)
+in vec3 vertexPosition;
+
+uniform mat4 mvp;
+
+void main()
+{
+    gl_Position = mvp*vec4(vertexPosition, 1.0);
+}
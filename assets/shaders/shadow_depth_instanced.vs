@@ -0,0 +1,14 @@
+#version 330
+
+// Shadow map depth pass for instanced props
+in vec3 vertexPosition;
+
+// Per-instance model matrix (DrawMeshInstanced)
+in mat4 instanceTransform;
+
+uniform mat4 mvp;
+
+void main()
+{
+    gl_Position = mvp*instanceTransform*vec4(vertexPosition, 1.0);
+}
@@ -0,0 +1,257 @@
+#version 330
+
+// Feature defines are inserted after the version line (see ShaderManager::GetVariant):
+// FEATURE_POINT_LIGHTS, FEATURE_FLASHLIGHT, FEATURE_SHADOWS, FEATURE_LIGHTMAP
+
+// Input vertex attributes (from vertex shader)
+in vec2 fragTexCoord;
+in float fragLayer;
+in vec4 fragColor;
+in vec3 fragPosition;
+in vec3 fragNormal;
+in vec4 fragClip;
+
+// Surface texture set: array layers, or atlas cells when arrays are unavailable
+uniform sampler2DArray surfaceArray;
+uniform sampler2D texture0;       // atlas (fallback only)
+uniform int useAtlas;
+uniform vec4 atlasRects[16];      // x, y, width, height per layer
+uniform vec4 colDiffuse;
+
+#ifdef FEATURE_POINT_LIGHTS
+// Clustered point lights (see LightManager): per-cluster offset/count into the
+// index list, and two texels per light (position + radius, color * intensity)
+uniform usampler2D lightClusters;
+uniform usampler2D lightIndices;
+uniform sampler2D lightData;
+uniform vec3 clusterSize;         // CLUSTER_X, CLUSTER_Y, CLUSTER_Z
+uniform vec2 clusterDepth;        // near, CLUSTER_Z / log(far / near)
+#endif
+
+// Per-frame camera, sun, fog and flashlight (ShaderManager, std140)
+layout(std140) uniform FrameBlock {
+    vec4 viewPos;          // xyz
+    vec4 lightPos;         // xyz (sun)
+    vec4 lightColor;       // rgb, w = intensity
+    vec4 ambientColor;     // rgb, w = intensity
+    vec4 fogColor;         // rgb, w = density
+    vec4 fogRange;         // x = start, y = end
+    vec4 flashlightPos;    // xyz, w = 1 when on
+    vec4 flashlightDir;    // xyz, w = intensity
+    vec4 flashlightColor;  // rgb
+    vec4 flashlightCone;   // x = cos(inner), y = cos(outer)
+    vec4 frameTime;        // x = seconds
+} frame;
+
+#ifdef FEATURE_SHADOWS
+// Shadow pass results (ShadowManager, std140)
+layout(std140) uniform ShadowBlock {
+    mat4 spotMatrix;
+    mat4 sunMatrices[3];
+    vec4 sunDirection;     // xyz toward the sun, w = shadow strength
+    vec4 cascadeSplits;    // xyz = cascade radii
+    ivec4 flags;           // x = spot shadow on, y = sun shadow on, z = PCF radius
+} shadow;
+
+// Depth maps with hardware compare
+uniform sampler2DShadow spotShadowMap;
+uniform sampler2DShadow sunShadowMap;     // Cascades side by side
+#endif
+
+#ifdef FEATURE_LIGHTMAP
+// Baked interior light (see LightmapBaker): floor, ceiling and the four wall
+// orientations of the tile grid as six planes in a 3 x 2 layout
+uniform sampler2D lightmap;
+uniform vec2 lightmapTiles;       // Interior width, height
+uniform float lightmapRange;      // Multiplier stored as 1.0
+uniform float lightmapWallHeight;
+#endif
+
+// Output fragment color
+out vec4 finalColor;
+
+vec4 SampleSurface(vec2 uv, int layer)
+{
+    if (useAtlas == 0) return texture(surfaceArray, vec3(uv, float(layer)));
+
+    // Wrap inside the atlas cell; gradients come from the unwrapped UVs so mips stay stable
+    vec4 rect = atlasRects[clamp(layer, 0, 15)];
+    vec2 cellUV = rect.xy + fract(uv) * rect.zw;
+    return textureGrad(texture0, cellUV, dFdx(uv) * rect.zw, dFdy(uv) * rect.zw);
+}
+
+#ifdef FEATURE_POINT_LIGHTS
+vec3 PointLighting(vec3 position, vec3 normal)
+{
+    // Cluster from the screen position and view depth (clip w)
+    vec2 ndc = fragClip.xy / fragClip.w;
+    int slice = int(floor(log(fragClip.w / clusterDepth.x) * clusterDepth.y));
+    if (slice < 0 || slice >= int(clusterSize.z)) return vec3(0.0);
+    ivec2 tile = clamp(ivec2((ndc * 0.5 + 0.5) * clusterSize.xy), ivec2(0), ivec2(clusterSize.xy) - 1);
+    uvec2 cluster = texelFetch(lightClusters, ivec2(tile.y * int(clusterSize.x) + tile.x, slice), 0).xy;
+
+    // Meshes without normals light every side
+    bool hasNormal = dot(normal, normal) > 0.0001;
+    vec3 n = hasNormal ? normalize(normal) : vec3(0.0);
+
+    vec3 result = vec3(0.0);
+    int indexWidth = textureSize(lightIndices, 0).x;
+    for (uint i = 0u; i < cluster.y; i++) {
+        int index = int(cluster.x + i);
+        int light = int(texelFetch(lightIndices, ivec2(index % indexWidth, index / indexWidth), 0).r);
+        vec4 posRadius = texelFetch(lightData, ivec2(light * 2, 0), 0);
+        vec3 color = texelFetch(lightData, ivec2(light * 2 + 1, 0), 0).rgb;
+
+        vec3 toLight = posRadius.xyz - position;
+        float dist2 = dot(toLight, toLight);
+        float r = posRadius.w;
+        if (dist2 >= r * r) continue;
+
+        // Inverse square, windowed to reach zero at the radius
+        float falloff = clamp(1.0 - (dist2 * dist2) / (r * r * r * r), 0.0, 1.0);
+        float attenuation = falloff * falloff / (dist2 + 1.0);
+        float diffuse = hasNormal ? max(dot(n, toLight * inversesqrt(max(dist2, 0.0001))), 0.0) : 1.0;
+        result += color * diffuse * attenuation;
+    }
+    return result;
+}
+#endif
+
+#ifdef FEATURE_SHADOWS
+float FilterShadow(sampler2DShadow map, vec3 coord, vec2 texel, vec2 uvMin, vec2 uvMax)
+{
+    float sum = 0.0;
+    int radius = shadow.flags.z;
+    for (int y = -radius; y <= radius; y++) {
+        for (int x = -radius; x <= radius; x++) {
+            vec2 uv = clamp(coord.xy + vec2(x, y) * texel, uvMin, uvMax);
+            sum += texture(map, vec3(uv, coord.z));
+        }
+    }
+    float taps = float(2 * shadow.flags.z + 1);
+    return sum / (taps * taps);
+}
+
+float SpotShadow(vec3 position, vec3 normal)
+{
+    if (shadow.flags.x == 0) return 1.0;
+    vec4 clip = shadow.spotMatrix * vec4(position + normal * 0.02, 1.0);
+    vec3 coord = clip.xyz / clip.w * 0.5 + 0.5;
+    if (clip.w <= 0.0 || any(lessThan(coord, vec3(0.0))) || any(greaterThan(coord, vec3(1.0)))) return 1.0;
+    vec2 texel = 1.0 / vec2(textureSize(spotShadowMap, 0));
+    return FilterShadow(spotShadowMap, coord, texel, vec2(0.0), vec2(1.0));
+}
+
+float SunShadow(vec3 position, vec3 normal)
+{
+    if (shadow.flags.y == 0) return 1.0;
+    float dist = length(position - frame.viewPos.xyz);
+    int cascade = dist < shadow.cascadeSplits.x ? 0 : (dist < shadow.cascadeSplits.y ? 1 : 2);
+    if (dist >= shadow.cascadeSplits.z) return 1.0;
+
+    // Normal offset grows with the cascade's texel size
+    float offset = 0.03 * float(cascade + 1) * float(cascade + 1);
+    vec4 clip = shadow.sunMatrices[cascade] * vec4(position + normal * offset, 1.0);
+    vec3 coord = clip.xyz * 0.5 + 0.5;
+    if (any(lessThan(coord, vec3(0.0))) || any(greaterThan(coord, vec3(1.0)))) return 1.0;
+
+    // Keep the kernel inside this cascade's third of the atlas
+    vec2 size = vec2(textureSize(sunShadowMap, 0));
+    vec2 texel = 1.0 / size;
+    float left = float(cascade) / 3.0;
+    coord.x = left + coord.x / 3.0;
+    return FilterShadow(sunShadowMap, coord, texel,
+        vec2(left + texel.x * 0.5, 0.0), vec2(left + 1.0 / 3.0 - texel.x * 0.5, 1.0));
+}
+#endif
+
+#ifdef FEATURE_FLASHLIGHT
+vec3 Flashlight(vec3 position, vec3 normal, bool hasNormal)
+{
+    // Same cone and attenuation as lighting.fs
+    vec3 toLight = frame.flashlightPos.xyz - position;
+    float dist = length(toLight);
+    vec3 l = toLight / max(dist, 0.0001);
+    float theta = dot(l, normalize(-frame.flashlightDir.xyz));
+    float inner = frame.flashlightCone.x;
+    float outer = frame.flashlightCone.y;
+    if (theta <= outer) return vec3(0.0);
+
+    float cone = clamp((theta - outer) / (inner - outer), 0.0, 1.0);
+    float attenuation = 1.0 / (1.0 + 0.09 * dist + 0.032 * dist * dist);
+    float diffuse = hasNormal ? max(dot(normal, l), 0.0) : 1.0;
+    // Scaled down from lighting.fs: it multiplies the authored colour instead of lighting it
+    vec3 color = frame.flashlightColor.rgb * frame.flashlightDir.w * 0.3;
+#ifdef FEATURE_SHADOWS
+    return color * diffuse * cone * attenuation * SpotShadow(position, normal);
+#else
+    return color * diffuse * cone * attenuation;
+#endif
+}
+#endif
+
+#ifdef FEATURE_LIGHTMAP
+vec3 SampleLightmap(vec3 position, vec3 normal)
+{
+    // Plane from the dominant normal axis
+    vec3 a = abs(normal);
+    int plane;
+    vec2 axis = vec2(0.0);
+    if (a.y >= a.x && a.y >= a.z) plane = normal.y > 0.0 ? 0 : 1;
+    else if (a.x >= a.z) { plane = normal.x > 0.0 ? 2 : 3; axis.x = sign(normal.x); }
+    else { plane = normal.z > 0.0 ? 4 : 5; axis.y = sign(normal.z); }
+
+    // Walls belong to the open tile they face; their height is stacked inside the tile
+    vec2 tile = floor(position.xz + axis * 0.5 + 0.5);
+    float texelsPerTile = float(textureSize(lightmap, 0).x) / (3.0 * lightmapTiles.x);
+    float margin = 0.5 / texelsPerTile;
+    float h = clamp(position.y / lightmapWallHeight, margin, 1.0 - margin);
+    vec2 coord = position.xz + 0.5;
+    if (plane == 2 || plane == 3) coord = vec2(tile.x + h, position.z + 0.5);
+    else if (plane >= 4) coord = vec2(position.x + 0.5, tile.y + h);
+    coord = clamp(coord, vec2(margin), lightmapTiles - margin);
+
+    vec2 atlasTiles = lightmapTiles * vec2(3.0, 2.0);
+    vec4 texel = texture(lightmap, (vec2(plane % 3, plane / 3) * lightmapTiles + coord) / atlasTiles);
+
+    // No such face (props, doors): use the floor below
+    if (texel.a < 0.5) texel = texture(lightmap, clamp(position.xz + 0.5, vec2(margin), lightmapTiles - margin) / atlasTiles);
+    return texel.a < 0.5 ? vec3(1.0) : texel.rgb * lightmapRange;
+}
+#endif
+
+void main()
+{
+    // Negative layer = untextured (vertex color only)
+    int layer = int(floor(fragLayer + 0.5));
+    vec4 texelColor = (fragLayer < -0.5) ? vec4(1.0) : SampleSurface(fragTexCoord, layer);
+
+    finalColor = texelColor * colDiffuse * fragColor;
+
+    bool hasNormal = dot(fragNormal, fragNormal) > 0.0001;
+    vec3 n = hasNormal ? normalize(fragNormal) : vec3(0.0);
+
+#ifdef FEATURE_LIGHTMAP
+    // Baked ambient occlusion and bounce light inside interiors
+    finalColor.rgb *= SampleLightmap(fragPosition, hasNormal ? n : vec3(0.0, 1.0, 0.0));
+#endif
+
+    // Point lights and the flashlight add on top of the authored (unlit) colour
+    vec3 light = vec3(0.0);
+#ifdef FEATURE_POINT_LIGHTS
+    light += PointLighting(fragPosition, fragNormal);
+#endif
+#ifdef FEATURE_FLASHLIGHT
+    light += Flashlight(fragPosition, n, hasNormal);
+#endif
+    finalColor.rgb *= 1.0 + light;
+
+#ifdef FEATURE_SHADOWS
+    // Sun shadows darken it; faces turned away from the sun count as shadowed
+    if (shadow.flags.y != 0) {
+        float facing = hasNormal ? smoothstep(0.0, 0.2, dot(n, shadow.sunDirection.xyz)) : 1.0;
+        float lit = SunShadow(fragPosition, n) * facing;
+        finalColor.rgb *= mix(1.0 - shadow.sunDirection.w, 1.0, lit);
+    }
+#endif
+}
@@ -0,0 +1,46 @@
+#version 330
+
+// Feature defines are inserted after the version line (see ShaderManager::GetVariant)
+
+// Input vertex attributes
+in vec3 vertexPosition;
+in vec2 vertexTexCoord;
+in vec2 vertexTexCoord2;
+in vec3 vertexNormal;
+in vec4 vertexColor;
+
+#ifdef FEATURE_INSTANCING
+// Per-instance model matrix (DrawMeshInstanced)
+in mat4 instanceTransform;
+#endif
+
+// Input uniform values
+uniform mat4 mvp;
+uniform mat4 matModel;
+
+// Output vertex attributes (to fragment shader)
+out vec2 fragTexCoord;
+out float fragLayer;
+out vec4 fragColor;
+out vec3 fragPosition;   // World space, for point lights
+out vec3 fragNormal;
+out vec4 fragClip;       // Picks the light cluster
+
+void main()
+{
+    fragTexCoord = vertexTexCoord;
+    fragLayer = vertexTexCoord2.x;
+    fragColor = vertexColor;
+
+#ifdef FEATURE_INSTANCING
+    // mvp holds only view * projection for instanced draws
+    fragPosition = vec3(instanceTransform * vec4(vertexPosition, 1.0));
+    fragNormal = mat3(instanceTransform) * vertexNormal;
+    gl_Position = mvp * vec4(fragPosition, 1.0);
+#else
+    fragPosition = vec3(matModel * vec4(vertexPosition, 1.0));
+    fragNormal = mat3(matModel) * vertexNormal;
+    gl_Position = mvp * vec4(vertexPosition, 1.0);
+#endif
+    fragClip = gl_Position;
+}
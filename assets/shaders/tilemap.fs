@@ -0,0 +1,149 @@
+#version 330
+
+// Input vertex attributes (from vertex shader)
+in vec3 fragPosition;
+in vec2 fragTexCoord;
+in vec4 fragColor;
+
+// Surface texture set: array layers, or atlas cells when arrays are unavailable
+uniform sampler2DArray surfaceArray;
+uniform sampler2D texture0;       // atlas (fallback only)
+uniform int useAtlas;
+uniform vec4 atlasRects[16];      // x, y, width, height per layer
+uniform vec4 colDiffuse;
+
+// Tile index map: one texel per world tile, red channel = WorldTile id
+uniform sampler2D tileMap;
+uniform ivec2 mapSize;
+
+// WorldTile id -> surface layer
+uniform int tileLayer[8];
+
+// Flashlight and sun shadows, as in surface.fs (the ground is flat: normal +Y)
+// Per-frame camera, sun, fog and flashlight (ShaderManager, std140)
+layout(std140) uniform FrameBlock {
+    vec4 viewPos;          // xyz
+    vec4 lightPos;         // xyz (sun)
+    vec4 lightColor;       // rgb, w = intensity
+    vec4 ambientColor;     // rgb, w = intensity
+    vec4 fogColor;         // rgb, w = density
+    vec4 fogRange;         // x = start, y = end
+    vec4 flashlightPos;    // xyz, w = 1 when on
+    vec4 flashlightDir;    // xyz, w = intensity
+    vec4 flashlightColor;  // rgb
+    vec4 flashlightCone;   // x = cos(inner), y = cos(outer)
+    vec4 frameTime;        // x = seconds
+} frame;
+
+// Shadow pass results (ShadowManager, std140)
+layout(std140) uniform ShadowBlock {
+    mat4 spotMatrix;
+    mat4 sunMatrices[3];
+    vec4 sunDirection;     // xyz toward the sun, w = shadow strength
+    vec4 cascadeSplits;    // xyz = cascade radii
+    ivec4 flags;           // x = spot shadow on, y = sun shadow on, z = PCF radius
+} shadow;
+
+// Depth maps with hardware compare
+uniform sampler2DShadow spotShadowMap;
+uniform sampler2DShadow sunShadowMap;
+
+// Output fragment color
+out vec4 finalColor;
+
+vec4 SampleSurface(vec2 uv, int layer, vec2 dx, vec2 dy)
+{
+    if (useAtlas == 0) return textureGrad(surfaceArray, vec3(uv, float(layer)), dx, dy);
+
+    vec4 rect = atlasRects[clamp(layer, 0, 15)];
+    return textureGrad(texture0, rect.xy + uv * rect.zw, dx * rect.zw, dy * rect.zw);
+}
+
+float FilterShadow(sampler2DShadow map, vec3 coord, vec2 texel, vec2 uvMin, vec2 uvMax)
+{
+    float sum = 0.0;
+    int radius = shadow.flags.z;
+    for (int y = -radius; y <= radius; y++) {
+        for (int x = -radius; x <= radius; x++) {
+            vec2 uv = clamp(coord.xy + vec2(x, y) * texel, uvMin, uvMax);
+            sum += texture(map, vec3(uv, coord.z));
+        }
+    }
+    float taps = float(2 * shadow.flags.z + 1);
+    return sum / (taps * taps);
+}
+
+float SpotShadow(vec3 position, vec3 normal)
+{
+    if (shadow.flags.x == 0) return 1.0;
+    vec4 clip = shadow.spotMatrix * vec4(position + normal * 0.02, 1.0);
+    vec3 coord = clip.xyz / clip.w * 0.5 + 0.5;
+    if (clip.w <= 0.0 || any(lessThan(coord, vec3(0.0))) || any(greaterThan(coord, vec3(1.0)))) return 1.0;
+    vec2 texel = 1.0 / vec2(textureSize(spotShadowMap, 0));
+    return FilterShadow(spotShadowMap, coord, texel, vec2(0.0), vec2(1.0));
+}
+
+float SunShadow(vec3 position, vec3 normal)
+{
+    if (shadow.flags.y == 0) return 1.0;
+    float dist = length(position - frame.viewPos.xyz);
+    int cascade = dist < shadow.cascadeSplits.x ? 0 : (dist < shadow.cascadeSplits.y ? 1 : 2);
+    if (dist >= shadow.cascadeSplits.z) return 1.0;
+
+    // Normal offset grows with the cascade's texel size
+    float offset = 0.03 * float(cascade + 1) * float(cascade + 1);
+    vec4 clip = shadow.sunMatrices[cascade] * vec4(position + normal * offset, 1.0);
+    vec3 coord = clip.xyz * 0.5 + 0.5;
+    if (any(lessThan(coord, vec3(0.0))) || any(greaterThan(coord, vec3(1.0)))) return 1.0;
+
+    // Keep the kernel inside this cascade's third of the atlas
+    vec2 size = vec2(textureSize(sunShadowMap, 0));
+    vec2 texel = 1.0 / size;
+    float left = float(cascade) / 3.0;
+    coord.x = left + coord.x / 3.0;
+    return FilterShadow(sunShadowMap, coord, texel,
+        vec2(left + texel.x * 0.5, 0.0), vec2(left + 1.0 / 3.0 - texel.x * 0.5, 1.0));
+}
+
+vec3 Flashlight(vec3 position, vec3 normal, bool hasNormal)
+{
+    // Same cone and attenuation as lighting.fs
+    vec3 toLight = frame.flashlightPos.xyz - position;
+    float dist = length(toLight);
+    vec3 l = toLight / max(dist, 0.0001);
+    float theta = dot(l, normalize(-frame.flashlightDir.xyz));
+    float inner = frame.flashlightCone.x;
+    float outer = frame.flashlightCone.y;
+    if (theta <= outer) return vec3(0.0);
+
+    float cone = clamp((theta - outer) / (inner - outer), 0.0, 1.0);
+    float attenuation = 1.0 / (1.0 + 0.09 * dist + 0.032 * dist * dist);
+    float diffuse = hasNormal ? max(dot(normal, l), 0.0) : 1.0;
+    // Scaled down from lighting.fs: it multiplies the authored colour instead of lighting it
+    vec3 color = frame.flashlightColor.rgb * frame.flashlightDir.w * 0.3;
+    return color * diffuse * cone * attenuation * SpotShadow(position, normal);
+}
+
+void main()
+{
+    // Tiles are centred on integer coordinates
+    vec2 tilePos = fragPosition.xz + 0.5;
+    ivec2 tile = clamp(ivec2(floor(tilePos)), ivec2(0), mapSize - 1);
+
+    int tileId = int(texelFetch(tileMap, tile, 0).r * 255.0 + 0.5);
+    int layer = tileLayer[clamp(tileId, 0, 7)];
+
+    // Repeat each texture once per tile; explicit gradients avoid mip seams at tile edges
+    vec2 f = fract(tilePos);
+    vec2 uv = vec2(f.x, 1.0 - f.y);
+    vec2 dx = dFdx(tilePos);
+    vec2 dy = dFdy(tilePos);
+
+    finalColor = SampleSurface(uv, layer, dx, dy) * colDiffuse * fragColor;
+
+    vec3 n = vec3(0.0, 1.0, 0.0);
+    if (frame.flashlightPos.w > 0.5) finalColor.rgb *= 1.0 + Flashlight(fragPosition, n, true);
+    if (shadow.flags.y != 0) {
+        finalColor.rgb *= mix(1.0 - shadow.sunDirection.w, 1.0, SunShadow(fragPosition, n));
+    }
+}
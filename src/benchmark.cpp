@@ -0,0 +1,446 @@
+#include "benchmark.h"
+#include "render_stats.h"
+#include "raymath.h"
+#include "external/glad.h"
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <fstream>
+#include <queue>
+
+// Global instance
+BenchmarkRunner* g_Benchmark = nullptr;
+
+// Interior the indoor path walks through
+static const char* BENCHMARK_INTERIOR_ID = "lab_detailed_01";
+
+// How far ahead along the path the camera looks
+static const float BENCHMARK_LOOK_AHEAD = 2.0f;
+
+bool ParseBenchmarkArgs(int argc, char** argv, BenchmarkOptions* options) {
+    options->enabled = false;
+    options->frames = BENCHMARK_DEFAULT_FRAMES;
+    options->outputPath = "benchmark.csv";
+    options->stressLights = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if (strcmp(arg, "--benchmark") == 0) {
+            options->enabled = true;
+        }
+        else if (strncmp(arg, "--benchmark-frames=", 19) == 0) {
+            options->enabled = true;
+            options->frames = std::max(1, atoi(arg + 19));
+        }
+        else if (strncmp(arg, "--benchmark-out=", 16) == 0) {
+            options->enabled = true;
+            options->outputPath = arg + 16;
+        }
+        else if (strncmp(arg, "--benchmark-lights=", 19) == 0) {
+            options->enabled = true;
+            options->stressLights = std::max(0, atoi(arg + 19));
+        }
+    }
+    return options->enabled;
+}
+
+BenchmarkRunner::BenchmarkRunner(const BenchmarkOptions& benchmarkOptions) {
+    options = benchmarkOptions;
+    totalFrames = 0;
+    frame = 0;
+    currentPath = -1;
+    frameStart = 0.0;
+    cpuEnd = 0.0;
+    gpuTimers = false;
+    activeQuery = -1;
+    for (int i = 0; i < BENCHMARK_GPU_QUERIES; i++) {
+        queries[i] = 0;
+        querySample[i] = -1;
+    }
+}
+
+BenchmarkRunner::~BenchmarkRunner() {
+    if (gpuTimers) glDeleteQueries(BENCHMARK_GPU_QUERIES, queries);
+}
+
+void BenchmarkRunner::Initialize(const MapData& mapData, float eyeHeight) {
+    paths.clear();
+    BuildInteriorPath(mapData, eyeHeight);
+    BuildOutdoorPath(mapData, eyeHeight);
+
+    // Frames are split evenly; the last path takes the remainder
+    totalFrames = paths.empty() ? 0 : options.frames;
+    int assigned = 0;
+    for (size_t i = 0; i < paths.size(); i++) {
+        paths[i].frames = (i + 1 == paths.size()) ? totalFrames - assigned : totalFrames / (int)paths.size();
+        assigned += paths[i].frames;
+    }
+    samples.assign(totalFrames, BenchmarkSample{});
+
+    glGenQueries(BENCHMARK_GPU_QUERIES, queries);
+    gpuTimers = queries[0] != 0;
+
+    TraceLog(LOG_INFO, TextFormat("Benchmark: %d frames over %d paths (+%d warmup), seed %d",
+        totalFrames, (int)paths.size(), BENCHMARK_WARMUP_FRAMES, BENCHMARK_SEED));
+    for (const BenchmarkPath& path : paths) {
+        TraceLog(LOG_INFO, TextFormat("  %s: %d points, %.1fm, %d frames",
+            path.name, (int)path.points.size(), path.distances.back(), path.frames));
+    }
+}
+
+void BenchmarkRunner::AddPath(BenchmarkPath path) {
+    if (path.loop && !path.points.empty()) path.points.push_back(path.points.front());
+    if (path.points.size() < 2) {
+        TraceLog(LOG_WARNING, TextFormat("Benchmark: path '%s' is empty, skipped", path.name));
+        return;
+    }
+
+    path.distances.assign(1, 0.0f);
+    for (size_t i = 1; i < path.points.size(); i++) {
+        path.distances.push_back(path.distances.back() + Vector3Distance(path.points[i - 1], path.points[i]));
+    }
+    path.frames = 0;
+    paths.push_back(path);
+}
+
+// Walk from the spawn through every door of the lab, ending at the exit
+void BenchmarkRunner::BuildInteriorPath(const MapData& mapData, float eyeHeight) {
+    BenchmarkPath path;
+    path.name = "interior";
+    path.interiorId = BENCHMARK_INTERIOR_ID;
+    path.loop = false;
+
+    const Interior* interior = GetInterior(mapData, BENCHMARK_INTERIOR_ID);
+    if (!interior || interior->playerSpawnX < 0) {
+        AddPath(path);
+        return;
+    }
+
+    const int width = interior->width;
+    const int height = interior->height;
+    auto walkable = [&](int x, int y) {
+        if (x < 0 || y < 0 || x >= width || y >= height) return false;
+        int tile = interior->tiles[y * width + x];
+        return tile == IT_FLOOR || tile == IT_DOOR;
+    };
+
+    std::vector<int> targets;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            bool exit = (x == interior->doorX && y == interior->doorY);
+            if (interior->tiles[y * width + x] == IT_DOOR && !exit) targets.push_back(y * width + x);
+        }
+    }
+
+    int current = interior->playerSpawnY * width + interior->playerSpawnX;
+    std::vector<int> route(1, current);
+    std::vector<int> previous(width * height);
+    bool exitAdded = false;
+
+    while (true) {
+        // Breadth-first search from the current tile
+        std::fill(previous.begin(), previous.end(), -1);
+        previous[current] = current;
+        std::queue<int> open;
+        open.push(current);
+        while (!open.empty()) {
+            int cell = open.front();
+            open.pop();
+            const int dx[4] = { 1, -1, 0, 0 };
+            const int dy[4] = { 0, 0, 1, -1 };
+            for (int d = 0; d < 4; d++) {
+                int nx = cell % width + dx[d];
+                int ny = cell / width + dy[d];
+                if (!walkable(nx, ny) || previous[ny * width + nx] >= 0) continue;
+                previous[ny * width + nx] = cell;
+                open.push(ny * width + nx);
+            }
+        }
+
+        // Nearest reachable door next (ties go to the lower tile index, so the route is stable);
+        // the exit door comes last
+        int next = -1;
+        int bestSteps = 0;
+        for (int target : targets) {
+            if (previous[target] < 0) continue;
+            int steps = 0;
+            for (int cell = target; cell != current; cell = previous[cell]) steps++;
+            if (next < 0 || steps < bestSteps) {
+                next = target;
+                bestSteps = steps;
+            }
+        }
+        if (next < 0) {
+            int exitCell = interior->doorY * width + interior->doorX;
+            if (exitAdded || interior->doorX < 0 || previous[exitCell] < 0) break;
+            next = exitCell;
+            exitAdded = true;
+        }
+        targets.erase(std::remove(targets.begin(), targets.end(), next), targets.end());
+
+        std::vector<int> leg;
+        for (int cell = next; cell != current; cell = previous[cell]) leg.push_back(cell);
+        route.insert(route.end(), leg.rbegin(), leg.rend());
+        current = next;
+    }
+
+    for (int cell : route) {
+        path.points.push_back(Vector3{ (float)(cell % width), eyeHeight, (float)(cell / width) });
+    }
+    AddPath(path);
+}
+
+// Loop around the outermost roads of the city band
+void BenchmarkRunner::BuildOutdoorPath(const MapData& mapData, float eyeHeight) {
+    BenchmarkPath path;
+    path.name = "outdoor";
+    path.loop = true;
+
+    // Band limits as laid out by GenerateMapData
+    int oceanW = (int)(mapData.width * 0.15f);
+    int cityY1 = (int)(mapData.height * 0.35f);
+    auto isRoad = [&](int x, int y) { return mapData.tiles[y * mapData.width + x] == WT_ROAD; };
+
+    // Grid roads are the rows and columns that are mostly road (buildings interrupt some)
+    std::vector<int> rows, columns;
+    for (int y = 0; y < cityY1; y++) {
+        int count = 0;
+        for (int x = oceanW; x < mapData.width; x++) count += isRoad(x, y);
+        if (count * 10 > (mapData.width - oceanW) * 6) rows.push_back(y);
+    }
+    for (int x = oceanW; x < mapData.width; x++) {
+        int count = 0;
+        for (int y = 0; y < cityY1; y++) count += isRoad(x, y);
+        if (count * 10 > cityY1 * 6) columns.push_back(x);
+    }
+
+    int x0, x1, y0, y1;
+    if (rows.size() >= 2 && columns.size() >= 2) {
+        x0 = columns.front();
+        x1 = columns.back();
+        y0 = rows.front();
+        y1 = rows.back();
+    }
+    else {
+        x0 = oceanW + 4;
+        x1 = mapData.width - 5;
+        y0 = 4;
+        y1 = cityY1 - 5;
+    }
+
+    path.points.push_back(Vector3{ (float)x0, eyeHeight, (float)y0 });
+    path.points.push_back(Vector3{ (float)x1, eyeHeight, (float)y0 });
+    path.points.push_back(Vector3{ (float)x1, eyeHeight, (float)y1 });
+    path.points.push_back(Vector3{ (float)x0, eyeHeight, (float)y1 });
+    AddPath(path);
+}
+
+int BenchmarkRunner::GetPathForFrame(int timedFrame, float* t) const {
+    int start = 0;
+    for (size_t i = 0; i < paths.size(); i++) {
+        if (timedFrame < start + paths[i].frames || i + 1 == paths.size()) {
+            *t = paths[i].frames > 1 ? (float)(timedFrame - start) / (paths[i].frames - 1) : 0.0f;
+            *t = Clamp(*t, 0.0f, 1.0f);
+            return (int)i;
+        }
+        start += paths[i].frames;
+    }
+    *t = 0.0f;
+    return 0;
+}
+
+Vector3 BenchmarkRunner::SamplePath(const BenchmarkPath& path, float distance) const {
+    float total = path.distances.back();
+    if (path.loop) distance = fmodf(distance + total, total);
+    distance = Clamp(distance, 0.0f, total);
+
+    size_t i = std::upper_bound(path.distances.begin(), path.distances.end(), distance) - path.distances.begin();
+    i = std::min(std::max<size_t>(i, 1), path.points.size() - 1);
+    float length = path.distances[i] - path.distances[i - 1];
+    float t = length > 0.0f ? (distance - path.distances[i - 1]) / length : 0.0f;
+    return Vector3Lerp(path.points[i - 1], path.points[i], t);
+}
+
+void BenchmarkRunner::BeginFrame(Camera3D* camera, Vector3* playerPosition, float* yaw, float* pitch) {
+    frameStart = GetTime();
+    if (paths.empty()) return;
+
+    // Warmup frames hold the first view
+    float t = 0.0f;
+    int pathIndex = frame < BENCHMARK_WARMUP_FRAMES ? 0 : GetPathForFrame(frame - BENCHMARK_WARMUP_FRAMES, &t);
+    const BenchmarkPath& path = paths[pathIndex];
+
+    if (pathIndex != currentPath) {
+        currentPath = pathIndex;
+        if (path.interiorId.empty()) {
+            if (g_MapPlayer.insideInterior && !ExitInterior(g_MapData, g_MapPlayer)) {
+                g_MapPlayer.insideInterior = false;
+                g_MapPlayer.currentInteriorId.clear();
+            }
+        }
+        else if (!g_MapPlayer.insideInterior || g_MapPlayer.currentInteriorId != path.interiorId) {
+            for (const Building& building : g_MapData.buildings) {
+                if (building.interiorId == path.interiorId) {
+                    EnterInterior(g_MapData, g_MapPlayer, building.id);
+                    break;
+                }
+            }
+        }
+        TraceLog(LOG_INFO, TextFormat("Benchmark: path '%s'", path.name));
+    }
+
+    float distance = t * path.distances.back();
+    Vector3 position = SamplePath(path, distance);
+    Vector3 ahead = SamplePath(path, distance + BENCHMARK_LOOK_AHEAD);
+    Vector3 forward = Vector3Subtract(ahead, position);
+    if (Vector3Length(forward) < 0.01f) {
+        // End of an open path: keep the heading of the last stretch
+        forward = Vector3Subtract(position, SamplePath(path, distance - BENCHMARK_LOOK_AHEAD));
+    }
+    forward.y = 0.0f;
+    forward = Vector3Normalize(forward);
+
+    *playerPosition = position;
+    *yaw = atan2f(forward.z, forward.x) * RAD2DEG;
+    *pitch = 0.0f;
+    camera->position = position;
+    camera->target = Vector3Add(position, forward);
+}
+
+void BenchmarkRunner::BeginGpuTimer() {
+    if (!gpuTimers || frame < BENCHMARK_WARMUP_FRAMES) return;
+
+    int slot = frame % BENCHMARK_GPU_QUERIES;
+    if (querySample[slot] >= 0) ResolveQuery(slot);
+    glBeginQuery(GL_TIME_ELAPSED, queries[slot]);
+    activeQuery = slot;
+}
+
+void BenchmarkRunner::EndGpuTimer() {
+    if (activeQuery >= 0) {
+        glEndQuery(GL_TIME_ELAPSED);
+        querySample[activeQuery] = frame - BENCHMARK_WARMUP_FRAMES;
+        activeQuery = -1;
+    }
+    cpuEnd = GetTime();
+}
+
+void BenchmarkRunner::ResolveQuery(int slot) {
+    // Several frames old by now, so this rarely waits
+    GLuint64 elapsed = 0;
+    glGetQueryObjectui64v(queries[slot], GL_QUERY_RESULT, &elapsed);
+    samples[querySample[slot]].gpuMs = (float)(elapsed / 1000000.0);
+    querySample[slot] = -1;
+}
+
+void BenchmarkRunner::EndFrame() {
+    if (frame >= BENCHMARK_WARMUP_FRAMES && frame - BENCHMARK_WARMUP_FRAMES < totalFrames) {
+        int timedFrame = frame - BENCHMARK_WARMUP_FRAMES;
+        float t;
+        BenchmarkSample& sample = samples[timedFrame];
+        sample.path = GetPathForFrame(timedFrame, &t);
+        sample.cpuMs = (float)((cpuEnd - frameStart) * 1000.0);
+        sample.frameMs = (float)((GetTime() - frameStart) * 1000.0);
+        if (!gpuTimers) sample.gpuMs = -1.0f;
+
+        if (g_RenderStats) {
+            const FrameRenderStats& stats = g_RenderStats->GetCurrent();
+            PassStats total = stats.Total();
+            sample.drawCalls = total.drawCalls;
+            sample.vertices = total.vertices;
+            sample.triangles = total.triangles;
+            sample.batchFlushes = stats.batchFlushes;
+            sample.textureBinds = stats.textureBinds;
+            sample.shaderBinds = stats.shaderBinds;
+            sample.skipped = stats.skipped;
+            sample.culled = total.culled;
+        }
+    }
+    frame++;
+}
+
+// Average fps over the slowest 'fraction' of frames
+static float LowFps(std::vector<float> frameMs, float fraction) {
+    if (frameMs.empty()) return 0.0f;
+    std::sort(frameMs.begin(), frameMs.end(), std::greater<float>());
+    size_t count = std::max<size_t>(1, (size_t)(frameMs.size() * fraction));
+    double sum = 0.0;
+    for (size_t i = 0; i < count; i++) sum += frameMs[i];
+    return sum > 0.0 ? (float)(1000.0 * count / sum) : 0.0f;
+}
+
+bool BenchmarkRunner::WriteResults() {
+    for (int slot = 0; slot < BENCHMARK_GPU_QUERIES; slot++) {
+        if (querySample[slot] >= 0) ResolveQuery(slot);
+    }
+
+    std::ofstream outfile(options.outputPath);
+    if (!outfile.is_open()) {
+        TraceLog(LOG_ERROR, TextFormat("Benchmark: failed to open %s for writing.", options.outputPath.c_str()));
+        return false;
+    }
+    outfile << "frame,path,cpu_ms,gpu_ms,frame_ms,draw_calls,vertices,triangles,batch_flushes,texture_binds,shader_binds,skipped,culled\n";
+    for (int i = 0; i < totalFrames; i++) {
+        const BenchmarkSample& s = samples[i];
+        outfile << i << "," << paths[s.path].name << "," << s.cpuMs << "," << s.gpuMs << "," << s.frameMs << ","
+            << s.drawCalls << "," << s.vertices << "," << s.triangles << "," << s.batchFlushes << ","
+            << s.textureBinds << "," << s.shaderBinds << "," << s.skipped << "," << s.culled << "\n";
+    }
+    outfile.close();
+
+    // Summary next to the per-frame file: <name>_summary.csv
+    std::string summaryPath = options.outputPath;
+    size_t dot = summaryPath.rfind('.');
+    if (dot != std::string::npos && summaryPath.find_first_of("/\\", dot) == std::string::npos) summaryPath.erase(dot);
+    summaryPath += "_summary.csv";
+
+    std::ofstream summary(summaryPath);
+    if (!summary.is_open()) {
+        TraceLog(LOG_ERROR, TextFormat("Benchmark: failed to open %s for writing.", summaryPath.c_str()));
+        return false;
+    }
+    summary << "path,frames,avg_fps,avg_frame_ms,avg_cpu_ms,avg_gpu_ms,low_1pct_fps,low_0.1pct_fps,max_frame_ms\n";
+    for (int p = -1; p < (int)paths.size(); p++) {
+        std::vector<float> frameMs;
+        double cpu = 0.0, gpu = 0.0;
+        float worst = 0.0f;
+        for (const BenchmarkSample& s : samples) {
+            if (p >= 0 && s.path != p) continue;
+            frameMs.push_back(s.frameMs);
+            cpu += s.cpuMs;
+            gpu += s.gpuMs;
+            worst = std::max(worst, s.frameMs);
+        }
+        if (frameMs.empty()) continue;
+
+        double total = 0.0;
+        for (float ms : frameMs) total += ms;
+        size_t n = frameMs.size();
+        summary << (p < 0 ? "all" : paths[p].name) << "," << n << ","
+            << (total > 0.0 ? 1000.0 * n / total : 0.0) << "," << total / n << ","
+            << cpu / n << "," << (gpuTimers ? gpu / n : -1.0) << ","
+            << LowFps(frameMs, 0.01f) << "," << LowFps(frameMs, 0.001f) << "," << worst << "\n";
+
+        if (p < 0) {
+            TraceLog(LOG_INFO, "Benchmark: %.1f avg fps, %.1f 1%% low, %.1f 0.1%% low",
+                total > 0.0 ? 1000.0 * n / total : 0.0, LowFps(frameMs, 0.01f), LowFps(frameMs, 0.001f));
+        }
+    }
+    summary.close();
+
+    TraceLog(LOG_INFO, TextFormat("Benchmark: wrote %s and %s", options.outputPath.c_str(), summaryPath.c_str()));
+    return true;
+}
+
+// Global initialization
+void InitializeBenchmarkSystem(const BenchmarkOptions& options) {
+    g_Benchmark = new BenchmarkRunner(options);
+    TraceLog(LOG_INFO, "Benchmark mode enabled");
+}
+
+void CleanupBenchmarkSystem() {
+    if (g_Benchmark) {
+        delete g_Benchmark;
+        g_Benchmark = nullptr;
+    }
+}
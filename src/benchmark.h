@@ -0,0 +1,122 @@
+#pragma once
+#include "globals.h"
+#include "map.h"
+#include <vector>
+#include <string>
+
+// Seed for srand/SetRandomSeed so map and procedural textures match between runs
+#define BENCHMARK_SEED 1337
+
+// Frames rendered before timing starts (shader compiles, first uploads)
+#define BENCHMARK_WARMUP_FRAMES 60
+
+#define BENCHMARK_DEFAULT_FRAMES 2000
+
+// In-flight GPU timer queries; results are read this many frames late
+#define BENCHMARK_GPU_QUERIES 4
+
+// Command line options
+struct BenchmarkOptions {
+    bool enabled;
+    int frames;               // Timed frames, split between the two paths
+    std::string outputPath;   // Per-frame CSV; the summary goes next to it
+    int stressLights;         // Extra point lights around the camera (0 = none)
+};
+
+// Parse --benchmark, --benchmark-frames=N, --benchmark-out=FILE and
+// --benchmark-lights=N.
+// Returns false if none of them was given.
+bool ParseBenchmarkArgs(int argc, char** argv, BenchmarkOptions* options);
+
+// One scripted camera path
+struct BenchmarkPath {
+    const char* name;
+    std::vector<Vector3> points;
+    std::vector<float> distances;   // Cumulative length at each point
+    std::string interiorId;         // Empty for outdoor paths
+    bool loop;                      // Last point joins the first
+    int frames;
+};
+
+// Timings and counters for one frame
+struct BenchmarkSample {
+    int path;
+    float cpuMs;       // Loop start to just before EndDrawing
+    float gpuMs;       // GL_TIME_ELAPSED over the frame's GL work (-1 if unavailable)
+    float frameMs;     // Loop start to after EndDrawing (includes the swap)
+    int drawCalls;
+    int vertices;
+    int triangles;
+    int batchFlushes;
+    int textureBinds;
+    int shaderBinds;
+    int skipped;
+    int culled;
+};
+
+// Benchmark runner class
+// Drives the camera along two fixed paths by frame number (never by time),
+// so every run renders the same views: a walk through lab_detailed_01 from the
+// cryo room through its doors, then a loop around the outermost city-band
+// roads. After the last frame the per-frame samples and a summary with 1% and
+// 0.1% lows are written as CSV.
+//
+// Runs in a hidden window, so it works without a monitor, e.g. on Linux:
+//   xvfb-run -a env LIBGL_ALWAYS_SOFTWARE=1 ./abandonedlabmodular --benchmark
+class BenchmarkRunner {
+public:
+    explicit BenchmarkRunner(const BenchmarkOptions& options);
+    ~BenchmarkRunner();
+
+    // Build the camera paths for the generated map
+    void Initialize(const MapData& mapData, float eyeHeight);
+
+    // Place the camera for this frame, entering or leaving the lab between paths
+    void BeginFrame(Camera3D* camera, Vector3* playerPosition, float* yaw, float* pitch);
+
+    // Bracket the frame's GL work (inside BeginDrawing/EndDrawing)
+    void BeginGpuTimer();
+    void EndGpuTimer();
+
+    // Record the frame; call after EndDrawing
+    void EndFrame();
+
+    bool IsFinished() const { return frame >= BENCHMARK_WARMUP_FRAMES + totalFrames; }
+
+    // Write the per-frame CSV and the summary CSV
+    bool WriteResults();
+
+private:
+    BenchmarkOptions options;
+    std::vector<BenchmarkPath> paths;
+    std::vector<BenchmarkSample> samples;
+    int totalFrames;
+    int frame;
+    int currentPath;
+    double frameStart;
+    double cpuEnd;
+    bool gpuTimers;
+
+    unsigned int queries[BENCHMARK_GPU_QUERIES];
+    int querySample[BENCHMARK_GPU_QUERIES];   // Sample waiting on each query, -1 = free
+    int activeQuery;
+
+    void BuildInteriorPath(const MapData& mapData, float eyeHeight);
+    void BuildOutdoorPath(const MapData& mapData, float eyeHeight);
+    void AddPath(BenchmarkPath path);
+
+    // Which path and how far along it (0..1) a timed frame is
+    int GetPathForFrame(int timedFrame, float* t) const;
+    Vector3 SamplePath(const BenchmarkPath& path, float distance) const;
+
+    void ResolveQuery(int slot);
+};
+
+// Global benchmark runner (nullptr unless --benchmark was given)
+extern BenchmarkRunner* g_Benchmark;
+
+// Initialize benchmark runner
+void InitializeBenchmarkSystem(const BenchmarkOptions& options);
+
+// Cleanup benchmark runner
+void CleanupBenchmarkSystem();
@@ -1,4 +1,15 @@
 #include "console.h"
+#include "render_stats.h"
+#include "profiler.h"
+#include "light_manager.h"
+#include "shadow_manager.h"
+#include "lightmap_baker.h"
+#include "uniform_buffer.h"
+#include "geometry_streamer.h"
+#include "post_process.h"
+#include "minimap_renderer.h"
+#include "ui_cache.h"
+#include "texture_manager.h"
 #include <algorithm>
 #include <sstream>
 #include <cctype>
@@ -24,7 +35,7 @@ void ProcessConsoleCommand(std::vector<std::string>& consoleHistory, float* heal
     std::transform(command.begin(), command.end(), command.begin(), [](unsigned char c){ return static_cast<char>(std::tolower(c)); });
 
     if (command == "help") {
-        consoleHistory.push_back("Available commands: help, noclip, setstat <stat> <value>, setfov <value>");
+        consoleHistory.push_back("Available commands: help, noclip, setstat <stat> <value>, setfov <value>, stats [overlay], profile [show|pause|export <file>], lights [stress [count]|off], shadows, lightmaps, uniforms, shaders, stream, minimap, ui [on|off], post [exposure|contrast|saturation|grain <value>]");
     } else if (command == "noclip") {
         *isNoclip = !(*isNoclip);
         consoleHistory.push_back(TextFormat("Noclip %s", *isNoclip ? "enabled." : "disabled."));
@@ -60,6 +71,103 @@ void ProcessConsoleCommand(std::vector<std::string>& consoleHistory, float* heal
             *fov = value;
             consoleHistory.push_back(TextFormat("FOV set to %.0f", value));
         }
+    } else if (command == "stats") {
+        std::string option;
+        ss >> option;
+        if (!g_RenderStats) {
+            consoleHistory.push_back("Render stats not available.");
+        } else if (option == "overlay") {
+            g_RenderStats->ToggleExpanded();
+            consoleHistory.push_back(TextFormat("Render stats overlay %s", g_RenderStats->IsExpanded() ? "expanded." : "collapsed."));
+        } else {
+            g_RenderStats->AppendReport(consoleHistory);
+        }
+    } else if (command == "profile") {
+        std::string option;
+        ss >> option;
+        if (!g_Profiler) {
+            consoleHistory.push_back("Profiler not available (compiled out of release builds).");
+        } else if (option == "show") {
+            g_Profiler->ToggleVisible();
+            consoleHistory.push_back(g_Profiler->IsVisible() ? "Profiler view shown (F4)." : "Profiler view hidden.");
+        } else if (option == "pause") {
+            g_Profiler->SetPaused(!g_Profiler->IsPaused());
+            consoleHistory.push_back(g_Profiler->IsPaused() ? "Profiler paused." : "Profiler resumed.");
+        } else if (option == "export") {
+            std::string filename;
+            ss >> filename;
+            if (filename.empty()) filename = "profile_trace.json";
+            if (g_Profiler->ExportChromeTrace(filename.c_str())) {
+                consoleHistory.push_back("Trace written to " + filename + " (open in ui.perfetto.dev).");
+            } else {
+                consoleHistory.push_back("Failed to write " + filename + ".");
+            }
+        } else {
+            g_Profiler->AppendReport(consoleHistory);
+        }
+    } else if (command == "lights") {
+        std::string option;
+        ss >> option;
+        if (!g_LightManager || !g_LightManager->IsReady()) {
+            consoleHistory.push_back("Point lights not available.");
+        } else if (option == "stress") {
+            int count = LIGHT_STRESS_DEFAULT;
+            ss >> count;
+            if (ss.fail()) count = LIGHT_STRESS_DEFAULT;
+            g_LightManager->SetStressLights(count);
+            consoleHistory.push_back(TextFormat("%d stress lights around the camera.", g_LightManager->GetStressLightCount()));
+        } else if (option == "off") {
+            g_LightManager->SetStressLights(0);
+            consoleHistory.push_back("Stress lights removed.");
+        } else {
+            g_LightManager->AppendReport(consoleHistory);
+        }
+    } else if (command == "shadows") {
+        if (g_ShadowManager) g_ShadowManager->AppendReport(consoleHistory);
+        else consoleHistory.push_back("Shadows not available.");
+    } else if (command == "lightmaps") {
+        if (g_LightmapBaker) g_LightmapBaker->AppendReport(consoleHistory);
+        else consoleHistory.push_back("Lightmaps not available.");
+    } else if (command == "uniforms") {
+        AppendUniformReport(consoleHistory);
+    } else if (command == "shaders") {
+        if (g_ShaderManager) g_ShaderManager->AppendVariantReport(consoleHistory);
+        else consoleHistory.push_back("Shaders not loaded.");
+    } else if (command == "stream") {
+        if (g_GeometryStreamer && g_GeometryStreamer->IsReady()) g_GeometryStreamer->AppendReport(consoleHistory);
+        else consoleHistory.push_back("Geometry streaming not available.");
+    } else if (command == "minimap") {
+        if (g_MinimapRenderer) g_MinimapRenderer->AppendReport(consoleHistory);
+        else consoleHistory.push_back("Minimap renderer not available.");
+    } else if (command == "ui") {
+        std::string option;
+        ss >> option;
+        if (!g_UiCache) {
+            consoleHistory.push_back("UI cache not available.");
+        } else {
+            if (option == "on" || option == "off") {
+                g_UiCache->SetEnabled(option == "on");
+                g_UiCache->Invalidate();
+            }
+            g_UiCache->AppendReport(consoleHistory);
+        }
+    } else if (command == "post") {
+        if (!g_PostProcess) {
+            consoleHistory.push_back("Post-processing not available.");
+        }
+        else {
+            std::string setting;
+            float value = 0.0f;
+            PostProcessGrading& grading = g_PostProcess->GetGrading();
+            if (ss >> setting >> value) {
+                if (setting == "exposure") grading.exposure = fmaxf(0.0f, fminf(4.0f, value));
+                else if (setting == "contrast") grading.contrast = fmaxf(0.0f, fminf(2.0f, value));
+                else if (setting == "saturation") grading.saturation = fmaxf(0.0f, fminf(2.0f, value));
+                else if (setting == "grain") grading.grain = fmaxf(0.0f, fminf(0.5f, value));
+                else consoleHistory.push_back("Usage: post [exposure|contrast|saturation|grain <value>]");
+            }
+            g_PostProcess->AppendReport(consoleHistory);
+        }
     } else {
         consoleHistory.push_back("Unknown command. Type 'help'.");
     }
@@ -86,20 +194,21 @@ void DrawConsole(int screenW, int screenH, const std::vector<std::string>& histo
     DrawRectangle(0, screenH / 2 - 25, screenW, 25, PIPBOY_SELECTED);
     DrawText(TextFormat("] %s_", input ? input : ""), 10, screenH / 2 - 20, 18, PIPBOY_GREEN);
 }
-void UpdateConsoleInput() {
-    int key = GetKeyPressed();
-    while (key != 0) {
-        if (key == KEY_BACKSPACE) {
-            if (consoleInputLength > 0) {
-                consoleInput[--consoleInputLength] = '\0';
-            }
-        } else if (key == KEY_ENTER) {
-            // Process command
-            ProcessConsoleCommand(consoleHistory, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
-        } else if (consoleInputLength < MAX_COMMAND_LENGTH - 1 && isprint(key)) {
-            consoleInput[consoleInputLength++] = static_cast<char>(key);
+void UpdateConsoleInput(float* health, float* stamina, float* hunger, float* thirst, bool* isNoclip, float* fov) {
+    if (IsKeyPressed(KEY_BACKSPACE) && consoleInputLength > 0) {
+        consoleInput[--consoleInputLength] = '\0';
+    }
+    if (IsKeyPressed(KEY_ENTER)) {
+        ProcessConsoleCommand(consoleHistory, health, stamina, hunger, thirst, isNoclip, fov);
+    }
+
+    // Typed characters; the grave/tilde key only toggles the console
+    int c = GetCharPressed();
+    while (c != 0) {
+        if (c != '`' && c != '~' && consoleInputLength < MAX_COMMAND_LENGTH - 1 && c >= 32 && c < 127) {
+            consoleInput[consoleInputLength++] = static_cast<char>(c);
             consoleInput[consoleInputLength] = '\0';
         }
-        key = GetKeyPressed();
+        c = GetCharPressed();
     }
 }
@@ -9,4 +9,5 @@ extern std::vector<std::string> consoleHistory;
 void ProcessConsoleCommand(std::vector<std::string>& consoleHistory, float* health, float* stamina, float* hunger, float* thirst, bool* isNoclip, float* fov);
 // Helper for main.cpp
 void DrawConsole(int screenW, int screenH, const std::vector<std::string>& history, const char* input, int inputLength);
-void UpdateConsoleInput();
\ No newline at end of file
+// Read typed characters; Enter runs the command against the given player state
+void UpdateConsoleInput(float* health, float* stamina, float* hunger, float* thirst, bool* isNoclip, float* fov);
\ No newline at end of file
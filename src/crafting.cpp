@@ -2,6 +2,7 @@
 #include "recipes.h" // Needed for the recipes global
 #include "items.h"
 #include "inventory.h" // For AddItemToInventory
+#include "input.h"
 
 bool HasIngredients(const CraftingRecipe& recipe, InventorySlot* inventory) { 
     // [Implementation of HasIngredients]
@@ -52,10 +53,10 @@ void DrawCraftingMenu(int screenW, int screenH, InventorySlot* inventory, int* s
     int recipeHeight = 40;
     
     // Input handling for menu navigation
-    if (IsKeyPressed(KEY_UP) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_UP))) {
+    if (InputIsKeyPressed(KEY_UP) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_UP))) {
         *selectedRecipeIndex = (*selectedRecipeIndex - 1 + (int)recipes.size()) % (int)recipes.size();
     }
-    if (IsKeyPressed(KEY_DOWN) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_DOWN))) {
+    if (InputIsKeyPressed(KEY_DOWN) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_DOWN))) {
         *selectedRecipeIndex = (*selectedRecipeIndex + 1) % (int)recipes.size();
     }
 
@@ -74,7 +75,7 @@ void DrawCraftingMenu(int screenW, int screenH, InventorySlot* inventory, int* s
         DrawText(TextFormat("Result: %s x%d", GetItemName(recipe.resultId), recipe.resultQuantity), listX + 200, recipeY + 15, 12, PIPBOY_DIM);
         
         // Mouse selection check
-        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && GetMousePosition().x >= listX && GetMousePosition().x <= listX + listW && GetMousePosition().y >= recipeY && GetMousePosition().y <= recipeY + recipeHeight) {
+        if (InputIsMouseButtonPressed(MOUSE_LEFT_BUTTON) && InputGetMousePosition().x >= listX && InputGetMousePosition().x <= listX + listW && InputGetMousePosition().y >= recipeY && InputGetMousePosition().y <= recipeY + recipeHeight) {
              *selectedRecipeIndex = (int)i;
         }
     }
@@ -102,7 +103,7 @@ void DrawCraftingMenu(int screenW, int screenH, InventorySlot* inventory, int* s
         DrawRectangle(detailX, btnY, 150, 30, btnColor);
         DrawText("CRAFT (E)", detailX + 10, btnY + 8, 18, canCraft ? BLACK : PIPBOY_DARK);
         
-        bool craftAction = IsKeyPressed(KEY_E) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_DOWN));
+        bool craftAction = InputIsKeyPressed(KEY_E) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_DOWN));
         if (canCraft && craftAction) {
              ConsumeIngredients(recipe, inventory); 
              AddItemToInventory(inventory, recipe.resultId, recipe.resultQuantity, 0); 
@@ -0,0 +1,205 @@
+#include "culling.h"
+#include "occlusion.h"
+#include "raymath.h"
+#include "rlgl.h"
+
+// Global instance
+FrustumCuller* g_FrustumCuller = nullptr;
+
+// =============================================================================
+// FRUSTUM
+// =============================================================================
+
+void Frustum::SetFromMatrix(Matrix m) {
+    // raylib matrices transform column vectors as x' = m0*x + m4*y + m8*z + m12,
+    // so the rows of the clip transform are (m0 m4 m8 m12), (m1 m5 m9 m13), ...
+    Vector4 row0 = { m.m0, m.m4, m.m8, m.m12 };
+    Vector4 row1 = { m.m1, m.m5, m.m9, m.m13 };
+    Vector4 row2 = { m.m2, m.m6, m.m10, m.m14 };
+    Vector4 row3 = { m.m3, m.m7, m.m11, m.m15 };
+
+    const Vector4* rows[3] = { &row0, &row1, &row2 };
+    for (int i = 0; i < 3; i++) {
+        const Vector4& r = *rows[i];
+        planes[i * 2] = Vector4{ row3.x + r.x, row3.y + r.y, row3.z + r.z, row3.w + r.w };
+        planes[i * 2 + 1] = Vector4{ row3.x - r.x, row3.y - r.y, row3.z - r.z, row3.w - r.w };
+    }
+
+    for (int i = 0; i < 6; i++) {
+        Vector4& p = planes[i];
+        float len = sqrtf(p.x * p.x + p.y * p.y + p.z * p.z);
+        if (len > 0.0f) p = Vector4{ p.x / len, p.y / len, p.z / len, p.w / len };
+    }
+}
+
+void Frustum::SetFromCamera(const Camera3D& camera, float aspect) {
+    float nearPlane = (float)rlGetCullDistanceNear();
+    float farPlane = (float)rlGetCullDistanceFar();
+
+    Matrix view = MatrixLookAt(camera.position, camera.target, camera.up);
+    Matrix projection;
+    if (camera.projection == CAMERA_ORTHOGRAPHIC) {
+        float top = camera.fovy / 2.0f;
+        float right = top * aspect;
+        projection = MatrixOrtho(-right, right, -top, top, nearPlane, farPlane);
+    }
+    else {
+        projection = MatrixPerspective(camera.fovy * DEG2RAD, aspect, nearPlane, farPlane);
+    }
+
+    // raylib multiplies left-to-right: view first, then projection
+    SetFromMatrix(MatrixMultiply(view, projection));
+}
+
+bool Frustum::ContainsBox(Vector3 min, Vector3 max) const {
+    for (int i = 0; i < 6; i++) {
+        const Vector4& p = planes[i];
+        // Corner furthest along the plane normal; if it is outside, the whole box is
+        float x = p.x >= 0.0f ? max.x : min.x;
+        float y = p.y >= 0.0f ? max.y : min.y;
+        float z = p.z >= 0.0f ? max.z : min.z;
+        if (p.x * x + p.y * y + p.z * z + p.w < 0.0f) return false;
+    }
+    return true;
+}
+
+bool Frustum::ContainsSphere(Vector3 center, float radius) const {
+    for (int i = 0; i < 6; i++) {
+        const Vector4& p = planes[i];
+        if (p.x * center.x + p.y * center.y + p.z * center.z + p.w < -radius) return false;
+    }
+    return true;
+}
+
+FrustumResult Frustum::ClassifyBox(Vector3 min, Vector3 max) const {
+    FrustumResult result = FRUSTUM_INSIDE;
+    for (int i = 0; i < 6; i++) {
+        const Vector4& p = planes[i];
+        // Far corner outside: fully outside. Near corner outside: straddles this plane
+        float fx = p.x >= 0.0f ? max.x : min.x;
+        float fy = p.y >= 0.0f ? max.y : min.y;
+        float fz = p.z >= 0.0f ? max.z : min.z;
+        if (p.x * fx + p.y * fy + p.z * fz + p.w < 0.0f) return FRUSTUM_OUTSIDE;
+
+        float nx = p.x >= 0.0f ? min.x : max.x;
+        float ny = p.y >= 0.0f ? min.y : max.y;
+        float nz = p.z >= 0.0f ? min.z : max.z;
+        if (p.x * nx + p.y * ny + p.z * nz + p.w < 0.0f) result = FRUSTUM_INTERSECT;
+    }
+    return result;
+}
+
+// =============================================================================
+// BOX LIST
+// =============================================================================
+
+void CullBoxList::Add(const BoundingBox& box) {
+    minX.push_back(box.min.x);
+    minY.push_back(box.min.y);
+    minZ.push_back(box.min.z);
+    maxX.push_back(box.max.x);
+    maxY.push_back(box.max.y);
+    maxZ.push_back(box.max.z);
+}
+
+void CullBoxList::Clear() {
+    minX.clear();
+    minY.clear();
+    minZ.clear();
+    maxX.clear();
+    maxY.clear();
+    maxZ.clear();
+}
+
+// =============================================================================
+// FRUSTUM CULLER
+// =============================================================================
+
+FrustumCuller::FrustumCuller() {
+    for (int i = 0; i < 6; i++) frustum.planes[i] = Vector4{ 0.0f, 0.0f, 0.0f, 1.0f };
+    viewProjection = MatrixIdentity();
+    enabled = false;
+    stats = { 0, 0, 0 };
+    lastStats = { 0, 0, 0 };
+}
+
+void FrustumCuller::BeginFrame(bool enableCulling) {
+    lastStats = stats;
+    stats = { 0, 0, 0 };
+    enabled = enableCulling;
+
+    // Inside BeginMode3D the modelview holds the camera view and the projection
+    // matches the current render target (including upscaled targets)
+    viewProjection = MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection());
+    frustum.SetFromMatrix(viewProjection);
+}
+
+void FrustumCuller::Record(int tested, int visible) {
+    stats.tested += tested;
+    stats.visible += visible;
+    stats.culled += tested - visible;
+}
+
+bool FrustumCuller::IsBoxVisible(const BoundingBox& box) {
+    bool visible = !enabled || frustum.ContainsBox(box.min, box.max);
+    Record(1, visible ? 1 : 0);
+    return visible;
+}
+
+bool FrustumCuller::IsSphereVisible(Vector3 center, float radius) {
+    bool visible = !enabled || frustum.ContainsSphere(center, radius);
+    Record(1, visible ? 1 : 0);
+    return visible;
+}
+
+int FrustumCuller::CullBoxes(const CullBoxList& boxes, std::vector<unsigned char>& visible) {
+    const int count = boxes.Count();
+    visible.assign(count, 1);
+
+    if (enabled) {
+        unsigned char* out = visible.data();
+        for (int p = 0; p < 6; p++) {
+            const Vector4 plane = frustum.planes[p];
+            // Pick the far corner per plane once, so the inner loop has no branches
+            const float* xs = plane.x >= 0.0f ? boxes.maxX.data() : boxes.minX.data();
+            const float* ys = plane.y >= 0.0f ? boxes.maxY.data() : boxes.minY.data();
+            const float* zs = plane.z >= 0.0f ? boxes.maxZ.data() : boxes.minZ.data();
+            for (int i = 0; i < count; i++) {
+                float d = plane.x * xs[i] + plane.y * ys[i] + plane.z * zs[i] + plane.w;
+                out[i] &= (unsigned char)(d >= 0.0f);
+            }
+        }
+    }
+
+    int visibleCount = 0;
+    for (int i = 0; i < count; i++) visibleCount += visible[i];
+    Record(count, visibleCount);
+    return visibleCount;
+}
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+bool IsBoxInView(const BoundingBox& box) {
+    if (g_FrustumCuller && !g_FrustumCuller->IsBoxVisible(box)) return false;
+    return !g_OcclusionCuller || !g_OcclusionCuller->IsOccluded(box);
+}
+
+bool IsSphereInView(Vector3 center, float radius) {
+    return !g_FrustumCuller || g_FrustumCuller->IsSphereVisible(center, radius);
+}
+
+// Global initialization
+void InitializeCullingSystem() {
+    g_FrustumCuller = new FrustumCuller();
+    TraceLog(LOG_INFO, "Culling system initialized");
+}
+
+void CleanupCullingSystem() {
+    if (g_FrustumCuller) {
+        delete g_FrustumCuller;
+        g_FrustumCuller = nullptr;
+    }
+    TraceLog(LOG_INFO, "Culling system cleaned up");
+}
@@ -0,0 +1,100 @@
+#pragma once
+// NOTE: only raylib here - waypoints.h (pulled in by globals.h) culls its markers
+#include "raylib.h"
+#include <vector>
+
+// Result of classifying a box against the frustum
+enum FrustumResult {
+    FRUSTUM_OUTSIDE = 0,
+    FRUSTUM_INTERSECT,
+    FRUSTUM_INSIDE
+};
+
+// View frustum as six normalized planes (xyz = normal pointing inwards, w = distance).
+// A point p is inside a plane when dot(normal, p) + w >= 0.
+struct Frustum {
+    Vector4 planes[6];   // left, right, bottom, top, near, far
+
+    // Extract the planes from a combined view * projection matrix
+    void SetFromMatrix(Matrix viewProjection);
+
+    // Build the frustum a camera would use for the given aspect ratio
+    void SetFromCamera(const Camera3D& camera, float aspect);
+
+    bool ContainsBox(Vector3 min, Vector3 max) const;
+    bool ContainsSphere(Vector3 center, float radius) const;
+
+    // Outside, straddling, or fully inside (lets hierarchies skip child tests)
+    FrustumResult ClassifyBox(Vector3 min, Vector3 max) const;
+};
+
+// Bounding boxes stored as separate coordinate arrays so the batch test runs
+// the same multiply-add over contiguous floats (auto-vectorizes cleanly)
+struct CullBoxList {
+    std::vector<float> minX, minY, minZ;
+    std::vector<float> maxX, maxY, maxZ;
+
+    void Add(const BoundingBox& box);
+    void Clear();
+    int Count() const { return (int)minX.size(); }
+};
+
+// Per-frame culling counters
+struct CullingStats {
+    int tested;
+    int visible;
+    int culled;
+};
+
+// Frustum culler class
+// Holds the frustum of the camera currently being rendered. Draw code asks it
+// which bounds are visible before submitting anything to the render queue.
+class FrustumCuller {
+public:
+    FrustumCuller();
+
+    // Capture the frustum from the active rlgl matrices (call after BeginMode3D).
+    // When disabled every test passes but is still counted.
+    void BeginFrame(bool enabled);
+
+    bool IsEnabled() const { return enabled; }
+
+    bool IsBoxVisible(const BoundingBox& box);
+    bool IsSphereVisible(Vector3 center, float radius);
+
+    // Test a batch of boxes; visible[i] is set to 1 or 0. Returns the visible count.
+    int CullBoxes(const CullBoxList& boxes, std::vector<unsigned char>& visible);
+
+    const Frustum& GetFrustum() const { return frustum; }
+
+    // View * projection captured with the frustum (for screen-space tests)
+    Matrix GetViewProjection() const { return viewProjection; }
+
+    // Add results of tests done elsewhere (e.g. a spatial index query) to the counters
+    void Record(int tested, int visible);
+
+    // Counters for the frame in progress and the last completed frame
+    const CullingStats& GetStats() const { return stats; }
+    const CullingStats& GetLastStats() const { return lastStats; }
+
+private:
+    Frustum frustum;
+    Matrix viewProjection;
+    bool enabled;
+    CullingStats stats;
+    CullingStats lastStats;
+};
+
+// Global frustum culler instance
+extern FrustumCuller* g_FrustumCuller;
+
+// Visibility helpers: true when no culler exists, so callers never need to check.
+// Boxes are also tested against the occlusion buffer once it has been rasterized.
+bool IsBoxInView(const BoundingBox& box);
+bool IsSphereInView(Vector3 center, float radius);
+
+// Initialize culling system
+void InitializeCullingSystem();
+
+// Cleanup culling system
+void CleanupCullingSystem();
@@ -1,4 +1,5 @@
 #include "fileio.h"
+#include "profiler.h"
 #include <sys/stat.h> // for stat()
 
 // Implements file saving and loading logic using the globals.h structs.
@@ -10,6 +11,7 @@ bool SaveFileExists(int slotIndex) {
 }
 // ... SaveGame and LoadGame implementations here (omitted for brevity, copied from source)
 void SaveGame(int slotIndex, Vector3 pos, float yaw, float pitch, float hp, float stam, float hung, float thirst, InventorySlot* inv, float batt, bool lightOn, char map[MAP_SIZE][MAP_SIZE], float fov) {
+    PROFILE_SCOPE("SaveGame");
     std::string filename = TextFormat(SAVE_FILE_NAME_FORMAT, slotIndex);
     std::ofstream outfile(filename);
 
@@ -61,6 +63,7 @@ void SaveGame(int slotIndex, Vector3 pos, float yaw, float pitch, float hp, floa
 }
 
 bool LoadGame(int slotIndex, Vector3* pos, float* yaw, float* pitch, float* hp, float* stam, float* hung, float* thirst, InventorySlot* inv, float* batt, bool* lightOn, char map[MAP_SIZE][MAP_SIZE], float* fov) {
+    PROFILE_SCOPE("LoadGame");
     std::string filename = TextFormat(SAVE_FILE_NAME_FORMAT, slotIndex);
     std::ifstream infile(filename);
 
@@ -0,0 +1,327 @@
+#include "geometry_streamer.h"
+#include "profiler.h"
+#include "raymath.h"
+#include "rlgl.h"
+#include "external/glad.h"
+#include <cstring>
+#include <cstddef>
+#include <cmath>
+
+// Global instance
+GeometryStreamer* g_GeometryStreamer = nullptr;
+
+// Flip a triangle so it winds counter-clockwise seen from outside (rlgl culls back faces)
+static void AddOutwardTriangle(std::vector<Vector3>& out, Vector3 a, Vector3 b, Vector3 c) {
+    Vector3 normal = Vector3CrossProduct(Vector3Subtract(b, a), Vector3Subtract(c, a));
+    Vector3 centroid = Vector3Scale(Vector3Add(Vector3Add(a, b), c), 1.0f / 3.0f);
+    if (Vector3DotProduct(normal, centroid) < 0.0f) {
+        Vector3 swap = b;
+        b = c;
+        c = swap;
+    }
+    out.push_back(a);
+    out.push_back(b);
+    out.push_back(c);
+}
+
+// Unit cube centered on the origin, two triangles per face
+static std::vector<Vector3> BuildCubeTemplate() {
+    std::vector<Vector3> cube;
+    cube.reserve(STREAM_CUBE_VERTICES);
+    for (int axis = 0; axis < 3; axis++) {
+        for (int side = -1; side <= 1; side += 2) {
+            // Corners of the face in the two other axes
+            Vector3 corners[4];
+            const float uv[4][2] = { { -0.5f, -0.5f }, { 0.5f, -0.5f }, { 0.5f, 0.5f }, { -0.5f, 0.5f } };
+            for (int i = 0; i < 4; i++) {
+                float p[3];
+                p[axis] = 0.5f * side;
+                p[(axis + 1) % 3] = uv[i][0];
+                p[(axis + 2) % 3] = uv[i][1];
+                corners[i] = Vector3{ p[0], p[1], p[2] };
+            }
+            AddOutwardTriangle(cube, corners[0], corners[1], corners[2]);
+            AddOutwardTriangle(cube, corners[0], corners[2], corners[3]);
+        }
+    }
+    return cube;
+}
+
+// Unit sphere, STREAM_SPHERE_RINGS x STREAM_SPHERE_SLICES quads (STREAM_SPHERE_VERTICES vertices)
+static std::vector<Vector3> BuildSphereTemplate() {
+    std::vector<Vector3> sphere;
+    sphere.reserve(STREAM_SPHERE_VERTICES);
+    for (int ring = 0; ring < STREAM_SPHERE_RINGS; ring++) {
+        float lat0 = -PI / 2.0f + PI * ring / STREAM_SPHERE_RINGS;
+        float lat1 = -PI / 2.0f + PI * (ring + 1) / STREAM_SPHERE_RINGS;
+        for (int slice = 0; slice < STREAM_SPHERE_SLICES; slice++) {
+            float lon0 = 2.0f * PI * slice / STREAM_SPHERE_SLICES;
+            float lon1 = 2.0f * PI * (slice + 1) / STREAM_SPHERE_SLICES;
+            Vector3 a = { cosf(lat0) * sinf(lon0), sinf(lat0), cosf(lat0) * cosf(lon0) };
+            Vector3 b = { cosf(lat0) * sinf(lon1), sinf(lat0), cosf(lat0) * cosf(lon1) };
+            Vector3 c = { cosf(lat1) * sinf(lon1), sinf(lat1), cosf(lat1) * cosf(lon1) };
+            Vector3 d = { cosf(lat1) * sinf(lon0), sinf(lat1), cosf(lat1) * cosf(lon0) };
+            AddOutwardTriangle(sphere, a, b, c);
+            AddOutwardTriangle(sphere, a, c, d);
+        }
+    }
+    return sphere;
+}
+
+GeometryStreamer::GeometryStreamer() {
+    ready = false;
+    buffer = 0;
+    vao = 0;
+    mapped = nullptr;
+    for (int i = 0; i < STREAM_REGIONS; i++) fences[i] = nullptr;
+    region = 0;
+    regionUsed = 0;
+    pendingMode = GL_TRIANGLES;
+    stats = { 0, 0, 0, 0, 0, 0 };
+    lastStats = stats;
+}
+
+GeometryStreamer::~GeometryStreamer() {
+    Unload();
+}
+
+bool GeometryStreamer::Initialize() {
+    TraceLog(LOG_INFO, "Initializing Geometry Streamer...");
+
+    // Vertex arrays and fences need GL 3.3
+    if (rlGetVersion() < RL_OPENGL_33) {
+        TraceLog(LOG_WARNING, "Geometry streaming needs OpenGL 3.3, shapes use the rlgl batch");
+        return false;
+    }
+
+    cubeTemplate = BuildCubeTemplate();
+    sphereTemplate = BuildSphereTemplate();
+    pending.reserve(STREAM_SPHERE_VERTICES * 8);
+
+    GLsizeiptr size = (GLsizeiptr)STREAM_REGIONS * STREAM_REGION_BYTES;
+    glGenBuffers(1, &buffer);
+    if (buffer == 0) return false;
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+
+#if defined(GL_MAP_PERSISTENT_BIT)
+    // Immutable storage mapped once for the streamer's lifetime (GL 4.4 / ARB_buffer_storage)
+    if (glBufferStorage != nullptr) {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, size, nullptr, flags);
+        mapped = (unsigned char*)glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags);
+    }
+#endif
+    if (!mapped) glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_STREAM_DRAW);
+
+    // Feed the default shader: position and color from the buffer, texcoord held constant
+    int* locs = rlGetShaderLocsDefault();
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+    glEnableVertexAttribArray(locs[SHADER_LOC_VERTEX_POSITION]);
+    glVertexAttribPointer(locs[SHADER_LOC_VERTEX_POSITION], 3, GL_FLOAT, GL_FALSE, sizeof(StreamVertex), (void*)0);
+    glEnableVertexAttribArray(locs[SHADER_LOC_VERTEX_COLOR]);
+    glVertexAttribPointer(locs[SHADER_LOC_VERTEX_COLOR], 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(StreamVertex),
+        (void*)offsetof(StreamVertex, r));
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    ready = vao != 0;
+    if (!ready) {
+        Unload();
+        return false;
+    }
+
+    TraceLog(LOG_INFO, TextFormat("Geometry streamer: %d x %d KB regions, %s", STREAM_REGIONS, STREAM_REGION_BYTES / 1024,
+        mapped ? "persistent mapping" : "unsynchronized map per run"));
+    return true;
+}
+
+void GeometryStreamer::BeginFrame() {
+    if (!ready) return;
+    lastStats = stats;
+    stats = { 0, 0, 0, 0, 0, 0 };
+
+    region = (region + 1) % STREAM_REGIONS;
+    regionUsed = 0;
+    pending.clear();
+
+    // The GPU normally finished with this region two frames ago; waiting here means it is behind
+    GLsync fence = (GLsync)fences[region];
+    if (fence) {
+        if (glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED) {
+            PROFILE_SCOPE("StreamFenceWait");
+            stats.stalls++;
+            glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+        }
+        glDeleteSync(fence);
+        fences[region] = nullptr;
+    }
+}
+
+bool GeometryStreamer::Reserve(int mode, int count) {
+    if (!ready) return false;
+    if (mode != pendingMode) {
+        Draw();
+        pendingMode = mode;
+    }
+
+    int vertexBytes = (int)sizeof(StreamVertex);
+    if (regionUsed + ((int)pending.size() + count) * vertexBytes > STREAM_REGION_BYTES) {
+        Draw();
+        if (regionUsed + count * vertexBytes > STREAM_REGION_BYTES) {
+            stats.overflows++;
+            return false;
+        }
+    }
+    return true;
+}
+
+void GeometryStreamer::AddTemplate(const std::vector<Vector3>& shape, Vector3 origin, Vector3 scale, Color color) {
+    size_t first = pending.size();
+    pending.resize(first + shape.size());
+    StreamVertex* out = &pending[first];
+    for (size_t i = 0; i < shape.size(); i++) {
+        out[i].x = origin.x + shape[i].x * scale.x;
+        out[i].y = origin.y + shape[i].y * scale.y;
+        out[i].z = origin.z + shape[i].z * scale.z;
+        out[i].r = color.r;
+        out[i].g = color.g;
+        out[i].b = color.b;
+        out[i].a = color.a;
+    }
+    stats.shapes++;
+}
+
+bool GeometryStreamer::AddCube(Vector3 position, Vector3 size, Color color) {
+    if (!Reserve(GL_TRIANGLES, STREAM_CUBE_VERTICES)) return false;
+    AddTemplate(cubeTemplate, position, size, color);
+    return true;
+}
+
+bool GeometryStreamer::AddSphere(Vector3 center, float radius, Color color) {
+    if (!Reserve(GL_TRIANGLES, STREAM_SPHERE_VERTICES)) return false;
+    AddTemplate(sphereTemplate, center, Vector3{ radius, radius, radius }, color);
+    return true;
+}
+
+bool GeometryStreamer::AddLine(Vector3 start, Vector3 end, Color color) {
+    if (!Reserve(GL_LINES, 2)) return false;
+    StreamVertex a = { start.x, start.y, start.z, color.r, color.g, color.b, color.a };
+    StreamVertex b = { end.x, end.y, end.z, color.r, color.g, color.b, color.a };
+    pending.push_back(a);
+    pending.push_back(b);
+    stats.shapes++;
+    return true;
+}
+
+void GeometryStreamer::Draw() {
+    if (!ready || pending.empty()) return;
+
+    int count = (int)pending.size();
+    int bytes = count * (int)sizeof(StreamVertex);
+    int offset = region * STREAM_REGION_BYTES + regionUsed;
+
+    // Whatever rlgl has batched so far was submitted before these shapes
+    rlDrawRenderBatchActive();
+
+    if (mapped) {
+        memcpy(mapped + offset, pending.data(), bytes);
+    }
+    else {
+        // The region's fence guarantees the GPU is done with it, so no implicit sync is needed
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        void* dst = glMapBufferRange(GL_ARRAY_BUFFER, offset, bytes,
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        if (dst) {
+            memcpy(dst, pending.data(), bytes);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        if (!dst) {
+            pending.clear();
+            return;
+        }
+    }
+
+    // Same state the rlgl batch would use: default shader and texture, current matrices
+    int* locs = rlGetShaderLocsDefault();
+    Matrix mvp = MatrixMultiply(rlGetMatrixTransform(), MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection()));
+    float white[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    int textureUnit = 0;
+    rlEnableShader(rlGetShaderIdDefault());
+    rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_MVP], mvp);
+    rlSetUniform(locs[SHADER_LOC_COLOR_DIFFUSE], white, SHADER_UNIFORM_VEC4, 1);
+    rlSetUniform(locs[SHADER_LOC_MAP_ALBEDO], &textureUnit, SHADER_UNIFORM_INT, 1);
+    rlActiveTextureSlot(0);
+    rlEnableTexture(rlGetTextureIdDefault());
+
+    glBindVertexArray(vao);
+    glVertexAttrib2f(locs[SHADER_LOC_VERTEX_TEXCOORD01], 0.0f, 0.0f);
+    glDrawArrays(pendingMode, offset / (int)sizeof(StreamVertex), count);
+    glBindVertexArray(0);
+
+    rlDisableTexture();
+    rlDisableShader();
+
+    regionUsed += bytes;
+    stats.bytes += bytes;
+    stats.vertices += count;
+    stats.draws++;
+    pending.clear();
+}
+
+void GeometryStreamer::EndFrame() {
+    if (!ready) return;
+    Draw();
+    if (regionUsed > 0 && !fences[region]) {
+        fences[region] = (void*)glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+}
+
+void GeometryStreamer::AppendReport(std::vector<std::string>& lines) const {
+    if (!ready) {
+        lines.push_back("Geometry streaming not available (shapes use the rlgl batch).");
+        return;
+    }
+    lines.push_back(TextFormat("Streamed last frame: %d shapes, %d vertices, %.1f KB in %d draws (%s)",
+        lastStats.shapes, lastStats.vertices, lastStats.bytes / 1024.0f, lastStats.draws,
+        mapped ? "persistent" : "mapped per run"));
+    lines.push_back(TextFormat("Region overflows: %d, fence stalls: %d", lastStats.overflows, lastStats.stalls));
+}
+
+void GeometryStreamer::Unload() {
+    for (int i = 0; i < STREAM_REGIONS; i++) {
+        if (fences[i]) glDeleteSync((GLsync)fences[i]);
+        fences[i] = nullptr;
+    }
+    if (mapped) {
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        mapped = nullptr;
+    }
+    if (vao) glDeleteVertexArrays(1, &vao);
+    if (buffer) glDeleteBuffers(1, &buffer);
+    vao = 0;
+    buffer = 0;
+    pending.clear();
+    ready = false;
+}
+
+// =============================================================================
+// GLOBAL INITIALIZATION
+// =============================================================================
+
+void InitializeGeometryStreamer() {
+    if (!g_GeometryStreamer) {
+        g_GeometryStreamer = new GeometryStreamer();
+        g_GeometryStreamer->Initialize();
+    }
+}
+
+void CleanupGeometryStreamer() {
+    if (g_GeometryStreamer) {
+        delete g_GeometryStreamer;
+        g_GeometryStreamer = nullptr;
+    }
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include "globals.h"
+#include <vector>
+#include <string>
+
+// Ring of per-frame regions; a region is rewritten only after the GPU has
+// passed the fence placed when it was last drawn from
+#define STREAM_REGIONS 3
+#define STREAM_REGION_BYTES (1024 * 1024)
+
+// Unit shape templates
+#define STREAM_SPHERE_RINGS 16
+#define STREAM_SPHERE_SLICES 16
+#define STREAM_SPHERE_VERTICES (STREAM_SPHERE_RINGS * STREAM_SPHERE_SLICES * 6)
+#define STREAM_CUBE_VERTICES 36
+
+// Per-frame streaming counters
+struct StreamStats {
+    int bytes;          // Vertex data written
+    int vertices;
+    int shapes;         // Cubes, spheres and lines
+    int draws;          // glDrawArrays calls
+    int overflows;      // Shapes that did not fit the region (drawn through rlgl instead)
+    int stalls;         // Frames that had to wait on a region's fence
+};
+
+// Geometry streamer class
+// Draws transient untextured shapes (doors, waypoint beams and spheres, hand
+// glow, debug cubes) from one dynamic vertex buffer instead of rlgl's
+// immediate batch. Shapes are written as pre-transformed, vertex-coloured
+// triangles or lines from precomputed unit templates, and each run of them is
+// one glDrawArrays with the default shader, so DrawSphere's per-call
+// tessellation and the batch flushes it forces are gone.
+// The buffer is split into STREAM_REGIONS regions used round-robin, one per
+// frame, each guarded by a fence. With GL 4.4 buffer storage the whole buffer
+// is mapped once (persistent, coherent); otherwise every run is written with
+// an unsynchronized glMapBufferRange, which the fences make safe.
+class GeometryStreamer {
+public:
+    GeometryStreamer();
+    ~GeometryStreamer();
+
+    // Create the buffer, vertex array and shape templates. Returns false if unsupported.
+    bool Initialize();
+
+    bool IsReady() const { return ready; }
+
+    // Move to the next region, waiting for the GPU to release it if needed
+    void BeginFrame();
+
+    // Append a shape (world space). False if the region is full; draw it another way.
+    bool AddCube(Vector3 position, Vector3 size, Color color);
+    bool AddSphere(Vector3 center, float radius, Color color);
+    bool AddLine(Vector3 start, Vector3 end, Color color);
+
+    // Draw everything appended since the last Draw (flushes rlgl's batch first to keep order)
+    void Draw();
+
+    // Draw what is left and fence the region
+    void EndFrame();
+
+    bool IsPersistent() const { return mapped != nullptr; }
+    const StreamStats& GetStats() const { return lastStats; }
+
+    // Console report (last full frame)
+    void AppendReport(std::vector<std::string>& lines) const;
+
+    void Unload();
+
+private:
+    // Position + RGBA8, 16 bytes
+    struct StreamVertex {
+        float x, y, z;
+        unsigned char r, g, b, a;
+    };
+
+    bool ready;
+    unsigned int buffer;
+    unsigned int vao;
+    unsigned char* mapped;              // Persistent mapping, or null
+    void* fences[STREAM_REGIONS];       // GLsync per region
+    int region;
+    int regionUsed;                     // Bytes drawn from the current region
+
+    std::vector<StreamVertex> pending;  // Vertices of the current run
+    int pendingMode;                    // GL_TRIANGLES or GL_LINES
+
+    std::vector<Vector3> cubeTemplate;
+    std::vector<Vector3> sphereTemplate;
+
+    StreamStats stats;
+    StreamStats lastStats;
+
+    // Make room for a run of vertices in this mode; false if the region cannot hold them
+    bool Reserve(int mode, int count);
+    void AddTemplate(const std::vector<Vector3>& shape, Vector3 origin, Vector3 scale, Color color);
+};
+
+// Global geometry streamer instance
+extern GeometryStreamer* g_GeometryStreamer;
+
+// Initialize geometry streamer
+void InitializeGeometryStreamer();
+
+// Cleanup geometry streamer
+void CleanupGeometryStreamer();
@@ -137,6 +137,7 @@ struct GraphicsSettings {
     int maxDrawCalls;
     UpscalingMode upscalingMode;
     UpscalingQuality upscalingQuality;
+    int shadowPcfKernel;    // Shadow filter width in texels, 0 = shadows off
 };
 
 const Resolution AVAILABLE_RESOLUTIONS[] = {
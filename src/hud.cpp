@@ -1,40 +1,58 @@
 #include "hud.h"
 #include "items.h"
+#include "profiler.h"
+#include "ui_cache.h"
+#include <cmath>
+#include <algorithm>
 
-void DrawHUD(int screenW, int screenH, float health, float stamina, float hunger, float thirst, float fov, float flashlightBattery, bool isFlashlightOn, InventorySlot* inventory) {
-    int barWidth = 200;
-    int barHeight = 20;
-    int barX = 10;
-    int barYStart = screenH - 100;
-
-    // Health Bar
-    DrawRectangle(barX, barYStart, barWidth, barHeight, PIPBOY_DARK);
-    DrawRectangle(barX, barYStart, (int)(barWidth * (health / 100.0f)), barHeight, PIPBOY_GREEN);
-    DrawText(TextFormat("HP: %.0f", health), barX + 5, barYStart + 3, 15, BLACK);
+// Bars print "%.0f", so their text can only change when the value crosses a multiple of 0.5
+static int BarTextStep(float value) {
+    return (int)floorf(value * 2.0f);
+}
 
-    // Stamina Bar
-    DrawRectangle(barX, barYStart + barHeight + 5, barWidth, barHeight, PIPBOY_DARK);
-    DrawRectangle(barX, barYStart + barHeight + 5, (int)(barWidth * (stamina / 100.0f)), barHeight, PIPBOY_GREEN);
-    DrawText(TextFormat("STA: %.0f", stamina), barX + 5, barYStart + barHeight + 8, 15, BLACK);
+static void DrawStatBar(int x, int y, int width, int height, float value, const char* label) {
+    DrawRectangle(x, y, width, height, PIPBOY_DARK);
+    DrawRectangle(x, y, (int)(width * (value / 100.0f)), height, PIPBOY_GREEN);
+    DrawText(TextFormat("%s: %.0f", label, value), x + 5, y + 3, 15, BLACK);
+}
 
-    // Hunger Bar
-    DrawRectangle(barX, barYStart + (barHeight + 5) * 2, barWidth, barHeight, PIPBOY_DARK);
-    DrawRectangle(barX, barYStart + (barHeight + 5) * 2, (int)(barWidth * (hunger / 100.0f)), barHeight, PIPBOY_GREEN);
-    DrawText(TextFormat("HNG: %.0f", hunger), barX + 5, barYStart + (barHeight + 5) * 2 + 3, 15, BLACK);
+void DrawHUD(int screenW, int screenH, float health, float stamina, float hunger, float thirst, float fov, float flashlightBattery, bool isFlashlightOn, InventorySlot* inventory) {
+    PROFILE_SCOPE("DrawHUD");
+    // Each block is a retained panel, repainted only when what it shows changes
+    const int barWidth = 200;
+    const int barHeight = 20;
+    const int barX = 10;
+    const int barYStart = screenH - 100;
 
-    // Thirst Bar
-    DrawRectangle(barX, barYStart + (barHeight + 5) * 3, barWidth, barHeight, PIPBOY_DARK);
-    DrawRectangle(barX, barYStart + (barHeight + 5) * 3, (int)(barWidth * (thirst / 100.0f)), barHeight, PIPBOY_GREEN);
-    DrawText(TextFormat("THR: %.0f", thirst), barX + 5, barYStart + (barHeight + 5) * 3 + 3, 15, BLACK);
+    // Health, Stamina, Hunger and Thirst bars
+    const float barValues[4] = { health, stamina, hunger, thirst };
+    UiKey barsKey;
+    for (int i = 0; i < 4; i++) {
+        barsKey.Add(BarTextStep(barValues[i])).Add((int)(barWidth * (barValues[i] / 100.0f)));
+    }
+    DrawRetainedPanel(UI_PANEL_HUD_BARS, barX, barYStart, barWidth, (barHeight + 5) * 3 + barHeight, barsKey,
+        [&](int x, int y) {
+            DrawStatBar(x, y, barWidth, barHeight, health, "HP");
+            DrawStatBar(x, y + barHeight + 5, barWidth, barHeight, stamina, "STA");
+            DrawStatBar(x, y + (barHeight + 5) * 2, barWidth, barHeight, hunger, "HNG");
+            DrawStatBar(x, y + (barHeight + 5) * 3, barWidth, barHeight, thirst, "THR");
+        });
 
     // Flashlight Status
     if (isFlashlightOn) {
         int batteryX = screenW - 100;
         int batteryY = screenH - 30;
-        DrawText("FLASHLIGHT ON", batteryX - 100, batteryY - 20, 15, PIPBOY_GREEN);
-        DrawRectangle(batteryX, batteryY, 80, 20, PIPBOY_DARK);
-        DrawRectangle(batteryX, batteryY, (int)(80 * (flashlightBattery / 100.0f)), 20, PIPBOY_GREEN);
-        DrawText(TextFormat("BATT: %.0f%%", flashlightBattery), batteryX + 5, batteryY + 3, 15, BLACK);
+        UiKey batteryKey;
+        batteryKey.Add(BarTextStep(flashlightBattery)).Add((int)(80 * (flashlightBattery / 100.0f)));
+        // Wide enough for the label and for the longest battery text on the bar
+        int batteryW = std::max(std::max(180, MeasureText("FLASHLIGHT ON", 15)), 105 + MeasureText("BATT: 100%", 15));
+        DrawRetainedPanel(UI_PANEL_HUD_BATTERY, batteryX - 100, batteryY - 20, batteryW, 40, batteryKey,
+            [&](int x, int y) {
+                DrawText("FLASHLIGHT ON", x, y, 15, PIPBOY_GREEN);
+                DrawRectangle(x + 100, y + 20, 80, 20, PIPBOY_DARK);
+                DrawRectangle(x + 100, y + 20, (int)(80 * (flashlightBattery / 100.0f)), 20, PIPBOY_GREEN);
+                DrawText(TextFormat("BATT: %.0f%%", flashlightBattery), x + 105, y + 23, 15, BLACK);
+            });
     }
 
     // Equipped Item Info (Hand Slot 0) - Bottom Center
@@ -42,51 +60,71 @@ void DrawHUD(int screenW, int screenH, float health, float stamina, float hunger
     int itemY = screenH - 50;
     const InventorySlot& equipped = inventory[BACKPACK_SLOTS];
 
-    if (equipped.itemId != ITEM_NONE) {
-        // Draw equipped item box
-        DrawRectangle(itemX, itemY, 300, 40, Color{ 0, 0, 0, 180 });
-        DrawRectangleLines(itemX, itemY, 300, 40, PIPBOY_GREEN);
+    // Count magazines in inventory (reserve ammo for the pistol)
+    int magCount = 0;
+    if (equipped.itemId == ITEM_PISTOL) {
+        for (int i = 0; i < BACKPACK_SLOTS; i++) {
+            if (inventory[i].itemId == ITEM_MAG) {
+                magCount += inventory[i].quantity;
+            }
+        }
+    }
 
-        // Item name
-        DrawText(GetItemName(equipped.itemId), itemX + 10, itemY + 5, 18, PIPBOY_GREEN);
+    UiKey itemKey;
+    itemKey.Add(equipped.itemId).Add(equipped.quantity).Add(equipped.ammo).Add(magCount);
 
-        // Quantity (if more than 1)
-        if (equipped.quantity > 1) {
-            DrawText(TextFormat("x%d", equipped.quantity), itemX + 180, itemY + 5, 18, PIPBOY_GREEN);
+    // The box is 300 wide, but long item names or hints may run past it
+    int itemW = 300;
+    if (equipped.itemId != ITEM_NONE) {
+        itemW = std::max(itemW, 10 + MeasureText(GetItemName(equipped.itemId), 18));
+        if (equipped.quantity > 1) itemW = std::max(itemW, 180 + MeasureText(TextFormat("x%d", equipped.quantity), 18));
+        if (equipped.itemId == ITEM_PISTOL) {
+            itemW = std::max(itemW, 40 + MeasureText(TextFormat("/ %d mags", magCount), 14));
+            itemW = std::max(itemW, 150 + MeasureText("Press R to reload", 14));
+        }
+        if (equipped.itemId == ITEM_WATER_BOTTLE || equipped.itemId == ITEM_POTATO_CHIPS) {
+            itemW = std::max(itemW, 150 + MeasureText("Right-click to use", 12));
         }
+    }
+    DrawRetainedPanel(UI_PANEL_HUD_ITEM, itemX, itemY, itemW, 40, itemKey, [&](int x, int y) {
+        if (equipped.itemId != ITEM_NONE) {
+            // Draw equipped item box
+            DrawRectangle(x, y, 300, 40, Color{ 0, 0, 0, 180 });
+            DrawRectangleLines(x, y, 300, 40, PIPBOY_GREEN);
 
-        // Ammo display for weapons (large and prominent)
-        if (equipped.itemId == ITEM_PISTOL) {
-            // Current ammo in magazine
-            DrawText(TextFormat("%d", equipped.ammo), itemX + 10, itemY + 25, 16,
-                equipped.ammo > 0 ? PIPBOY_GREEN : Color{ 255, 50, 50, 255 });
+            // Item name
+            DrawText(GetItemName(equipped.itemId), x + 10, y + 5, 18, PIPBOY_GREEN);
 
-            // Count magazines in inventory
-            int magCount = 0;
-            for (int i = 0; i < BACKPACK_SLOTS; i++) {
-                if (inventory[i].itemId == ITEM_MAG) {
-                    magCount += inventory[i].quantity;
-                }
+            // Quantity (if more than 1)
+            if (equipped.quantity > 1) {
+                DrawText(TextFormat("x%d", equipped.quantity), x + 180, y + 5, 18, PIPBOY_GREEN);
             }
 
-            // Reserve ammo (magazines)
-            DrawText(TextFormat("/ %d mags", magCount), itemX + 40, itemY + 25, 14, PIPBOY_DIM);
+            // Ammo display for weapons (large and prominent)
+            if (equipped.itemId == ITEM_PISTOL) {
+                // Current ammo in magazine
+                DrawText(TextFormat("%d", equipped.ammo), x + 10, y + 25, 16,
+                    equipped.ammo > 0 ? PIPBOY_GREEN : Color{ 255, 50, 50, 255 });
 
-            // Reload hint if empty
-            if (equipped.ammo == 0 && magCount > 0) {
-                DrawText("Press R to reload", itemX + 150, itemY + 25, 14, Color{ 255, 200, 50, 255 });
+                // Reserve ammo (magazines)
+                DrawText(TextFormat("/ %d mags", magCount), x + 40, y + 25, 14, PIPBOY_DIM);
+
+                // Reload hint if empty
+                if (equipped.ammo == 0 && magCount > 0) {
+                    DrawText("Press R to reload", x + 150, y + 25, 14, Color{ 255, 200, 50, 255 });
+                }
             }
-        }
 
-        // Instructions for consumables
-        if (equipped.itemId == ITEM_WATER_BOTTLE || equipped.itemId == ITEM_POTATO_CHIPS) {
-            DrawText("Right-click to use", itemX + 150, itemY + 25, 12, PIPBOY_DIM);
+            // Instructions for consumables
+            if (equipped.itemId == ITEM_WATER_BOTTLE || equipped.itemId == ITEM_POTATO_CHIPS) {
+                DrawText("Right-click to use", x + 150, y + 25, 12, PIPBOY_DIM);
+            }
         }
-    }
-    else {
-        // No item equipped
-        DrawRectangle(itemX, itemY, 300, 40, Color{ 0, 0, 0, 100 });
-        DrawRectangleLines(itemX, itemY, 300, 40, PIPBOY_DIM);
-        DrawText("No item equipped", itemX + 80, itemY + 12, 16, PIPBOY_DIM);
-    }
-}
\ No newline at end of file
+        else {
+            // No item equipped
+            DrawRectangle(x, y, 300, 40, Color{ 0, 0, 0, 100 });
+            DrawRectangleLines(x, y, 300, 40, PIPBOY_DIM);
+            DrawText("No item equipped", x + 80, y + 12, 16, PIPBOY_DIM);
+        }
+    });
+}
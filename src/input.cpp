@@ -0,0 +1,384 @@
+#include "input.h"
+#include "render_stats.h"
+#include <cstdlib>
+#include <ctime>
+
+// Global instance
+InputSystem* g_Input = nullptr;
+
+// Which parts of a frame differ from the previous one
+enum InputFrameFlags {
+    FRAME_KEYS = 1 << 0,
+    FRAME_MOUSE_BUTTONS = 1 << 1,
+    FRAME_MOUSE_POSITION = 1 << 2,
+    FRAME_MOUSE_DELTA = 1 << 3,
+    FRAME_MOUSE_WHEEL = 1 << 4,
+    FRAME_GAMEPAD = 1 << 5
+};
+
+static bool TestBit(const unsigned char* bits, int index) {
+    return (bits[index >> 3] >> (index & 7)) & 1;
+}
+
+template <typename T>
+static void Put(std::vector<unsigned char>& out, const T& value) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+static bool Get(const std::vector<unsigned char>& in, size_t& offset, T* value) {
+    if (offset + sizeof(T) > in.size()) return false;
+    memcpy(value, in.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+static bool GamepadEqual(const InputFrame& a, const InputFrame& b) {
+    return a.gamepadAvailable == b.gamepadAvailable && a.gamepadButtons == b.gamepadButtons &&
+        memcmp(a.gamepadAxes, b.gamepadAxes, sizeof(a.gamepadAxes)) == 0;
+}
+
+bool ParseInputArgs(int argc, char** argv, InputOptions* options) {
+    options->mode = INPUT_LIVE;
+    options->path.clear();
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if (strncmp(arg, "--record=", 9) == 0) {
+            options->mode = INPUT_RECORD;
+            options->path = arg + 9;
+        }
+        else if (strncmp(arg, "--replay=", 9) == 0) {
+            options->mode = INPUT_REPLAY;
+            options->path = arg + 9;
+        }
+    }
+    return options->mode != INPUT_LIVE;
+}
+
+InputSystem::InputSystem(const InputOptions& options) {
+    mode = options.mode;
+    path = options.path;
+    seed = 0;
+    current = {};
+    previous = {};
+    readOffset = 0;
+    frameCount = 0;
+    replayFrame = 0;
+    replayDone = false;
+    finished = false;
+    frameStart = 0.0;
+}
+
+InputSystem::~InputSystem() {
+    Finish();
+}
+
+bool InputSystem::Initialize() {
+    if (mode == INPUT_RECORD) {
+        seed = (unsigned int)time(nullptr);
+        data.clear();
+        TraceLog(LOG_INFO, TextFormat("Input: recording to %s (seed %u)", path.c_str(), seed));
+        return true;
+    }
+    if (mode != INPUT_REPLAY) return true;
+
+    std::ifstream infile(path, std::ios::binary);
+    if (!infile.is_open()) {
+        TraceLog(LOG_ERROR, TextFormat("Input: replay file %s not found.", path.c_str()));
+        mode = INPUT_LIVE;
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(infile), std::istreambuf_iterator<char>());
+
+    unsigned int magic = 0, version = 0;
+    float timestep = 0.0f;
+    readOffset = 0;
+    if (!Get(data, readOffset, &magic) || !Get(data, readOffset, &version) ||
+        !Get(data, readOffset, &seed) || !Get(data, readOffset, &timestep) ||
+        !Get(data, readOffset, &frameCount) ||
+        magic != INPUT_FILE_MAGIC || version != INPUT_FILE_VERSION) {
+        TraceLog(LOG_ERROR, TextFormat("Input: %s is not a version %d input recording.", path.c_str(), INPUT_FILE_VERSION));
+        mode = INPUT_LIVE;
+        data.clear();
+        return false;
+    }
+
+    TraceLog(LOG_INFO, TextFormat("Input: replaying %s (%d frames, seed %u)", path.c_str(), frameCount, seed));
+    return true;
+}
+
+void InputSystem::Capture(InputFrame& frame) const {
+    frame = {};
+    for (int key = 0; key < INPUT_KEY_COUNT; key++) {
+        if (IsKeyDown(key)) frame.keys[key >> 3] |= (unsigned char)(1 << (key & 7));
+    }
+    for (int button = 0; button < INPUT_MOUSE_BUTTONS; button++) {
+        if (IsMouseButtonDown(button)) frame.mouseButtons |= (unsigned char)(1 << button);
+    }
+    Vector2 position = GetMousePosition();
+    frame.mouseX = (short)Clamp(position.x, -32768.0f, 32767.0f);
+    frame.mouseY = (short)Clamp(position.y, -32768.0f, 32767.0f);
+    Vector2 delta = GetMouseDelta();
+    frame.mouseDeltaX = delta.x;
+    frame.mouseDeltaY = delta.y;
+    frame.mouseWheel = GetMouseWheelMove();
+
+    frame.gamepadAvailable = IsGamepadAvailable(0);
+    if (frame.gamepadAvailable) {
+        for (int button = 0; button < INPUT_GAMEPAD_BUTTONS; button++) {
+            if (IsGamepadButtonDown(0, button)) frame.gamepadButtons |= 1u << button;
+        }
+        for (int axis = 0; axis < INPUT_GAMEPAD_AXES; axis++) {
+            frame.gamepadAxes[axis] = (short)(Clamp(GetGamepadAxisMovement(0, axis), -1.0f, 1.0f) * 32767.0f);
+        }
+    }
+    frame.frameTime = GetFrameTime();
+}
+
+void InputSystem::Encode(const InputFrame& frame, const InputFrame& last) {
+    unsigned char flags = 0;
+    if (memcmp(frame.keys, last.keys, sizeof(frame.keys)) != 0) flags |= FRAME_KEYS;
+    if (frame.mouseButtons != last.mouseButtons) flags |= FRAME_MOUSE_BUTTONS;
+    if (frame.mouseX != last.mouseX || frame.mouseY != last.mouseY) flags |= FRAME_MOUSE_POSITION;
+    if (frame.mouseDeltaX != 0.0f || frame.mouseDeltaY != 0.0f) flags |= FRAME_MOUSE_DELTA;
+    if (frame.mouseWheel != 0.0f) flags |= FRAME_MOUSE_WHEEL;
+    if (!GamepadEqual(frame, last)) flags |= FRAME_GAMEPAD;
+
+    Put(data, flags);
+    if (flags & FRAME_KEYS) data.insert(data.end(), frame.keys, frame.keys + sizeof(frame.keys));
+    if (flags & FRAME_MOUSE_BUTTONS) Put(data, frame.mouseButtons);
+    if (flags & FRAME_MOUSE_POSITION) { Put(data, frame.mouseX); Put(data, frame.mouseY); }
+    if (flags & FRAME_MOUSE_DELTA) { Put(data, frame.mouseDeltaX); Put(data, frame.mouseDeltaY); }
+    if (flags & FRAME_MOUSE_WHEEL) Put(data, frame.mouseWheel);
+    if (flags & FRAME_GAMEPAD) {
+        unsigned char available = frame.gamepadAvailable ? 1 : 0;
+        Put(data, available);
+        Put(data, frame.gamepadButtons);
+        for (int axis = 0; axis < INPUT_GAMEPAD_AXES; axis++) Put(data, frame.gamepadAxes[axis]);
+    }
+    Put(data, frame.frameTime);
+}
+
+bool InputSystem::Decode(InputFrame& frame, const InputFrame& last) {
+    unsigned char flags = 0;
+    if (!Get(data, readOffset, &flags)) return false;
+
+    // Unchanged parts carry over; deltas and the wheel reset to zero
+    frame = last;
+    frame.mouseDeltaX = frame.mouseDeltaY = 0.0f;
+    frame.mouseWheel = 0.0f;
+
+    bool ok = true;
+    if (flags & FRAME_KEYS) {
+        ok = readOffset + sizeof(frame.keys) <= data.size();
+        if (ok) {
+            memcpy(frame.keys, data.data() + readOffset, sizeof(frame.keys));
+            readOffset += sizeof(frame.keys);
+        }
+    }
+    if (ok && (flags & FRAME_MOUSE_BUTTONS)) ok = Get(data, readOffset, &frame.mouseButtons);
+    if (ok && (flags & FRAME_MOUSE_POSITION)) ok = Get(data, readOffset, &frame.mouseX) && Get(data, readOffset, &frame.mouseY);
+    if (ok && (flags & FRAME_MOUSE_DELTA)) ok = Get(data, readOffset, &frame.mouseDeltaX) && Get(data, readOffset, &frame.mouseDeltaY);
+    if (ok && (flags & FRAME_MOUSE_WHEEL)) ok = Get(data, readOffset, &frame.mouseWheel);
+    if (ok && (flags & FRAME_GAMEPAD)) {
+        unsigned char available = 0;
+        ok = Get(data, readOffset, &available) && Get(data, readOffset, &frame.gamepadButtons);
+        frame.gamepadAvailable = available != 0;
+        for (int axis = 0; ok && axis < INPUT_GAMEPAD_AXES; axis++) ok = Get(data, readOffset, &frame.gamepadAxes[axis]);
+    }
+    return ok && Get(data, readOffset, &frame.frameTime);
+}
+
+void InputSystem::BeginFrame() {
+    frameStart = GetTime();
+    previous = current;
+
+    if (mode == INPUT_REPLAY) {
+        if (replayDone) return;
+        if (replayFrame >= frameCount || !Decode(current, previous)) {
+            replayDone = true;
+            current = previous;
+            TraceLog(LOG_INFO, TextFormat("Input: replay finished after %d frames", replayFrame));
+            return;
+        }
+        replayFrame++;
+        return;
+    }
+
+    Capture(current);
+    if (mode == INPUT_RECORD) {
+        Encode(current, previous);
+        frameCount++;
+    }
+}
+
+float InputSystem::GetDeltaTime() const {
+    return mode == INPUT_LIVE ? GetFrameTime() : INPUT_FIXED_TIMESTEP;
+}
+
+void InputSystem::EndFrame() {
+    if (mode != INPUT_REPLAY || replayDone) return;
+
+    ReplayTiming timing = {};
+    timing.frameMs = (float)((GetTime() - frameStart) * 1000.0);
+    timing.recordedMs = current.frameTime * 1000.0f;
+    if (g_RenderStats) {
+        const FrameRenderStats& stats = g_RenderStats->GetCurrent();
+        PassStats total = stats.Total();
+        timing.drawCalls = total.drawCalls;
+        timing.triangles = total.triangles;
+        timing.skipped = stats.skipped;
+    }
+    timings.push_back(timing);
+}
+
+bool InputSystem::WriteRecording() const {
+    std::ofstream outfile(path, std::ios::binary);
+    if (!outfile.is_open()) {
+        TraceLog(LOG_ERROR, TextFormat("Input: failed to open %s for writing.", path.c_str()));
+        return false;
+    }
+
+    unsigned int magic = INPUT_FILE_MAGIC, version = INPUT_FILE_VERSION;
+    float timestep = INPUT_FIXED_TIMESTEP;
+    outfile.write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+    outfile.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    outfile.write(reinterpret_cast<const char*>(&seed), sizeof(seed));
+    outfile.write(reinterpret_cast<const char*>(&timestep), sizeof(timestep));
+    outfile.write(reinterpret_cast<const char*>(&frameCount), sizeof(frameCount));
+    outfile.write(reinterpret_cast<const char*>(data.data()), data.size());
+    outfile.close();
+
+    TraceLog(LOG_INFO, TextFormat("Input: wrote %d frames (%d bytes) to %s", frameCount, (int)data.size(), path.c_str()));
+    return true;
+}
+
+bool InputSystem::WriteTimings() const {
+    if (timings.empty()) return true;
+
+    std::string timingPath = path + ".timing.csv";
+    std::ofstream outfile(timingPath);
+    if (!outfile.is_open()) {
+        TraceLog(LOG_ERROR, TextFormat("Input: failed to open %s for writing.", timingPath.c_str()));
+        return false;
+    }
+
+    outfile << "frame,frame_ms,recorded_frame_ms,draw_calls,triangles,skipped\n";
+    double total = 0.0;
+    int worstFrame = 0;
+    for (size_t i = 0; i < timings.size(); i++) {
+        const ReplayTiming& t = timings[i];
+        outfile << i << "," << t.frameMs << "," << t.recordedMs << "," << t.drawCalls << ","
+            << t.triangles << "," << t.skipped << "\n";
+        total += t.frameMs;
+        if (t.frameMs > timings[worstFrame].frameMs) worstFrame = (int)i;
+    }
+    outfile.close();
+
+    TraceLog(LOG_INFO, TextFormat("Input: replay timings in %s (avg %.2f ms, worst %.2f ms at frame %d)",
+        timingPath.c_str(), total / timings.size(), timings[worstFrame].frameMs, worstFrame));
+    return true;
+}
+
+void InputSystem::Finish() {
+    if (finished) return;
+    finished = true;
+    if (mode == INPUT_RECORD) WriteRecording();
+    else if (mode == INPUT_REPLAY) WriteTimings();
+}
+
+// =============================================================================
+// raylib input wrappers
+// =============================================================================
+
+bool InputIsKeyPressed(int key) {
+    if (!g_Input) return IsKeyPressed(key);
+    if (key < 0 || key >= INPUT_KEY_COUNT) return false;
+    return TestBit(g_Input->GetCurrent().keys, key) && !TestBit(g_Input->GetPrevious().keys, key);
+}
+
+bool InputIsKeyDown(int key) {
+    if (!g_Input) return IsKeyDown(key);
+    if (key < 0 || key >= INPUT_KEY_COUNT) return false;
+    return TestBit(g_Input->GetCurrent().keys, key);
+}
+
+bool InputIsKeyReleased(int key) {
+    if (!g_Input) return IsKeyReleased(key);
+    if (key < 0 || key >= INPUT_KEY_COUNT) return false;
+    return !TestBit(g_Input->GetCurrent().keys, key) && TestBit(g_Input->GetPrevious().keys, key);
+}
+
+bool InputIsMouseButtonPressed(int button) {
+    if (!g_Input) return IsMouseButtonPressed(button);
+    if (button < 0 || button >= INPUT_MOUSE_BUTTONS) return false;
+    return ((g_Input->GetCurrent().mouseButtons & ~g_Input->GetPrevious().mouseButtons) >> button) & 1;
+}
+
+bool InputIsMouseButtonDown(int button) {
+    if (!g_Input) return IsMouseButtonDown(button);
+    if (button < 0 || button >= INPUT_MOUSE_BUTTONS) return false;
+    return (g_Input->GetCurrent().mouseButtons >> button) & 1;
+}
+
+bool InputIsMouseButtonReleased(int button) {
+    if (!g_Input) return IsMouseButtonReleased(button);
+    if (button < 0 || button >= INPUT_MOUSE_BUTTONS) return false;
+    return ((~g_Input->GetCurrent().mouseButtons & g_Input->GetPrevious().mouseButtons) >> button) & 1;
+}
+
+Vector2 InputGetMousePosition() {
+    if (!g_Input) return GetMousePosition();
+    return Vector2{ (float)g_Input->GetCurrent().mouseX, (float)g_Input->GetCurrent().mouseY };
+}
+
+Vector2 InputGetMouseDelta() {
+    if (!g_Input) return GetMouseDelta();
+    return Vector2{ g_Input->GetCurrent().mouseDeltaX, g_Input->GetCurrent().mouseDeltaY };
+}
+
+float InputGetMouseWheelMove() {
+    if (!g_Input) return GetMouseWheelMove();
+    return g_Input->GetCurrent().mouseWheel;
+}
+
+bool InputIsGamepadAvailable(int gamepad) {
+    if (!g_Input) return IsGamepadAvailable(gamepad);
+    return gamepad == 0 && g_Input->GetCurrent().gamepadAvailable;
+}
+
+bool InputIsGamepadButtonPressed(int gamepad, int button) {
+    if (!g_Input) return IsGamepadButtonPressed(gamepad, button);
+    if (gamepad != 0 || button < 0 || button >= INPUT_GAMEPAD_BUTTONS) return false;
+    unsigned int pressed = g_Input->GetCurrent().gamepadButtons & ~g_Input->GetPrevious().gamepadButtons;
+    return (pressed >> button) & 1u;
+}
+
+bool InputIsGamepadButtonDown(int gamepad, int button) {
+    if (!g_Input) return IsGamepadButtonDown(gamepad, button);
+    if (gamepad != 0 || button < 0 || button >= INPUT_GAMEPAD_BUTTONS) return false;
+    return (g_Input->GetCurrent().gamepadButtons >> button) & 1u;
+}
+
+float InputGetGamepadAxisMovement(int gamepad, int axis) {
+    if (!g_Input) return GetGamepadAxisMovement(gamepad, axis);
+    if (gamepad != 0 || axis < 0 || axis >= INPUT_GAMEPAD_AXES) return 0.0f;
+    return g_Input->GetCurrent().gamepadAxes[axis] / 32767.0f;
+}
+
+// Global initialization
+void InitializeInputSystem(const InputOptions& options) {
+    g_Input = new InputSystem(options);
+    g_Input->Initialize();
+    TraceLog(LOG_INFO, "Input system initialized");
+}
+
+void CleanupInputSystem() {
+    if (g_Input) {
+        delete g_Input;
+        g_Input = nullptr;
+    }
+    TraceLog(LOG_INFO, "Input system cleaned up");
+}
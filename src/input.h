@@ -0,0 +1,144 @@
+#pragma once
+#include "globals.h"
+#include <vector>
+#include <string>
+
+// Keyboard codes covered by a snapshot (raylib's highest, KEY_KB_MENU, is 348)
+#define INPUT_KEY_COUNT 352
+#define INPUT_MOUSE_BUTTONS 3
+#define INPUT_GAMEPAD_BUTTONS 32
+#define INPUT_GAMEPAD_AXES GAMEPAD_AXIS_COUNT
+
+// Simulation step while recording or replaying, so both see identical deltas
+#define INPUT_FIXED_TIMESTEP (1.0f / 60.0f)
+
+#define INPUT_FILE_MAGIC 0x50524C41u   // "ALRP"
+#define INPUT_FILE_VERSION 1
+
+// Input as seen by the game for one frame
+struct InputFrame {
+    unsigned char keys[INPUT_KEY_COUNT / 8];
+    unsigned char mouseButtons;        // Bit per MouseButton
+    short mouseX;
+    short mouseY;
+    float mouseDeltaX;
+    float mouseDeltaY;
+    float mouseWheel;
+    bool gamepadAvailable;
+    unsigned int gamepadButtons;       // Bit per GamepadButton
+    short gamepadAxes[INPUT_GAMEPAD_AXES];   // Axis * 32767
+    float frameTime;                   // Real frame time when it was captured
+};
+
+enum InputMode {
+    INPUT_LIVE = 0,
+    INPUT_RECORD,
+    INPUT_REPLAY
+};
+
+// Command line options
+struct InputOptions {
+    InputMode mode;
+    std::string path;
+};
+
+// Parse --record=FILE and --replay=FILE. Returns false if neither was given.
+bool ParseInputArgs(int argc, char** argv, InputOptions* options);
+
+// Input system class
+// Gameplay and menu code read input through the Input* wrappers below instead
+// of raylib, and those answer from a snapshot taken once per frame. Live, the
+// snapshot comes from raylib; recording also appends it to a compact binary
+// file (delta-coded against the previous frame) together with the RNG seed;
+// replay reads the snapshots back, so the same frames run on the same map with
+// the same input. Both recording and replay step the simulation by
+// INPUT_FIXED_TIMESTEP. Console text input is not captured.
+class InputSystem {
+public:
+    explicit InputSystem(const InputOptions& options);
+    ~InputSystem();
+
+    // Open the replay file or pick the recording seed. Returns false if a replay
+    // could not be loaded (the system then stays live).
+    bool Initialize();
+
+    // Seed for srand/SetRandomSeed when recording or replaying
+    unsigned int GetSeed() const { return seed; }
+
+    InputMode GetMode() const { return mode; }
+    bool IsRecording() const { return mode == INPUT_RECORD; }
+    bool IsReplaying() const { return mode == INPUT_REPLAY; }
+
+    // Take this frame's snapshot (call once, before any input is read)
+    void BeginFrame();
+
+    // Simulation delta: the fixed step when recording or replaying
+    float GetDeltaTime() const;
+
+    // Replay ran out of frames
+    bool IsReplayFinished() const { return mode == INPUT_REPLAY && replayDone; }
+
+    // Note the render stats of a replayed frame (call after EndDrawing)
+    void EndFrame();
+
+    // Write the recording, or the replay timings next to the replay file
+    void Finish();
+
+    const InputFrame& GetCurrent() const { return current; }
+    const InputFrame& GetPrevious() const { return previous; }
+
+private:
+    // Per-frame timing captured during replay
+    struct ReplayTiming {
+        float frameMs;
+        float recordedMs;
+        int drawCalls;
+        int triangles;
+        int skipped;
+    };
+
+    InputMode mode;
+    std::string path;
+    unsigned int seed;
+    InputFrame current;
+    InputFrame previous;
+
+    std::vector<unsigned char> data;   // Recorded stream, or the loaded file
+    size_t readOffset;
+    int frameCount;
+    int replayFrame;
+    bool replayDone;
+    bool finished;
+    double frameStart;
+    std::vector<ReplayTiming> timings;
+
+    void Capture(InputFrame& frame) const;
+    void Encode(const InputFrame& frame, const InputFrame& last);
+    bool Decode(InputFrame& frame, const InputFrame& last);
+    bool WriteRecording() const;
+    bool WriteTimings() const;
+};
+
+// Global input system instance
+extern InputSystem* g_Input;
+
+// raylib input, answered from the current snapshot (straight raylib without g_Input)
+bool InputIsKeyPressed(int key);
+bool InputIsKeyDown(int key);
+bool InputIsKeyReleased(int key);
+bool InputIsMouseButtonPressed(int button);
+bool InputIsMouseButtonDown(int button);
+bool InputIsMouseButtonReleased(int button);
+Vector2 InputGetMousePosition();
+Vector2 InputGetMouseDelta();
+float InputGetMouseWheelMove();
+bool InputIsGamepadAvailable(int gamepad);
+bool InputIsGamepadButtonPressed(int gamepad, int button);
+bool InputIsGamepadButtonDown(int gamepad, int button);
+float InputGetGamepadAxisMovement(int gamepad, int axis);
+
+// Initialize input system
+void InitializeInputSystem(const InputOptions& options);
+
+// Cleanup input system (writes any pending recording)
+void CleanupInputSystem();
@@ -1,6 +1,7 @@
 #include "inventory.h"
 #include "items.h"
 #include "model_manager.h"
+#include "input.h"
 #include "player.h" // For GetModelIDFromItem - this is the correct header
 
 // Static variables for drag and drop
@@ -134,10 +135,10 @@ void DrawInventory(int screenW, int screenH, InventorySlot* inventory, int* sele
 
     DrawText("Drag & Drop items to move them", invX + padding, invY + 10, 14, PIPBOY_DIM);
 
-    Vector2 mousePos = GetMousePosition();
-    bool mousePressed = IsMouseButtonPressed(MOUSE_LEFT_BUTTON);
-    bool mouseReleased = IsMouseButtonReleased(MOUSE_LEFT_BUTTON);
-    bool mouseDown = IsMouseButtonDown(MOUSE_LEFT_BUTTON);
+    Vector2 mousePos = InputGetMousePosition();
+    bool mousePressed = InputIsMouseButtonPressed(MOUSE_LEFT_BUTTON);
+    bool mouseReleased = InputIsMouseButtonReleased(MOUSE_LEFT_BUTTON);
+    bool mouseDown = InputIsMouseButtonDown(MOUSE_LEFT_BUTTON);
 
     // --- Hand Slots ---
     int handY = invY + padding + 30;
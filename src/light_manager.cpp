@@ -0,0 +1,454 @@
+#include "light_manager.h"
+#include "profiler.h"
+#include "raymath.h"
+#include "rlgl.h"
+#include "external/glad.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// Global instance
+LightManager* g_LightManager = nullptr;
+
+// Worker threads used besides the render thread
+static const int MAX_LIGHT_WORKERS = 3;
+
+// Interior light fixtures (tile coordinates are world coordinates inside)
+static const float WARNING_LIGHT_HEIGHT = CEILING_HEIGHT - 0.4f;
+static const float CONSOLE_LIGHT_HEIGHT = 1.2f;
+
+// Cheap integer hash to 0..1, so flicker and stress lights never touch rand()
+// (recordings and the benchmark depend on its sequence)
+static float Hash01(unsigned int n) {
+    n = (n << 13) ^ n;
+    n = n * (n * n * 15731u + 789221u) + 1376312589u;
+    return (float)(n & 0x7fffffffu) / 2147483647.0f;
+}
+
+// View depth where slice s starts (exponential, so near slices stay thin)
+static float SliceDepth(int slice) {
+    return CLUSTER_NEAR * powf(CLUSTER_FAR / CLUSTER_NEAR, (float)slice / CLUSTER_Z);
+}
+
+static unsigned int CreateDataTexture(GLint internalFormat, int width, int height, GLenum format, GLenum type) {
+    unsigned int id = 0;
+    glGenTextures(1, &id);
+    if (id == 0) return 0;
+    glBindTexture(GL_TEXTURE_2D, id);
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, type, nullptr);
+    // Fetched with texelFetch only; integer textures must not be filtered
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return id;
+}
+
+LightManager::LightManager() {
+    ready = false;
+    clusterTexture = 0;
+    indexTexture = 0;
+    dataTexture = 0;
+    stressCount = 0;
+    stressCenter = Vector3{ 0.0f, 0.0f, 0.0f };
+    projX = 1.0f;
+    projY = 1.0f;
+    stats = { 0, 0, 0, 0, 0, 0 };
+
+    clusterLights.assign((size_t)CLUSTER_COUNT * CLUSTER_MAX_LIGHTS, 0);
+    clusterCounts.assign(CLUSTER_COUNT, 0);
+    clusterGrid.assign(CLUSTER_COUNT * 2, 0);
+    indexList.assign(CLUSTER_INDEX_CAPACITY, 0);
+
+    workGeneration = 0;
+    workPending = 0;
+    workQuit = false;
+    for (int i = 0; i < 8; i++) bandDropped[i] = 0;
+
+    int hardware = (int)std::thread::hardware_concurrency();
+    int workerCount = std::max(0, std::min(MAX_LIGHT_WORKERS, hardware - 1));
+    sliceBands = workerCount + 1;
+
+    for (int band = 1; band < sliceBands; band++) {
+        workers.emplace_back(&LightManager::WorkerLoop, this, band);
+    }
+}
+
+LightManager::~LightManager() {
+    {
+        std::lock_guard<std::mutex> lock(workMutex);
+        workQuit = true;
+    }
+    workStart.notify_all();
+    for (auto& worker : workers) worker.join();
+
+    Unload();
+}
+
+bool LightManager::Initialize() {
+    TraceLog(LOG_INFO, "Initializing Light Manager...");
+
+    while (glGetError() != GL_NO_ERROR) {}
+    clusterTexture = CreateDataTexture(GL_RG32UI, CLUSTER_X * CLUSTER_Y, CLUSTER_Z, GL_RG_INTEGER, GL_UNSIGNED_INT);
+    indexTexture = CreateDataTexture(GL_R32UI, CLUSTER_INDEX_WIDTH, CLUSTER_INDEX_CAPACITY / CLUSTER_INDEX_WIDTH,
+        GL_RED_INTEGER, GL_UNSIGNED_INT);
+    dataTexture = CreateDataTexture(GL_RGBA32F, MAX_POINT_LIGHTS * 2, 1, GL_RGBA, GL_FLOAT);
+
+    if (clusterTexture == 0 || indexTexture == 0 || dataTexture == 0 || glGetError() != GL_NO_ERROR) {
+        TraceLog(LOG_WARNING, "Light cluster textures could not be created, point lights disabled");
+        Unload();
+        return false;
+    }
+
+    // Start with every cluster empty
+    glBindTexture(GL_TEXTURE_2D, clusterTexture);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, CLUSTER_X * CLUSTER_Y, CLUSTER_Z, GL_RG_INTEGER, GL_UNSIGNED_INT, clusterGrid.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    ready = true;
+    TraceLog(LOG_INFO, TextFormat("Light clusters: %dx%dx%d, %d binning threads",
+        CLUSTER_X, CLUSTER_Y, CLUSTER_Z, sliceBands));
+    return true;
+}
+
+float LightManager::GetFlickerScale(const PointLight& light, float time) const {
+    switch (light.flicker) {
+    case LIGHT_PULSE: {
+        // Rotating beacon: a sharp sweep with a dim glow in between
+        float sweep = fmaxf(0.0f, sinf(time * 4.0f + light.phase));
+        return 0.15f + 0.85f * sweep * sweep * sweep * sweep;
+    }
+    case LIGHT_FLICKER: {
+        // Mostly steady with the odd dropout, stepped like a failing tube
+        float noise = Hash01((unsigned int)(time * 12.0f + light.phase * 97.0f));
+        return noise < 0.08f ? 0.2f : 0.85f + 0.15f * noise;
+    }
+    default:
+        return 1.0f;
+    }
+}
+
+void CollectInteriorLights(const Interior& interior, std::vector<PointLight>& out) {
+    for (int y = 0; y < interior.height; y++) {
+        for (int x = 0; x < interior.width; x++) {
+            int tile = interior.tiles[y * interior.width + x];
+            if (tile != IT_WARNING_LIGHT && tile != IT_CONSOLE) continue;
+
+            PointLight light;
+            light.phase = Hash01((unsigned int)(y * interior.width + x)) * 6.2832f;
+            light.lifetime = -1.0f;
+            light.duration = 0.0f;
+            if (tile == IT_WARNING_LIGHT) {
+                light.position = Vector3{ (float)x, WARNING_LIGHT_HEIGHT, (float)y };
+                light.radius = 6.0f;
+                light.color = Vector3{ 1.0f, 0.45f, 0.08f };
+                light.intensity = 1.6f;
+                light.flicker = LIGHT_PULSE;
+            }
+            else {
+                light.position = Vector3{ (float)x, CONSOLE_LIGHT_HEIGHT, (float)y };
+                light.radius = 2.5f;
+                light.color = Vector3{ 0.4f, 0.8f, 1.0f };
+                light.intensity = 0.6f;
+                light.flicker = LIGHT_FLICKER;
+            }
+            out.push_back(light);
+        }
+    }
+}
+
+void LightManager::GatherInteriorLights(const Interior& interior) {
+    // Re-scanned every frame: a few hundred tiles, and it can never go stale
+    CollectInteriorLights(interior, lights);
+}
+
+void LightManager::GatherStressLights(float time) {
+    for (int i = 0; i < stressCount; i++) {
+        // Each light orbits the camera on its own ring, height and speed
+        float ring = 2.0f + Hash01(i * 4 + 0) * 18.0f;
+        float angle = Hash01(i * 4 + 1) * 6.2832f + time * (0.2f + Hash01(i * 4 + 2) * 0.6f);
+        float hue = Hash01(i * 4 + 3) * 360.0f;
+        Color tint = ColorFromHSV(hue, 0.8f, 1.0f);
+
+        PointLight light;
+        light.position = Vector3{
+            stressCenter.x + cosf(angle) * ring,
+            0.3f + Hash01(i * 7 + 5) * 2.5f,
+            stressCenter.z + sinf(angle) * ring
+        };
+        light.radius = 2.0f + Hash01(i * 7 + 6) * 3.0f;
+        light.color = Vector3{ tint.r / 255.0f, tint.g / 255.0f, tint.b / 255.0f };
+        light.intensity = 1.2f;
+        light.flicker = LIGHT_STEADY;
+        light.phase = 0.0f;
+        light.lifetime = -1.0f;
+        light.duration = 0.0f;
+        lights.push_back(light);
+    }
+}
+
+void LightManager::Update(const MapData& mapData, const MapPlayerState& playerState, Vector3 viewPos, float time, float deltaTime) {
+    lights.clear();
+
+    if (playerState.insideInterior) {
+        const Interior* interior = GetInterior(mapData, playerState.currentInteriorId);
+        if (interior) GatherInteriorLights(*interior);
+    }
+    for (PointLight& light : lights) {
+        light.intensity *= GetFlickerScale(light, time);
+    }
+
+    // Transient lights fade out quadratically over their lifetime
+    for (size_t i = 0; i < transients.size();) {
+        PointLight& light = transients[i];
+        light.lifetime -= deltaTime;
+        if (light.lifetime <= 0.0f) {
+            transients[i] = transients.back();
+            transients.pop_back();
+            continue;
+        }
+        float fade = light.lifetime / light.duration;
+        PointLight faded = light;
+        faded.intensity *= fade * fade;
+        lights.push_back(faded);
+        i++;
+    }
+
+    if (stressCount > 0) {
+        stressCenter = viewPos;
+        GatherStressLights(time);
+    }
+}
+
+void LightManager::AddFlash(Vector3 position, Vector3 color, float radius, float intensity, float duration) {
+    if (duration <= 0.0f) return;
+    PointLight light;
+    light.position = position;
+    light.radius = radius;
+    light.color = color;
+    light.intensity = intensity;
+    light.flicker = LIGHT_STEADY;
+    light.phase = 0.0f;
+    light.lifetime = duration;
+    light.duration = duration;
+    transients.push_back(light);
+}
+
+void LightManager::SetStressLights(int count) {
+    stressCount = std::max(0, count);
+}
+
+void LightManager::BinBand(int band) {
+    PROFILE_SCOPE("BinLightSlices");
+    int dropped = 0;
+    int lightCount = (int)viewLights.size();
+
+    for (int slice = band; slice < CLUSTER_Z; slice += sliceBands) {
+        float sliceNear = SliceDepth(slice);
+        float sliceFar = SliceDepth(slice + 1);
+        unsigned int* counts = &clusterCounts[slice * CLUSTER_X * CLUSTER_Y];
+        memset(counts, 0, sizeof(unsigned int) * CLUSTER_X * CLUSTER_Y);
+
+        for (int i = 0; i < lightCount; i++) {
+            const ViewLight& light = viewLights[i];
+            if (light.depth - light.radius > sliceFar || light.depth + light.radius < sliceNear) continue;
+
+            // Screen rectangle of the sphere's bounding box, clipped to this slice's depth range.
+            // x / depth is smallest at the far end for positive x and at the near end for negative x.
+            float lo = std::max(light.depth - light.radius, sliceNear);
+            float hi = std::min(light.depth + light.radius, sliceFar);
+            float minX = light.x - light.radius, maxX = light.x + light.radius;
+            float minY = light.y - light.radius, maxY = light.y + light.radius;
+            float ndcMinX = projX * minX / (minX >= 0.0f ? hi : lo);
+            float ndcMaxX = projX * maxX / (maxX >= 0.0f ? lo : hi);
+            float ndcMinY = projY * minY / (minY >= 0.0f ? hi : lo);
+            float ndcMaxY = projY * maxY / (maxY >= 0.0f ? lo : hi);
+            if (ndcMaxX < -1.0f || ndcMinX > 1.0f || ndcMaxY < -1.0f || ndcMinY > 1.0f) continue;
+
+            int tileX0 = std::max(0, (int)floorf((ndcMinX * 0.5f + 0.5f) * CLUSTER_X));
+            int tileX1 = std::min(CLUSTER_X - 1, (int)floorf((ndcMaxX * 0.5f + 0.5f) * CLUSTER_X));
+            int tileY0 = std::max(0, (int)floorf((ndcMinY * 0.5f + 0.5f) * CLUSTER_Y));
+            int tileY1 = std::min(CLUSTER_Y - 1, (int)floorf((ndcMaxY * 0.5f + 0.5f) * CLUSTER_Y));
+
+            for (int ty = tileY0; ty <= tileY1; ty++) {
+                for (int tx = tileX0; tx <= tileX1; tx++) {
+                    int local = ty * CLUSTER_X + tx;
+                    int cluster = slice * CLUSTER_X * CLUSTER_Y + local;
+                    if (counts[local] < CLUSTER_MAX_LIGHTS) {
+                        clusterLights[(size_t)cluster * CLUSTER_MAX_LIGHTS + counts[local]++] = (unsigned short)i;
+                    }
+                    else {
+                        dropped++;
+                    }
+                }
+            }
+        }
+    }
+    bandDropped[band] = dropped;
+}
+
+void LightManager::WorkerLoop(int band) {
+    char threadName[32];
+    snprintf(threadName, sizeof(threadName), "Lights %d", band);
+    PROFILE_THREAD_NAME(threadName);
+
+    int seenGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(workMutex);
+            workStart.wait(lock, [&] { return workQuit || workGeneration != seenGeneration; });
+            if (workQuit) return;
+            seenGeneration = workGeneration;
+        }
+
+        BinBand(band);
+
+        {
+            std::lock_guard<std::mutex> lock(workMutex);
+            workPending--;
+        }
+        workDone.notify_one();
+    }
+}
+
+void LightManager::BuildClusters() {
+    if (!ready) return;
+    PROFILE_SCOPE("LightClusters");
+
+    stats = { (int)lights.size(), 0, 0, 0, 0, 0 };
+
+    // Lights into view space; x right, y up, depth forward
+    Matrix view = rlGetMatrixModelview();
+    Matrix projection = rlGetMatrixProjection();
+    projX = projection.m0;
+    projY = projection.m5;
+    float sideX = 1.0f / sqrtf(projX * projX + 1.0f);
+    float sideY = 1.0f / sqrtf(projY * projY + 1.0f);
+
+    viewLights.clear();
+    lightData.clear();
+    for (const PointLight& light : lights) {
+        if (light.intensity <= 0.001f) continue;
+        const Vector3& p = light.position;
+        float vx = view.m0 * p.x + view.m4 * p.y + view.m8 * p.z + view.m12;
+        float vy = view.m1 * p.x + view.m5 * p.y + view.m9 * p.z + view.m13;
+        float depth = -(view.m2 * p.x + view.m6 * p.y + view.m10 * p.z + view.m14);
+        float r = light.radius;
+
+        // Sphere against the near/far range and the four side planes
+        if (depth + r < CLUSTER_NEAR || depth - r > CLUSTER_FAR) continue;
+        if ((projX * vx - depth) * sideX > r || (-projX * vx - depth) * sideX > r) continue;
+        if ((projY * vy - depth) * sideY > r || (-projY * vy - depth) * sideY > r) continue;
+
+        if ((int)viewLights.size() >= MAX_POINT_LIGHTS) {
+            stats.dropped++;
+            continue;
+        }
+        viewLights.push_back(ViewLight{ vx, vy, depth, r });
+        lightData.insert(lightData.end(), {
+            p.x, p.y, p.z, r,
+            light.color.x * light.intensity, light.color.y * light.intensity, light.color.z * light.intensity, 0.0f
+        });
+    }
+    stats.visible = (int)viewLights.size();
+
+    // Wake the workers, bin band 0 here, then wait for the rest
+    {
+        std::lock_guard<std::mutex> lock(workMutex);
+        workPending = sliceBands - 1;
+        workGeneration++;
+    }
+    workStart.notify_all();
+
+    BinBand(0);
+
+    {
+        std::unique_lock<std::mutex> lock(workMutex);
+        workDone.wait(lock, [&] { return workPending == 0; });
+    }
+    for (int band = 0; band < sliceBands; band++) stats.dropped += bandDropped[band];
+
+    // Pack the per-cluster lists into one index list
+    unsigned int offset = 0;
+    for (int cluster = 0; cluster < CLUSTER_COUNT; cluster++) {
+        unsigned int count = clusterCounts[cluster];
+        if (offset + count > CLUSTER_INDEX_CAPACITY) {
+            stats.dropped += (int)(offset + count - CLUSTER_INDEX_CAPACITY);
+            count = CLUSTER_INDEX_CAPACITY - offset;
+        }
+        const unsigned short* src = &clusterLights[(size_t)cluster * CLUSTER_MAX_LIGHTS];
+        for (unsigned int k = 0; k < count; k++) indexList[offset + k] = src[k];
+
+        clusterGrid[cluster * 2 + 0] = offset;
+        clusterGrid[cluster * 2 + 1] = count;
+        offset += count;
+        if (count > 0) stats.occupiedClusters++;
+        stats.maxPerCluster = std::max(stats.maxPerCluster, (int)count);
+    }
+    stats.indices = (int)offset;
+
+    // Upload; only the index rows in use
+    glBindTexture(GL_TEXTURE_2D, clusterTexture);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, CLUSTER_X * CLUSTER_Y, CLUSTER_Z, GL_RG_INTEGER, GL_UNSIGNED_INT, clusterGrid.data());
+    if (offset > 0) {
+        int rows = (int)((offset + CLUSTER_INDEX_WIDTH - 1) / CLUSTER_INDEX_WIDTH);
+        glBindTexture(GL_TEXTURE_2D, indexTexture);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, CLUSTER_INDEX_WIDTH, rows, GL_RED_INTEGER, GL_UNSIGNED_INT, indexList.data());
+    }
+    if (stats.visible > 0) {
+        glBindTexture(GL_TEXTURE_2D, dataTexture);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, stats.visible * 2, 1, GL_RGBA, GL_FLOAT, lightData.data());
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void LightManager::BindTextures() const {
+    if (!ready) return;
+    glActiveTexture(GL_TEXTURE0 + LIGHT_CLUSTER_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_2D, clusterTexture);
+    glActiveTexture(GL_TEXTURE0 + LIGHT_INDEX_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_2D, indexTexture);
+    glActiveTexture(GL_TEXTURE0 + LIGHT_DATA_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_2D, dataTexture);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void LightManager::AppendReport(std::vector<std::string>& lines) const {
+    if (!ready) {
+        lines.push_back("Point lights not available.");
+        return;
+    }
+    lines.push_back(TextFormat("Point lights: %d active, %d visible, %d stress",
+        stats.lights, stats.visible, stressCount));
+    lines.push_back(TextFormat("Clusters %dx%dx%d: %d occupied, max %d lights, %d indices, %d dropped",
+        CLUSTER_X, CLUSTER_Y, CLUSTER_Z, stats.occupiedClusters, stats.maxPerCluster, stats.indices, stats.dropped));
+}
+
+void LightManager::Unload() {
+    if (clusterTexture) glDeleteTextures(1, &clusterTexture);
+    if (indexTexture) glDeleteTextures(1, &indexTexture);
+    if (dataTexture) glDeleteTextures(1, &dataTexture);
+    clusterTexture = 0;
+    indexTexture = 0;
+    dataTexture = 0;
+    ready = false;
+}
+
+// =============================================================================
+// GLOBAL INITIALIZATION
+// =============================================================================
+
+void InitializeLightSystem() {
+    if (!g_LightManager) {
+        g_LightManager = new LightManager();
+        g_LightManager->Initialize();
+    }
+}
+
+void CleanupLightSystem() {
+    if (g_LightManager) {
+        delete g_LightManager;
+        g_LightManager = nullptr;
+    }
+}
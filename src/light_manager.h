@@ -0,0 +1,157 @@
+#pragma once
+#include "globals.h"
+#include "map.h"
+#include <vector>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// Froxel grid: screen tiles by exponential depth slices
+#define CLUSTER_X 16
+#define CLUSTER_Y 9
+#define CLUSTER_Z 24
+#define CLUSTER_COUNT (CLUSTER_X * CLUSTER_Y * CLUSTER_Z)
+#define CLUSTER_NEAR 0.1f    // First slice starts here (view depth)
+#define CLUSTER_FAR 80.0f    // Lights past this depth are dropped
+
+#define CLUSTER_MAX_LIGHTS 64            // Per cluster; extra lights are counted as dropped
+#define CLUSTER_INDEX_WIDTH 1024         // Light index texture row length
+#define CLUSTER_INDEX_CAPACITY (CLUSTER_INDEX_WIDTH * 64)
+
+#define MAX_POINT_LIGHTS 512             // Visible lights uploaded per frame
+#define LIGHT_STRESS_DEFAULT 256
+
+// Texture units above SURFACE_ARRAY_TEXTURE_UNIT
+#define LIGHT_CLUSTER_TEXTURE_UNIT 9     // RG32UI: offset, count per cluster
+#define LIGHT_INDEX_TEXTURE_UNIT 10      // R32UI: light indices
+#define LIGHT_DATA_TEXTURE_UNIT 11       // RGBA32F: position + radius, color * intensity
+
+enum LightFlicker {
+    LIGHT_STEADY = 0,
+    LIGHT_PULSE,      // Rotating warning beacon
+    LIGHT_FLICKER     // Failing tube / monitor
+};
+
+struct PointLight {
+    Vector3 position;
+    float radius;
+    Vector3 color;        // Linear 0..1
+    float intensity;
+    LightFlicker flicker;
+    float phase;          // Per-light offset so neighbours don't flicker in sync
+    float lifetime;       // Seconds left for transient lights, < 0 = permanent
+    float duration;       // Initial lifetime, for the fade
+};
+
+// Per-frame light counters
+struct LightStats {
+    int lights;           // Active before culling
+    int visible;          // Touching at least one cluster
+    int indices;          // Entries in the index list
+    int maxPerCluster;
+    int occupiedClusters;
+    int dropped;          // Cluster or index overflow
+};
+
+// Light manager class
+// Collects the point lights around the camera each frame (warning beacons and
+// monitors of the current interior, muzzle flashes, stress lights), bins them
+// into a CLUSTER_X x CLUSTER_Y x CLUSTER_Z froxel grid on the CPU and uploads
+// the per-cluster index lists as textures. The surface shaders look up their
+// fragment's cluster and only loop over the lights listed there, so shading
+// cost follows lights per cluster rather than lights in the scene.
+// Binning runs over depth slices, spread across a small worker pool the same
+// way OcclusionCuller splits its bands.
+class LightManager {
+public:
+    LightManager();
+    ~LightManager();
+
+    // Create the cluster textures. Returns false if they could not be created.
+    bool Initialize();
+
+    bool IsReady() const { return ready; }
+
+    // Any lights gathered this frame (the shaders skip the cluster lookup otherwise)
+    bool HasLights() const { return ready && !lights.empty(); }
+
+    // Gather and animate this frame's lights (call before BeginMode3D)
+    void Update(const MapData& mapData, const MapPlayerState& playerState, Vector3 viewPos, float time, float deltaTime);
+
+    // Bin the lights with the active rlgl matrices and upload (call after BeginMode3D)
+    void BuildClusters();
+
+    // Bind the cluster textures to their units
+    void BindTextures() const;
+
+    // Short-lived light that fades out, e.g. a muzzle flash
+    void AddFlash(Vector3 position, Vector3 color, float radius, float intensity, float duration);
+
+    // Scatter count moving lights around the camera (0 removes them)
+    void SetStressLights(int count);
+    int GetStressLightCount() const { return stressCount; }
+
+    const LightStats& GetStats() const { return stats; }
+
+    // Console report
+    void AppendReport(std::vector<std::string>& lines) const;
+
+    void Unload();
+
+private:
+    // Visible light in view space, as the workers bin it
+    struct ViewLight {
+        float x, y, depth;   // depth = distance along the view direction
+        float radius;
+    };
+
+    bool ready;
+    unsigned int clusterTexture;
+    unsigned int indexTexture;
+    unsigned int dataTexture;
+
+    std::vector<PointLight> lights;       // This frame's lights (static + transient + stress)
+    std::vector<PointLight> transients;
+    int stressCount;
+    Vector3 stressCenter;
+
+    std::vector<ViewLight> viewLights;
+    std::vector<float> lightData;                 // 8 floats per visible light
+    std::vector<unsigned short> clusterLights;    // CLUSTER_MAX_LIGHTS per cluster
+    std::vector<unsigned int> clusterCounts;
+    std::vector<unsigned int> clusterGrid;        // offset, count per cluster
+    std::vector<unsigned int> indexList;
+    float projX;   // Projection scale: ndc = proj * view / depth
+    float projY;
+    LightStats stats;
+
+    // Worker pool: slice s is binned by worker s % sliceBands (band 0 by the caller)
+    std::vector<std::thread> workers;
+    std::mutex workMutex;
+    std::condition_variable workStart;
+    std::condition_variable workDone;
+    int workGeneration;
+    int workPending;
+    bool workQuit;
+    int sliceBands;
+    int bandDropped[8];
+
+    void WorkerLoop(int band);
+    void BinBand(int band);
+    void GatherInteriorLights(const Interior& interior);
+    void GatherStressLights(float time);
+    float GetFlickerScale(const PointLight& light, float time) const;
+};
+
+// Fixed light fixtures of an interior (warning beacons, consoles), appended to out
+void CollectInteriorLights(const Interior& interior, std::vector<PointLight>& out);
+
+// Global light manager instance
+extern LightManager* g_LightManager;
+
+// Initialize light system
+void InitializeLightSystem();
+
+// Cleanup light system
+void CleanupLightSystem();
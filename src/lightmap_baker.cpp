@@ -0,0 +1,542 @@
+#include "lightmap_baker.h"
+#include "light_manager.h"
+#include "texture_manager.h"
+#include "profiler.h"
+#include "raymath.h"
+#include "rlgl.h"
+#include "external/glad.h"
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <fstream>
+#include <cmath>
+#include <cfloat>
+
+// Global instance
+LightmapBaker* g_LightmapBaker = nullptr;
+
+// Surfaces as WorldGeometry bakes them: floor top and ceiling underside
+static const float LIGHTMAP_FLOOR_Y = 0.025f;
+static const float LIGHTMAP_CEILING_Y = CEILING_HEIGHT - 0.05f;
+
+// Rays that travel this far without a hit count as open to the ambient light
+static const float LIGHTMAP_AO_DISTANCE = 1.5f;
+// Bounce rays stop here; fixture light never reaches further anyway
+static const float LIGHTMAP_RAY_DISTANCE = 8.0f;
+
+// Shading multiplier: ambient in the open, darkened by occlusion, plus the bounce
+static const float LIGHTMAP_AMBIENT = 0.95f;
+static const float LIGHTMAP_AO_STRENGTH = 0.6f;
+static const float LIGHTMAP_BOUNCE_SCALE = 2.0f;
+
+// Diffuse albedo per plane (floor tiles, white ceiling, concrete walls)
+static const float LIGHTMAP_ALBEDO[LIGHTMAP_PLANE_COUNT] = { 0.4f, 0.8f, 0.55f, 0.55f, 0.55f, 0.55f };
+
+static const float LIGHTMAP_EPSILON = 0.01f;
+
+// =============================================================================
+// BAKE GRID
+// =============================================================================
+
+// The interior as the baker sees it: solid tile columns between a floor and a ceiling
+struct LightmapGrid {
+    const Interior* interior;
+    int W, H, R;
+    int planeW, planeH;        // Texels per plane
+    int width, height;         // Whole texture
+    std::vector<PointLight> lights;
+
+    bool IsSolid(int x, int y) const {
+        return x < 0 || y < 0 || x >= W || y >= H || interior->tiles[y * W + x] == IT_WALL;
+    }
+    bool IsFloor(int x, int y) const {
+        if (x < 0 || y < 0 || x >= W || y >= H) return false;
+        int t = interior->tiles[y * W + x];
+        return t != IT_EMPTY && t != IT_WALL;
+    }
+};
+
+// Surface under a texel
+struct LightmapTexel {
+    Vector3 position;
+    Vector3 normal;
+    int plane;
+    int sheet;      // Texels only filter with texels on the same sheet (one wall row / column)
+    bool valid;
+};
+
+static LightmapTexel DescribeTexel(const LightmapGrid& g, int col, int row) {
+    LightmapTexel t;
+    t.plane = (col / g.planeW) + 3 * (row / g.planeH);
+    int lc = col % g.planeW;
+    int lr = row % g.planeH;
+    int tx = lc / g.R;
+    int ty = lr / g.R;
+    float along = (lc + 0.5f) / g.R - 0.5f;       // World x (or z) across the plane
+    float down = (lr + 0.5f) / g.R - 0.5f;
+    bool open = !g.IsSolid(tx, ty);
+
+    switch (t.plane) {
+    case LIGHTMAP_FLOOR:
+    case LIGHTMAP_CEILING: {
+        bool floor = t.plane == LIGHTMAP_FLOOR;
+        t.position = Vector3{ along, floor ? LIGHTMAP_FLOOR_Y : LIGHTMAP_CEILING_Y, down };
+        t.normal = Vector3{ 0.0f, floor ? 1.0f : -1.0f, 0.0f };
+        t.sheet = 0;
+        t.valid = g.IsFloor(tx, ty);
+        break;
+    }
+    case LIGHTMAP_WALL_POS_Z:
+    case LIGHTMAP_WALL_NEG_Z: {
+        // Runs along x; each tile row stacks the wall height in R texels
+        int dir = t.plane == LIGHTMAP_WALL_POS_Z ? 1 : -1;
+        float y = ((lr % g.R) + 0.5f) / g.R * WALL_HEIGHT;
+        t.position = Vector3{ along, y, ty - dir * 0.5f };
+        t.normal = Vector3{ 0.0f, 0.0f, (float)dir };
+        t.sheet = ty;
+        t.valid = open && g.IsSolid(tx, ty - dir);
+        break;
+    }
+    default: {
+        // Runs along z; each tile column stacks the wall height in R texels
+        int dir = t.plane == LIGHTMAP_WALL_POS_X ? 1 : -1;
+        float y = ((lc % g.R) + 0.5f) / g.R * WALL_HEIGHT;
+        t.position = Vector3{ tx - dir * 0.5f, y, down };
+        t.normal = Vector3{ (float)dir, 0.0f, 0.0f };
+        t.sheet = tx;
+        t.valid = open && g.IsSolid(tx - dir, ty);
+        break;
+    }
+    }
+    return t;
+}
+
+// Texel holding a surface point; cell is the open tile owning the face
+static int TexelAt(const LightmapGrid& g, int plane, int cellX, int cellZ, Vector3 p) {
+    int ox = (plane % 3) * g.planeW;
+    int oy = (plane / 3) * g.planeH;
+    auto inCell = [&](float world, int cell) { return Clamp(floorf((world + 0.5f) * g.R), (float)(cell * g.R), (float)(cell * g.R + g.R - 1)); };
+    int height = (int)Clamp(floorf(p.y / WALL_HEIGHT * g.R), 0.0f, (float)(g.R - 1));
+    int col, row;
+    if (plane == LIGHTMAP_FLOOR || plane == LIGHTMAP_CEILING) {
+        col = (int)inCell(p.x, cellX);
+        row = (int)inCell(p.z, cellZ);
+    }
+    else if (plane == LIGHTMAP_WALL_POS_Z || plane == LIGHTMAP_WALL_NEG_Z) {
+        col = (int)inCell(p.x, cellX);
+        row = cellZ * g.R + height;
+    }
+    else {
+        col = cellX * g.R + height;
+        row = (int)inCell(p.z, cellZ);
+    }
+    return (oy + row) * g.width + ox + col;
+}
+
+struct LightmapHit {
+    float t;
+    int plane;      // -1 = fell through a hole in the floor
+    int cellX;
+    int cellZ;
+};
+
+// March a ray through the tile grid (2D DDA) between the floor and ceiling planes
+static bool TraceRay(const LightmapGrid& g, Vector3 o, Vector3 d, float maxT, LightmapHit* hit) {
+    int cx = (int)floorf(o.x + 0.5f);
+    int cz = (int)floorf(o.z + 0.5f);
+    int stepX = d.x > 0.0f ? 1 : -1;
+    int stepZ = d.z > 0.0f ? 1 : -1;
+    float tMaxX = fabsf(d.x) > 1e-6f ? ((cx + 0.5f * stepX) - o.x) / d.x : FLT_MAX;
+    float tMaxZ = fabsf(d.z) > 1e-6f ? ((cz + 0.5f * stepZ) - o.z) / d.z : FLT_MAX;
+    float tDeltaX = fabsf(d.x) > 1e-6f ? fabsf(1.0f / d.x) : FLT_MAX;
+    float tDeltaZ = fabsf(d.z) > 1e-6f ? fabsf(1.0f / d.z) : FLT_MAX;
+
+    float tPlane = FLT_MAX;
+    int plane = -1;
+    if (d.y > 1e-6f) { tPlane = (LIGHTMAP_CEILING_Y - o.y) / d.y; plane = LIGHTMAP_CEILING; }
+    else if (d.y < -1e-6f) { tPlane = (LIGHTMAP_FLOOR_Y - o.y) / d.y; plane = LIGHTMAP_FLOOR; }
+    float limit = fminf(tPlane, maxT);
+
+    while (true) {
+        float t;
+        bool alongX = tMaxX < tMaxZ;
+        if (alongX) {
+            if (tMaxX >= limit) break;
+            t = tMaxX;
+            cx += stepX;
+            tMaxX += tDeltaX;
+        }
+        else {
+            if (tMaxZ >= limit) break;
+            t = tMaxZ;
+            cz += stepZ;
+            tMaxZ += tDeltaZ;
+        }
+        if (!g.IsSolid(cx, cz)) continue;
+
+        // Entered a wall column: the face belongs to the cell we came from
+        hit->t = t;
+        if (alongX) {
+            hit->plane = stepX > 0 ? LIGHTMAP_WALL_NEG_X : LIGHTMAP_WALL_POS_X;
+            hit->cellX = cx - stepX;
+            hit->cellZ = cz;
+        }
+        else {
+            hit->plane = stepZ > 0 ? LIGHTMAP_WALL_NEG_Z : LIGHTMAP_WALL_POS_Z;
+            hit->cellX = cx;
+            hit->cellZ = cz - stepZ;
+        }
+        return true;
+    }
+
+    if (tPlane > maxT) return false;
+    hit->t = tPlane;
+    hit->plane = g.IsFloor(cx, cz) ? plane : -1;
+    hit->cellX = cx;
+    hit->cellZ = cz;
+    return true;
+}
+
+// Light arriving straight from the fixtures, same falloff as surface.fs, with shadow rays
+static Vector3 DirectLight(const LightmapGrid& g, Vector3 p, Vector3 n) {
+    Vector3 result = { 0.0f, 0.0f, 0.0f };
+    Vector3 origin = Vector3Add(p, Vector3Scale(n, LIGHTMAP_EPSILON));
+    for (const PointLight& light : g.lights) {
+        Vector3 toLight = Vector3Subtract(light.position, origin);
+        float dist2 = Vector3DotProduct(toLight, toLight);
+        float r = light.radius;
+        if (dist2 >= r * r || dist2 < 1e-6f) continue;
+        float dist = sqrtf(dist2);
+        Vector3 l = Vector3Scale(toLight, 1.0f / dist);
+        float ndl = Vector3DotProduct(n, l);
+        if (ndl <= 0.0f) continue;
+
+        LightmapHit hit;
+        if (TraceRay(g, origin, l, dist, &hit) && hit.t < dist - LIGHTMAP_EPSILON) continue;
+
+        float falloff = Clamp(1.0f - (dist2 * dist2) / (r * r * r * r), 0.0f, 1.0f);
+        float attenuation = falloff * falloff / (dist2 + 1.0f);
+        result = Vector3Add(result, Vector3Scale(light.color, light.intensity * ndl * attenuation));
+    }
+    return result;
+}
+
+// Deterministic per-texel random numbers, so a bake never depends on the thread count
+static unsigned int XorShift(unsigned int& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static float Random01(unsigned int& state) {
+    return (XorShift(state) & 0xffffff) / 16777216.0f;
+}
+
+// Run fn(row) over all rows on every thread; the caller takes part
+static void ParallelRows(int rows, int threads, const std::function<void(int)>& fn) {
+    std::atomic<int> next(0);
+    auto work = [&]() {
+        for (int row = next++; row < rows; row = next++) fn(row);
+    };
+    std::vector<std::thread> pool;
+    for (int i = 1; i < threads; i++) pool.emplace_back(work);
+    work();
+    for (std::thread& thread : pool) thread.join();
+}
+
+// =============================================================================
+// CACHE
+// =============================================================================
+
+// FNV-1a over the bake settings and the tile grid
+static unsigned int HashInterior(const Interior& interior) {
+    unsigned int hash = 2166136261u;
+    auto mix = [&](int value) {
+        for (int i = 0; i < 4; i++) {
+            hash ^= (unsigned int)((value >> (i * 8)) & 0xff);
+            hash *= 16777619u;
+        }
+    };
+    mix(LIGHTMAP_FILE_VERSION);
+    mix(LIGHTMAP_TEXELS_PER_TILE);
+    mix(LIGHTMAP_SAMPLES);
+    mix(interior.width);
+    mix(interior.height);
+    for (int tile : interior.tiles) mix(tile);
+    return hash;
+}
+
+static bool LoadCachedLightmap(const char* path, int width, int height, std::vector<unsigned char>& pixels) {
+    std::ifstream infile(path, std::ios::binary);
+    if (!infile.is_open()) return false;
+
+    unsigned int magic = 0, version = 0;
+    int fileWidth = 0, fileHeight = 0;
+    infile.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    infile.read(reinterpret_cast<char*>(&version), sizeof(version));
+    infile.read(reinterpret_cast<char*>(&fileWidth), sizeof(fileWidth));
+    infile.read(reinterpret_cast<char*>(&fileHeight), sizeof(fileHeight));
+    if (!infile || magic != LIGHTMAP_FILE_MAGIC || version != LIGHTMAP_FILE_VERSION ||
+        fileWidth != width || fileHeight != height) {
+        TraceLog(LOG_WARNING, TextFormat("Lightmap cache %s is stale, rebaking", path));
+        return false;
+    }
+
+    pixels.resize((size_t)width * height * 4);
+    infile.read(reinterpret_cast<char*>(pixels.data()), pixels.size());
+    return (bool)infile;
+}
+
+static void SaveCachedLightmap(const char* path, int width, int height, const std::vector<unsigned char>& pixels) {
+    std::ofstream outfile(path, std::ios::binary);
+    if (!outfile.is_open()) {
+        TraceLog(LOG_WARNING, TextFormat("Lightmap: failed to open %s for writing.", path));
+        return;
+    }
+    unsigned int magic = LIGHTMAP_FILE_MAGIC, version = LIGHTMAP_FILE_VERSION;
+    outfile.write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+    outfile.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    outfile.write(reinterpret_cast<const char*>(&width), sizeof(width));
+    outfile.write(reinterpret_cast<const char*>(&height), sizeof(height));
+    outfile.write(reinterpret_cast<const char*>(pixels.data()), pixels.size());
+}
+
+// =============================================================================
+// LIGHTMAP BAKER
+// =============================================================================
+
+LightmapBaker::LightmapBaker() {
+    threadCount = 1;
+}
+
+LightmapBaker::~LightmapBaker() {
+    Unload();
+}
+
+void LightmapBaker::Initialize() {
+    unsigned int cores = std::thread::hardware_concurrency();
+    threadCount = cores > 0 ? (int)cores : 1;
+    TraceLog(LOG_INFO, TextFormat("Lightmap baker: %d threads, %d texels per tile, %d samples",
+        threadCount, LIGHTMAP_TEXELS_PER_TILE, LIGHTMAP_SAMPLES));
+}
+
+InteriorLightmap LightmapBaker::BakeInterior(const Interior& interior) {
+    PROFILE_SCOPE("BakeLightmap");
+    InteriorLightmap lightmap = {};
+    lightmap.tilesX = interior.width;
+    lightmap.tilesY = interior.height;
+    if (interior.width <= 0 || interior.height <= 0) return lightmap;
+
+    LightmapGrid g;
+    g.interior = &interior;
+    g.W = interior.width;
+    g.H = interior.height;
+    g.R = LIGHTMAP_TEXELS_PER_TILE;
+    g.planeW = g.W * g.R;
+    g.planeH = g.H * g.R;
+    g.width = g.planeW * 3;
+    g.height = g.planeH * 2;
+    CollectInteriorLights(interior, g.lights);
+
+    const int texelCount = g.width * g.height;
+    std::vector<unsigned char> pixels;
+    const char* cachePath = TextFormat("lightmap_%08x.lmap", HashInterior(interior));
+    std::string path = cachePath;
+
+    if (LoadCachedLightmap(path.c_str(), g.width, g.height, pixels)) {
+        lightmap.fromCache = true;
+    }
+    else {
+        double start = GetTime();
+
+        // Pass 1: surface of every texel and the direct light on it (the bounce source)
+        std::vector<LightmapTexel> texels(texelCount);
+        std::vector<Vector3> direct(texelCount, Vector3{ 0.0f, 0.0f, 0.0f });
+        ParallelRows(g.height, threadCount, [&](int row) {
+            for (int col = 0; col < g.width; col++) {
+                int i = row * g.width + col;
+                texels[i] = DescribeTexel(g, col, row);
+                if (texels[i].valid) direct[i] = DirectLight(g, texels[i].position, texels[i].normal);
+            }
+        });
+
+        // Pass 2: stratified cosine-weighted hemisphere; open rays give ambient, hits one bounce
+        std::vector<Vector3> gathered(texelCount, Vector3{ 0.0f, 0.0f, 0.0f });
+        const int strata = (int)sqrtf((float)LIGHTMAP_SAMPLES);
+        ParallelRows(g.height, threadCount, [&](int row) {
+            for (int col = 0; col < g.width; col++) {
+                int i = row * g.width + col;
+                const LightmapTexel& texel = texels[i];
+                if (!texel.valid) continue;
+
+                // Axis-aligned normals: the tangent frame is a permutation
+                Vector3 n = texel.normal;
+                Vector3 t = fabsf(n.y) > 0.5f ? Vector3{ 1.0f, 0.0f, 0.0f } : Vector3{ 0.0f, 1.0f, 0.0f };
+                Vector3 b = Vector3CrossProduct(n, t);
+                Vector3 origin = Vector3Add(texel.position, Vector3Scale(n, LIGHTMAP_EPSILON));
+
+                unsigned int rng = (unsigned int)i * 9781u + 0x9e3779b9u;
+                int open = 0;
+                Vector3 bounce = { 0.0f, 0.0f, 0.0f };
+                for (int s = 0; s < strata * strata; s++) {
+                    float u1 = ((s % strata) + Random01(rng)) / strata;
+                    float u2 = ((s / strata) + Random01(rng)) / strata;
+                    float r = sqrtf(u1);
+                    float phi = 2.0f * PI * u2;
+                    Vector3 dir = Vector3Add(Vector3Add(Vector3Scale(t, r * cosf(phi)), Vector3Scale(b, r * sinf(phi))),
+                        Vector3Scale(n, sqrtf(fmaxf(0.0f, 1.0f - u1))));
+
+                    LightmapHit hit;
+                    bool hitSomething = TraceRay(g, origin, dir, LIGHTMAP_RAY_DISTANCE, &hit);
+                    if (!hitSomething || hit.t > LIGHTMAP_AO_DISTANCE) open++;
+                    if (!hitSomething || hit.plane < 0) continue;
+
+                    // Cosine-weighted: irradiance is the mean of albedo * direct light at the hits
+                    Vector3 q = Vector3Add(origin, Vector3Scale(dir, hit.t));
+                    int j = TexelAt(g, hit.plane, hit.cellX, hit.cellZ, q);
+                    bounce = Vector3Add(bounce, Vector3Scale(direct[j], LIGHTMAP_ALBEDO[hit.plane]));
+                }
+
+                float samples = (float)(strata * strata);
+                float ambient = LIGHTMAP_AMBIENT * (1.0f - LIGHTMAP_AO_STRENGTH * (1.0f - open / samples));
+                gathered[i] = Vector3AddValue(Vector3Scale(bounce, LIGHTMAP_BOUNCE_SCALE / samples), ambient);
+            }
+        });
+
+        // Pass 3: denoise on the texel's own sheet, then dilate into the empty texels around
+        // each sheet so bilinear filtering at face edges never blends in black
+        std::vector<Vector3> filtered(texelCount, Vector3{ 0.0f, 0.0f, 0.0f });
+        std::vector<unsigned char> coverage(texelCount, 0);
+        const int radius = LIGHTMAP_DENOISE_RADIUS;
+        ParallelRows(g.height, threadCount, [&](int row) {
+            for (int col = 0; col < g.width; col++) {
+                int i = row * g.width + col;
+                const LightmapTexel& texel = texels[i];
+                int px = col / g.planeW, py = row / g.planeH;
+                bool valid = texel.valid;
+                int reach = valid ? radius : 1;
+
+                Vector3 sum = { 0.0f, 0.0f, 0.0f };
+                float weight = 0.0f;
+                for (int dy = -reach; dy <= reach; dy++) {
+                    for (int dx = -reach; dx <= reach; dx++) {
+                        int c = col + dx, r = row + dy;
+                        if (c < 0 || r < 0 || c >= g.width || r >= g.height) continue;
+                        if (c / g.planeW != px || r / g.planeH != py) continue;
+                        int j = r * g.width + c;
+                        if (!texels[j].valid || texels[j].sheet != texel.sheet) continue;
+                        float w = expf(-(float)(dx * dx + dy * dy) / (float)(radius * radius));
+                        sum = Vector3Add(sum, Vector3Scale(gathered[j], w));
+                        weight += w;
+                    }
+                }
+                if (weight <= 0.0f) continue;
+                filtered[i] = Vector3Scale(sum, 1.0f / weight);
+                coverage[i] = 1;
+            }
+        });
+
+        pixels.assign((size_t)texelCount * 4, 0);
+        for (int i = 0; i < texelCount; i++) {
+            if (!coverage[i]) continue;
+            pixels[i * 4 + 0] = (unsigned char)Clamp(filtered[i].x / LIGHTMAP_RANGE * 255.0f + 0.5f, 0.0f, 255.0f);
+            pixels[i * 4 + 1] = (unsigned char)Clamp(filtered[i].y / LIGHTMAP_RANGE * 255.0f + 0.5f, 0.0f, 255.0f);
+            pixels[i * 4 + 2] = (unsigned char)Clamp(filtered[i].z / LIGHTMAP_RANGE * 255.0f + 0.5f, 0.0f, 255.0f);
+            pixels[i * 4 + 3] = 255;
+        }
+
+        lightmap.bakeMs = (float)((GetTime() - start) * 1000.0);
+        SaveCachedLightmap(path.c_str(), g.width, g.height, pixels);
+    }
+
+    for (int i = 0; i < texelCount; i++) {
+        if (pixels[i * 4 + 3] > 0) lightmap.texels++;
+    }
+
+    Image image = { pixels.data(), g.width, g.height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    lightmap.texture = LoadTextureFromImage(image);
+    SetTextureFilter(lightmap.texture, TEXTURE_FILTER_BILINEAR);
+    SetTextureWrap(lightmap.texture, TEXTURE_WRAP_CLAMP);
+
+    if (lightmap.fromCache) {
+        TraceLog(LOG_INFO, TextFormat("Lightmap '%s': %dx%d loaded from %s", interior.id.c_str(), g.width, g.height, path.c_str()));
+    }
+    else {
+        TraceLog(LOG_INFO, TextFormat("Lightmap '%s': %dx%d, %d texels, %d lights baked in %.0f ms on %d threads",
+            interior.id.c_str(), g.width, g.height, lightmap.texels, (int)g.lights.size(), lightmap.bakeMs, threadCount));
+    }
+    return lightmap;
+}
+
+void LightmapBaker::BakeInteriors(const MapData& mapData) {
+    PROFILE_SCOPE("BakeLightmaps");
+    Unload();
+    for (const auto& pair : mapData.interiors) {
+        lightmaps[pair.first] = BakeInterior(pair.second);
+    }
+}
+
+const InteriorLightmap* LightmapBaker::GetLightmap(const Interior& interior) {
+    auto it = lightmaps.find(interior.id);
+    if (it == lightmaps.end()) {
+        // Interior added after the map bake - bake it on first use
+        it = lightmaps.emplace(interior.id, BakeInterior(interior)).first;
+    }
+    return it->second.texture.id > 0 ? &it->second : nullptr;
+}
+
+void LightmapBaker::BindInterior(const Interior* interior) {
+    const InteriorLightmap* lightmap = interior ? GetLightmap(*interior) : nullptr;
+    if (lightmap) {
+        glActiveTexture(GL_TEXTURE0 + LIGHTMAP_TEXTURE_UNIT);
+        glBindTexture(GL_TEXTURE_2D, lightmap->texture.id);
+        glActiveTexture(GL_TEXTURE0);
+    }
+    if (g_ShaderManager) {
+        g_ShaderManager->SetLightmap(lightmap != nullptr, lightmap ? lightmap->tilesX : 0, lightmap ? lightmap->tilesY : 0);
+    }
+}
+
+void LightmapBaker::AppendReport(std::vector<std::string>& lines) const {
+    if (lightmaps.empty()) {
+        lines.push_back("No lightmaps baked.");
+        return;
+    }
+    for (const auto& pair : lightmaps) {
+        const InteriorLightmap& lightmap = pair.second;
+        if (lightmap.fromCache) {
+            lines.push_back(TextFormat("%s: %dx%d, %d texels (cached)", pair.first.c_str(),
+                lightmap.texture.width, lightmap.texture.height, lightmap.texels));
+        }
+        else {
+            lines.push_back(TextFormat("%s: %dx%d, %d texels, baked in %.0f ms", pair.first.c_str(),
+                lightmap.texture.width, lightmap.texture.height, lightmap.texels, lightmap.bakeMs));
+        }
+    }
+}
+
+void LightmapBaker::Unload() {
+    for (auto& pair : lightmaps) {
+        if (pair.second.texture.id > 0) UnloadTexture(pair.second.texture);
+    }
+    lightmaps.clear();
+}
+
+// =============================================================================
+// GLOBAL INITIALIZATION
+// =============================================================================
+
+void InitializeLightmapSystem() {
+    if (!g_LightmapBaker) {
+        g_LightmapBaker = new LightmapBaker();
+        g_LightmapBaker->Initialize();
+    }
+}
+
+void CleanupLightmapSystem() {
+    if (g_LightmapBaker) {
+        delete g_LightmapBaker;
+        g_LightmapBaker = nullptr;
+    }
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include "globals.h"
+#include "map.h"
+#include <vector>
+#include <string>
+#include <unordered_map>
+
+// Lightmap resolution and quality
+#define LIGHTMAP_TEXELS_PER_TILE 8       // Per tile edge and per wall height
+#define LIGHTMAP_SAMPLES 64              // Hemisphere rays per texel (stratified 8 x 8)
+#define LIGHTMAP_DENOISE_RADIUS 2        // Filter footprint is (2r + 1)^2 texels
+
+// Stored as RGBA8: 255 = this shading multiplier, alpha marks texels with a surface
+#define LIGHTMAP_RANGE 2.0f
+
+// Texture unit above the shadow map units
+#define LIGHTMAP_TEXTURE_UNIT 14
+
+// Disk cache: lightmap_<hash>.lmap next to the settings file
+#define LIGHTMAP_FILE_MAGIC 0x504D4C41   // "ALMP"
+#define LIGHTMAP_FILE_VERSION 1
+
+// Lightmap planes. Every open tile owns its floor, its ceiling and the wall
+// faces around it; plane f covers the whole interior grid and sits at
+// (f % 3, f / 3) in a 3 x 2 layout, so neighbouring tiles are neighbouring texels.
+enum LightmapPlane {
+    LIGHTMAP_FLOOR = 0,
+    LIGHTMAP_CEILING,
+    LIGHTMAP_WALL_POS_X,    // Faces pointing +X (wall on the -X side of the tile)
+    LIGHTMAP_WALL_NEG_X,
+    LIGHTMAP_WALL_POS_Z,
+    LIGHTMAP_WALL_NEG_Z,
+    LIGHTMAP_PLANE_COUNT
+};
+
+struct InteriorLightmap {
+    Texture2D texture;
+    int tilesX;             // Interior width / height the layout was built for
+    int tilesY;
+    int texels;             // Texels with a surface
+    float bakeMs;           // 0 when loaded from the cache
+    bool fromCache;
+};
+
+// Lightmap baker class
+// Precomputes the ambient and indirect light of interiors on the CPU. The
+// faces come straight from the tile grid (the same walls, floor and ceiling
+// WorldGeometry meshes), so no UV unwrap is needed: the surface shader finds
+// its texel from world position and normal. Each texel gathers stratified
+// cosine-weighted rays against the tile grid: rays that get far count toward
+// ambient, rays that hit pick up the direct light (with shadow rays to the
+// fixed fixtures) cached at the hit point, giving one bounce. The result is
+// denoised with a filter that stays on its own wall, dilated so bilinear
+// sampling never reads empty texels, and cached on disk keyed by a hash of
+// the interior tiles. Texel rows are spread across every hardware thread.
+// Direct light from the fixtures stays with the clustered point lights so
+// beacons keep animating; it is only baked as the source of the bounce.
+class LightmapBaker {
+public:
+    LightmapBaker();
+    ~LightmapBaker();
+
+    void Initialize();
+
+    // Bake (or load from the cache) a lightmap for every interior of a fresh map
+    void BakeInteriors(const MapData& mapData);
+
+    // Lightmap of an interior, baked on first use if it was added after the map bake
+    const InteriorLightmap* GetLightmap(const Interior& interior);
+
+    // Bind the current interior's lightmap and enable it on the surface shaders
+    // (nullptr outdoors disables it)
+    void BindInterior(const Interior* interior);
+
+    // Console report
+    void AppendReport(std::vector<std::string>& lines) const;
+
+    void Unload();
+
+private:
+    std::unordered_map<std::string, InteriorLightmap> lightmaps;
+    int threadCount;
+
+    InteriorLightmap BakeInterior(const Interior& interior);
+};
+
+// Global lightmap baker instance
+extern LightmapBaker* g_LightmapBaker;
+
+// Initialize lightmap system
+void InitializeLightmapSystem();
+
+// Cleanup lightmap system
+void CleanupLightmapSystem();
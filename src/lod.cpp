@@ -0,0 +1,163 @@
+#include "lod.h"
+#include "raymath.h"
+#include <vector>
+#include <unordered_map>
+#include <cstring>
+
+// Global instance
+LodSystem* g_LodSystem = nullptr;
+
+int SelectLodLevel(int current, float distance, const LodBands& bands) {
+    int level = current;
+    if (level < 0) level = 0;
+    if (level > bands.count) level = bands.count;
+
+    // Coarser: past the next boundary plus the margin
+    while (level < bands.count && distance > bands.distances[level] * (1.0f + LOD_HYSTERESIS)) level++;
+
+    // Finer: inside the previous boundary minus the margin
+    while (level > 0 && distance < bands.distances[level - 1] * (1.0f - LOD_HYSTERESIS)) level--;
+
+    return level;
+}
+
+LodSystem::LodSystem() {
+    viewPosition = Vector3{ 0.0f, 0.0f, 0.0f };
+    enabled = false;
+    stats = {};
+    lastStats = {};
+}
+
+void LodSystem::BeginFrame(Vector3 position, bool isEnabled) {
+    viewPosition = position;
+    enabled = isEnabled;
+    lastStats = stats;
+    stats = {};
+}
+
+int LodSystem::Resolve(int* level, float distance, const LodBands& bands) {
+    int selected = 0;
+    if (enabled) selected = SelectLodLevel(level ? *level : 0, distance, bands);
+    if (level) *level = selected;
+    stats.selected[selected]++;
+    return selected;
+}
+
+int LodSystem::Select(int* level, Vector3 position, const LodBands& bands) {
+    return Resolve(level, Vector3Distance(viewPosition, position), bands);
+}
+
+int LodSystem::SelectBox(int* level, const BoundingBox& box, const LodBands& bands) {
+    Vector3 closest = {
+        fminf(fmaxf(viewPosition.x, box.min.x), box.max.x),
+        fminf(fmaxf(viewPosition.y, box.min.y), box.max.y),
+        fminf(fmaxf(viewPosition.z, box.min.z), box.max.z)
+    };
+    return Resolve(level, Vector3Distance(viewPosition, closest), bands);
+}
+
+// =============================================================================
+// MESH SIMPLIFICATION
+// =============================================================================
+
+Mesh SimplifyMesh(const Mesh& mesh, int resolution) {
+    Mesh result = { 0 };
+    if (mesh.vertices == nullptr || mesh.vertexCount < 3 || resolution < 1) return result;
+
+    BoundingBox box = GetMeshBoundingBox(mesh);
+    Vector3 extent = Vector3Subtract(box.max, box.min);
+    float longest = fmaxf(fmaxf(extent.x, extent.y), extent.z);
+    if (longest <= 0.0f) return result;
+    float cellSize = longest / resolution;
+
+    // Assign every vertex to a grid cell and average the positions/normals per cell
+    struct Cluster {
+        Vector3 position;
+        Vector3 normal;
+        int count;
+    };
+    std::vector<Cluster> clusters;
+    std::vector<int> vertexCluster(mesh.vertexCount);
+    std::unordered_map<long long, int> cellLookup;
+
+    for (int i = 0; i < mesh.vertexCount; i++) {
+        Vector3 p = { mesh.vertices[i * 3], mesh.vertices[i * 3 + 1], mesh.vertices[i * 3 + 2] };
+        long long cx = (long long)((p.x - box.min.x) / cellSize);
+        long long cy = (long long)((p.y - box.min.y) / cellSize);
+        long long cz = (long long)((p.z - box.min.z) / cellSize);
+        long long key = (cx << 42) | (cy << 21) | cz;
+
+        auto it = cellLookup.find(key);
+        int cluster;
+        if (it == cellLookup.end()) {
+            cluster = (int)clusters.size();
+            cellLookup[key] = cluster;
+            clusters.push_back(Cluster{ Vector3{ 0.0f, 0.0f, 0.0f }, Vector3{ 0.0f, 0.0f, 0.0f }, 0 });
+        }
+        else {
+            cluster = it->second;
+        }
+
+        Cluster& c = clusters[cluster];
+        c.position = Vector3Add(c.position, p);
+        if (mesh.normals) {
+            c.normal = Vector3Add(c.normal, Vector3{ mesh.normals[i * 3], mesh.normals[i * 3 + 1], mesh.normals[i * 3 + 2] });
+        }
+        c.count++;
+        vertexCluster[i] = cluster;
+    }
+
+    for (auto& c : clusters) {
+        c.position = Vector3Scale(c.position, 1.0f / c.count);
+        c.normal = Vector3Normalize(c.normal);
+    }
+
+    // Keep triangles whose corners land in three different cells
+    int triangleCount = mesh.indices ? mesh.triangleCount : mesh.vertexCount / 3;
+    std::vector<int> kept;
+    kept.reserve(triangleCount * 3);
+    for (int t = 0; t < triangleCount; t++) {
+        int v[3];
+        for (int k = 0; k < 3; k++) v[k] = mesh.indices ? mesh.indices[t * 3 + k] : t * 3 + k;
+        int a = vertexCluster[v[0]], b = vertexCluster[v[1]], c = vertexCluster[v[2]];
+        if (a == b || b == c || a == c) continue;
+        kept.push_back(v[0]);
+        kept.push_back(v[1]);
+        kept.push_back(v[2]);
+    }
+    if (kept.empty()) return result;
+
+    // Non-indexed output: clustered positions and normals, original UVs and colors
+    result.vertexCount = (int)kept.size();
+    result.triangleCount = result.vertexCount / 3;
+    result.vertices = (float*)RL_MALLOC(result.vertexCount * 3 * sizeof(float));
+    result.normals = (float*)RL_MALLOC(result.vertexCount * 3 * sizeof(float));
+    if (mesh.texcoords) result.texcoords = (float*)RL_MALLOC(result.vertexCount * 2 * sizeof(float));
+    if (mesh.colors) result.colors = (unsigned char*)RL_MALLOC(result.vertexCount * 4 * sizeof(unsigned char));
+
+    for (int i = 0; i < result.vertexCount; i++) {
+        int src = kept[i];
+        const Cluster& c = clusters[vertexCluster[src]];
+        memcpy(&result.vertices[i * 3], &c.position, 3 * sizeof(float));
+        memcpy(&result.normals[i * 3], &c.normal, 3 * sizeof(float));
+        if (result.texcoords) memcpy(&result.texcoords[i * 2], &mesh.texcoords[src * 2], 2 * sizeof(float));
+        if (result.colors) memcpy(&result.colors[i * 4], &mesh.colors[src * 4], 4 * sizeof(unsigned char));
+    }
+
+    UploadMesh(&result, false);
+    return result;
+}
+
+// Global initialization
+void InitializeLodSystem() {
+    g_LodSystem = new LodSystem();
+    TraceLog(LOG_INFO, "LOD system initialized");
+}
+
+void CleanupLodSystem() {
+    if (g_LodSystem) {
+        delete g_LodSystem;
+        g_LodSystem = nullptr;
+    }
+    TraceLog(LOG_INFO, "LOD system cleaned up");
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include "raylib.h"
+
+// Highest number of detail levels any object can have (level 0 = full detail)
+#define MAX_LOD_LEVELS 4
+
+// Fraction a switch distance is widened by in the direction of travel, so an
+// object sitting on a boundary does not flicker between two levels
+#define LOD_HYSTERESIS 0.1f
+
+// Switch distances for one kind of object: level i is used beyond distances[i - 1]
+struct LodBands {
+    float distances[MAX_LOD_LEVELS - 1];
+    int count;   // Number of switch distances (levels - 1)
+};
+
+// Per-frame counters, indexed by selected level
+struct LodStats {
+    int selected[MAX_LOD_LEVELS];
+};
+
+// Pick a level for an object currently drawn at 'current'. Moving to a coarser
+// level needs the distance to clear the boundary by LOD_HYSTERESIS, and so does
+// moving back, so objects near a boundary keep whatever they had.
+int SelectLodLevel(int current, float distance, const LodBands& bands);
+
+// LOD system class
+// Holds the view position for the frame and whether GraphicsSettings::enableLOD
+// is on. Objects keep their own current level; with the system off everything
+// selects level 0 and the stored levels reset so re-enabling starts clean.
+class LodSystem {
+public:
+    LodSystem();
+
+    // Capture the viewer position and the settings toggle for this frame
+    void BeginFrame(Vector3 viewPosition, bool enabled);
+
+    bool IsEnabled() const { return enabled; }
+    Vector3 GetViewPosition() const { return viewPosition; }
+
+    // Select a level for an object at 'position' and store it in *level (if given).
+    // Returns 0 when the system is disabled.
+    int Select(int* level, Vector3 position, const LodBands& bands);
+
+    // Same, for a box (distance to its closest point, so big objects switch late)
+    int SelectBox(int* level, const BoundingBox& box, const LodBands& bands);
+
+    const LodStats& GetStats() const { return stats; }
+    const LodStats& GetLastStats() const { return lastStats; }
+
+private:
+    Vector3 viewPosition;
+    bool enabled;
+    LodStats stats;
+    LodStats lastStats;
+
+    int Resolve(int* level, float distance, const LodBands& bands);
+};
+
+// Global LOD system instance
+extern LodSystem* g_LodSystem;
+
+// Build a reduced copy of a mesh by vertex clustering: vertices are snapped to a
+// grid with 'resolution' cells along the longest axis and merged per cell, and
+// triangles that collapse are dropped. The result is non-indexed and uploaded;
+// an empty mesh (vertexCount 0) means nothing was left worth keeping.
+Mesh SimplifyMesh(const Mesh& mesh, int resolution);
+
+// Initialize LOD system
+void InitializeLodSystem();
+
+// Cleanup LOD system
+void CleanupLodSystem();
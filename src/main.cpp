@@ -15,6 +15,24 @@
 #include "rlgl.h"
 #include "upscaling_manager.h"
 #include "model_manager.h"
+#include "world_geometry.h"
+#include "render_queue.h"
+#include "geometry_streamer.h"
+#include "post_process.h"
+#include "minimap_renderer.h"
+#include "ui_cache.h"
+#include "culling.h"
+#include "occlusion.h"
+#include "lod.h"
+#include "prop_renderer.h"
+#include "render_stats.h"
+#include "profiler.h"
+#include "benchmark.h"
+#include "input.h"
+#include "light_manager.h"
+#include "shadow_manager.h"
+#include "lightmap_baker.h"
+#include <cstdlib>
 
 
 
@@ -83,7 +101,8 @@ GraphicsSettings graphicsSettings = {
     true,   // enableFrustumCulling
     1000,   // maxDrawCalls
     UPSCALING_NONE,        // upscalingMode
-    UPSCALE_QUALITY_QUALITY // upscalingQuality
+    UPSCALE_QUALITY_QUALITY, // upscalingQuality
+    3       // shadowPcfKernel (3x3)
 };
 
 // Performance optimization: Frame time tracking
@@ -237,8 +256,31 @@ void InitNewGame(Camera3D* camera, Vector3* playerPosition, Vector3* playerVeloc
 }
 
 
-int main() {
-    LoadGraphicsSettings(&graphicsSettings);
+int main(int argc, char** argv) {
+    // Benchmark runs use the built-in default settings (not the user's file) and a fixed seed
+    BenchmarkOptions benchmarkOptions;
+    bool benchmark = ParseBenchmarkArgs(argc, argv, &benchmarkOptions);
+    if (benchmark) {
+        graphicsSettings.vsync = false;
+        graphicsSettings.targetFPS = 0;
+    }
+    else {
+        LoadGraphicsSettings(&graphicsSettings);
+    }
+
+    // Input recording and replay share the recording's seed; replays run uncapped for timing.
+    // Recording steps INPUT_FIXED_TIMESTEP per frame, so it is capped to that rate to play at real speed.
+    InputOptions inputOptions;
+    if (benchmark || !ParseInputArgs(argc, argv, &inputOptions)) inputOptions.mode = INPUT_LIVE;
+    InitializeInputSystem(inputOptions);
+    if (g_Input->IsReplaying()) {
+        graphicsSettings.vsync = false;
+        graphicsSettings.targetFPS = 0;
+    }
+    else if (g_Input->IsRecording()) {
+        graphicsSettings.vsync = false;
+        graphicsSettings.targetFPS = (int)(1.0f / INPUT_FIXED_TIMESTEP + 0.5f);
+    }
     const Resolution& initialRes = AVAILABLE_RESOLUTIONS[graphicsSettings.resolutionIndex];
 
     // Get monitor resolution for fullscreen
@@ -246,7 +288,15 @@ int main() {
     int monitorHeight = GetMonitorHeight(0);
 
     // Set fullscreen flag BEFORE InitWindow
-    SetConfigFlags(FLAG_WINDOW_RESIZABLE | FLAG_FULLSCREEN_MODE);
+    if (benchmark) {
+        // Hidden fixed-size window: no monitor needed, works under Xvfb and software GL
+        SetConfigFlags(FLAG_WINDOW_HIDDEN);
+        monitorWidth = initialRes.width;
+        monitorHeight = initialRes.height;
+    }
+    else {
+        SetConfigFlags(FLAG_WINDOW_RESIZABLE | FLAG_FULLSCREEN_MODE);
+    }
     if (graphicsSettings.msaa) {
         if (graphicsSettings.msaaSamples == 2) SetConfigFlags(FLAG_MSAA_4X_HINT);
         else if (graphicsSettings.msaaSamples == 4) SetConfigFlags(FLAG_MSAA_4X_HINT);
@@ -256,6 +306,15 @@ int main() {
     InitWindow(monitorWidth, monitorHeight, "Echoes of Time");
     SetExitKey(KEY_NULL);
 
+    // InitWindow reseeds the RNG from the clock, so fixed seeds are applied after it
+    // and before any map or texture generation
+    bool fixedSeed = benchmark || g_Input->GetMode() != INPUT_LIVE;
+    if (fixedSeed) {
+        unsigned int seed = benchmark ? BENCHMARK_SEED : g_Input->GetSeed();
+        srand(seed);
+        SetRandomSeed(seed);
+    }
+
     // ==============================================================
     // FIXED SPLASH SCREEN RENDERING
     // ==============================================================
@@ -309,12 +368,27 @@ int main() {
     // END SPLASH SCREEN FIX
     // ==============================================================
 
+    InitializeProfiler();
     InitializeUpscalingSystem(initialRes.width, initialRes.height);
+    InitializePostProcessSystem();
     ApplyGraphicsSettings(graphicsSettings);
 
     // Initialize all systems (this takes time - splash is visible during this)
     InitializeRenderingSystems();
+    InitializeRenderStats();
+    InitializeRenderQueue();
+    InitializeGeometryStreamer();
+    InitializeCullingSystem();
+    InitializeOcclusionSystem();
+    InitializeLodSystem();
+    InitializeLightSystem();
+    InitializeShadowSystem();
+    InitializeLightmapSystem();
+    InitializeMinimapSystem();
+    InitializeUiCacheSystem();
     InitializeModelSystem();
+    InitializeWorldGeometrySystem();
+    InitializePropSystem();
 
     // Unload splash after everything loaded
     if (splashTexture.id > 0) {
@@ -323,15 +397,34 @@ int main() {
 
     InitNewGame(&camera, &playerPosition, &playerVelocity, &health, &stamina, &hunger, &thirst, &yaw, &pitch, &onGround, inventory, &flashlightBattery, &isFlashlightOn, map, &fov);
 
+    // Benchmark: straight into gameplay, camera driven by the scripted paths
+    int exitCode = 0;
+    if (benchmark) {
+        InitializeBenchmarkSystem(benchmarkOptions);
+        g_Benchmark->Initialize(g_MapData, playerHeight);
+        if (g_LightManager) g_LightManager->SetStressLights(benchmarkOptions.stressLights);
+        gameState = GameState::Gameplay;
+    }
+    // Recordings start in gameplay so a replay begins from the same state
+    if (g_Input->GetMode() != INPUT_LIVE) gameState = GameState::Gameplay;
+
     int screenW = GetScreenWidth();
     int screenH = GetScreenHeight();
     bool prevBindingMode = isBindingMode;
 
     while (!WindowShouldClose()) {
-        float deltaTime = GetFrameTime();
+        if (g_Input) {
+            g_Input->BeginFrame();
+            if (g_Input->IsReplayFinished()) break;
+        }
+        float deltaTime = g_Input ? g_Input->GetDeltaTime() : GetFrameTime();
+        if (g_Profiler) g_Profiler->BeginFrame();
+        PROFILE_SCOPE("Frame");
+        if (g_RenderStats) g_RenderStats->BeginFrame();
+        if (g_Benchmark) g_Benchmark->BeginFrame(&camera, &playerPosition, &yaw, &pitch);
 
         // Performance monitoring
-        frameTimeAccumulator += deltaTime;
+        frameTimeAccumulator += GetFrameTime();
         frameCount++;
         if (frameTimeAccumulator >= 1.0f) {
             avgFrameTime = frameTimeAccumulator / frameCount;
@@ -340,7 +433,7 @@ int main() {
         }
 
         bool isAnyMenuOpen = (inventoryOpen || isCraftingOpen || isMapOpen);
-        bool useController = isControllerEnabled && IsGamepadAvailable(0);
+        bool useController = isControllerEnabled && InputIsGamepadAvailable(0);
 
         bool shouldCaptureCursor = (gameState == GameState::Gameplay && !isAnyMenuOpen && !isBindingMode) || isBindingMode;
 
@@ -358,7 +451,7 @@ int main() {
         }
 
         // Global ESC handling
-        if (IsKeyPressed(KEY_ESCAPE) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_START))) {
+        if (InputIsKeyPressed(KEY_ESCAPE) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_START))) {
             if (gameState == GameState::Gameplay && !isAnyMenuOpen) {
                 gameState = GameState::Paused;
                 pauseMenuSelection = 0;
@@ -390,27 +483,34 @@ int main() {
             }
         }
 
-        if (IsKeyPressed(KEY_GRAVE)) {
+        if (gameState == GameState::Console) {
+            UpdateConsoleInput(&health, &stamina, &hunger, &thirst, &isNoclip, &fov);
+        }
+        if (InputIsKeyPressed(KEY_F3) && g_RenderStats) g_RenderStats->ToggleExpanded();
+        if (InputIsKeyPressed(KEY_F4) && g_Profiler) g_Profiler->ToggleVisible();
+
+        if (InputIsKeyPressed(KEY_GRAVE)) {
             if (gameState == GameState::Gameplay) gameState = GameState::Console;
             else if (gameState == GameState::Console) gameState = GameState::Gameplay;
         }
 
         // --- Gameplay Input & Logic ---
-        if (gameState == GameState::Gameplay) {
-            bool inventoryTogglePressed = IsKeyPressed(KEY_I) || (useController && IsActionPressed(ACTION_INVENTORY, bindings));
+        if (gameState == GameState::Gameplay && !g_Benchmark) {
+            PROFILE_SCOPE("Update");
+            bool inventoryTogglePressed = InputIsKeyPressed(KEY_I) || (useController && IsActionPressed(ACTION_INVENTORY, bindings));
             if (inventoryTogglePressed) { CloseInGameMenus(); inventoryOpen = !inventoryOpen; }
 
-            bool craftingTogglePressed = IsKeyPressed(KEY_C) || (useController && IsActionPressed(ACTION_CRAFTING, bindings));
+            bool craftingTogglePressed = InputIsKeyPressed(KEY_C) || (useController && IsActionPressed(ACTION_CRAFTING, bindings));
             if (craftingTogglePressed) { CloseInGameMenus(); isCraftingOpen = !isCraftingOpen; if (isCraftingOpen) selectedRecipeIndex = 0; }
 
-            bool mapTogglePressed = IsKeyPressed(KEY_M) || (useController && IsActionPressed(ACTION_MAP, bindings));
+            bool mapTogglePressed = InputIsKeyPressed(KEY_M) || (useController && IsActionPressed(ACTION_MAP, bindings));
             if (mapTogglePressed) { CloseInGameMenus(); isMapOpen = !isMapOpen; }
 
             if (!isAnyMenuOpen) {
                 UpdatePlayer(deltaTime, &camera, &playerPosition, &playerVelocity, &yaw, &pitch, &onGround, playerSpeed, playerHeight, gravity, jumpForce, &stamina, isNoclip, useController);
 
                 // Door interaction - FIXED: Check nearDoor before using it
-                if (IsKeyPressed(KEY_E) && !inventoryOpen && !isCraftingOpen && !isMapOpen) {
+                if (InputIsKeyPressed(KEY_E) && !inventoryOpen && !isCraftingOpen && !isMapOpen) {
                     Door* nearDoor = GetNearestDoor(playerPosition, 2.5f);
 
                     if (nearDoor) {
@@ -451,7 +551,7 @@ int main() {
                 UpdateDoors(deltaTime);
 
                 // Flashlight toggle
-                bool flashlightPressed = useController ? IsActionPressed(ACTION_FLASHLIGHT, bindings) : IsKeyPressed(KEY_F);
+                bool flashlightPressed = useController ? IsActionPressed(ACTION_FLASHLIGHT, bindings) : InputIsKeyPressed(KEY_F);
                 if (flashlightPressed) isFlashlightOn = !isFlashlightOn;
 
                 if (isFlashlightOn && flashlightBattery > 0.0f) {
@@ -463,7 +563,7 @@ int main() {
                 }
 
                 // Use item
-                bool useItemPressed = useController ? IsActionPressed(ACTION_USE_ITEM, bindings) : IsMouseButtonPressed(MOUSE_RIGHT_BUTTON);
+                bool useItemPressed = useController ? IsActionPressed(ACTION_USE_ITEM, bindings) : InputIsMouseButtonPressed(MOUSE_RIGHT_BUTTON);
                 if (useItemPressed) {
                     UseEquippedItem(inventory, &health, &stamina, &hunger, &thirst);
                 }
@@ -471,13 +571,13 @@ int main() {
                 // ADS toggle (right mouse hold for pistol/rifle)
                 int equippedWeapon = inventory[BACKPACK_SLOTS].itemId;
                 if (equippedWeapon == ITEM_PISTOL || equippedWeapon == ITEM_M16) {
-                    bool adsPressed = IsMouseButtonDown(MOUSE_RIGHT_BUTTON) ||
-                        (useController && IsGamepadButtonDown(0, GAMEPAD_BUTTON_LEFT_TRIGGER_2));
+                    bool adsPressed = InputIsMouseButtonDown(MOUSE_RIGHT_BUTTON) ||
+                        (useController && InputIsGamepadButtonDown(0, GAMEPAD_BUTTON_LEFT_TRIGGER_2));
                     g_CurrentWeaponState.isADS = adsPressed;
                 }
 
                 // Reload weapon
-                bool reloadPressed = IsKeyPressed(KEY_R) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_LEFT_FACE_LEFT));
+                bool reloadPressed = InputIsKeyPressed(KEY_R) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_LEFT_FACE_LEFT));
                 if (reloadPressed && !isReloading) {
                     if (ReloadWeapon(inventory)) {
                         isReloading = true;
@@ -498,7 +598,7 @@ int main() {
                 }
 
                 // Weapon shooting with weapon system
-                bool shootPressed = useController ? IsActionPressed(ACTION_SHOOT, bindings) : IsMouseButtonPressed(MOUSE_LEFT_BUTTON);
+                bool shootPressed = useController ? IsActionPressed(ACTION_SHOOT, bindings) : InputIsMouseButtonPressed(MOUSE_LEFT_BUTTON);
                 if (shootPressed && shotTimer <= 0.0f && !isReloading) {
                     int weaponId = inventory[BACKPACK_SLOTS].itemId;
                     WeaponStats* stats = g_WeaponSystem.GetWeaponStats(weaponId);
@@ -518,6 +618,13 @@ int main() {
                         g_CurrentWeaponState.animState = ANIM_SHOOT;
                         g_CurrentWeaponState.animTimer = 0.2f;
 
+                        // Muzzle flash lights the room for a few frames
+                        if (g_LightManager) {
+                            Vector3 aim = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
+                            g_LightManager->AddFlash(Vector3Add(camera.position, Vector3Scale(aim, 0.8f)),
+                                Vector3{ 1.0f, 0.8f, 0.45f }, 7.0f, 3.0f, 0.06f);
+                        }
+
                         TraceLog(LOG_INFO, TextFormat("%s fired! Damage: %.0f",
                             GetItemName(weaponId), stats->damage));
                     }
@@ -543,7 +650,7 @@ int main() {
         }
         // Menu state handling
         if (gameState == GameState::MainMenu) {
-            if (IsKeyPressed(KEY_ENTER) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_DOWN))) {
+            if (InputIsKeyPressed(KEY_ENTER) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_DOWN))) {
                 if (mainMenuSelection == 0) { InitNewGame(&camera, &playerPosition, &playerVelocity, &health, &stamina, &hunger, &thirst, &yaw, &pitch, &onGround, inventory, &flashlightBattery, &isFlashlightOn, map, &fov); gameState = GameState::Gameplay; }
                 if (mainMenuSelection == 1) { stateBeforeSettings = GameState::MainMenu; saveSlotSelection = 0; gameState = GameState::LoadMenu; }
                 if (mainMenuSelection == 2) { stateBeforeSettings = GameState::MainMenu; settingsSelection = 0; gameState = GameState::Settings; }
@@ -551,7 +658,7 @@ int main() {
             }
         }
         else if (gameState == GameState::Paused) {
-            if (IsKeyPressed(KEY_ENTER) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_DOWN))) {
+            if (InputIsKeyPressed(KEY_ENTER) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_DOWN))) {
                 if (pauseMenuSelection == 0) gameState = GameState::Gameplay;
                 if (pauseMenuSelection == 1) { stateBeforeSettings = GameState::Paused; saveSlotSelection = 0; gameState = GameState::LoadMenu; }
                 if (pauseMenuSelection == 2) { stateBeforeSettings = GameState::Paused; settingsSelection = 0; gameState = GameState::Settings; }
@@ -559,7 +666,7 @@ int main() {
             }
         }
         else if (gameState == GameState::LoadMenu) {
-            if ((IsKeyPressed(KEY_ENTER) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_DOWN)))) {
+            if ((InputIsKeyPressed(KEY_ENTER) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_DOWN)))) {
                 bool fileExists = SaveFileExists(saveSlotSelection + 1);
                 if (stateBeforeSettings == GameState::Paused) {
                     SaveGame(saveSlotSelection + 1, playerPosition, yaw, pitch, health, stamina, hunger, thirst, inventory, flashlightBattery, isFlashlightOn, map, fov);
@@ -586,15 +693,29 @@ int main() {
 
         // --- RENDERING ---
         BeginDrawing();
+        if (g_Benchmark) g_Benchmark->BeginGpuTimer();
+        if (g_UiCache) g_UiCache->BeginFrame();
 
         ClearBackground(Color{ 5, 10, 15, 255 });
 
         // Only render 3D when necessary
         if (gameState == GameState::Gameplay || gameState == GameState::Paused) {
+            // Shadow maps render into their own framebuffers, before the scene target is bound
+            if (g_ShadowManager) {
+                Vector3 flashDir = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
+                g_ShadowManager->Render(g_MapData, g_MapPlayer, camera.position,
+                    isFlashlightOn && flashlightBattery > 0.0f, camera.position, flashDir,
+                    graphicsSettings.shadowPcfKernel);
+            }
             // Begin upscaled rendering
             if (g_UpscalingManager && graphicsSettings.upscalingMode != UPSCALING_NONE) {
                 g_UpscalingManager->BeginUpscaledRender();
             }
+            // Point lights for this frame (binned into clusters once the 3D matrices are set)
+            if (g_LightManager) {
+                float lightDelta = gameState == GameState::Gameplay ? deltaTime : 0.0f;
+                g_LightManager->Update(g_MapData, g_MapPlayer, camera.position, (float)GetTime(), lightDelta);
+            }
             // Update shader lighting uniforms
             if (g_ShaderManager) {
                 Vector3 sunPos = { MAP_SIZE / 2.0f, 100.0f, MAP_SIZE / 2.0f };
@@ -607,6 +728,19 @@ int main() {
 
             BeginMode3D(camera);
 
+            // World draws below are recorded and flushed in sorted order before EndMode3D
+            if (g_RenderQueue) {
+                g_RenderQueue->SetDrawBudget(graphicsSettings.maxDrawCalls);
+                g_RenderQueue->Begin(camera);
+            }
+            if (g_FrustumCuller) g_FrustumCuller->BeginFrame(graphicsSettings.enableFrustumCulling);
+            // Building occluders only exist outdoors; interiors use portal culling instead
+            if (g_OcclusionCuller) {
+                g_OcclusionCuller->BeginFrame(graphicsSettings.enableFrustumCulling && !g_MapPlayer.insideInterior);
+            }
+            if (g_LodSystem) g_LodSystem->BeginFrame(camera.position, graphicsSettings.enableLOD);
+            if (g_LightManager) g_LightManager->BuildClusters();
+
             // Draw grid ONLY when outside
             if (!g_MapPlayer.insideInterior) {
                 if (g_ShaderManager && g_ShaderManager->GetLightingShader().id > 0) {
@@ -623,6 +757,7 @@ int main() {
             g_WaypointManager.DrawIn3D(playerPosition, 100.0f);
 
             // Draw weapon using weapon system
+            if (g_RenderQueue) g_RenderQueue->SetPass(RENDER_PASS_VIEWMODEL);
             int equippedWeapon = inventory[BACKPACK_SLOTS].itemId;
             if (equippedWeapon != ITEM_NONE) {
                 Vector3 forward = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
@@ -653,11 +788,26 @@ int main() {
                 DrawIdleHands(camera, (float)GetTime());
             }
 
+            if (g_RenderQueue) g_RenderQueue->Flush();
+
             EndMode3D();
             // End upscaled rendering
             if (g_UpscalingManager && graphicsSettings.upscalingMode != UPSCALING_NONE) {
                 g_UpscalingManager->EndUpscaledRender(screenW, screenH);
             }
+            // Post-processing: vignette, flashlight glow, low-health pulse, grain and grading in one pass
+            if (g_PostProcess && graphicsSettings.renderScale >= 0.9f) {
+                PostProcessParams post = { 1.0f, 0.0f, 0.0f, (float)GetTime() };
+                if (isFlashlightOn && flashlightBattery > 0.0f) {
+                    post.flashlightGlow = (flashlightBattery / 100.0f) * 30.0f / 255.0f;
+                }
+                if (health < 30.0f) {
+                    float pulseIntensity = sinf(GetTime() * 2.0f) * 0.5f + 0.5f;
+                    post.damagePulse = (30.0f - health) * 2.0f * pulseIntensity / 255.0f;
+                }
+                g_PostProcess->Apply(screenW, screenH, post);
+            }
+            if (g_RenderStats) g_RenderStats->BeginUi();
             // Check for nearby door and show prompt
             Door* nearDoor = GetNearestDoor(playerPosition, 2.5f);
             if (nearDoor && !isAnyMenuOpen) {
@@ -665,24 +815,6 @@ int main() {
                 int textWidth = MeasureText(doorText, 20);
                 DrawText(doorText, screenW / 2 - textWidth / 2, screenH - 100, 20, PIPBOY_GREEN);
             }
-            // Post-processing effects
-            if (graphicsSettings.renderScale >= 0.9f) {
-                DrawRectangleGradientV(0, 0, screenW, screenH / 5, Color{ 0, 0, 0, 120 }, Color{ 0, 0, 0, 0 });
-                DrawRectangleGradientV(0, screenH * 4 / 5, screenW, screenH / 5, Color{ 0, 0, 0, 0 }, Color{ 0, 0, 0, 120 });
-                DrawRectangleGradientH(0, 0, screenW / 6, screenH, Color{ 0, 0, 0, 100 }, Color{ 0, 0, 0, 0 });
-                DrawRectangleGradientH(screenW * 5 / 6, 0, screenW / 6, screenH, Color{ 0, 0, 0, 0 }, Color{ 0, 0, 0, 100 });
-
-                if (isFlashlightOn && flashlightBattery > 0.0f) {
-                    float glowAlpha = (flashlightBattery / 100.0f) * 30.0f;
-                    DrawRectangle(0, 0, screenW, screenH, Color{ 255, 245, 200, (unsigned char)glowAlpha });
-                }
-
-                if (health < 30.0f) {
-                    float pulseIntensity = sinf(GetTime() * 2.0f) * 0.5f + 0.5f;
-                    unsigned char redAlpha = (unsigned char)((30.0f - health) * 2.0f * pulseIntensity);
-                    DrawRectangle(0, 0, screenW, screenH, Color{ 180, 0, 0, redAlpha });
-                }
-            }
 
             if (showMinimap && gameState == GameState::Gameplay && !isMapOpen) {
                 DrawMinimap(map, playerPosition, yaw, screenW - 160, 10, 150, 150, true, 0);
@@ -761,12 +893,12 @@ int main() {
         // Menu rendering
         if (gameState == GameState::MainMenu) {
             ClearBackground(PIPBOY_DARK);
-            std::vector<std::string> options = { "New Game", "Load Game", "Settings", "Exit" };
+            static const std::vector<std::string> options = { "New Game", "Load Game", "Settings", "Exit" };
             DrawMenu(screenW, screenH, options, &mainMenuSelection, useController, "ECHOES OF TIME");
         }
         else if (gameState == GameState::Paused) {
             DrawRectangle(0, 0, screenW, screenH, Color{ 0, 0, 0, 180 });
-            std::vector<std::string> options = { "Continue", "Save Game", "Settings", "Main Menu" };
+            static const std::vector<std::string> options = { "Continue", "Save Game", "Settings", "Main Menu" };
             DrawMenu(screenW, screenH, options, &pauseMenuSelection, useController, "PAUSED");
         }
         else if (gameState == GameState::GameOver) {
@@ -796,19 +928,75 @@ int main() {
             DrawConsole(screenW, screenH, consoleHistory, consoleInput, consoleInputLength);
         }
 
+        if (g_RenderStats) g_RenderStats->EndUi();
+
         // FPS display
         if (graphicsSettings.showFPS) {
             DrawText(TextFormat("FPS: %d (%.2fms)", GetFPS(), avgFrameTime * 1000.0f),
                 10, 10, 20, PIPBOY_GREEN);
+            if (g_FrustumCuller) {
+                const CullingStats& cull = g_FrustumCuller->GetStats();
+                DrawText(TextFormat("Culling: %d visible / %d culled", cull.visible, cull.culled),
+                    10, 32, 16, PIPBOY_GREEN);
+            }
+            if (g_OcclusionCuller && g_OcclusionCuller->IsEnabled()) {
+                const OcclusionStats& occ = g_OcclusionCuller->GetStats();
+                DrawText(TextFormat("Occlusion: %d occluders, %d/%d occluded", occ.occluders, occ.occluded, occ.tested),
+                    10, 50, 16, PIPBOY_GREEN);
+            }
+            if (g_LodSystem && g_LodSystem->IsEnabled()) {
+                const LodStats& lod = g_LodSystem->GetStats();
+                int reduced = lod.selected[1] + lod.selected[2] + lod.selected[3];
+                DrawText(TextFormat("LOD: %d full / %d reduced", lod.selected[0], reduced),
+                    10, 68, 16, PIPBOY_GREEN);
+            }
+        }
+        // Render stats (F3 expands the per-pass table, also without the FPS display)
+        if (g_RenderStats && (graphicsSettings.showFPS || g_RenderStats->IsExpanded())) {
+            g_RenderStats->DrawOverlay(10, 86);
+        }
+        // Profiler flame view (F4)
+        if (g_Profiler && g_Profiler->IsVisible()) {
+            g_Profiler->DrawFlameView(10, screenH - 250, screenW - 20, 240);
+        }
+
+        if (g_Benchmark) g_Benchmark->EndGpuTimer();
+        {
+            PROFILE_SCOPE("EndDrawing");
+            EndDrawing();
         }
 
-        EndDrawing();
+        if (g_Input) g_Input->EndFrame();
+        if (g_Benchmark) {
+            g_Benchmark->EndFrame();
+            if (g_Benchmark->IsFinished()) {
+                if (!g_Benchmark->WriteResults()) exitCode = 1;
+                break;
+            }
+        }
     }
     // Cleanup rendering systems
+    CleanupBenchmarkSystem();
+    CleanupInputSystem();
+    CleanupPropSystem();
+    CleanupWorldGeometrySystem();
     CleanupModelSystem();  
+    CleanupGeometryStreamer();
+    CleanupRenderQueue();
+    CleanupRenderStats();
+    CleanupCullingSystem();
+    CleanupOcclusionSystem();
+    CleanupLodSystem();
+    CleanupLightSystem();
+    CleanupShadowSystem();
+    CleanupLightmapSystem();
+    CleanupUiCacheSystem();
+    CleanupMinimapSystem();
+    CleanupPostProcessSystem();
+    CleanupProfiler();
 	//close sound system      
     CleanupRenderingSystems();
 
     CloseWindow();
-    return 0;
+    return exitCode;
 }
\ No newline at end of file
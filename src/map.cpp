@@ -1,6 +1,16 @@
 #include "globals.h"
 #include "map.h"
 #include "texture_manager.h"
+#include "world_geometry.h"
+#include "render_queue.h"
+#include "culling.h"
+#include "occlusion.h"
+#include "prop_renderer.h"
+#include "light_manager.h"
+#include "shadow_manager.h"
+#include "lightmap_baker.h"
+#include "minimap_renderer.h"
+#include "profiler.h"
 #include <cstdlib>
 #include <ctime>
 #include <cmath>
@@ -16,9 +26,6 @@ int currentFloor = -1;
 int currentBuildingIndex = -1;
 static int idCounter = 1;
 
-// Helper to draw textured cubes (forward declaration)
-void DrawCubeTexture(Texture2D texture, Vector3 position, float width, float height, float length, Color color);
-
 // =============================================================================
 // NEW MAP SYSTEM IMPLEMENTATION
 // =============================================================================
@@ -85,6 +92,15 @@ static Interior MakeLabDetailedInterior(const std::string& id) {
     it.tiles[(cryoY + 1) * W + cryoX] = IT_COOLANT_PUDDLE;
     it.tiles[(cryoY + 2) * W + (cryoX + 2)] = IT_BROKEN_GLASS;
 
+    // Warning beacons along the outer walls and the south corridor (ceiling mounted)
+    for (int y = 3; y < H - 1; y += 4) {
+        it.tiles[y * W + 1] = IT_WARNING_LIGHT;
+        it.tiles[y * W + (W - 2)] = IT_WARNING_LIGHT;
+    }
+    for (int x = 3; x < W - 1; x += 4) {
+        if (x != doorX) it.tiles[(H - 2) * W + x] = IT_WARNING_LIGHT;
+    }
+
     it.spawns.push_back({ cryoX + 1, cryoY, "terminal_log_cryo" });
     it.spawns.push_back({ cryoX + 1, cryoY + 1, "small_medkit" });
     it.playerSpawnX = cryoX + 2;
@@ -199,12 +215,42 @@ static void PlaceBuilding(MapData& m, int x, int y, int w, int h, BuildingType b
     doors.push_back(entranceDoor);
 }
 
+// Index ground chunks, building footprints and exterior doors for culling and queries
+static void BuildSpatialIndex(MapData& m) {
+    m.index.Clear();
+
+    if (g_WorldGeometry) {
+        const auto& chunks = g_WorldGeometry->GetGroundChunks();
+        for (int i = 0; i < (int)chunks.size(); i++) {
+            m.index.Add(SPATIAL_GROUND, i, chunks[i].bounds);
+        }
+    }
+
+    for (int i = 0; i < (int)m.buildings.size(); i++) {
+        const BuildingRect& fp = m.buildings[i].footprint;
+        BoundingBox bounds = {
+            Vector3{ fp.x - 0.5f, 0.0f, fp.y - 0.5f },
+            Vector3{ fp.x + fp.w - 0.5f, CEILING_HEIGHT + 0.1f, fp.y + fp.h - 0.5f }
+        };
+        m.index.Add(SPATIAL_BUILDING, i, bounds);
+    }
+
+    // Interior doors use interior coordinates, so only exterior doors go in the world index
+    for (int i = 0; i < (int)doors.size(); i++) {
+        if (!doors[i].isInteriorDoor) m.index.Add(SPATIAL_DOOR, i, GetDoorBounds(doors[i]));
+    }
+
+    m.index.Build();
+}
+
 // Main map generation
 void GenerateMapData(MapData& m) {
+    PROFILE_SCOPE("GenerateMapData");
     m.width = MAP_WIDTH;
     m.height = MAP_HEIGHT;
     m.tiles.assign(m.width * m.height, WT_GRASS);
     m.buildings.clear();
+    m.index.Clear();
     doors.clear(); // Clear existing doors
 
     CreateInteriors(m);
@@ -273,6 +319,19 @@ void GenerateMapData(MapData& m) {
     // Set map start state: spawn player inside lab cryo room
     m.startInsideInterior = true;
     m.startInteriorId = "lab_detailed_01";
+
+    // Bake static ground and building shells for the exterior renderer
+    if (g_WorldGeometry) {
+        g_WorldGeometry->BakeGround(m);
+        g_WorldGeometry->BakeBuildings(m);
+        g_WorldGeometry->BakeInteriors(m);
+    }
+    if (g_PropRenderer) g_PropRenderer->BakeInteriors(m);
+    if (g_LightmapBaker) g_LightmapBaker->BakeInteriors(m);
+    if (g_ShadowManager) g_ShadowManager->Invalidate();
+    if (g_MinimapRenderer) g_MinimapRenderer->Invalidate();
+
+    BuildSpatialIndex(m);
 }
 
 // Initialize player from map start
@@ -363,10 +422,100 @@ bool ExitInterior(MapData& m, MapPlayerState& p) {
 // 3D RENDERING - NEW IMPLEMENTATION
 // =============================================================================
 
+// Per-tile ground draw, used when the tilemap renderer is unavailable
+static void DrawGroundImmediate(const MapData& mapData, Texture2D grassTex, Texture2D roadTex, Texture2D waterTex) {
+    RenderStatPassScope statPass(STAT_PASS_GROUND);
+    for (int z = 0; z < mapData.height; z++) {
+        for (int x = 0; x < mapData.width; x++) {
+            int tile = mapData.tiles[z * mapData.width + x];
+
+            Texture2D floorTex = grassTex;
+            if (tile == WT_ROAD || tile == WT_CONCRETE) floorTex = roadTex;
+            else if (tile == WT_WATER) floorTex = waterTex;
+
+            BoundingBox bounds = { Vector3{ x - 0.5f, -0.025f, z - 0.5f }, Vector3{ x + 0.5f, 0.025f, z + 0.5f } };
+            if (floorTex.id > 0 && IsBoxInView(bounds)) {
+                QueueCubeTexture(floorTex, Vector3{ (float)x, 0.0f, (float)z },
+                    1.0f, 0.05f, 1.0f, WHITE);
+            }
+        }
+    }
+}
+
+// Door slab and frame (no culling - callers have already tested the bounds)
+static void DrawDoorGeometry(const Door& door) {
+    // Doors are how the player gets around; keep them when the draw budget runs out
+    RenderImportanceScope importance(RENDER_IMPORTANCE_HIGH);
+    RenderStatPassScope statPass(STAT_PASS_DOORS);
+    Texture2D doorTex = g_TextureManager ? g_TextureManager->GetTexture(TEX_DOOR_METAL) : Texture2D{ 0 };
+
+    Color doorColor = door.isLocked ? Color{ 150, 50, 50, 255 } : Color{ 100, 100, 110, 255 };
+
+    if (!door.isOpen) {
+        if (doorTex.id > 0) {
+            QueueCubeTexture(doorTex, Vector3{ door.position.x, DOOR_HEIGHT / 2.0f, door.position.z },
+                0.2f, DOOR_HEIGHT, 1.0f, doorColor);
+        }
+        else {
+            QueueCube(Vector3{ door.position.x, DOOR_HEIGHT / 2.0f, door.position.z },
+                0.2f, DOOR_HEIGHT, 1.0f, doorColor);
+        }
+
+        // Draw door frame
+        QueueCube(Vector3{ door.position.x, DOOR_HEIGHT + 0.1f, door.position.z },
+            0.3f, 0.2f, 1.2f, Color{ 80, 80, 85, 255 });
+    }
+}
+
+// Per-tile building draw, used when no baked geometry is available
+static void DrawBuildingImmediate(const Building& building, Texture2D buildingTex) {
+    RenderStatPassScope statPass(STAT_PASS_BUILDINGS);
+    const BuildingRect& fp = building.footprint;
+
+    // Draw building walls
+    for (int z = fp.y; z < fp.y + fp.h; z++) {
+        for (int x = fp.x; x < fp.x + fp.w; x++) {
+            // Draw outer walls only on perimeter
+            bool isPerimeter = (x == fp.x || x == fp.x + fp.w - 1 ||
+                z == fp.y || z == fp.y + fp.h - 1);
+
+            // Don't draw wall at entrance
+            bool isEntrance = (x == building.entranceX && z == building.entranceY);
+
+            if (isPerimeter && !isEntrance) {
+                if (buildingTex.id > 0) {
+                    QueueCubeTexture(buildingTex, Vector3{ (float)x, WALL_HEIGHT / 2.0f, (float)z },
+                        1.0f, WALL_HEIGHT, 1.0f, WHITE);
+                }
+                else {
+                    QueueCube(Vector3{ (float)x, WALL_HEIGHT / 2.0f, (float)z },
+                        1.0f, WALL_HEIGHT, 1.0f, Color{ 120, 120, 130, 255 });
+                }
+            }
+        }
+    }
+
+    // Draw roof
+    Vector3 roofCenter = Vector3{
+        fp.x + fp.w / 2.0f,
+        CEILING_HEIGHT,
+        fp.y + fp.h / 2.0f
+    };
+    QueueCube(roofCenter, (float)fp.w, 0.2f, (float)fp.h, Color{ 80, 50, 50, 255 });
+}
+
 void Draw3DWorld(const MapData& mapData, const MapPlayerState& playerState) {
+    PROFILE_SCOPE("Draw3DWorld");
+    // One bind covers every baked surface this frame
+    if (g_TextureManager) g_TextureManager->BindSurfaceTextures();
+    if (g_LightManager) g_LightManager->BindTextures();
+    if (g_ShadowManager) g_ShadowManager->BindTextures();
+
+    const Interior* interior = playerState.insideInterior ? GetInterior(mapData, playerState.currentInteriorId) : nullptr;
+    if (g_LightmapBaker) g_LightmapBaker->BindInterior(interior);
+
     if (playerState.insideInterior) {
         // Draw interior
-        const Interior* interior = GetInterior(mapData, playerState.currentInteriorId);
         if (interior) {
             Draw3DInterior(*interior);
         }
@@ -378,108 +527,120 @@ void Draw3DWorld(const MapData& mapData, const MapPlayerState& playerState) {
         Texture2D buildingTex = g_TextureManager ? g_TextureManager->GetTexture(TEX_BUILDING_EXTERIOR) : Texture2D{ 0 };
         Texture2D waterTex = g_TextureManager ? g_TextureManager->GetTexture(TEX_GRASS) : Texture2D{ 0 };
 
-        // Draw ground tiles
-        for (int z = 0; z < mapData.height; z++) {
-            for (int x = 0; x < mapData.width; x++) {
-                int tile = mapData.tiles[z * mapData.width + x];
-
-                Texture2D floorTex = grassTex;
-                if (tile == WT_ROAD || tile == WT_CONCRETE) floorTex = roadTex;
-                else if (tile == WT_WATER) floorTex = waterTex;
+        bool haveGround = g_WorldGeometry && g_WorldGeometry->HasGround();
+        if (!haveGround) {
+            // Per-tile cubes if the tilemap shader is unavailable
+            DrawGroundImmediate(mapData, grassTex, roadTex, waterTex);
+        }
 
-                if (floorTex.id > 0) {
-                    DrawCubeTexture(floorTex, Vector3{ (float)x, 0.0f, (float)z },
-                        1.0f, 0.05f, 1.0f, WHITE);
+        if (mapData.index.IsBuilt() && g_FrustumCuller && g_FrustumCuller->IsEnabled()) {
+            // Hierarchical culling: whole quadtree nodes are accepted or rejected at once
+            static std::vector<SpatialItem> visibleItems;
+            int typeMask = SPATIAL_BUILDING | SPATIAL_DOOR | (haveGround ? SPATIAL_GROUND : 0);
+            mapData.index.QueryFrustum(g_FrustumCuller->GetFrustum(), typeMask, visibleItems);
+            g_FrustumCuller->Record(mapData.index.GetItemCount(typeMask), (int)visibleItems.size());
+
+            // Visible building shells are the occluders for everything else (and each other)
+            bool occlusion = g_OcclusionCuller && g_OcclusionCuller->IsEnabled();
+            if (occlusion) {
+                for (const auto& item : visibleItems) {
+                    if (item.type == SPATIAL_BUILDING) g_OcclusionCuller->AddOccluder(item.bounds);
                 }
+                g_OcclusionCuller->Rasterize();
             }
-        }
 
-        // Draw buildings
-        for (const auto& building : mapData.buildings) {
-            // Draw building walls
-            for (int z = building.footprint.y; z < building.footprint.y + building.footprint.h; z++) {
-                for (int x = building.footprint.x; x < building.footprint.x + building.footprint.w; x++) {
-                    // Draw outer walls only on perimeter
-                    bool isPerimeter = (x == building.footprint.x || x == building.footprint.x + building.footprint.w - 1 ||
-                        z == building.footprint.y || z == building.footprint.y + building.footprint.h - 1);
+            int drawnGround = 0, drawnBuildings = 0, drawnDoors = 0;
+            for (const auto& item : visibleItems) {
+                if (occlusion && g_OcclusionCuller->IsOccluded(item.bounds)) continue;
 
-                    // Don't draw wall at entrance
-                    bool isEntrance = (x == building.entranceX && z == building.entranceY);
+                if (item.type == SPATIAL_GROUND) drawnGround++;
+                else if (item.type == SPATIAL_BUILDING) drawnBuildings++;
+                else drawnDoors++;
 
-                    if (isPerimeter && !isEntrance) {
-                        if (buildingTex.id > 0) {
-                            DrawCubeTexture(buildingTex, Vector3{ (float)x, WALL_HEIGHT / 2.0f, (float)z },
-                                1.0f, WALL_HEIGHT, 1.0f, WHITE);
-                        }
-                        else {
-                            DrawCube(Vector3{ (float)x, WALL_HEIGHT / 2.0f, (float)z },
-                                1.0f, WALL_HEIGHT, 1.0f, Color{ 120, 120, 130, 255 });
-                        }
+                switch (item.type) {
+                case SPATIAL_GROUND:
+                    g_WorldGeometry->DrawGroundChunk(item.index);
+                    break;
+                case SPATIAL_BUILDING:
+                    if (!g_WorldGeometry || !g_WorldGeometry->DrawBuilding(item.index)) {
+                        DrawBuildingImmediate(mapData.buildings[item.index], buildingTex);
                     }
+                    break;
+                case SPATIAL_DOOR:
+                    DrawDoorGeometry(doors[item.index]);
+                    break;
                 }
             }
 
-            // Draw roof
-            Vector3 roofCenter = Vector3{
-                building.footprint.x + building.footprint.w / 2.0f,
-                CEILING_HEIGHT,
-                building.footprint.y + building.footprint.h / 2.0f
-            };
-            DrawCube(roofCenter, (float)building.footprint.w, 0.2f, (float)building.footprint.h, Color{ 80, 50, 50, 255 });
+            if (g_RenderStats) {
+                int totalGround = haveGround ? mapData.index.GetItemCount(SPATIAL_GROUND) : 0;
+                g_RenderStats->RecordObjects(STAT_PASS_GROUND, drawnGround, totalGround - drawnGround);
+                g_RenderStats->RecordObjects(STAT_PASS_BUILDINGS, drawnBuildings,
+                    mapData.index.GetItemCount(SPATIAL_BUILDING) - drawnBuildings);
+                g_RenderStats->RecordObjects(STAT_PASS_DOORS, drawnDoors,
+                    mapData.index.GetItemCount(SPATIAL_DOOR) - drawnDoors);
+            }
         }
+        else {
+            // Draw ground (GPU tilemap chunks)
+            if (haveGround) {
+                g_WorldGeometry->DrawGround();
+            }
 
-        // Draw exterior doors
-        for (const auto& door : doors) {
-            if (!door.isInteriorDoor) {
-                DrawDoor(door);
+            // Draw buildings (baked meshes, immediate mode if nothing was baked)
+            if (g_WorldGeometry && g_WorldGeometry->HasBuildings()) {
+                g_WorldGeometry->DrawBuildings();
+            }
+            else {
+                for (const auto& building : mapData.buildings) {
+                    const BuildingRect& fp = building.footprint;
+                    BoundingBox bounds = {
+                        Vector3{ fp.x - 0.5f, 0.0f, fp.y - 0.5f },
+                        Vector3{ fp.x + fp.w - 0.5f, CEILING_HEIGHT + 0.1f, fp.y + fp.h - 0.5f }
+                    };
+                    if (IsBoxInView(bounds)) DrawBuildingImmediate(building, buildingTex);
+                }
+            }
+
+            // Draw exterior doors
+            for (const auto& door : doors) {
+                if (!door.isInteriorDoor) {
+                    DrawDoor(door);
+                }
             }
         }
     }
 }
 
-void Draw3DInterior(const Interior& interior) {
-    Texture2D wallTex = g_TextureManager ? g_TextureManager->GetTexture(TEX_WALL_CONCRETE) : Texture2D{ 0 };
-    Texture2D floorTex = g_TextureManager ? g_TextureManager->GetTexture(TEX_FLOOR_TILE) : Texture2D{ 0 };
-    Texture2D doorTex = g_TextureManager ? g_TextureManager->GetTexture(TEX_DOOR_METAL) : Texture2D{ 0 };
-
+// Per-tile interior shell draw, used when the interior could not be meshed
+static void DrawInteriorShellImmediate(const Interior& interior, Texture2D wallTex, Texture2D floorTex) {
+    RenderStatPassScope statPass(STAT_PASS_INTERIOR);
     for (int y = 0; y < interior.height; y++) {
         for (int x = 0; x < interior.width; x++) {
             int tile = interior.tiles[y * interior.width + x];
-            Vector3 pos = Vector3{ (float)x, 0.0f, (float)y };
+            if (tile == IT_EMPTY) continue;
+
+            float top = tile == IT_WALL ? WALL_HEIGHT : 0.025f;
+            BoundingBox bounds = { Vector3{ x - 0.5f, -0.025f, y - 0.5f }, Vector3{ x + 0.5f, top, y + 0.5f } };
+            if (!IsBoxInView(bounds)) continue;
 
             // Draw floor for all non-empty tiles
             if (tile != IT_EMPTY && floorTex.id > 0) {
-                DrawCubeTexture(floorTex, Vector3{ (float)x, 0.0f, (float)y },
+                QueueCubeTexture(floorTex, Vector3{ (float)x, 0.0f, (float)y },
                     1.0f, 0.05f, 1.0f, WHITE);
             }
 
             // Draw walls
             if (tile == IT_WALL) {
                 if (wallTex.id > 0) {
-                    DrawCubeTexture(wallTex, Vector3{ (float)x, WALL_HEIGHT / 2.0f, (float)y },
+                    QueueCubeTexture(wallTex, Vector3{ (float)x, WALL_HEIGHT / 2.0f, (float)y },
                         1.0f, WALL_HEIGHT, 1.0f, WHITE);
                 }
                 else {
-                    DrawCube(Vector3{ (float)x, WALL_HEIGHT / 2.0f, (float)y },
+                    QueueCube(Vector3{ (float)x, WALL_HEIGHT / 2.0f, (float)y },
                         1.0f, WALL_HEIGHT, 1.0f, Color{ 180, 180, 185, 255 });
                 }
             }
-
-            // Draw props
-            switch (tile) {
-            case IT_CRYOPOD_BROKEN:
-                DrawCube(Vector3{ (float)x, 0.5f, (float)y }, 0.8f, 1.0f, 0.8f, Color{ 100, 150, 200, 255 });
-                break;
-            case IT_CONSOLE:
-                DrawCube(Vector3{ (float)x, 0.4f, (float)y }, 0.6f, 0.8f, 0.6f, Color{ 80, 120, 160, 255 });
-                break;
-            case IT_BENCH:
-                DrawCube(Vector3{ (float)x, 0.4f, (float)y }, 0.8f, 0.8f, 0.4f, Color{ 140, 120, 100, 255 });
-                break;
-            case IT_BED:
-                DrawCube(Vector3{ (float)x, 0.3f, (float)y }, 0.9f, 0.6f, 0.9f, Color{ 180, 160, 140, 255 });
-                break;
-            }
         }
     }
 
@@ -489,7 +650,92 @@ void Draw3DInterior(const Interior& interior) {
         CEILING_HEIGHT,
         interior.height / 2.0f
     };
-    DrawCube(ceilingCenter, (float)interior.width, 0.1f, (float)interior.height, Color{ 240, 240, 240, 255 });
+    QueueCube(ceilingCenter, (float)interior.width, 0.1f, (float)interior.height, Color{ 240, 240, 240, 255 });
+}
+
+// Per-tile prop cubes for the four original prop types, used without the prop renderer
+static void DrawPropsImmediate(const Interior& interior, const PortalGraph* graph,
+    const std::vector<unsigned char>& visibleCells) {
+    RenderStatPassScope statPass(STAT_PASS_PROPS);
+    auto isTileVisible = [&](int x, int y) {
+        if (!graph) return true;
+        int cell = graph->GetCellAt(x, y);
+        return cell < 0 || visibleCells[cell] != 0;
+    };
+
+    // Gather prop tiles and cull them as one batch
+    static CullBoxList propBounds;
+    static std::vector<int> propTiles;
+    static std::vector<unsigned char> propVisible;
+    propBounds.Clear();
+    propTiles.clear();
+    for (int i = 0; i < (int)interior.tiles.size(); i++) {
+        int tile = interior.tiles[i];
+        if (tile != IT_CRYOPOD_BROKEN && tile != IT_CONSOLE && tile != IT_BENCH && tile != IT_BED) continue;
+
+        if (!isTileVisible(i % interior.width, i / interior.width)) continue;
+
+        float x = (float)(i % interior.width);
+        float y = (float)(i / interior.width);
+        propBounds.Add(BoundingBox{ Vector3{ x - 0.5f, 0.0f, y - 0.5f }, Vector3{ x + 0.5f, 1.0f, y + 0.5f } });
+        propTiles.push_back(i);
+    }
+    if (g_FrustumCuller) g_FrustumCuller->CullBoxes(propBounds, propVisible);
+    else propVisible.assign(propTiles.size(), 1);
+
+    // Draw props
+    for (size_t p = 0; p < propTiles.size(); p++) {
+        if (!propVisible[p]) continue;
+        int x = propTiles[p] % interior.width;
+        int y = propTiles[p] / interior.width;
+        int tile = interior.tiles[propTiles[p]];
+
+        switch (tile) {
+        case IT_CRYOPOD_BROKEN:
+            QueueCube(Vector3{ (float)x, 0.5f, (float)y }, 0.8f, 1.0f, 0.8f, Color{ 100, 150, 200, 255 });
+            break;
+        case IT_CONSOLE:
+            QueueCube(Vector3{ (float)x, 0.4f, (float)y }, 0.6f, 0.8f, 0.6f, Color{ 80, 120, 160, 255 });
+            break;
+        case IT_BENCH:
+            QueueCube(Vector3{ (float)x, 0.4f, (float)y }, 0.8f, 0.8f, 0.4f, Color{ 140, 120, 100, 255 });
+            break;
+        case IT_BED:
+            QueueCube(Vector3{ (float)x, 0.3f, (float)y }, 0.9f, 0.6f, 0.9f, Color{ 180, 160, 140, 255 });
+            break;
+        }
+    }
+}
+
+void Draw3DInterior(const Interior& interior) {
+    PROFILE_SCOPE("Draw3DInterior");
+    Texture2D wallTex = g_TextureManager ? g_TextureManager->GetTexture(TEX_WALL_CONCRETE) : Texture2D{ 0 };
+    Texture2D floorTex = g_TextureManager ? g_TextureManager->GetTexture(TEX_FLOOR_TILE) : Texture2D{ 0 };
+
+    // Portal visibility: only rooms seen from the player's room through door openings
+    static std::vector<unsigned char> visibleCells;
+    const PortalGraph* graph = nullptr;
+    if (g_WorldGeometry && g_FrustumCuller && g_FrustumCuller->IsEnabled()) {
+        graph = &g_WorldGeometry->GetInteriorShell(interior)->graph;
+        int visibleCount = graph->FindVisibleCells(camera.position, g_FrustumCuller->GetFrustum(),
+            g_FrustumCuller->GetViewProjection(), visibleCells);
+        g_FrustumCuller->Record(graph->GetCellCount(), visibleCount);
+        if (g_RenderStats) {
+            g_RenderStats->RecordObjects(STAT_PASS_INTERIOR, visibleCount, graph->GetCellCount() - visibleCount);
+        }
+    }
+    // Walls, floor and ceiling (cached greedy mesh, per-tile cubes as fallback)
+    if (!g_WorldGeometry || !g_WorldGeometry->DrawInterior(interior, graph ? &visibleCells : nullptr)) {
+        DrawInteriorShellImmediate(interior, wallTex, floorTex);
+    }
+
+    // Props: one instanced draw per prop type
+    if (g_PropRenderer) {
+        g_PropRenderer->DrawInterior(interior, graph, graph ? &visibleCells : nullptr);
+    }
+    else {
+        DrawPropsImmediate(interior, graph, visibleCells);
+    }
 
     // Draw interior doors
     for (const auto& door : doors) {
@@ -499,25 +745,19 @@ void Draw3DInterior(const Interior& interior) {
     }
 }
 
-void DrawDoor(const Door& door) {
-    Texture2D doorTex = g_TextureManager ? g_TextureManager->GetTexture(TEX_DOOR_METAL) : Texture2D{ 0 };
-
-    Color doorColor = door.isLocked ? Color{ 150, 50, 50, 255 } : Color{ 100, 100, 110, 255 };
-
-    if (!door.isOpen) {
-        if (doorTex.id > 0) {
-            DrawCubeTexture(doorTex, Vector3{ door.position.x, DOOR_HEIGHT / 2.0f, door.position.z },
-                0.2f, DOOR_HEIGHT, 1.0f, doorColor);
-        }
-        else {
-            DrawCube(Vector3{ door.position.x, DOOR_HEIGHT / 2.0f, door.position.z },
-                0.2f, DOOR_HEIGHT, 1.0f, doorColor);
-        }
+BoundingBox GetDoorBounds(const Door& door) {
+    // Door slab plus the wider frame above it
+    return BoundingBox{
+        Vector3{ door.position.x - 0.15f, 0.0f, door.position.z - 0.6f },
+        Vector3{ door.position.x + 0.15f, DOOR_HEIGHT + 0.2f, door.position.z + 0.6f }
+    };
+}
 
-        // Draw door frame
-        DrawCube(Vector3{ door.position.x, DOOR_HEIGHT + 0.1f, door.position.z },
-            0.3f, 0.2f, 1.2f, Color{ 80, 80, 85, 255 });
-    }
+void DrawDoor(const Door& door) {
+    if (door.isOpen) return;
+    bool visible = IsBoxInView(GetDoorBounds(door));
+    if (g_RenderStats) g_RenderStats->RecordObjects(STAT_PASS_DOORS, visible ? 1 : 0, visible ? 0 : 1);
+    if (visible) DrawDoorGeometry(door);
 }
 
 void UpdateDoors(float deltaTime) {
@@ -541,6 +781,21 @@ Door* GetNearestDoor(Vector3 playerPos, float maxDistance) {
     Door* nearest = nullptr;
     float minDist = maxDistance;
 
+    // Outside, only exterior doors within range are candidates
+    if (!g_MapPlayer.insideInterior && g_MapData.index.IsBuilt()) {
+        static std::vector<SpatialItem> nearby;
+        g_MapData.index.QueryRadius(playerPos, maxDistance, SPATIAL_DOOR, nearby);
+        for (const auto& item : nearby) {
+            Door& door = doors[item.index];
+            float dist = Vector3Distance(playerPos, Vector3{ door.position.x, playerPos.y, door.position.z });
+            if (dist < minDist) {
+                minDist = dist;
+                nearest = &door;
+            }
+        }
+        return nearest;
+    }
+
     for (auto& door : doors) {
         // Calculate door position based on whether player is inside
         Vector3 doorPos = door.position;
@@ -604,6 +859,19 @@ bool CheckWallCollision(Vector3 position, float radius, const MapData& mapData,
         int gridX = (int)floorf(position.x);
         int gridZ = (int)floorf(position.z);
 
+        // Only buildings overlapping the 3x3 neighbourhood can collide
+        static std::vector<const Building*> candidates;
+        candidates.clear();
+        if (mapData.index.IsBuilt()) {
+            static std::vector<SpatialItem> nearby;
+            mapData.index.QueryRegion((float)(gridX - 1), (float)(gridZ - 1), (float)(gridX + 1), (float)(gridZ + 1),
+                SPATIAL_BUILDING, nearby);
+            for (const auto& item : nearby) candidates.push_back(&mapData.buildings[item.index]);
+        }
+        else {
+            for (const auto& building : mapData.buildings) candidates.push_back(&building);
+        }
+
         for (int dz = -1; dz <= 1; dz++) {
             for (int dx = -1; dx <= 1; dx++) {
                 int checkX = gridX + dx;
@@ -613,20 +881,20 @@ bool CheckWallCollision(Vector3 position, float radius, const MapData& mapData,
                     checkZ >= 0 && checkZ < mapData.height) {
 
                     // Check if position is inside a building footprint
-                    for (const auto& building : mapData.buildings) {
-                        bool insideBuilding = checkX >= building.footprint.x &&
-                            checkX < building.footprint.x + building.footprint.w &&
-                            checkZ >= building.footprint.y &&
-                            checkZ < building.footprint.y + building.footprint.h;
+                    for (const Building* building : candidates) {
+                        bool insideBuilding = checkX >= building->footprint.x &&
+                            checkX < building->footprint.x + building->footprint.w &&
+                            checkZ >= building->footprint.y &&
+                            checkZ < building->footprint.y + building->footprint.h;
 
                         if (insideBuilding) {
                             // Only collide with perimeter walls, not entrance
-                            bool isPerimeter = (checkX == building.footprint.x ||
-                                checkX == building.footprint.x + building.footprint.w - 1 ||
-                                checkZ == building.footprint.y ||
-                                checkZ == building.footprint.y + building.footprint.h - 1);
+                            bool isPerimeter = (checkX == building->footprint.x ||
+                                checkX == building->footprint.x + building->footprint.w - 1 ||
+                                checkZ == building->footprint.y ||
+                                checkZ == building->footprint.y + building->footprint.h - 1);
 
-                            bool isEntrance = (checkX == building.entranceX && checkZ == building.entranceY);
+                            bool isEntrance = (checkX == building->entranceX && checkZ == building->entranceY);
 
                             if (isPerimeter && !isEntrance) {
                                 Vector3 tileCenter = Vector3{ (float)checkX + 0.5f, position.y, (float)checkZ + 0.5f };
@@ -681,40 +949,23 @@ void GenerateMap(char map[MAP_SIZE][MAP_SIZE]) {
 void DrawMinimap(char map[MAP_SIZE][MAP_SIZE], Vector3 playerPos, float yaw,
     int minimapX, int minimapY, int minimapW, int minimapH,
     bool largeMap, int screenH) {
+    PROFILE_SCOPE("DrawMinimap");
     DrawRectangle(minimapX, minimapY, minimapW, minimapH, Color{ 0, 0, 0, 180 });
     DrawRectangleLines(minimapX, minimapY, minimapW, minimapH, PIPBOY_GREEN);
 
     int viewRange = largeMap ? 20 : 15;
     float cellSize = (float)minimapW / (viewRange * 2);
 
+    // Tiles come from cached textures: one quad per map, updated only where tiles change
     // Inside building - show interior layout
     if (g_MapPlayer.insideInterior) {
         const Interior* interior = GetInterior(g_MapData, g_MapPlayer.currentInteriorId);
         if (interior) {
             DrawText("INTERIOR", minimapX + 5, minimapY + 5, 12, PIPBOY_GREEN);
 
-            // Draw interior tiles
-            for (int y = 0; y < interior->height; y++) {
-                for (int x = 0; x < interior->width; x++) {
-                    int tile = interior->tiles[y * interior->width + x];
-                    Color col = PIPBOY_DIM;
-
-                    switch (tile) {
-                    case IT_WALL: col = Color{ 90, 90, 90, 255 }; break;
-                    case IT_DOOR: col = Color{ 200, 170, 60, 255 }; break;
-                    case IT_FLOOR: col = Color{ 100, 100, 100, 255 }; break;
-                    case IT_CRYOPOD_BROKEN: col = Color{ 255, 100, 100, 255 }; break;
-                    case IT_CONSOLE: col = Color{ 100, 200, 255, 255 }; break;
-                    }
-
-                    int drawX = minimapX + (int)(x * cellSize);
-                    int drawY = minimapY + 20 + (int)(y * cellSize);
-
-                    if (drawX >= minimapX && drawX < minimapX + minimapW &&
-                        drawY >= minimapY && drawY < minimapY + minimapH) {
-                        DrawRectangle(drawX, drawY, (int)ceilf(cellSize), (int)ceilf(cellSize), col);
-                    }
-                }
+            if (g_MinimapRenderer) {
+                Rectangle bounds = { (float)minimapX, (float)(minimapY + 20), (float)minimapW, (float)(minimapH - 20) };
+                g_MinimapRenderer->DrawInterior(*interior, bounds, cellSize);
             }
 
             // Draw player position in interior
@@ -727,29 +978,9 @@ void DrawMinimap(char map[MAP_SIZE][MAP_SIZE], Vector3 playerPos, float yaw,
     }
     // Outside - show world map
     else {
-        int playerX = (int)playerPos.x;
-        int playerZ = (int)playerPos.z;
-
-        for (int r = -viewRange; r < viewRange; ++r) {
-            for (int c = -viewRange; c < viewRange; ++c) {
-                int worldX = playerX + c;
-                int worldZ = playerZ + r;
-
-                if (worldX < 0 || worldX >= MAP_SIZE || worldZ < 0 || worldZ >= MAP_SIZE) continue;
-
-                Color col = PIPBOY_DIM;
-                switch (map[worldZ][worldX]) {
-                case '~': col = Color{ 30, 60, 120, 255 }; break;
-                case 'B': col = Color{ 100, 100, 120, 255 }; break;
-                case '=': col = Color{ 80, 80, 80, 255 }; break;
-                case '"': col = Color{ 30, 120, 30, 200 }; break;
-                case '.': col = Color{ 90, 90, 95, 255 }; break;
-                }
-
-                int drawX = minimapX + (int)((c + viewRange) * cellSize);
-                int drawY = minimapY + (int)((r + viewRange) * cellSize);
-                DrawRectangle(drawX, drawY, (int)ceilf(cellSize), (int)ceilf(cellSize), col);
-            }
+        if (g_MinimapRenderer) {
+            Rectangle bounds = { (float)minimapX, (float)minimapY, (float)minimapW, (float)minimapH };
+            g_MinimapRenderer->DrawWorld(map, (int)playerPos.x, (int)playerPos.z, bounds, cellSize);
         }
 
         Vector2 centerPos = { minimapX + minimapW / 2.0f, minimapY + minimapH / 2.0f };
@@ -776,9 +1007,7 @@ void DrawMapGeometry(char map[MAP_SIZE][MAP_SIZE]) {
 }
 
 bool IsAABBInFrustum(const Camera3D& camera, const AABB& box) {
-    float distance = Vector3Distance(camera.position,
-        Vector3{ (box.min.x + box.max.x) * 0.5f,
-                (box.min.y + box.max.y) * 0.5f,
-                (box.min.z + box.max.z) * 0.5f });
-    return distance < 100.0f;
+    Frustum frustum;
+    frustum.SetFromCamera(camera, (float)GetScreenWidth() / (float)GetScreenHeight());
+    return frustum.ContainsBox(box.min, box.max);
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include "globals.h"
+#include "spatial_index.h"
 #include <unordered_map>
 
 // Forward declaration
@@ -141,6 +142,7 @@ struct MapData {
     std::vector<Building> buildings;
     bool startInsideInterior;
     std::string startInteriorId;
+    SpatialIndex index;   // Ground chunks, buildings and exterior doors (built by GenerateMapData)
 
     MapData() : width(0), height(0), startInsideInterior(false) {
         tileset = { 0 };
@@ -189,6 +191,7 @@ void DrawMapGeometry(char map[MAP_SIZE][MAP_SIZE]);
 void Draw3DWorld(const MapData& mapData, const MapPlayerState& playerState);
 void Draw3DInterior(const Interior& interior);
 void DrawDoor(const Door& door);
+BoundingBox GetDoorBounds(const Door& door);
 void UpdateDoors(float deltaTime);
 Door* GetNearestDoor(Vector3 playerPos, float maxDistance);
 
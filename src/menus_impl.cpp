@@ -1,7 +1,9 @@
 #include "menus.h"
 #include "fileio.h"
+#include "input.h"
 #include <fstream>
 #include "sound_manager.h"
+#include "shadow_manager.h"
 
 // NEW: Audio Settings Menu
 void DrawAudioSettingsMenu(int screenW, int screenH, int* selection, GameState* nextState) {
@@ -14,14 +16,14 @@ void DrawAudioSettingsMenu(int screenW, int screenH, int* selection, GameState*
     DrawRectangleLines(menuX, menuY, menuW, menuH, PIPBOY_GREEN);
     DrawText("AUDIO SETTINGS", menuX + 20, menuY + 10, 26, PIPBOY_GREEN);
 
-    bool useController = isControllerEnabled && IsGamepadAvailable(0);
+    bool useController = isControllerEnabled && InputIsGamepadAvailable(0);
 
     // Navigation (4 options: master, sfx, music, back)
-    if (IsKeyPressed(KEY_UP) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_UP))) {
+    if (InputIsKeyPressed(KEY_UP) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_UP))) {
         *selection = (*selection - 1 + 4) % 4;
         if (g_SoundManager) g_SoundManager->PlaySound(SND_UI_SELECT, 0.3f);
     }
-    if (IsKeyPressed(KEY_DOWN) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_DOWN))) {
+    if (InputIsKeyPressed(KEY_DOWN) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_DOWN))) {
         *selection = (*selection + 1) % 4;
         if (g_SoundManager) g_SoundManager->PlaySound(SND_UI_SELECT, 0.3f);
     }
@@ -63,8 +65,8 @@ void DrawAudioSettingsMenu(int screenW, int screenH, int* selection, GameState*
         }
 
         // Mouse selection
-        Vector2 mousePos = GetMousePosition();
-        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) &&
+        Vector2 mousePos = InputGetMousePosition();
+        if (InputIsMouseButtonPressed(MOUSE_LEFT_BUTTON) &&
             mousePos.x >= menuX + 20 && mousePos.x <= menuX + menuW - 20 &&
             mousePos.y >= optY && mousePos.y <= optY + 50) {
             *selection = i;
@@ -74,9 +76,9 @@ void DrawAudioSettingsMenu(int screenW, int screenH, int* selection, GameState*
         optY += 55;
     }
 
-    bool leftPressed = IsKeyPressed(KEY_LEFT) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_LEFT));
-    bool rightPressed = IsKeyPressed(KEY_RIGHT) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_RIGHT));
-    bool enterPressed = IsKeyPressed(KEY_ENTER) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_DOWN));
+    bool leftPressed = InputIsKeyPressed(KEY_LEFT) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_LEFT));
+    bool rightPressed = InputIsKeyPressed(KEY_RIGHT) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_RIGHT));
+    bool enterPressed = InputIsKeyPressed(KEY_ENTER) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_DOWN));
 
     if (leftPressed || rightPressed) {
         if (g_SoundManager) g_SoundManager->PlaySound(SND_UI_SELECT, 0.3f);
@@ -139,14 +141,14 @@ void DrawSettingsMenu(int screenW, int screenH, bool* showMinimap, bool* isContr
     DrawRectangleLines(menuX, menuY, menuW, menuH, PIPBOY_GREEN);
     DrawText("SETTINGS", menuX + 20, menuY + 10, 28, PIPBOY_GREEN);
 
-    bool useController = *isControllerEnabled && IsGamepadAvailable(0);
+    bool useController = *isControllerEnabled && InputIsGamepadAvailable(0);
 
     // Navigation (6 options now - removed 3 audio settings, added 1 audio submenu)
-    if (IsKeyPressed(KEY_UP) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_UP))) {
+    if (InputIsKeyPressed(KEY_UP) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_UP))) {
         *settingsSelection = (*settingsSelection - 1 + 6) % 6;
         if (g_SoundManager) g_SoundManager->PlaySound(SND_UI_SELECT, 0.3f);
     }
-    if (IsKeyPressed(KEY_DOWN) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_DOWN))) {
+    if (InputIsKeyPressed(KEY_DOWN) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_DOWN))) {
         *settingsSelection = (*settingsSelection + 1) % 6;
         if (g_SoundManager) g_SoundManager->PlaySound(SND_UI_SELECT, 0.3f);
     }
@@ -172,8 +174,8 @@ void DrawSettingsMenu(int screenW, int screenH, bool* showMinimap, bool* isContr
         DrawRectangleLines(menuX + 20, optY, menuW - 40, 50, (*settingsSelection == i) ? PIPBOY_GREEN : PIPBOY_DIM);
         DrawText(options[i], menuX + 30, optY + 15, 20, fgColor);
 
-        Vector2 mousePos = GetMousePosition();
-        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) &&
+        Vector2 mousePos = InputGetMousePosition();
+        if (InputIsMouseButtonPressed(MOUSE_LEFT_BUTTON) &&
             mousePos.x >= menuX + 20 && mousePos.x <= menuX + menuW - 20 &&
             mousePos.y >= optY && mousePos.y <= optY + 50) {
             *settingsSelection = i;
@@ -183,9 +185,9 @@ void DrawSettingsMenu(int screenW, int screenH, bool* showMinimap, bool* isContr
         optY += 55;
     }
 
-    bool leftPressed = IsKeyPressed(KEY_LEFT) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_LEFT));
-    bool rightPressed = IsKeyPressed(KEY_RIGHT) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_RIGHT));
-    bool enterPressed = IsKeyPressed(KEY_ENTER) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_DOWN));
+    bool leftPressed = InputIsKeyPressed(KEY_LEFT) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_LEFT));
+    bool rightPressed = InputIsKeyPressed(KEY_RIGHT) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_RIGHT));
+    bool enterPressed = InputIsKeyPressed(KEY_ENTER) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_DOWN));
 
     if (leftPressed || rightPressed) {
         if (g_SoundManager) g_SoundManager->PlaySound(SND_UI_SELECT, 0.3f);
@@ -248,7 +250,7 @@ void DrawSettingsMenu(int screenW, int screenH, bool* showMinimap, bool* isContr
 // Graphics settings menu (unchanged, included for completeness)
 void DrawGraphicsSettingsMenu(int screenW, int screenH, GraphicsSettings* settings, int* selection, GameState* nextState) {
     int menuW = 800;
-    int menuH = 700;
+    int menuH = 720;
     int menuX = (screenW - menuW) / 2;
     int menuY = (screenH - menuH) / 2;
 
@@ -256,14 +258,14 @@ void DrawGraphicsSettingsMenu(int screenW, int screenH, GraphicsSettings* settin
     DrawRectangleLines(menuX, menuY, menuW, menuH, PIPBOY_GREEN);
     DrawText("GRAPHICS SETTINGS", menuX + 20, menuY + 10, 26, PIPBOY_GREEN);
 
-    bool useController = isControllerEnabled && IsGamepadAvailable(0);
+    bool useController = isControllerEnabled && InputIsGamepadAvailable(0);
 
-    if (IsKeyPressed(KEY_UP) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_UP))) {
-        *selection = (*selection - 1 + 11) % 11;
+    if (InputIsKeyPressed(KEY_UP) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_UP))) {
+        *selection = (*selection - 1 + 12) % 12;
         if (g_SoundManager) g_SoundManager->PlaySound(SND_UI_SELECT, 0.3f);
     }
-    if (IsKeyPressed(KEY_DOWN) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_DOWN))) {
-        *selection = (*selection + 1) % 11;
+    if (InputIsKeyPressed(KEY_DOWN) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_DOWN))) {
+        *selection = (*selection + 1) % 12;
         if (g_SoundManager) g_SoundManager->PlaySound(SND_UI_SELECT, 0.3f);
     }
 
@@ -277,6 +279,11 @@ void DrawGraphicsSettingsMenu(int screenW, int screenH, GraphicsSettings* settin
     int optY = menuY + 90;
     const char* msaaLabels[] = { "OFF", "2x", "4x", "8x" };
     int msaaIndex = settings->msaa ? (settings->msaaSamples == 2 ? 1 : settings->msaaSamples == 4 ? 2 : 3) : 0;
+    const char* shadowLabels[SHADOW_PCF_KERNEL_COUNT] = { "OFF", "Hard", "PCF 3x3", "PCF 5x5", "PCF 7x7" };
+    int shadowIndex = 0;
+    for (int k = 0; k < SHADOW_PCF_KERNEL_COUNT; k++) {
+        if (SHADOW_PCF_KERNELS[k] == settings->shadowPcfKernel) shadowIndex = k;
+    }
 
     std::vector<std::string> optionLabels = {
         TextFormat("Resolution: %s", AVAILABLE_RESOLUTIONS[settings->resolutionIndex].label),
@@ -288,32 +295,33 @@ void DrawGraphicsSettingsMenu(int screenW, int screenH, GraphicsSettings* settin
         TextFormat("LOD System: %s", settings->enableLOD ? "ON" : "OFF"),
         TextFormat("Frustum Culling: %s", settings->enableFrustumCulling ? "ON" : "OFF"),
         TextFormat("Max Draw Calls: %d", settings->maxDrawCalls),
+        TextFormat("Shadows: %s", shadowLabels[shadowIndex]),
         "Apply Changes",
         "Back"
     };
 
-    for (int i = 0; i < 11; i++) {
+    for (int i = 0; i < 12; i++) {
         Color bgColor = (*selection == i) ? PIPBOY_SELECTED : PIPBOY_DARK;
         Color fgColor = (*selection == i) ? PIPBOY_GREEN : PIPBOY_DIM;
 
-        DrawRectangle(menuX + 20, optY, menuW - 40, 45, bgColor);
-        DrawRectangleLines(menuX + 20, optY, menuW - 40, 45, (*selection == i) ? PIPBOY_GREEN : PIPBOY_DIM);
-        DrawText(optionLabels[i].c_str(), menuX + 30, optY + 12, 18, fgColor);
+        DrawRectangle(menuX + 20, optY, menuW - 40, 40, bgColor);
+        DrawRectangleLines(menuX + 20, optY, menuW - 40, 40, (*selection == i) ? PIPBOY_GREEN : PIPBOY_DIM);
+        DrawText(optionLabels[i].c_str(), menuX + 30, optY + 10, 18, fgColor);
 
-        Vector2 mousePos = GetMousePosition();
-        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) &&
+        Vector2 mousePos = InputGetMousePosition();
+        if (InputIsMouseButtonPressed(MOUSE_LEFT_BUTTON) &&
             mousePos.x >= menuX + 20 && mousePos.x <= menuX + menuW - 20 &&
-            mousePos.y >= optY && mousePos.y <= optY + 45) {
+            mousePos.y >= optY && mousePos.y <= optY + 40) {
             *selection = i;
             if (g_SoundManager) g_SoundManager->PlaySound(SND_UI_SELECT, 0.5f);
         }
 
-        optY += 50;
+        optY += 46;
     }
 
-    bool leftPressed = IsKeyPressed(KEY_LEFT) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_LEFT));
-    bool rightPressed = IsKeyPressed(KEY_RIGHT) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_RIGHT));
-    bool enterPressed = IsKeyPressed(KEY_ENTER) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_DOWN));
+    bool leftPressed = InputIsKeyPressed(KEY_LEFT) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_LEFT));
+    bool rightPressed = InputIsKeyPressed(KEY_RIGHT) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_RIGHT));
+    bool enterPressed = InputIsKeyPressed(KEY_ENTER) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_DOWN));
 
     if (leftPressed || rightPressed) {
         if (g_SoundManager) g_SoundManager->PlaySound(SND_UI_SELECT, 0.3f);
@@ -370,6 +378,11 @@ void DrawGraphicsSettingsMenu(int screenW, int screenH, GraphicsSettings* settin
         if (rightPressed && settings->maxDrawCalls < 5000) settings->maxDrawCalls += 100;
         break;
     case 9:
+        if (leftPressed) shadowIndex = (shadowIndex - 1 + SHADOW_PCF_KERNEL_COUNT) % SHADOW_PCF_KERNEL_COUNT;
+        if (rightPressed) shadowIndex = (shadowIndex + 1) % SHADOW_PCF_KERNEL_COUNT;
+        settings->shadowPcfKernel = SHADOW_PCF_KERNELS[shadowIndex];
+        break;
+    case 10:
         if (enterPressed) {
             ApplyGraphicsSettings(*settings);
             SaveGraphicsSettings(*settings);
@@ -377,7 +390,7 @@ void DrawGraphicsSettingsMenu(int screenW, int screenH, GraphicsSettings* settin
             TraceLog(LOG_INFO, "Graphics settings applied and saved");
         }
         break;
-    case 10:
+    case 11:
         if (enterPressed) {
             if (g_SoundManager) g_SoundManager->PlaySound(SND_UI_BACK, 0.5f);
             *nextState = GameState::Settings;
@@ -405,6 +418,7 @@ void SaveGraphicsSettings(const GraphicsSettings& settings) {
         file << "max_draw_calls " << settings.maxDrawCalls << "\n";
         file << "upscaling_mode " << settings.upscalingMode << "\n";
         file << "upscaling_quality " << settings.upscalingQuality << "\n";
+        file << "shadow_pcf_kernel " << settings.shadowPcfKernel << "\n";
         file.close();
         TraceLog(LOG_INFO, "Graphics settings saved");
     }
@@ -426,6 +440,7 @@ void LoadGraphicsSettings(GraphicsSettings* settings) {
             else if (key == "max_draw_calls") file >> settings->maxDrawCalls;
             else if (key == "upscaling_mode") { int v; file >> v; settings->upscalingMode = (UpscalingMode)v; }
             else if (key == "upscaling_quality") { int v; file >> v; settings->upscalingQuality = (UpscalingQuality)v; }
+            else if (key == "shadow_pcf_kernel") file >> settings->shadowPcfKernel;
         }
         file.close();
         TraceLog(LOG_INFO, "Graphics settings loaded");
@@ -444,6 +459,7 @@ void LoadGraphicsSettings(GraphicsSettings* settings) {
         settings->maxDrawCalls = 1000;
         settings->upscalingMode = UPSCALING_NONE;
         settings->upscalingQuality = UPSCALE_QUALITY_QUALITY;
+        settings->shadowPcfKernel = 3;
     }
 }
 
@@ -489,12 +505,12 @@ void DrawLoadMenu(int screenW, int screenH, int* selectedSlot, GameState current
     DrawText(title, menuX + 20, menuY + 10, 28, PIPBOY_GREEN);
 
     // Navigation
-    bool useController = isControllerEnabled && IsGamepadAvailable(0);
-    if (IsKeyPressed(KEY_UP) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_UP))) {
+    bool useController = isControllerEnabled && InputIsGamepadAvailable(0);
+    if (InputIsKeyPressed(KEY_UP) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_UP))) {
         *selectedSlot = (*selectedSlot - 1 + MAX_SAVE_SLOTS) % MAX_SAVE_SLOTS;
         if (g_SoundManager) g_SoundManager->PlaySound(SND_UI_SELECT, 0.3f);
     }
-    if (IsKeyPressed(KEY_DOWN) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_DOWN))) {
+    if (InputIsKeyPressed(KEY_DOWN) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_DOWN))) {
         *selectedSlot = (*selectedSlot + 1) % MAX_SAVE_SLOTS;
         if (g_SoundManager) g_SoundManager->PlaySound(SND_UI_SELECT, 0.3f);
     }
@@ -518,8 +534,8 @@ void DrawLoadMenu(int screenW, int screenH, int* selectedSlot, GameState current
         }
 
         // Mouse selection
-        Vector2 mousePos = GetMousePosition();
-        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) &&
+        Vector2 mousePos = InputGetMousePosition();
+        if (InputIsMouseButtonPressed(MOUSE_LEFT_BUTTON) &&
             mousePos.x >= menuX + 20 && mousePos.x <= menuX + menuW - 20 &&
             mousePos.y >= slotY && mousePos.y <= slotY + 60) {
             *selectedSlot = i;
@@ -558,9 +574,9 @@ void DrawControllerBindings(int screenW, int screenH, int* activeBindingIndex, b
         DrawText("Press ESC to cancel", screenW / 2 - 100, screenH / 2 + 10, 16, PIPBOY_DIM);
 
         // Check for button press
-        if (IsGamepadAvailable(0)) {
+        if (InputIsGamepadAvailable(0)) {
             for (int btn = 0; btn < GAMEPAD_BUTTON_COUNT; btn++) {
-                if (IsGamepadButtonPressed(0, btn)) {
+                if (InputIsGamepadButtonPressed(0, btn)) {
                     currentBindings[*activeBindingIndex].isAxis = false;
                     currentBindings[*activeBindingIndex].inputId = btn;
                     currentBindings[*activeBindingIndex].threshold = 0.0f;
@@ -572,7 +588,7 @@ void DrawControllerBindings(int screenW, int screenH, int* activeBindingIndex, b
             }
         }
 
-        if (IsKeyPressed(KEY_ESCAPE)) {
+        if (InputIsKeyPressed(KEY_ESCAPE)) {
             *isBindingMode = false;
             *activeBindingIndex = -1;
             if (g_SoundManager) g_SoundManager->PlaySound(SND_UI_BACK, 0.5f);
@@ -581,14 +597,14 @@ void DrawControllerBindings(int screenW, int screenH, int* activeBindingIndex, b
         return;
     }
 
-    bool useController = isControllerEnabled && IsGamepadAvailable(0);
+    bool useController = isControllerEnabled && InputIsGamepadAvailable(0);
 
     // Navigation
-    if (IsKeyPressed(KEY_UP) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_UP))) {
+    if (InputIsKeyPressed(KEY_UP) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_UP))) {
         *controllerSettingsSelection = (*controllerSettingsSelection - 1 + ACTION_COUNT) % ACTION_COUNT;
         if (g_SoundManager) g_SoundManager->PlaySound(SND_UI_SELECT, 0.3f);
     }
-    if (IsKeyPressed(KEY_DOWN) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_DOWN))) {
+    if (InputIsKeyPressed(KEY_DOWN) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_DOWN))) {
         *controllerSettingsSelection = (*controllerSettingsSelection + 1) % ACTION_COUNT;
         if (g_SoundManager) g_SoundManager->PlaySound(SND_UI_SELECT, 0.3f);
     }
@@ -616,8 +632,8 @@ void DrawControllerBindings(int screenW, int screenH, int* activeBindingIndex, b
         DrawText(bindingText, menuX + 300, bindY + 13, 18, fgColor);
 
         // Mouse selection
-        Vector2 mousePos = GetMousePosition();
-        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) &&
+        Vector2 mousePos = InputGetMousePosition();
+        if (InputIsMouseButtonPressed(MOUSE_LEFT_BUTTON) &&
             mousePos.x >= menuX + 20 && mousePos.x <= menuX + menuW - 20 &&
             mousePos.y >= bindY && mousePos.y <= bindY + 45) {
             *controllerSettingsSelection = i;
@@ -627,7 +643,7 @@ void DrawControllerBindings(int screenW, int screenH, int* activeBindingIndex, b
     }
 
     // Handle rebinding
-    if (IsKeyPressed(KEY_ENTER) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_DOWN))) {
+    if (InputIsKeyPressed(KEY_ENTER) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_DOWN))) {
         *isBindingMode = true;
         *activeBindingIndex = *controllerSettingsSelection;
     }
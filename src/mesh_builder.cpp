@@ -0,0 +1,139 @@
+#include "mesh_builder.h"
+#include <cstring>
+
+MeshBuilder::MeshBuilder() {
+    currentLayer = -1.0f;
+    useLayers = false;
+}
+
+void MeshBuilder::Clear() {
+    vertices.clear();
+    texcoords.clear();
+    normals.clear();
+    colors.clear();
+    layers.clear();
+    currentLayer = -1.0f;
+    useLayers = false;
+}
+
+void MeshBuilder::SetLayer(int layer) {
+    currentLayer = (float)layer;
+    useLayers = true;
+}
+
+void MeshBuilder::PushVertex(Vector3 p, Vector3 n, Vector2 uv, Color color) {
+    vertices.push_back(p.x);
+    vertices.push_back(p.y);
+    vertices.push_back(p.z);
+    normals.push_back(n.x);
+    normals.push_back(n.y);
+    normals.push_back(n.z);
+    texcoords.push_back(uv.x);
+    texcoords.push_back(uv.y);
+    colors.push_back(color.r);
+    colors.push_back(color.g);
+    colors.push_back(color.b);
+    colors.push_back(color.a);
+    layers.push_back(currentLayer);
+    layers.push_back(0.0f);
+}
+
+void MeshBuilder::AddQuad(Vector3 a, Vector3 b, Vector3 c, Vector3 d, Vector3 normal,
+    Vector2 uvMin, Vector2 uvMax, Color color) {
+    Vector2 uvA = { uvMin.x, uvMin.y };
+    Vector2 uvB = { uvMax.x, uvMin.y };
+    Vector2 uvC = { uvMax.x, uvMax.y };
+    Vector2 uvD = { uvMin.x, uvMax.y };
+
+    // Two counter-clockwise triangles: a-b-c, a-c-d
+    PushVertex(a, normal, uvA, color);
+    PushVertex(b, normal, uvB, color);
+    PushVertex(c, normal, uvC, color);
+
+    PushVertex(a, normal, uvA, color);
+    PushVertex(c, normal, uvC, color);
+    PushVertex(d, normal, uvD, color);
+}
+
+void MeshBuilder::AddBox(Vector3 center, Vector3 size, Vector2 uvPerUnit, Color color, int faces) {
+    float x0 = center.x - size.x / 2, x1 = center.x + size.x / 2;
+    float y0 = center.y - size.y / 2, y1 = center.y + size.y / 2;
+    float z0 = center.z - size.z / 2, z1 = center.z + size.z / 2;
+
+    // Same face winding and UV orientation as DrawCubeTexture
+    Vector2 uvZero = { 0.0f, 0.0f };
+    Vector2 uvFront = { size.x * uvPerUnit.x, size.y * uvPerUnit.y };
+    Vector2 uvSide = { size.z * uvPerUnit.x, size.y * uvPerUnit.y };
+    Vector2 uvCap = { size.x * uvPerUnit.x, size.z * uvPerUnit.x };
+
+    if (faces & BOX_FACE_FRONT) {
+        AddQuad(Vector3{ x0, y0, z1 }, Vector3{ x1, y0, z1 }, Vector3{ x1, y1, z1 }, Vector3{ x0, y1, z1 },
+            Vector3{ 0.0f, 0.0f, 1.0f }, uvZero, uvFront, color);
+    }
+    if (faces & BOX_FACE_BACK) {
+        AddQuad(Vector3{ x1, y0, z0 }, Vector3{ x0, y0, z0 }, Vector3{ x0, y1, z0 }, Vector3{ x1, y1, z0 },
+            Vector3{ 0.0f, 0.0f, -1.0f }, uvZero, uvFront, color);
+    }
+    if (faces & BOX_FACE_TOP) {
+        AddQuad(Vector3{ x0, y1, z1 }, Vector3{ x1, y1, z1 }, Vector3{ x1, y1, z0 }, Vector3{ x0, y1, z0 },
+            Vector3{ 0.0f, 1.0f, 0.0f }, uvZero, uvCap, color);
+    }
+    if (faces & BOX_FACE_BOTTOM) {
+        AddQuad(Vector3{ x0, y0, z0 }, Vector3{ x1, y0, z0 }, Vector3{ x1, y0, z1 }, Vector3{ x0, y0, z1 },
+            Vector3{ 0.0f, -1.0f, 0.0f }, uvZero, uvCap, color);
+    }
+    if (faces & BOX_FACE_RIGHT) {
+        AddQuad(Vector3{ x1, y0, z1 }, Vector3{ x1, y0, z0 }, Vector3{ x1, y1, z0 }, Vector3{ x1, y1, z1 },
+            Vector3{ 1.0f, 0.0f, 0.0f }, uvZero, uvSide, color);
+    }
+    if (faces & BOX_FACE_LEFT) {
+        AddQuad(Vector3{ x0, y0, z0 }, Vector3{ x0, y0, z1 }, Vector3{ x0, y1, z1 }, Vector3{ x0, y1, z0 },
+            Vector3{ -1.0f, 0.0f, 0.0f }, uvZero, uvSide, color);
+    }
+}
+
+Mesh MeshBuilder::Build() const {
+    Mesh mesh = { 0 };
+    if (vertices.empty()) return mesh;
+
+    mesh.vertexCount = GetVertexCount();
+    mesh.triangleCount = mesh.vertexCount / 3;
+
+    // raylib frees these with RL_FREE in UnloadMesh
+    mesh.vertices = (float*)RL_MALLOC(vertices.size() * sizeof(float));
+    mesh.texcoords = (float*)RL_MALLOC(texcoords.size() * sizeof(float));
+    mesh.normals = (float*)RL_MALLOC(normals.size() * sizeof(float));
+    mesh.colors = (unsigned char*)RL_MALLOC(colors.size() * sizeof(unsigned char));
+
+    memcpy(mesh.vertices, vertices.data(), vertices.size() * sizeof(float));
+    memcpy(mesh.texcoords, texcoords.data(), texcoords.size() * sizeof(float));
+    memcpy(mesh.normals, normals.data(), normals.size() * sizeof(float));
+    memcpy(mesh.colors, colors.data(), colors.size() * sizeof(unsigned char));
+
+    if (useLayers) {
+        mesh.texcoords2 = (float*)RL_MALLOC(layers.size() * sizeof(float));
+        memcpy(mesh.texcoords2, layers.data(), layers.size() * sizeof(float));
+    }
+
+    UploadMesh(&mesh, false);
+    return mesh;
+}
+
+Model LoadModelFromMeshes(const Mesh* meshes, int meshCount) {
+    Model model = { 0 };
+    if (meshCount <= 0) return model;
+
+    model.transform = MatrixIdentity();
+    model.meshCount = meshCount;
+    model.materialCount = meshCount;
+    model.meshes = (Mesh*)RL_CALLOC(meshCount, sizeof(Mesh));
+    model.materials = (Material*)RL_CALLOC(meshCount, sizeof(Material));
+    model.meshMaterial = (int*)RL_CALLOC(meshCount, sizeof(int));
+
+    for (int i = 0; i < meshCount; i++) {
+        model.meshes[i] = meshes[i];
+        model.materials[i] = LoadMaterialDefault();
+        model.meshMaterial[i] = i;
+    }
+    return model;
+}
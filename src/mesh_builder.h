@@ -0,0 +1,61 @@
+#pragma once
+#include "globals.h"
+#include <vector>
+
+// Box face flags for MeshBuilder::AddBox
+enum BoxFace {
+    BOX_FACE_FRONT = 1 << 0,   // +Z
+    BOX_FACE_BACK = 1 << 1,    // -Z
+    BOX_FACE_TOP = 1 << 2,     // +Y
+    BOX_FACE_BOTTOM = 1 << 3,  // -Y
+    BOX_FACE_RIGHT = 1 << 4,   // +X
+    BOX_FACE_LEFT = 1 << 5,    // -X
+    BOX_FACE_ALL = 0x3F
+};
+
+// Accumulates triangles on the CPU and uploads them as a single static Mesh.
+// Geometry is non-indexed so large batches are not limited by 16-bit indices.
+class MeshBuilder {
+public:
+    MeshBuilder();
+
+    // Add a quad; corners must be counter-clockwise when viewed from the front
+    void AddQuad(Vector3 a, Vector3 b, Vector3 c, Vector3 d, Vector3 normal,
+        Vector2 uvMin, Vector2 uvMax, Color color = WHITE);
+
+    // Add an axis-aligned box. uvPerUnit sets texture repeats per world unit
+    // (x = horizontal, y = vertical) so long walls tile instead of stretching.
+    void AddBox(Vector3 center, Vector3 size, Vector2 uvPerUnit,
+        Color color = WHITE, int faces = BOX_FACE_ALL);
+
+    // Surface texture layer written to texcoords2.x for following geometry
+    // (-1 = untextured). Meshes only get texcoords2 once a layer has been set.
+    void SetLayer(int layer);
+
+    // Number of vertices currently accumulated
+    int GetVertexCount() const { return (int)(vertices.size() / 3); }
+
+    bool IsEmpty() const { return vertices.empty(); }
+
+    // Discard accumulated geometry
+    void Clear();
+
+    // Copy the geometry into a Mesh and upload it to the GPU.
+    // The caller owns the result and must release it with UnloadMesh/UnloadModel.
+    Mesh Build() const;
+
+private:
+    std::vector<float> vertices;
+    std::vector<float> texcoords;
+    std::vector<float> normals;
+    std::vector<unsigned char> colors;
+    std::vector<float> layers;
+    float currentLayer;
+    bool useLayers;
+
+    void PushVertex(Vector3 p, Vector3 n, Vector2 uv, Color color);
+};
+
+// Wrap already-built meshes in a Model with one default material per mesh.
+// Material i is used by mesh i; the caller assigns textures afterwards.
+Model LoadModelFromMeshes(const Mesh* meshes, int meshCount);
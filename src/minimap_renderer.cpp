@@ -0,0 +1,177 @@
+#include "minimap_renderer.h"
+#include "profiler.h"
+#include <cmath>
+
+// Global instance
+MinimapRenderer* g_MinimapRenderer = nullptr;
+
+// Legacy world map characters (see GenerateMap)
+static Color WorldTileColor(int tile) {
+    switch (tile) {
+    case '~': return Color{ 30, 60, 120, 255 };
+    case 'B': return Color{ 100, 100, 120, 255 };
+    case '=': return Color{ 80, 80, 80, 255 };
+    case '"': return Color{ 30, 120, 30, 200 };
+    case '.': return Color{ 90, 90, 95, 255 };
+    default: return PIPBOY_DIM;
+    }
+}
+
+static Color InteriorTileColor(int tile) {
+    switch (tile) {
+    case IT_WALL: return Color{ 90, 90, 90, 255 };
+    case IT_DOOR: return Color{ 200, 170, 60, 255 };
+    case IT_FLOOR: return Color{ 100, 100, 100, 255 };
+    case IT_CRYOPOD_BROKEN: return Color{ 255, 100, 100, 255 };
+    case IT_CONSOLE: return Color{ 100, 200, 255, 255 };
+    default: return PIPBOY_DIM;
+    }
+}
+
+MinimapRenderer::MinimapRenderer() {
+    stats = { 0, 0 };
+}
+
+MinimapRenderer::~MinimapRenderer() {
+    Unload();
+}
+
+template <typename TileT>
+void MinimapRenderer::Sync(TileLayer& layer, const TileT* tiles, int width, int height, Color (*colorOf)(int)) {
+    if (width <= 0 || height <= 0) return;
+
+    // First use or a different size: rasterize everything
+    if (layer.texture.id == 0 || layer.width != width || layer.height != height) {
+        UnloadLayer(layer);
+        layer.width = width;
+        layer.height = height;
+        layer.tiles.resize(width * height);
+        std::vector<Color> pixels(width * height);
+        for (int i = 0; i < width * height; i++) {
+            layer.tiles[i] = (int)tiles[i];
+            pixels[i] = colorOf(layer.tiles[i]);
+        }
+
+        Image image = { pixels.data(), width, height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+        layer.texture = LoadTextureFromImage(image);
+        SetTextureFilter(layer.texture, TEXTURE_FILTER_POINT);
+        SetTextureWrap(layer.texture, TEXTURE_WRAP_CLAMP);
+
+        stats.uploads++;
+        stats.uploadedTexels += width * height;
+        return;
+    }
+
+    // Bounding rectangle of the tiles that changed since the last upload
+    int minX = width, minY = height, maxX = -1, maxY = -1;
+    for (int y = 0; y < height; y++) {
+        const TileT* row = tiles + y * width;
+        const int* cached = &layer.tiles[y * width];
+        for (int x = 0; x < width; x++) {
+            if ((int)row[x] == cached[x]) continue;
+            if (x < minX) minX = x;
+            if (x > maxX) maxX = x;
+            if (y < minY) minY = y;
+            if (y > maxY) maxY = y;
+        }
+    }
+    if (maxX < 0) return;
+
+    int rectW = maxX - minX + 1;
+    int rectH = maxY - minY + 1;
+    std::vector<Color> pixels(rectW * rectH);
+    for (int y = 0; y < rectH; y++) {
+        for (int x = 0; x < rectW; x++) {
+            int index = (minY + y) * width + (minX + x);
+            layer.tiles[index] = (int)tiles[index];
+            pixels[y * rectW + x] = colorOf(layer.tiles[index]);
+        }
+    }
+    UpdateTextureRec(layer.texture, Rectangle{ (float)minX, (float)minY, (float)rectW, (float)rectH }, pixels.data());
+
+    stats.uploads++;
+    stats.uploadedTexels += rectW * rectH;
+}
+
+void MinimapRenderer::DrawWindow(const TileLayer& layer, Rectangle source, Rectangle bounds, float cellSize) {
+    if (layer.texture.id == 0 || cellSize <= 0.0f) return;
+
+    // Clip the window to the layer; tiles outside it stay background
+    float x0 = fmaxf(source.x, 0.0f);
+    float y0 = fmaxf(source.y, 0.0f);
+    float x1 = fminf(source.x + source.width, (float)layer.width);
+    float y1 = fminf(source.y + source.height, (float)layer.height);
+    if (x1 <= x0 || y1 <= y0) return;
+
+    Rectangle dest = {
+        bounds.x + (x0 - source.x) * cellSize,
+        bounds.y + (y0 - source.y) * cellSize,
+        (x1 - x0) * cellSize,
+        (y1 - y0) * cellSize
+    };
+    DrawTexturePro(layer.texture, Rectangle{ x0, y0, x1 - x0, y1 - y0 }, dest, Vector2{ 0, 0 }, 0.0f, WHITE);
+}
+
+void MinimapRenderer::DrawWorld(char map[MAP_SIZE][MAP_SIZE], int centerX, int centerZ, Rectangle bounds, float cellSize) {
+    PROFILE_SCOPE("MinimapWorld");
+    Sync(world, &map[0][0], MAP_SIZE, MAP_SIZE, WorldTileColor);
+
+    int cols = (int)(bounds.width / cellSize);
+    int rows = (int)(bounds.height / cellSize);
+    Rectangle source = { (float)(centerX - cols / 2), (float)(centerZ - rows / 2), (float)cols, (float)rows };
+    DrawWindow(world, source, bounds, cellSize);
+}
+
+void MinimapRenderer::DrawInterior(const Interior& interior, Rectangle bounds, float cellSize) {
+    PROFILE_SCOPE("MinimapInterior");
+    if ((int)interior.tiles.size() < interior.width * interior.height) return;
+
+    TileLayer& layer = interiors[interior.id];
+    Sync(layer, interior.tiles.data(), interior.width, interior.height, InteriorTileColor);
+
+    int cols = (int)(bounds.width / cellSize);
+    int rows = (int)(bounds.height / cellSize);
+    DrawWindow(layer, Rectangle{ 0, 0, (float)cols, (float)rows }, bounds, cellSize);
+}
+
+void MinimapRenderer::Invalidate() {
+    for (auto& entry : interiors) UnloadLayer(entry.second);
+    interiors.clear();
+}
+
+void MinimapRenderer::AppendReport(std::vector<std::string>& lines) const {
+    lines.push_back(TextFormat("Minimap: world %dx%d, %d cached interiors",
+        world.width, world.height, (int)interiors.size()));
+    lines.push_back(TextFormat("Tile uploads: %d (%d texels)", stats.uploads, stats.uploadedTexels));
+}
+
+void MinimapRenderer::UnloadLayer(TileLayer& layer) {
+    if (layer.texture.id > 0) UnloadTexture(layer.texture);
+    layer.texture = { 0 };
+    layer.width = 0;
+    layer.height = 0;
+    layer.tiles.clear();
+}
+
+void MinimapRenderer::Unload() {
+    UnloadLayer(world);
+    Invalidate();
+}
+
+// =============================================================================
+// GLOBAL INITIALIZATION
+// =============================================================================
+
+void InitializeMinimapSystem() {
+    if (!g_MinimapRenderer) {
+        g_MinimapRenderer = new MinimapRenderer();
+        TraceLog(LOG_INFO, "Minimap renderer initialized");
+    }
+}
+
+void CleanupMinimapSystem() {
+    if (g_MinimapRenderer) {
+        delete g_MinimapRenderer;
+        g_MinimapRenderer = nullptr;
+    }
+}
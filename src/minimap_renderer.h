@@ -0,0 +1,72 @@
+#pragma once
+#include "globals.h"
+#include "map.h"
+#include <map>
+#include <vector>
+#include <string>
+
+// Tile texture upload counters
+struct MinimapStats {
+    int uploads;            // UpdateTexture(Rec) calls since start
+    int uploadedTexels;
+};
+
+// Minimap renderer class
+// Keeps the world map and each interior as a texture with one texel per tile,
+// so the minimap and the map screen are one textured quad (a window around the
+// player) plus markers. Before drawing, the tiles are compared with the copy
+// the texture was made from and only the rectangle around changed tiles is
+// re-uploaded; interiors are rasterized the first time they are shown.
+class MinimapRenderer {
+public:
+    MinimapRenderer();
+    ~MinimapRenderer();
+
+    // Draw the world tiles around (centerX, centerZ), cellSize pixels per tile, clipped to bounds
+    void DrawWorld(char map[MAP_SIZE][MAP_SIZE], int centerX, int centerZ, Rectangle bounds, float cellSize);
+
+    // Draw a whole interior from the top-left of bounds, clipped to bounds
+    void DrawInterior(const Interior& interior, Rectangle bounds, float cellSize);
+
+    // Drop cached interiors (new map)
+    void Invalidate();
+
+    const MinimapStats& GetStats() const { return stats; }
+
+    // Console report
+    void AppendReport(std::vector<std::string>& lines) const;
+
+    void Unload();
+
+private:
+    struct TileLayer {
+        TileLayer() : texture(), width(0), height(0) {}
+
+        Texture2D texture;
+        int width;
+        int height;
+        std::vector<int> tiles;    // Tiles the texture currently shows
+    };
+
+    TileLayer world;
+    std::map<std::string, TileLayer> interiors;
+    MinimapStats stats;
+
+    // Bring a layer's texture up to date with the given tiles
+    template <typename TileT>
+    void Sync(TileLayer& layer, const TileT* tiles, int width, int height, Color (*colorOf)(int));
+
+    // Draw a tile-space window of a layer; parts outside the layer are left empty
+    void DrawWindow(const TileLayer& layer, Rectangle source, Rectangle bounds, float cellSize);
+
+    void UnloadLayer(TileLayer& layer);
+};
+
+// Global minimap renderer instance
+extern MinimapRenderer* g_MinimapRenderer;
+
+// Initialize minimap renderer
+void InitializeMinimapSystem();
+
+// Cleanup minimap renderer
+void CleanupMinimapSystem();
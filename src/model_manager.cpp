@@ -1,6 +1,10 @@
 #include "model_manager.h"
 #include "texture_manager.h"
+#include "render_queue.h"
+#include "mesh_builder.h"
+#include "profiler.h"
 #include "rlgl.h"
+#include <vector>
 
 // Global instance
 ModelManager* g_ModelManager = nullptr;
@@ -22,6 +26,15 @@ static const char* MODEL_PATHS[MODEL_COUNT] = {
 // Auto-calculated scales - models will be sized to fit in a 0.15 unit cube
 static const float TARGET_SIZE = 0.15f;
 
+// Simplification grid (cells along the longest axis) for each LOD level
+static const int MODEL_LOD_RESOLUTION[MAX_LOD_LEVELS - 1] = { 12, 6, 3 };
+
+// A level is only kept if it drops at least this share of the previous level's triangles
+static const float MODEL_LOD_MIN_REDUCTION = 0.25f;
+
+// Switch distances in multiples of the model's scaled size
+static const float MODEL_LOD_DISTANCE[MAX_LOD_LEVELS - 1] = { 40.0f, 100.0f, 200.0f };
+
 ModelManager::ModelManager() {
     fallbackModel = { 0 };
 }
@@ -31,6 +44,7 @@ ModelManager::~ModelManager() {
 }
 
 void ModelManager::Initialize() {
+    PROFILE_SCOPE("LoadModels");
     TraceLog(LOG_INFO, "Initializing Model Manager...");
 
     // Create fallback model first
@@ -53,6 +67,9 @@ void ModelManager::Initialize() {
             data.offset = Vector3{ 0.0f, 0.0f, 0.0f };
             data.rotation = Vector3{ 0.0f, 0.0f, 0.0f };
             data.filename = MODEL_PATHS[i];
+            data.lodCount = 0;
+            data.lodBands.count = 0;
+            data.lodsBuilt = false;
             models[id] = data;
         }
     }
@@ -98,6 +115,9 @@ bool ModelManager::LoadModelFile(ModelID id, const char* filename) {
             data.offset = Vector3{ 0.0f, 0.0f, 0.0f };
             data.rotation = Vector3{ 0.0f, 0.0f, 0.0f };
             data.filename = filename;
+            data.lodCount = 0;
+            data.lodBands.count = 0;
+            data.lodsBuilt = false;
 
             models[id] = data;
             TraceLog(LOG_INFO, "Loaded model: %s (auto-scaled to %.3f)",
@@ -226,6 +246,81 @@ Model ModelManager::CreateProceduralModel(ModelID id) {
     return model;
 }
 
+void ModelManager::BuildModelLods(ModelData& data) {
+    data.lodsBuilt = true;
+    data.lodCount = 0;
+    data.lodBands.count = 0;
+
+    const Model& source = data.model;
+    if (source.meshCount == 0) return;
+
+    int previousTriangles = 0;
+    for (int m = 0; m < source.meshCount; m++) previousTriangles += source.meshes[m].triangleCount;
+
+    for (int level = 0; level < MAX_LOD_LEVELS - 1; level++) {
+        std::vector<Mesh> meshes;
+        int triangles = 0;
+        bool collapsed = false;
+        for (int m = 0; m < source.meshCount; m++) {
+            Mesh reduced = SimplifyMesh(source.meshes[m], MODEL_LOD_RESOLUTION[level]);
+            if (reduced.vertexCount == 0) collapsed = true;
+            meshes.push_back(reduced);
+            triangles += reduced.triangleCount;
+        }
+
+        // Stop once a part vanishes or simplification no longer pays off
+        // (already low-poly, e.g. the procedural cubes)
+        if (collapsed || triangles > previousTriangles * (1.0f - MODEL_LOD_MIN_REDUCTION)) {
+            for (auto& mesh : meshes) {
+                if (mesh.vertexCount > 0) UnloadMesh(mesh);
+            }
+            break;
+        }
+
+        Model lod = LoadModelFromMeshes(meshes.data(), (int)meshes.size());
+        lod.transform = source.transform;
+        for (int m = 0; m < source.meshCount; m++) {
+            const Material& material = source.materials[source.meshMaterial[m]];
+            lod.materials[m].shader = material.shader;
+            for (int map = 0; map <= MATERIAL_MAP_BRDF; map++) lod.materials[m].maps[map] = material.maps[map];
+        }
+
+        data.lods[data.lodCount++] = lod;
+        previousTriangles = triangles;
+    }
+
+    // Distances follow the scaled model size so every item switches at a similar screen size
+    BoundingBox bbox = GetModelBoundingBox(source);
+    Vector3 size = Vector3Subtract(bbox.max, bbox.min);
+    float extent = fmaxf(fmaxf(size.x * data.scale.x, size.y * data.scale.y), size.z * data.scale.z);
+    data.lodBands.count = data.lodCount;
+    for (int i = 0; i < data.lodCount; i++) {
+        data.lodBands.distances[i] = extent * MODEL_LOD_DISTANCE[i];
+    }
+
+    if (data.lodCount > 0) {
+        TraceLog(LOG_INFO, "Model LODs: %s -> %d levels, coarsest %d triangles",
+            data.filename.c_str(), data.lodCount, previousTriangles);
+    }
+}
+
+void ModelManager::UnloadModelLods(ModelData& data) {
+    // Only the meshes belong to the LOD copy. Its materials point at the source
+    // model's shader and textures, so just the arrays are freed, never their contents.
+    for (int i = 0; i < data.lodCount; i++) {
+        Model& lod = data.lods[i];
+        for (int m = 0; m < lod.meshCount; m++) UnloadMesh(lod.meshes[m]);
+        for (int m = 0; m < lod.materialCount; m++) RL_FREE(lod.materials[m].maps);
+        RL_FREE(lod.meshes);
+        RL_FREE(lod.materials);
+        RL_FREE(lod.meshMaterial);
+        lod = { 0 };
+    }
+    data.lodCount = 0;
+    data.lodBands.count = 0;
+    data.lodsBuilt = false;
+}
+
 Model ModelManager::GetModel(ModelID id) {
     if (models.find(id) != models.end() && models[id].model.meshCount > 0) {
         return models[id].model;
@@ -244,9 +339,10 @@ bool ModelManager::IsLoaded(ModelID id) {
     return models.find(id) != models.end() && models[id].loaded;
 }
 
-void ModelManager::DrawModel(ModelID id, Vector3 position, Vector3 forward, Vector3 right, Vector3 up, Color tint) {
-    const ModelData* data = GetModelData(id);
-    if (!data) return;
+void ModelManager::DrawModel(ModelID id, Vector3 position, Vector3 forward, Vector3 right, Vector3 up, Color tint, int* lodLevel) {
+    auto it = models.find(id);
+    if (it == models.end()) return;
+    ModelData* data = &it->second;
 
     // Apply transforms
     Vector3 scaledPos = position;
@@ -278,10 +374,16 @@ void ModelManager::DrawModel(ModelID id, Vector3 position, Vector3 forward, Vect
     // Apply translation
     transform = MatrixMultiply(transform, MatrixTranslate(scaledPos.x, scaledPos.y, scaledPos.z));
 
-    rlPushMatrix();
-    rlMultMatrixf(MatrixToFloat(transform));
-    ::DrawModel(data->model, Vector3Zero(), 1.0f, tint);
-    rlPopMatrix();
+    // Viewmodels and previews pass no LOD state and always use the full model:
+    // their distance to the world camera says nothing about their size on screen
+    const Model* model = &data->model;
+    if (lodLevel && g_LodSystem && g_LodSystem->IsEnabled() && !data->lodsBuilt) BuildModelLods(*data);
+    if (lodLevel && g_LodSystem && data->lodCount > 0) {
+        int level = g_LodSystem->Select(lodLevel, scaledPos, data->lodBands);
+        if (level > 0) model = &data->lods[level - 1];
+    }
+
+    QueueModel(*model, transform, tint);
 }
 
 void ModelManager::Reload() {
@@ -291,6 +393,7 @@ void ModelManager::Reload() {
 
 void ModelManager::Unload() {
     for (auto& pair : models) {
+        UnloadModelLods(pair.second);
         if (pair.second.model.meshCount > 0) {
             UnloadModel(pair.second.model);
         }
@@ -1,5 +1,6 @@
 #pragma once
 #include "globals.h"
+#include "lod.h"
 #include <map>
 #include <string>
 
@@ -21,6 +22,10 @@ enum ModelID {
 // Model data structure
 struct ModelData {
     Model model;
+    Model lods[MAX_LOD_LEVELS - 1];   // Simplified copies of model, coarsest last
+    int lodCount;                     // Number of entries in lods
+    LodBands lodBands;                // Switch distances, scaled to the model size
+    bool lodsBuilt;                   // lods generated (on the first draw that asks for LOD)
     bool loaded;
     Vector3 scale;
     Vector3 offset;
@@ -52,8 +57,10 @@ public:
     // Unload all models
     void Unload();
 
-    // Draw a model with proper transforms
-    void DrawModel(ModelID id, Vector3 position, Vector3 forward, Vector3 right, Vector3 up, Color tint = WHITE);
+    // Draw a model with proper transforms. World instances pass lodLevel (their
+    // per-instance LOD state, kept between frames for hysteresis) to use a
+    // simplified mesh when far away; without it the full model is drawn.
+    void DrawModel(ModelID id, Vector3 position, Vector3 forward, Vector3 right, Vector3 up, Color tint = WHITE, int* lodLevel = nullptr);
 
 private:
     std::map<ModelID, ModelData> models;
@@ -73,6 +80,13 @@ private:
 
     // Apply textures from texture manager
     void ApplyTexturesToModel(Model& model, ModelID id);
+
+    // Generate simplified LOD models and switch distances for a loaded model.
+    // Called lazily by DrawModel so models never drawn with LOD state cost nothing.
+    void BuildModelLods(ModelData& data);
+
+    // Free the LOD models of a model
+    void UnloadModelLods(ModelData& data);
 };
 
 // Global model manager instance
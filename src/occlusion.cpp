@@ -0,0 +1,285 @@
+#include "occlusion.h"
+#include "profiler.h"
+#include "raymath.h"
+#include "rlgl.h"
+#include <algorithm>
+#include <cfloat>
+
+// Global instance
+OcclusionCuller* g_OcclusionCuller = nullptr;
+
+// Clip-space w below this is treated as crossing the near plane
+static const float OCCLUSION_NEAR_W = 0.05f;
+
+// Worker threads used besides the render thread
+static const int MAX_OCCLUSION_WORKERS = 3;
+
+static const int HIZ_WIDTH = OCCLUSION_WIDTH / OCCLUSION_TILE;
+static const int HIZ_HEIGHT = OCCLUSION_HEIGHT / OCCLUSION_TILE;
+
+// Box faces as corner indices (corner bit 0 = x, bit 1 = y, bit 2 = z), counter-clockwise from outside
+static const int BOX_FACES[6][4] = {
+    { 0, 2, 3, 1 },   // -Z
+    { 4, 5, 7, 6 },   // +Z
+    { 0, 4, 6, 2 },   // -X
+    { 1, 3, 7, 5 },   // +X
+    { 0, 1, 5, 4 },   // -Y
+    { 2, 6, 7, 3 }    // +Y
+};
+
+// Clip-space transform using raylib's matrix layout (see Frustum::SetFromMatrix)
+static Vector4 TransformPoint(const Matrix& m, float x, float y, float z) {
+    return Vector4{
+        m.m0 * x + m.m4 * y + m.m8 * z + m.m12,
+        m.m1 * x + m.m5 * y + m.m9 * z + m.m13,
+        m.m2 * x + m.m6 * y + m.m10 * z + m.m14,
+        m.m3 * x + m.m7 * y + m.m11 * z + m.m15
+    };
+}
+
+OcclusionCuller::OcclusionCuller() {
+    enabled = false;
+    ready = false;
+    viewProjection = MatrixIdentity();
+    depthBuffer.assign(OCCLUSION_WIDTH * OCCLUSION_HEIGHT, 0.0f);
+    hizBuffer.assign(HIZ_WIDTH * HIZ_HEIGHT, 0.0f);
+    stats = { 0, 0, 0 };
+
+    workGeneration = 0;
+    workPending = 0;
+    workQuit = false;
+
+    // Bands must cover whole HiZ tile rows so each thread reduces its own tiles
+    int hardware = (int)std::thread::hardware_concurrency();
+    int workerCount = std::max(0, std::min(MAX_OCCLUSION_WORKERS, hardware - 1));
+    bandCount = workerCount + 1;
+    while (HIZ_HEIGHT % bandCount != 0) bandCount--;
+
+    for (int band = 1; band < bandCount; band++) {
+        workers.emplace_back(&OcclusionCuller::WorkerLoop, this, band);
+    }
+}
+
+OcclusionCuller::~OcclusionCuller() {
+    {
+        std::lock_guard<std::mutex> lock(workMutex);
+        workQuit = true;
+    }
+    workStart.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+void OcclusionCuller::BeginFrame(bool enableOcclusion) {
+    stats = { 0, 0, 0 };
+    enabled = enableOcclusion;
+    ready = false;
+    occluders.clear();
+    viewProjection = MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection());
+}
+
+void OcclusionCuller::AddOccluder(const BoundingBox& box) {
+    if (enabled) occluders.push_back(box);
+}
+
+void OcclusionCuller::SetupTriangles() {
+    triangles.clear();
+    for (const auto& box : occluders) {
+        Vector4 clip[8];
+        for (int c = 0; c < 8; c++) {
+            clip[c] = TransformPoint(viewProjection,
+                (c & 1) ? box.max.x : box.min.x,
+                (c & 2) ? box.max.y : box.min.y,
+                (c & 4) ? box.max.z : box.min.z);
+        }
+
+        for (int f = 0; f < 6; f++) {
+            const int* face = BOX_FACES[f];
+            // Faces crossing the near plane are dropped: a missing occluder is always safe
+            bool clipped = false;
+            for (int k = 0; k < 4; k++) clipped |= clip[face[k]].w < OCCLUSION_NEAR_W;
+            if (clipped) continue;
+
+            float sx[4], sy[4], sd[4];
+            for (int k = 0; k < 4; k++) {
+                const Vector4& v = clip[face[k]];
+                float invW = 1.0f / v.w;
+                sx[k] = (v.x * invW * 0.5f + 0.5f) * OCCLUSION_WIDTH;
+                sy[k] = (0.5f - v.y * invW * 0.5f) * OCCLUSION_HEIGHT;
+                sd[k] = invW;
+            }
+
+            // Back faces wind clockwise on screen (y points down here, so the sign flips)
+            float area = (sx[1] - sx[0]) * (sy[2] - sy[0]) - (sx[2] - sx[0]) * (sy[1] - sy[0]);
+            if (area >= 0.0f) continue;
+
+            for (int t = 0; t < 2; t++) {
+                int i0 = 0, i1 = t + 1, i2 = t + 2;
+                ScreenTriangle tri;
+                tri.x[0] = sx[i0]; tri.x[1] = sx[i1]; tri.x[2] = sx[i2];
+                tri.y[0] = sy[i0]; tri.y[1] = sy[i1]; tri.y[2] = sy[i2];
+                tri.depth[0] = sd[i0]; tri.depth[1] = sd[i1]; tri.depth[2] = sd[i2];
+                tri.minY = std::max(0, (int)floorf(std::min({ tri.y[0], tri.y[1], tri.y[2] })));
+                tri.maxY = std::min(OCCLUSION_HEIGHT - 1, (int)ceilf(std::max({ tri.y[0], tri.y[1], tri.y[2] })));
+                if (tri.minY <= tri.maxY) triangles.push_back(tri);
+            }
+        }
+    }
+}
+
+void OcclusionCuller::RasterizeBand(int band) {
+    PROFILE_SCOPE("Occlusion::RasterizeBand");
+    const int bandRows = OCCLUSION_HEIGHT / bandCount;
+    const int y0 = band * bandRows;
+    const int y1 = y0 + bandRows - 1;
+
+    std::fill(depthBuffer.begin() + y0 * OCCLUSION_WIDTH, depthBuffer.begin() + (y1 + 1) * OCCLUSION_WIDTH, 0.0f);
+
+    for (const auto& tri : triangles) {
+        int minY = std::max(tri.minY, y0);
+        int maxY = std::min(tri.maxY, y1);
+        if (minY > maxY) continue;
+
+        int minX = std::max(0, (int)floorf(std::min({ tri.x[0], tri.x[1], tri.x[2] })));
+        int maxX = std::min(OCCLUSION_WIDTH - 1, (int)ceilf(std::max({ tri.x[0], tri.x[1], tri.x[2] })));
+        if (minX > maxX) continue;
+
+        // Edge functions E_i(x, y) = a_i * x + b_i * y + c_i, positive inside
+        float a[3], b[3], c[3];
+        for (int e = 0; e < 3; e++) {
+            int i = (e + 1) % 3, j = (e + 2) % 3;
+            a[e] = tri.y[i] - tri.y[j];
+            b[e] = tri.x[j] - tri.x[i];
+            c[e] = tri.x[i] * tri.y[j] - tri.x[j] * tri.y[i];
+        }
+        float area = c[0] + c[1] + c[2];
+        if (area == 0.0f) continue;
+        float invArea = 1.0f / area;
+
+        for (int y = minY; y <= maxY; y++) {
+            float py = y + 0.5f;
+            float* row = &depthBuffer[y * OCCLUSION_WIDTH];
+            // Straight-line inner loop over the span so the compiler can vectorize it
+            for (int x = minX; x <= maxX; x++) {
+                float px = x + 0.5f;
+                float w0 = a[0] * px + b[0] * py + c[0];
+                float w1 = a[1] * px + b[1] * py + c[1];
+                float w2 = a[2] * px + b[2] * py + c[2];
+                bool inside = (w0 * area >= 0.0f) && (w1 * area >= 0.0f) && (w2 * area >= 0.0f);
+                float depth = (w0 * tri.depth[0] + w1 * tri.depth[1] + w2 * tri.depth[2]) * invArea;
+                row[x] = inside ? std::max(row[x], depth) : row[x];
+            }
+        }
+    }
+
+    // Reduce this band to HiZ tiles: keep the farthest (smallest 1/w) depth per tile
+    for (int ty = y0 / OCCLUSION_TILE; ty <= y1 / OCCLUSION_TILE; ty++) {
+        for (int tx = 0; tx < HIZ_WIDTH; tx++) {
+            float farthest = FLT_MAX;
+            for (int y = ty * OCCLUSION_TILE; y < (ty + 1) * OCCLUSION_TILE; y++) {
+                const float* row = &depthBuffer[y * OCCLUSION_WIDTH + tx * OCCLUSION_TILE];
+                for (int x = 0; x < OCCLUSION_TILE; x++) farthest = std::min(farthest, row[x]);
+            }
+            hizBuffer[ty * HIZ_WIDTH + tx] = farthest;
+        }
+    }
+}
+
+void OcclusionCuller::WorkerLoop(int band) {
+    char threadName[32];
+    snprintf(threadName, sizeof(threadName), "Occlusion %d", band);
+    PROFILE_THREAD_NAME(threadName);
+
+    int seenGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(workMutex);
+            workStart.wait(lock, [&] { return workQuit || workGeneration != seenGeneration; });
+            if (workQuit) return;
+            seenGeneration = workGeneration;
+        }
+
+        RasterizeBand(band);
+
+        {
+            std::lock_guard<std::mutex> lock(workMutex);
+            workPending--;
+        }
+        workDone.notify_one();
+    }
+}
+
+void OcclusionCuller::Rasterize() {
+    if (!enabled) return;
+
+    SetupTriangles();
+    stats.occluders = (int)occluders.size();
+
+    // Wake the workers, rasterize band 0 here, then wait for the rest
+    {
+        std::lock_guard<std::mutex> lock(workMutex);
+        workPending = bandCount - 1;
+        workGeneration++;
+    }
+    workStart.notify_all();
+
+    RasterizeBand(0);
+
+    std::unique_lock<std::mutex> lock(workMutex);
+    workDone.wait(lock, [&] { return workPending == 0; });
+    ready = true;
+}
+
+bool OcclusionCuller::IsOccluded(const BoundingBox& box) {
+    if (!enabled || !ready || triangles.empty()) return false;
+    stats.tested++;
+
+    // Screen rectangle and nearest depth of the box
+    float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+    float nearest = 0.0f;
+    for (int c = 0; c < 8; c++) {
+        Vector4 v = TransformPoint(viewProjection,
+            (c & 1) ? box.max.x : box.min.x,
+            (c & 2) ? box.max.y : box.min.y,
+            (c & 4) ? box.max.z : box.min.z);
+        if (v.w < OCCLUSION_NEAR_W) return false;   // Touches the camera - assume visible
+
+        float invW = 1.0f / v.w;
+        float sx = (v.x * invW * 0.5f + 0.5f) * OCCLUSION_WIDTH;
+        float sy = (0.5f - v.y * invW * 0.5f) * OCCLUSION_HEIGHT;
+        minX = std::min(minX, sx);
+        maxX = std::max(maxX, sx);
+        minY = std::min(minY, sy);
+        maxY = std::max(maxY, sy);
+        nearest = std::max(nearest, invW);
+    }
+
+    int tx0 = std::max(0, (int)floorf(minX) / OCCLUSION_TILE);
+    int ty0 = std::max(0, (int)floorf(minY) / OCCLUSION_TILE);
+    int tx1 = std::min(HIZ_WIDTH - 1, (int)ceilf(maxX) / OCCLUSION_TILE);
+    int ty1 = std::min(HIZ_HEIGHT - 1, (int)ceilf(maxY) / OCCLUSION_TILE);
+    if (tx0 > tx1 || ty0 > ty1) return false;   // Off screen - left to the frustum test
+
+    // Occluded only if every covering tile is entirely nearer than the box's nearest point
+    for (int ty = ty0; ty <= ty1; ty++) {
+        for (int tx = tx0; tx <= tx1; tx++) {
+            if (hizBuffer[ty * HIZ_WIDTH + tx] <= nearest) return false;
+        }
+    }
+
+    stats.occluded++;
+    return true;
+}
+
+// Global initialization
+void InitializeOcclusionSystem() {
+    g_OcclusionCuller = new OcclusionCuller();
+    TraceLog(LOG_INFO, "Occlusion system initialized (%dx%d depth buffer)", OCCLUSION_WIDTH, OCCLUSION_HEIGHT);
+}
+
+void CleanupOcclusionSystem() {
+    if (g_OcclusionCuller) {
+        delete g_OcclusionCuller;
+        g_OcclusionCuller = nullptr;
+    }
+    TraceLog(LOG_INFO, "Occlusion system cleaned up");
+}
@@ -0,0 +1,88 @@
+#pragma once
+// NOTE: only raylib here - culling.cpp folds occlusion into IsBoxInView
+#include "raylib.h"
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// Software depth buffer resolution (independent of the window size)
+#define OCCLUSION_WIDTH 256
+#define OCCLUSION_HEIGHT 128
+#define OCCLUSION_TILE 8   // Hierarchical-Z tile edge in pixels
+
+// Per-frame occlusion counters
+struct OcclusionStats {
+    int occluders;    // Boxes rasterized
+    int tested;
+    int occluded;
+};
+
+// Occlusion culler class
+// Rasterizes occluder boxes (building shells) into a small CPU depth buffer each
+// frame, reduces it to a hierarchical-Z grid, and rejects boxes that lie fully
+// behind it. Everything stays on the CPU, so there is no GPU readback.
+// Depth is stored as 1/w (larger = nearer), which interpolates linearly in
+// screen space; empty pixels are 0 and never occlude anything.
+class OcclusionCuller {
+public:
+    OcclusionCuller();
+    ~OcclusionCuller();
+
+    // Clear the buffer and capture the active rlgl matrices (call after BeginMode3D).
+    // When disabled nothing is rasterized and IsOccluded always returns false.
+    void BeginFrame(bool enabled);
+
+    bool IsEnabled() const { return enabled; }
+
+    // Queue an occluder; must be solid from every side it can be seen from
+    void AddOccluder(const BoundingBox& box);
+
+    // Rasterize the queued occluders across the worker threads and build the HiZ grid
+    void Rasterize();
+
+    // True if the box is hidden behind the rasterized occluders
+    bool IsOccluded(const BoundingBox& box);
+
+    const OcclusionStats& GetStats() const { return stats; }
+
+private:
+    // Occluder triangle in buffer space
+    struct ScreenTriangle {
+        float x[3], y[3];
+        float depth[3];   // 1/w
+        int minY, maxY;
+    };
+
+    bool enabled;
+    bool ready;
+    Matrix viewProjection;
+    std::vector<BoundingBox> occluders;
+    std::vector<ScreenTriangle> triangles;
+    std::vector<float> depthBuffer;   // OCCLUSION_WIDTH * OCCLUSION_HEIGHT
+    std::vector<float> hizBuffer;     // Farthest depth per tile
+    OcclusionStats stats;
+
+    // Worker pool: band i of the buffer is rasterized by worker i (band 0 by the caller)
+    std::vector<std::thread> workers;
+    std::mutex workMutex;
+    std::condition_variable workStart;
+    std::condition_variable workDone;
+    int workGeneration;
+    int workPending;
+    bool workQuit;
+    int bandCount;
+
+    void WorkerLoop(int band);
+    void RasterizeBand(int band);
+    void SetupTriangles();
+};
+
+// Global occlusion culler instance
+extern OcclusionCuller* g_OcclusionCuller;
+
+// Initialize occlusion system
+void InitializeOcclusionSystem();
+
+// Cleanup occlusion system
+void CleanupOcclusionSystem();
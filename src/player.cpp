@@ -1,6 +1,9 @@
 #include "player.h"
 #include "items.h"
 #include "model_manager.h"
+#include "render_queue.h"
+#include "profiler.h"
+#include "input.h"
 #include <math.h>
 
 const char* GetGamepadButtonName(int button) {
@@ -22,7 +25,7 @@ const char* GetGamepadButtonName(int button) {
 }
 
 bool IsActionPressed(int actionIndex, const ControllerBinding* currentBindings) {
-    if (!IsGamepadAvailable(0)) return false;
+    if (!InputIsGamepadAvailable(0)) return false;
     if (actionIndex < 0 || actionIndex >= ACTION_COUNT) return false;
     const ControllerBinding& binding = currentBindings[actionIndex];
 
@@ -30,16 +33,16 @@ bool IsActionPressed(int actionIndex, const ControllerBinding* currentBindings)
         return false;
     }
     else {
-        return IsGamepadButtonPressed(0, binding.inputId);
+        return InputIsGamepadButtonPressed(0, binding.inputId);
     }
 }
 
 bool IsActionDown(int actionIndex, const ControllerBinding* currentBindings) {
-    if (!IsGamepadAvailable(0)) return false;
+    if (!InputIsGamepadAvailable(0)) return false;
     if (actionIndex < 0 || actionIndex >= ACTION_COUNT) return false;
     const ControllerBinding& binding = currentBindings[actionIndex];
     if (binding.isAxis) {
-        float axisValue = GetGamepadAxisMovement(0, binding.inputId);
+        float axisValue = InputGetGamepadAxisMovement(0, binding.inputId);
         if (binding.threshold > 0.0f) {
             return axisValue >= binding.threshold;
         }
@@ -48,7 +51,7 @@ bool IsActionDown(int actionIndex, const ControllerBinding* currentBindings) {
         }
     }
     else {
-        return IsGamepadButtonDown(0, binding.inputId);
+        return InputIsGamepadButtonDown(0, binding.inputId);
     }
     return false;
 }
@@ -111,25 +114,26 @@ void DrawPlayerHands(Camera3D camera, InventorySlot* inventory, float pistolReco
         // Add glow effect for flashlight when on
         if (itemId == ITEM_FLASHLIGHT && isFlashlightOn) {
             Vector3 glowPos = Vector3Add(basePos, Vector3Scale(forward, 0.08f));
-            DrawSphere(glowPos, 0.04f, Color{ 255, 255, 220, 100 });
-            DrawSphere(glowPos, 0.03f, Color{ 255, 255, 200, 150 });
-            DrawSphere(glowPos, 0.02f, Color{ 255, 255, 180, 200 });
+            QueueSphere(glowPos, 0.04f, Color{ 255, 255, 220, 100 });
+            QueueSphere(glowPos, 0.03f, Color{ 255, 255, 200, 150 });
+            QueueSphere(glowPos, 0.02f, Color{ 255, 255, 180, 200 });
         }
     }
     else {
         // Fallback to simple cube if model manager not available
-        DrawCube(basePos, 0.05f, 0.05f, 0.05f, GRAY);
+        QueueCube(basePos, 0.05f, 0.05f, 0.05f, GRAY);
     }
 }
 
 void UpdatePlayer(float deltaTime, Camera3D* camera, Vector3* playerPosition, Vector3* playerVelocity, float* yaw, float* pitch, bool* onGround, float playerSpeed, float playerHeight, float gravity, float jumpForce, float* stamina, bool isNoclip, bool useController) {
+    PROFILE_SCOPE("UpdatePlayer");
     // FIX: Declare bindings as external (defined in controller_bindings.cpp)
     extern ControllerBinding bindings[ACTION_COUNT];
 
-    Vector2 mouseDelta = GetMouseDelta();
+    Vector2 mouseDelta = InputGetMouseDelta();
     if (useController) {
-        float moveAxisX = GetGamepadAxisMovement(0, GAMEPAD_CAMERA_MOVE_AXIS_X);
-        float moveAxisY = GetGamepadAxisMovement(0, GAMEPAD_CAMERA_MOVE_AXIS_Y);
+        float moveAxisX = InputGetGamepadAxisMovement(0, GAMEPAD_CAMERA_MOVE_AXIS_X);
+        float moveAxisY = InputGetGamepadAxisMovement(0, GAMEPAD_CAMERA_MOVE_AXIS_Y);
         mouseDelta.x = moveAxisX * 5.0f;
         mouseDelta.y = moveAxisY * 5.0f;
     }
@@ -152,21 +156,21 @@ void UpdatePlayer(float deltaTime, Camera3D* camera, Vector3* playerPosition, Ve
     Vector3 right = Vector3Normalize(Vector3CrossProduct(flatForward, camera->up));
     Vector3 movement = { 0 };
 
-    bool isSprinting = (IsKeyDown(KEY_LEFT_SHIFT) || (useController && IsActionDown(ACTION_SPRINT, bindings))) && *stamina > 0.0f;
+    bool isSprinting = (InputIsKeyDown(KEY_LEFT_SHIFT) || (useController && IsActionDown(ACTION_SPRINT, bindings))) && *stamina > 0.0f;
     float currentSpeed = playerSpeed * (isSprinting ? 2.0f : 1.0f);
 
     if (useController) {
-        float moveX = GetGamepadAxisMovement(0, GAMEPAD_PLAYER_MOVE_AXIS_X);
-        float moveY = GetGamepadAxisMovement(0, GAMEPAD_PLAYER_MOVE_AXIS_Y);
+        float moveX = InputGetGamepadAxisMovement(0, GAMEPAD_PLAYER_MOVE_AXIS_X);
+        float moveY = InputGetGamepadAxisMovement(0, GAMEPAD_PLAYER_MOVE_AXIS_Y);
         if (fabs(moveY) > 0.1f) movement = Vector3Add(movement, Vector3Scale(flatForward, -moveY * currentSpeed));
         if (fabs(moveX) > 0.1f) movement = Vector3Add(movement, Vector3Scale(right, moveX * currentSpeed));
     }
 
     if (Vector3LengthSqr(movement) == 0.0f || !useController) {
-        if (IsKeyDown(KEY_W)) movement = Vector3Add(movement, Vector3Scale(flatForward, currentSpeed));
-        if (IsKeyDown(KEY_S)) movement = Vector3Add(movement, Vector3Scale(flatForward, -currentSpeed));
-        if (IsKeyDown(KEY_A)) movement = Vector3Add(movement, Vector3Scale(right, -currentSpeed));
-        if (IsKeyDown(KEY_D)) movement = Vector3Add(movement, Vector3Scale(right, currentSpeed));
+        if (InputIsKeyDown(KEY_W)) movement = Vector3Add(movement, Vector3Scale(flatForward, currentSpeed));
+        if (InputIsKeyDown(KEY_S)) movement = Vector3Add(movement, Vector3Scale(flatForward, -currentSpeed));
+        if (InputIsKeyDown(KEY_A)) movement = Vector3Add(movement, Vector3Scale(right, -currentSpeed));
+        if (InputIsKeyDown(KEY_D)) movement = Vector3Add(movement, Vector3Scale(right, currentSpeed));
     }
 
     if (Vector3LengthSqr(movement) > 0.0f) {
@@ -177,7 +181,7 @@ void UpdatePlayer(float deltaTime, Camera3D* camera, Vector3* playerPosition, Ve
 
     if (!isNoclip) {
         const float JUMP_STAMINA_COST = 5.0f;
-        bool jumpPressed = IsKeyPressed(KEY_SPACE) || (useController && IsActionPressed(ACTION_JUMP, bindings));
+        bool jumpPressed = InputIsKeyPressed(KEY_SPACE) || (useController && IsActionPressed(ACTION_JUMP, bindings));
         if (jumpPressed && *onGround && *stamina >= JUMP_STAMINA_COST) {
             playerVelocity->y = jumpForce;
             *stamina -= JUMP_STAMINA_COST;
@@ -192,8 +196,8 @@ void UpdatePlayer(float deltaTime, Camera3D* camera, Vector3* playerPosition, Ve
         }
     }
     else {
-        if (IsKeyDown(KEY_SPACE)) playerPosition->y += currentSpeed;
-        if (IsKeyDown(KEY_LEFT_CONTROL)) playerPosition->y -= currentSpeed;
+        if (InputIsKeyDown(KEY_SPACE)) playerPosition->y += currentSpeed;
+        if (InputIsKeyDown(KEY_LEFT_CONTROL)) playerPosition->y -= currentSpeed;
     }
     camera->position = *playerPosition;
 }
\ No newline at end of file
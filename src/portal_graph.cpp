@@ -0,0 +1,180 @@
+#include "portal_graph.h"
+#include <cfloat>
+
+// Deepest chain of portals followed from the viewer's cell
+static const int MAX_PORTAL_DEPTH = 8;
+
+PortalGraph::PortalGraph() {
+    width = 0;
+    height = 0;
+}
+
+void PortalGraph::Build(const Interior& interior) {
+    width = interior.width;
+    height = interior.height;
+    cellMap.assign(width * height, -1);
+    cells.clear();
+    portals.clear();
+
+    auto tileAt = [&](int x, int y) { return interior.tiles[y * width + x]; };
+    auto isOpen = [&](int x, int y) {
+        if (x < 0 || y < 0 || x >= width || y >= height) return false;
+        int t = tileAt(x, y);
+        return t != IT_EMPTY && t != IT_WALL && t != IT_DOOR;
+    };
+
+    // Flood fill open tiles into cells
+    std::vector<int> stack;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            if (!isOpen(x, y) || cellMap[y * width + x] >= 0) continue;
+
+            int cellId = (int)cells.size();
+            PortalCell cell;
+            cell.bounds = BoundingBox{ Vector3{ FLT_MAX, 0.0f, FLT_MAX }, Vector3{ -FLT_MAX, WALL_HEIGHT, -FLT_MAX } };
+            cell.tileCount = 0;
+
+            cellMap[y * width + x] = cellId;
+            stack.push_back(y * width + x);
+            while (!stack.empty()) {
+                int i = stack.back();
+                stack.pop_back();
+                int tx = i % width, ty = i / width;
+                cell.tileCount++;
+                cell.bounds.min.x = fminf(cell.bounds.min.x, tx - 0.5f);
+                cell.bounds.min.z = fminf(cell.bounds.min.z, ty - 0.5f);
+                cell.bounds.max.x = fmaxf(cell.bounds.max.x, tx + 0.5f);
+                cell.bounds.max.z = fmaxf(cell.bounds.max.z, ty + 0.5f);
+
+                const int dx[4] = { 1, -1, 0, 0 };
+                const int dy[4] = { 0, 0, 1, -1 };
+                for (int d = 0; d < 4; d++) {
+                    int nx = tx + dx[d], ny = ty + dy[d];
+                    if (isOpen(nx, ny) && cellMap[ny * width + nx] < 0) {
+                        cellMap[ny * width + nx] = cellId;
+                        stack.push_back(ny * width + nx);
+                    }
+                }
+            }
+            cells.push_back(cell);
+        }
+    }
+
+    // Doors join the cells on opposite sides of them
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            if (tileAt(x, y) != IT_DOOR) continue;
+
+            auto cellOf = [&](int cx, int cy) { return isOpen(cx, cy) ? cellMap[cy * width + cx] : -1; };
+            int a = cellOf(x - 1, y), b = cellOf(x + 1, y);
+            if (a < 0 || b < 0 || a == b) {
+                int c = cellOf(x, y - 1), d = cellOf(x, y + 1);
+                if (c >= 0 && d >= 0 && c != d) { a = c; b = d; }
+            }
+
+            int owner = a >= 0 ? a : b;
+            if (owner < 0) {
+                // Exterior door or isolated door tile: owned by whichever side exists
+                for (int c : { cellOf(x, y - 1), cellOf(x, y + 1), cellOf(x - 1, y), cellOf(x + 1, y) }) {
+                    if (c >= 0) { owner = c; break; }
+                }
+            }
+            if (owner < 0) {
+                // No open neighbour at all - give it a cell of its own
+                owner = (int)cells.size();
+                PortalCell cell;
+                cell.bounds = BoundingBox{ Vector3{ x - 0.5f, 0.0f, y - 0.5f }, Vector3{ x + 0.5f, WALL_HEIGHT, y + 0.5f } };
+                cell.tileCount = 1;
+                cells.push_back(cell);
+            }
+            cellMap[y * width + x] = owner;
+
+            if (a >= 0 && b >= 0 && a != b) {
+                Portal portal;
+                portal.cells[0] = a;
+                portal.cells[1] = b;
+                portal.x = x;
+                portal.y = y;
+                portal.bounds = BoundingBox{ Vector3{ x - 0.5f, 0.0f, y - 0.5f }, Vector3{ x + 0.5f, WALL_HEIGHT, y + 0.5f } };
+                cells[a].portals.push_back((int)portals.size());
+                cells[b].portals.push_back((int)portals.size());
+                portals.push_back(portal);
+            }
+        }
+    }
+}
+
+int PortalGraph::GetCellAt(int x, int y) const {
+    if (x < 0 || y < 0 || x >= width || y >= height) return -1;
+    return cellMap[y * width + x];
+}
+
+int PortalGraph::GetCellAtPosition(Vector3 position) const {
+    return GetCellAt((int)floorf(position.x + 0.5f), (int)floorf(position.z + 0.5f));
+}
+
+PortalGraph::ScreenRect PortalGraph::ProjectBox(const BoundingBox& box, Matrix m) {
+    ScreenRect rect = { FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for (int i = 0; i < 8; i++) {
+        float x = (i & 1) ? box.max.x : box.min.x;
+        float y = (i & 2) ? box.max.y : box.min.y;
+        float z = (i & 4) ? box.max.z : box.min.z;
+
+        float cx = m.m0 * x + m.m4 * y + m.m8 * z + m.m12;
+        float cy = m.m1 * x + m.m5 * y + m.m9 * z + m.m13;
+        float cw = m.m3 * x + m.m7 * y + m.m11 * z + m.m15;
+
+        // Corner behind the viewer: the opening may cover anything, stay conservative
+        if (cw <= 0.0001f) return ScreenRect{ -1.0f, -1.0f, 1.0f, 1.0f };
+
+        rect.x0 = fminf(rect.x0, cx / cw);
+        rect.y0 = fminf(rect.y0, cy / cw);
+        rect.x1 = fmaxf(rect.x1, cx / cw);
+        rect.y1 = fmaxf(rect.y1, cy / cw);
+    }
+    return rect;
+}
+
+void PortalGraph::Traverse(int cell, ScreenRect rect, int depth, const Frustum& frustum, Matrix viewProjection,
+    std::vector<unsigned char>& visible, std::vector<unsigned char>& onPath) const {
+    visible[cell] = 1;
+    if (depth >= MAX_PORTAL_DEPTH) return;
+
+    for (int p : cells[cell].portals) {
+        const Portal& portal = portals[p];
+        int next = portal.cells[0] == cell ? portal.cells[1] : portal.cells[0];
+        if (onPath[next]) continue;
+        if (frustum.ClassifyBox(portal.bounds.min, portal.bounds.max) == FRUSTUM_OUTSIDE) continue;
+
+        // Narrow the view to what is seen through this opening
+        ScreenRect opening = ProjectBox(portal.bounds, viewProjection);
+        ScreenRect clipped = {
+            fmaxf(rect.x0, opening.x0), fmaxf(rect.y0, opening.y0),
+            fminf(rect.x1, opening.x1), fminf(rect.y1, opening.y1)
+        };
+        if (clipped.x0 >= clipped.x1 || clipped.y0 >= clipped.y1) continue;
+
+        onPath[next] = 1;
+        Traverse(next, clipped, depth + 1, frustum, viewProjection, visible, onPath);
+        onPath[next] = 0;
+    }
+}
+
+int PortalGraph::FindVisibleCells(Vector3 viewPosition, const Frustum& frustum, Matrix viewProjection,
+    std::vector<unsigned char>& visible) const {
+    int start = GetCellAtPosition(viewPosition);
+    if (start < 0) {
+        // Inside a wall (noclip) or outside the interior - nothing to reason about
+        visible.assign(cells.size(), 1);
+        return (int)cells.size();
+    }
+
+    visible.assign(cells.size(), 0);
+    std::vector<unsigned char> onPath(cells.size(), 0);
+    onPath[start] = 1;
+    Traverse(start, ScreenRect{ -1.0f, -1.0f, 1.0f, 1.0f }, 0, frustum, viewProjection, visible, onPath);
+
+    int count = 0;
+    for (unsigned char v : visible) count += v;
+    return count;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include "globals.h"
+#include "map.h"
+#include "culling.h"
+#include <vector>
+
+// A room: connected open tiles bounded by walls
+struct PortalCell {
+    BoundingBox bounds;
+    std::vector<int> portals;   // Indices into PortalGraph::GetPortals()
+    int tileCount;
+};
+
+// An IT_DOOR tile joining two cells
+struct Portal {
+    int cells[2];
+    int x, y;
+    BoundingBox bounds;         // The door opening, full wall height
+};
+
+// Portal graph class
+// Splits an interior into cells by flood-filling open tiles between walls, with
+// IT_DOOR tiles as the portals between them. At runtime cells are visited from
+// the viewer's cell through portals whose screen rectangles overlap the
+// rectangle they were reached through, so rooms behind walls are never drawn.
+class PortalGraph {
+public:
+    PortalGraph();
+
+    // Extract cells and portals from the interior tiles
+    void Build(const Interior& interior);
+
+    int GetCellCount() const { return (int)cells.size(); }
+    int GetPortalCount() const { return (int)portals.size(); }
+
+    const std::vector<PortalCell>& GetCells() const { return cells; }
+    const std::vector<Portal>& GetPortals() const { return portals; }
+
+    // Cell owning a tile (door tiles belong to their first neighbouring cell), -1 for walls
+    int GetCellAt(int x, int y) const;
+
+    // Cell containing a position in interior coordinates (tiles centred on integers)
+    int GetCellAtPosition(Vector3 position) const;
+
+    // Mark the cells visible from viewPosition (visible[i] = 1). If the viewer is not
+    // inside any cell everything is marked visible. Returns the visible cell count.
+    int FindVisibleCells(Vector3 viewPosition, const Frustum& frustum, Matrix viewProjection,
+        std::vector<unsigned char>& visible) const;
+
+private:
+    int width;
+    int height;
+    std::vector<int> cellMap;
+    std::vector<PortalCell> cells;
+    std::vector<Portal> portals;
+
+    // Screen-space rectangle in normalized device coordinates
+    struct ScreenRect {
+        float x0, y0, x1, y1;
+    };
+
+    static ScreenRect ProjectBox(const BoundingBox& box, Matrix viewProjection);
+
+    void Traverse(int cell, ScreenRect rect, int depth, const Frustum& frustum, Matrix viewProjection,
+        std::vector<unsigned char>& visible, std::vector<unsigned char>& onPath) const;
+};
@@ -0,0 +1,170 @@
+#include "post_process.h"
+#include "profiler.h"
+#include "rlgl.h"
+#include "external/glad.h"
+
+// Global instance
+PostProcessManager* g_PostProcess = nullptr;
+
+PostProcessManager::PostProcessManager() {
+    shader = { 0 };
+    sceneTarget = { 0 };
+    resolutionSlot = timeSlot = vignetteSlot = flashlightGlowSlot = damagePulseSlot = -1;
+    grainSlot = exposureSlot = contrastSlot = saturationSlot = tintSlot = -1;
+    grading = { 1.0f, 1.0f, 1.0f, Vector3{ 1.0f, 1.0f, 1.0f }, 0.03f };
+}
+
+PostProcessManager::~PostProcessManager() {
+    Unload();
+}
+
+bool PostProcessManager::Initialize() {
+    TraceLog(LOG_INFO, "Initializing Post-Process Manager...");
+
+    // Framebuffer blits need GL 3.3
+    if (rlGetVersion() < RL_OPENGL_33 || !FileExists("assets/shaders/post.fs")) {
+        TraceLog(LOG_WARNING, "Post-process shader unavailable, using overlay rectangles");
+        return false;
+    }
+
+    // Default vertex shader: only texcoords and the screen quad are needed
+    shader = LoadShader(0, "assets/shaders/post.fs");
+    if (shader.id == 0 || shader.id == rlGetShaderIdDefault()) {
+        shader = { 0 };
+        TraceLog(LOG_WARNING, "Post-process shader failed to compile, using overlay rectangles");
+        return false;
+    }
+
+    uniforms.Reset(shader);
+    resolutionSlot = uniforms.Add("resolution");
+    timeSlot = uniforms.Add("time");
+    vignetteSlot = uniforms.Add("vignette");
+    flashlightGlowSlot = uniforms.Add("flashlightGlow");
+    damagePulseSlot = uniforms.Add("damagePulse");
+    grainSlot = uniforms.Add("grain");
+    exposureSlot = uniforms.Add("exposure");
+    contrastSlot = uniforms.Add("contrast");
+    saturationSlot = uniforms.Add("saturation");
+    tintSlot = uniforms.Add("tint");
+
+    TraceLog(LOG_INFO, "Post-process shader loaded");
+    return true;
+}
+
+bool PostProcessManager::EnsureTarget(int width, int height) {
+    if (sceneTarget.id > 0 && sceneTarget.texture.width == width && sceneTarget.texture.height == height) {
+        return true;
+    }
+    if (sceneTarget.id > 0) UnloadRenderTexture(sceneTarget);
+    sceneTarget = LoadRenderTexture(width, height);
+    if (sceneTarget.id == 0) return false;
+    SetTextureFilter(sceneTarget.texture, TEXTURE_FILTER_POINT);
+    TraceLog(LOG_INFO, TextFormat("Post-process target: %dx%d", width, height));
+    return true;
+}
+
+void PostProcessManager::Apply(int screenW, int screenH, const PostProcessParams& params) {
+    PROFILE_SCOPE("PostProcess");
+    if (!IsReady()) {
+        DrawFallback(screenW, screenH, params);
+        return;
+    }
+
+    int width = rlGetFramebufferWidth();
+    int height = rlGetFramebufferHeight();
+    if (!EnsureTarget(width, height)) {
+        DrawFallback(screenW, screenH, params);
+        return;
+    }
+
+    // Copy (and resolve) the back buffer; pending rlgl draws belong to the frame
+    rlDrawRenderBatchActive();
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, sceneTarget.id);
+    glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    // Every pixel is replaced, so blending is unnecessary
+    rlDisableColorBlend();
+    BeginShaderMode(shader);
+    uniforms.SetVec2(resolutionSlot, Vector2{ (float)width, (float)height });
+    uniforms.SetFloat(timeSlot, params.time);
+    uniforms.SetFloat(vignetteSlot, params.vignette);
+    uniforms.SetFloat(flashlightGlowSlot, params.flashlightGlow);
+    uniforms.SetFloat(damagePulseSlot, params.damagePulse);
+    uniforms.SetFloat(grainSlot, grading.grain);
+    uniforms.SetFloat(exposureSlot, grading.exposure);
+    uniforms.SetFloat(contrastSlot, grading.contrast);
+    uniforms.SetFloat(saturationSlot, grading.saturation);
+    uniforms.SetVec3(tintSlot, grading.tint);
+
+    DrawTexturePro(
+        sceneTarget.texture,
+        Rectangle{ 0, 0, (float)width, (float)-height },
+        Rectangle{ 0, 0, (float)screenW, (float)screenH },
+        Vector2{ 0, 0 },
+        0.0f,
+        WHITE
+    );
+
+    EndShaderMode();
+    rlEnableColorBlend();
+}
+
+void PostProcessManager::DrawFallback(int screenW, int screenH, const PostProcessParams& params) {
+    unsigned char edgeV = (unsigned char)(120 * params.vignette);
+    unsigned char edgeH = (unsigned char)(100 * params.vignette);
+    DrawRectangleGradientV(0, 0, screenW, screenH / 5, Color{ 0, 0, 0, edgeV }, Color{ 0, 0, 0, 0 });
+    DrawRectangleGradientV(0, screenH * 4 / 5, screenW, screenH / 5, Color{ 0, 0, 0, 0 }, Color{ 0, 0, 0, edgeV });
+    DrawRectangleGradientH(0, 0, screenW / 6, screenH, Color{ 0, 0, 0, edgeH }, Color{ 0, 0, 0, 0 });
+    DrawRectangleGradientH(screenW * 5 / 6, 0, screenW / 6, screenH, Color{ 0, 0, 0, 0 }, Color{ 0, 0, 0, edgeH });
+
+    if (params.flashlightGlow > 0.0f) {
+        DrawRectangle(0, 0, screenW, screenH, Color{ 255, 245, 200, (unsigned char)(params.flashlightGlow * 255.0f) });
+    }
+    if (params.damagePulse > 0.0f) {
+        DrawRectangle(0, 0, screenW, screenH, Color{ 180, 0, 0, (unsigned char)(params.damagePulse * 255.0f) });
+    }
+}
+
+void PostProcessManager::AppendReport(std::vector<std::string>& lines) const {
+    if (!IsReady()) {
+        lines.push_back("Post-process shader not loaded (overlay rectangles).");
+        return;
+    }
+    lines.push_back(TextFormat("Post-process: single pass, target %dx%d",
+        sceneTarget.texture.width, sceneTarget.texture.height));
+    lines.push_back(TextFormat("Grading: exposure %.2f, contrast %.2f, saturation %.2f, tint %.2f %.2f %.2f, grain %.3f",
+        grading.exposure, grading.contrast, grading.saturation,
+        grading.tint.x, grading.tint.y, grading.tint.z, grading.grain));
+}
+
+void PostProcessManager::Unload() {
+    if (sceneTarget.id > 0) {
+        UnloadRenderTexture(sceneTarget);
+        sceneTarget = { 0 };
+    }
+    if (shader.id > 0) {
+        UnloadShader(shader);
+        shader = { 0 };
+        uniforms.Reset(shader);
+    }
+}
+
+// =============================================================================
+// GLOBAL INITIALIZATION
+// =============================================================================
+
+void InitializePostProcessSystem() {
+    if (!g_PostProcess) {
+        g_PostProcess = new PostProcessManager();
+        g_PostProcess->Initialize();
+    }
+}
+
+void CleanupPostProcessSystem() {
+    if (g_PostProcess) {
+        delete g_PostProcess;
+        g_PostProcess = nullptr;
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include "globals.h"
+#include "uniform_buffer.h"
+#include <vector>
+#include <string>
+
+// Per-frame overlay amounts, 0 = off
+struct PostProcessParams {
+    float vignette;         // Edge darkening
+    float flashlightGlow;   // Warm flashlight bloom (mix amount)
+    float damagePulse;      // Low-health red pulse (mix amount)
+    float time;             // Seconds, animates the grain
+};
+
+// Colour grading and grain, tunable from the console
+struct PostProcessGrading {
+    float exposure;
+    float contrast;
+    float saturation;
+    Vector3 tint;
+    float grain;
+};
+
+// Post-process manager class
+// Applies the screen overlays (vignette, flashlight glow, low-health pulse,
+// film grain and colour grading) in one opaque full-screen pass. The finished
+// 3D frame is copied out of the back buffer with a framebuffer blit (which also
+// resolves MSAA and works after the upscaler), then drawn back through
+// post.fs. Without the shader the old alpha-blended rectangles are drawn.
+class PostProcessManager {
+public:
+    PostProcessManager();
+    ~PostProcessManager();
+
+    // Load the shader. Returns false if only the fallback overlays are available.
+    bool Initialize();
+
+    bool IsReady() const { return shader.id > 0; }
+
+    PostProcessGrading& GetGrading() { return grading; }
+
+    // Replace the 3D frame in the back buffer with its post-processed version
+    void Apply(int screenW, int screenH, const PostProcessParams& params);
+
+    // Console report
+    void AppendReport(std::vector<std::string>& lines) const;
+
+    void Unload();
+
+private:
+    Shader shader;
+    ShaderUniforms uniforms;
+    int resolutionSlot;
+    int timeSlot;
+    int vignetteSlot;
+    int flashlightGlowSlot;
+    int damagePulseSlot;
+    int grainSlot;
+    int exposureSlot;
+    int contrastSlot;
+    int saturationSlot;
+    int tintSlot;
+
+    RenderTexture2D sceneTarget;    // Back buffer copy, framebuffer size
+    PostProcessGrading grading;
+
+    // (Re)create the copy target when the framebuffer size changes
+    bool EnsureTarget(int width, int height);
+
+    // Stacked rectangles used when post.fs is unavailable
+    void DrawFallback(int screenW, int screenH, const PostProcessParams& params);
+};
+
+// Global post-process manager instance
+extern PostProcessManager* g_PostProcess;
+
+// Initialize post-processing
+void InitializePostProcessSystem();
+
+// Cleanup post-processing
+void CleanupPostProcessSystem();
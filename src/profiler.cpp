@@ -0,0 +1,316 @@
+#include "profiler.h"
+#include "globals.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <map>
+
+// Global instance
+Profiler* g_Profiler = nullptr;
+
+// Buffer of the calling thread, valid while its owner is the live profiler
+static thread_local ProfileThreadBuffer* t_buffer = nullptr;
+static thread_local const Profiler* t_owner = nullptr;
+
+static const uint64_t EVENT_MASK = PROFILER_EVENT_CAPACITY - 1;
+
+// Frame strip scale: a bar reaching the top is a 30 fps frame
+static const float FLAME_STRIP_MS = 33.3f;
+
+static Color ScopeColor(const char* name) {
+    unsigned int hash = 2166136261u;
+    for (const char* c = name; *c; c++) hash = (hash ^ (unsigned char)*c) * 16777619u;
+    return ColorFromHSV((float)(hash % 360), 0.45f, 0.75f);
+}
+
+Profiler::Profiler() {
+    paused = false;
+    visible = false;
+    frameCount = 0;
+    frameHead = 0;
+    frameStart = Now();
+    selectedFrameStart = 0;
+}
+
+Profiler::~Profiler() {
+    for (ProfileThreadBuffer* buffer : threads) delete buffer;
+    threads.clear();
+}
+
+uint64_t Profiler::Now() {
+    static const auto epoch = std::chrono::steady_clock::now();
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - epoch).count();
+}
+
+ProfileThreadBuffer* Profiler::GetThreadBuffer() {
+    if (t_buffer && t_owner == this) return t_buffer;
+
+    ProfileThreadBuffer* buffer = new ProfileThreadBuffer();
+    buffer->written.store(0, std::memory_order_relaxed);
+    buffer->depth = 0;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        buffer->index = (int)threads.size();
+        snprintf(buffer->name, sizeof(buffer->name), buffer->index == 0 ? "Main" : "Thread %d", buffer->index);
+        threads.push_back(buffer);
+    }
+    t_buffer = buffer;
+    t_owner = this;
+    return buffer;
+}
+
+void Profiler::SetThreadName(const char* name) {
+    ProfileThreadBuffer* buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(registryMutex);
+    snprintf(buffer->name, sizeof(buffer->name), "%s", name);
+}
+
+int Profiler::BeginScope() {
+    if (IsPaused()) return -1;
+    return GetThreadBuffer()->depth++;
+}
+
+void Profiler::EndScope(const char* name, uint64_t start, int depth) {
+    ProfileThreadBuffer* buffer = GetThreadBuffer();
+    buffer->depth = depth;
+    if (IsPaused()) return;
+
+    uint64_t index = buffer->written.load(std::memory_order_relaxed);
+    ProfileEvent& event = buffer->events[index & EVENT_MASK];
+    event.name = name;
+    event.start = start;
+    event.end = Now();
+    event.depth = depth;
+    buffer->written.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::BeginFrame() {
+    uint64_t now = Now();
+    if (!IsPaused()) {
+        frames[frameHead] = { frameStart, now };
+        frameHead = (frameHead + 1) % PROFILER_HISTORY_FRAMES;
+        frameCount = std::min(frameCount + 1, PROFILER_HISTORY_FRAMES);
+    }
+    frameStart = now;
+}
+
+const ProfileFrame& Profiler::GetFrame(int back) const {
+    int slot = (frameHead - 1 - back + PROFILER_HISTORY_FRAMES * 2) % PROFILER_HISTORY_FRAMES;
+    return frames[slot];
+}
+
+void Profiler::Collect(uint64_t start, uint64_t end, std::vector<CollectedEvent>& out) const {
+    std::vector<ProfileThreadBuffer*> buffers;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        buffers = threads;
+    }
+
+    for (const ProfileThreadBuffer* buffer : buffers) {
+        uint64_t written = buffer->written.load(std::memory_order_acquire);
+        uint64_t oldest = written > PROFILER_EVENT_CAPACITY ? written - PROFILER_EVENT_CAPACITY : 0;
+
+        // Newest first: events are committed in end order, so stop once they end before 'start'
+        for (uint64_t i = written; i-- > oldest;) {
+            ProfileEvent event = buffer->events[i & EVENT_MASK];
+            // The owner may have lapped this slot while it was copied
+            if (buffer->written.load(std::memory_order_acquire) >= i + PROFILER_EVENT_CAPACITY) break;
+            if (end != 0) {
+                if (event.end < start) break;
+                if (event.start >= end) continue;
+            }
+            out.push_back({ event, buffer->index });
+        }
+    }
+}
+
+void Profiler::DrawFlameView(int x, int y, int width, int height) {
+    const int stripHeight = 40;
+    const int rowHeight = 14;
+    const int fontSize = 10;
+
+    DrawRectangle(x, y, width, height, Color{ 0, 0, 0, 210 });
+    DrawRectangleLines(x, y, width, height, PIPBOY_GREEN);
+    if (frameCount == 0) return;
+
+    // --- Frame time strip (newest on the right) ---
+    int stripY = y + 18;
+    float barWidth = (float)width / PROFILER_HISTORY_FRAMES;
+    Vector2 mouse = GetMousePosition();
+    bool inStrip = mouse.x >= x && mouse.x < x + width && mouse.y >= stripY && mouse.y < stripY + stripHeight;
+    if (inStrip && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
+        int back = (int)((x + width - mouse.x) / barWidth);
+        selectedFrameStart = back < frameCount ? GetFrame(back).start : 0;
+    }
+    if (inStrip && IsMouseButtonPressed(MOUSE_BUTTON_RIGHT)) selectedFrameStart = 0;
+
+    int selected = 0;
+    for (int back = 0; back < frameCount; back++) {
+        const ProfileFrame& frame = GetFrame(back);
+        if (selectedFrameStart != 0 && frame.start == selectedFrameStart) selected = back;
+
+        float ms = (frame.end - frame.start) / 1000000.0f;
+        int barHeight = (int)(std::min(ms / FLAME_STRIP_MS, 1.0f) * stripHeight);
+        Color color = ms < 16.7f ? PIPBOY_GREEN : (ms < FLAME_STRIP_MS ? YELLOW : RED);
+        float barX = x + width - (back + 1) * barWidth;
+        DrawRectangle((int)barX, stripY + stripHeight - barHeight, std::max(1, (int)barWidth - 1), barHeight, color);
+    }
+    // The selected frame scrolled out of the history: follow the latest again
+    if (selectedFrameStart != 0 && GetFrame(selected).start != selectedFrameStart) selectedFrameStart = 0;
+
+    int targetY = stripY + stripHeight - (int)(16.7f / FLAME_STRIP_MS * stripHeight);
+    DrawLine(x, targetY, x + width, targetY, PIPBOY_DIM);
+    float selectedX = x + width - (selected + 1) * barWidth;
+    DrawRectangleLines((int)selectedX, stripY, std::max(2, (int)barWidth), stripHeight, WHITE);
+
+    const ProfileFrame& frame = GetFrame(selected);
+    double frameNs = (double)std::max<uint64_t>(frame.end - frame.start, 1);
+    DrawText(TextFormat("Frame %.2f ms%s%s", frameNs / 1000000.0, selected > 0 ? TextFormat(" (%d back)", selected) : "",
+        IsPaused() ? "  [paused]" : ""), x + 6, y + 4, fontSize, PIPBOY_GREEN);
+
+    // --- Flame graph of the selected frame, one lane per thread ---
+    std::vector<CollectedEvent> events;
+    Collect(frame.start, frame.end, events);
+
+    int threadCount = 0;
+    for (const CollectedEvent& e : events) threadCount = std::max(threadCount, e.thread + 1);
+    std::vector<int> laneDepth(threadCount, -1);
+    for (const CollectedEvent& e : events) laneDepth[e.thread] = std::max(laneDepth[e.thread], e.event.depth);
+
+    std::vector<std::string> laneNames;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (int t = 0; t < threadCount; t++) laneNames.push_back(threads[t]->name);
+    }
+
+    std::vector<int> laneY(threadCount, 0);
+    int cursorY = stripY + stripHeight + 6;
+    for (int t = 0; t < threadCount; t++) {
+        if (laneDepth[t] < 0) continue;
+        laneY[t] = cursorY + rowHeight;
+        DrawText(laneNames[t].c_str(), x + 6, cursorY + 2, fontSize, PIPBOY_DIM);
+        cursorY += rowHeight * (laneDepth[t] + 2);
+    }
+
+    int bottom = y + height - 2;
+    for (const CollectedEvent& e : events) {
+        int rowY = laneY[e.thread] + e.event.depth * rowHeight;
+        if (rowY + rowHeight > bottom) continue;
+
+        uint64_t start = std::max(e.event.start, frame.start);
+        uint64_t end = std::min(e.event.end, frame.end);
+        int x0 = x + (int)((start - frame.start) / frameNs * width);
+        int x1 = x + (int)((end - frame.start) / frameNs * width);
+        int barW = std::max(1, x1 - x0);
+        DrawRectangle(x0, rowY, barW, rowHeight - 1, ScopeColor(e.event.name));
+
+        const char* label = TextFormat("%s %.2f", e.event.name, (e.event.end - e.event.start) / 1000000.0);
+        if (MeasureText(label, fontSize) + 4 <= barW) {
+            DrawText(label, x0 + 2, rowY + 2, fontSize, BLACK);
+        }
+        else if (MeasureText(e.event.name, fontSize) + 4 <= barW) {
+            DrawText(e.event.name, x0 + 2, rowY + 2, fontSize, BLACK);
+        }
+    }
+}
+
+void Profiler::AppendReport(std::vector<std::string>& lines) const {
+    if (frameCount == 0) {
+        lines.push_back("No frames recorded yet.");
+        return;
+    }
+
+    const ProfileFrame& frame = GetFrame(0);
+    std::vector<CollectedEvent> events;
+    Collect(frame.start, frame.end, events);
+
+    // Inclusive time per scope name on the main thread
+    std::map<std::string, std::pair<double, int>> totals;
+    for (const CollectedEvent& e : events) {
+        if (e.thread != 0) continue;
+        auto& total = totals[e.event.name];
+        total.first += (e.event.end - e.event.start) / 1000000.0;
+        total.second++;
+    }
+
+    std::vector<std::pair<std::string, std::pair<double, int>>> sorted(totals.begin(), totals.end());
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) { return a.second.first > b.second.first; });
+
+    lines.push_back(TextFormat("Last frame: %.2f ms", (frame.end - frame.start) / 1000000.0));
+    const size_t maxLines = 12;
+    for (size_t i = 0; i < sorted.size() && i < maxLines; i++) {
+        lines.push_back(TextFormat("  %s: %.2f ms (x%d)", sorted[i].first.c_str(), sorted[i].second.first, sorted[i].second.second));
+    }
+}
+
+// Scope names are string literals, but keep the JSON valid whatever they contain
+static void WriteJsonString(std::ofstream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; c++) {
+        if (*c == '"' || *c == '\\') out << '\\';
+        if ((unsigned char)*c >= 32) out << *c;
+    }
+    out << '"';
+}
+
+bool Profiler::ExportChromeTrace(const char* filename) const {
+    std::vector<CollectedEvent> events;
+    Collect(0, 0, events);
+    std::sort(events.begin(), events.end(), [](const CollectedEvent& a, const CollectedEvent& b) {
+        return a.event.start < b.event.start;
+    });
+
+    std::ofstream outfile(filename);
+    if (!outfile.is_open()) {
+        TraceLog(LOG_ERROR, TextFormat("Failed to open trace file %s for writing.", filename));
+        return false;
+    }
+
+    outfile << "{\"traceEvents\":[\n";
+    bool first = true;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (const ProfileThreadBuffer* buffer : threads) {
+            outfile << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+                << buffer->index << ",\"args\":{\"name\":";
+            WriteJsonString(outfile, buffer->name);
+            outfile << "}}";
+            first = false;
+        }
+    }
+
+    // Complete events, timestamps in microseconds
+    outfile.setf(std::ios::fixed);
+    outfile.precision(3);
+    for (const CollectedEvent& e : events) {
+        outfile << (first ? "" : ",\n") << "{\"name\":";
+        WriteJsonString(outfile, e.event.name);
+        outfile << ",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.thread
+            << ",\"ts\":" << e.event.start / 1000.0
+            << ",\"dur\":" << (e.event.end - e.event.start) / 1000.0 << "}";
+        first = false;
+    }
+    outfile << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    outfile.close();
+
+    TraceLog(LOG_INFO, TextFormat("Profiler: wrote %d events to %s", (int)events.size(), filename));
+    return true;
+}
+
+// Global initialization
+void InitializeProfiler() {
+#if PROFILER_ENABLED
+    g_Profiler = new Profiler();
+    g_Profiler->SetThreadName("Main");
+    TraceLog(LOG_INFO, "Profiler initialized");
+#endif
+}
+
+void CleanupProfiler() {
+    if (g_Profiler) {
+        delete g_Profiler;
+        g_Profiler = nullptr;
+        TraceLog(LOG_INFO, "Profiler cleaned up");
+    }
+}
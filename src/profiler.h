@@ -0,0 +1,152 @@
+#pragma once
+#include "raylib.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Scope timers are compiled into debug builds only; release builds get empty macros
+#ifndef PROFILER_ENABLED
+#ifdef NDEBUG
+#define PROFILER_ENABLED 0
+#else
+#define PROFILER_ENABLED 1
+#endif
+#endif
+
+// Events kept per thread (ring buffer, power of two)
+#define PROFILER_EVENT_CAPACITY 16384
+
+// Frames kept for the flame view
+#define PROFILER_HISTORY_FRAMES 120
+
+// One finished scope
+struct ProfileEvent {
+    const char* name;   // Must outlive the profiler (string literals)
+    uint64_t start;     // Nanoseconds since the profiler started
+    uint64_t end;
+    int depth;          // Nesting level on its thread
+};
+
+// Events recorded by one thread. Only the owning thread writes; readers copy
+// slots below 'written' and re-check it afterwards to discard overwritten ones.
+struct ProfileThreadBuffer {
+    ProfileEvent events[PROFILER_EVENT_CAPACITY];
+    std::atomic<uint64_t> written;
+    int depth;
+    int index;
+    char name[32];
+};
+
+// Start and end of one main loop iteration
+struct ProfileFrame {
+    uint64_t start;
+    uint64_t end;
+};
+
+// Profiler class
+// Collects nested scope timings from every thread into per-thread event rings
+// (no locks on the recording path; a thread takes the registry lock once, the
+// first time it records). The main loop marks frame boundaries; the last
+// PROFILER_HISTORY_FRAMES frames can be shown as a flame view and everything
+// still buffered can be written out as Chrome/Perfetto trace JSON.
+class Profiler {
+public:
+    Profiler();
+    ~Profiler();
+
+    // Time since the profiler started, in nanoseconds
+    static uint64_t Now();
+
+    // Name the calling thread in the flame view and in exported traces
+    void SetThreadName(const char* name);
+
+    // Scope recording (use PROFILE_SCOPE instead of calling these directly)
+    int BeginScope();
+    void EndScope(const char* name, uint64_t start, int depth);
+
+    // Close the previous frame and start a new one. The time before the first
+    // call (startup and asset loading) becomes the first frame.
+    void BeginFrame();
+
+    // Paused: nothing is recorded, so the history stays put for inspection
+    bool IsPaused() const { return paused.load(std::memory_order_relaxed); }
+    void SetPaused(bool pause) { paused.store(pause, std::memory_order_relaxed); }
+
+    bool IsVisible() const { return visible; }
+    void ToggleVisible() { visible = !visible; }
+
+    // Frame time strip of the history plus the flame graph of the selected frame
+    // (the latest one unless a bar in the strip was clicked)
+    void DrawFlameView(int x, int y, int width, int height);
+
+    // Inclusive time per scope on the main thread for the latest frame, for the console
+    void AppendReport(std::vector<std::string>& lines) const;
+
+    // Write every buffered event as Chrome trace JSON (chrome://tracing, ui.perfetto.dev)
+    bool ExportChromeTrace(const char* filename) const;
+
+private:
+    // Copy of an event with the thread it came from
+    struct CollectedEvent {
+        ProfileEvent event;
+        int thread;
+    };
+
+    mutable std::mutex registryMutex;
+    std::vector<ProfileThreadBuffer*> threads;
+    std::atomic<bool> paused;
+    bool visible;
+
+    ProfileFrame frames[PROFILER_HISTORY_FRAMES];
+    int frameCount;
+    int frameHead;          // Next slot to write
+    uint64_t frameStart;
+    uint64_t selectedFrameStart;   // Start of the frame picked in the strip, 0 = follow the latest
+
+    ProfileThreadBuffer* GetThreadBuffer();
+    const ProfileFrame& GetFrame(int back) const;
+
+    // Events overlapping [start, end) from every thread, or all buffered events
+    // when end is 0
+    void Collect(uint64_t start, uint64_t end, std::vector<CollectedEvent>& out) const;
+};
+
+// Global profiler instance (nullptr when compiled out)
+extern Profiler* g_Profiler;
+
+// Times the enclosing scope
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* scopeName) {
+        name = scopeName;
+        depth = g_Profiler ? g_Profiler->BeginScope() : -1;
+        start = Profiler::Now();
+    }
+    ~ProfileScope() {
+        if (depth >= 0 && g_Profiler) g_Profiler->EndScope(name, start, depth);
+    }
+
+private:
+    const char* name;
+    uint64_t start;
+    int depth;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if PROFILER_ENABLED
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+#define PROFILE_THREAD_NAME(name) do { if (g_Profiler) g_Profiler->SetThreadName(name); } while (0)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_THREAD_NAME(name) ((void)0)
+#endif
+
+// Initialize profiler (does nothing when compiled out)
+void InitializeProfiler();
+
+// Cleanup profiler
+void CleanupProfiler();
@@ -0,0 +1,335 @@
+#include "prop_renderer.h"
+#include "mesh_builder.h"
+#include "texture_manager.h"
+#include "world_geometry.h"
+#include "render_queue.h"
+
+// Global instance
+PropRenderer* g_PropRenderer = nullptr;
+
+// Sentinel for untextured parts
+static const TextureID PROP_NO_TEXTURE = TEX_COUNT;
+
+PropRenderer::PropRenderer() {
+    for (int i = 0; i < PROP_TYPE_COUNT; i++) {
+        meshes[i] = { 0 };
+        meshBounds[i] = { 0 };
+    }
+    material = { 0 };
+    initialized = false;
+    instanced = false;
+    stats = { 0, 0, 0 };
+}
+
+PropRenderer::~PropRenderer() {
+    Unload();
+}
+
+void PropRenderer::Initialize() {
+    Unload();
+
+    // Instancing needs the instanced surface shader (and through it the surface texture set)
+    instanced = g_ShaderManager && g_ShaderManager->IsSurfaceInstancedShaderLoaded();
+
+    int vertexCount = 0;
+    for (int i = 0; i < PROP_TYPE_COUNT; i++) {
+        meshes[i] = BuildPropMesh(PROP_FIRST_TILE + i, instanced);
+        meshBounds[i] = GetMeshBoundingBox(meshes[i]);
+        vertexCount += meshes[i].vertexCount;
+    }
+
+    material = LoadMaterialDefault();
+    if (instanced) {
+        material.shader = g_ShaderManager->GetSurfaceInstancedShader();
+        if (g_TextureManager->IsSurfaceAtlas()) {
+            material.maps[MATERIAL_MAP_ALBEDO].texture = g_TextureManager->GetSurfaceAtlas();
+        }
+    }
+    initialized = true;
+
+    TraceLog(LOG_INFO, "Prop renderer initialized: %d prop types, %d vertices, %s",
+        PROP_TYPE_COUNT, vertexCount, instanced ? "instanced" : "per-instance fallback");
+}
+
+// =============================================================================
+// PROP MESHES
+// =============================================================================
+
+Mesh PropRenderer::BuildPropMesh(int tile, bool layered) {
+    MeshBuilder builder;
+
+    // Props are modelled around the tile center at floor level (y = 0).
+    // Textured parts sample the surface set; their color tints the texture.
+    auto part = [&](float cx, float cy, float cz, float sx, float sy, float sz, Color color, TextureID texture) {
+        int layer = (layered && texture != PROP_NO_TEXTURE) ? g_TextureManager->GetSurfaceLayer(texture) : -1;
+        // Always set a layer when layered so every vertex carries texcoords2
+        if (layered) builder.SetLayer(layer);
+        builder.AddBox(Vector3{ cx, cy, cz }, Vector3{ sx, sy, sz }, Vector2{ 1.0f, 1.0f }, color);
+    };
+
+    const Color wood = { 150, 115, 80, 255 };
+    const Color metal = { 140, 145, 150, 255 };
+    const Color darkMetal = { 60, 65, 70, 255 };
+    const Color white = { 225, 225, 220, 255 };
+
+    switch (tile) {
+    case IT_BED:
+        part(0.0f, 0.15f, 0.0f, 0.9f, 0.3f, 0.9f, Color{ 120, 90, 60, 255 }, TEX_FLOOR_WOOD);
+        part(0.0f, 0.35f, 0.05f, 0.85f, 0.1f, 0.75f, Color{ 180, 160, 140, 255 }, TEX_FLOOR_CARPET);
+        part(0.0f, 0.44f, -0.3f, 0.5f, 0.08f, 0.2f, white, PROP_NO_TEXTURE);
+        break;
+    case IT_DESK:
+        part(0.0f, 0.72f, 0.0f, 0.9f, 0.06f, 0.5f, wood, TEX_FLOOR_WOOD);
+        part(-0.4f, 0.35f, 0.0f, 0.06f, 0.7f, 0.45f, wood, TEX_FLOOR_WOOD);
+        part(0.4f, 0.35f, 0.0f, 0.06f, 0.7f, 0.45f, wood, TEX_FLOOR_WOOD);
+        break;
+    case IT_SHELF:
+        part(-0.42f, 0.9f, 0.0f, 0.06f, 1.8f, 0.4f, metal, TEX_WALL_METAL);
+        part(0.42f, 0.9f, 0.0f, 0.06f, 1.8f, 0.4f, metal, TEX_WALL_METAL);
+        for (int i = 0; i < 4; i++) {
+            part(0.0f, 0.1f + i * 0.55f, 0.0f, 0.8f, 0.04f, 0.4f, metal, TEX_WALL_METAL);
+        }
+        break;
+    case IT_CRATE:
+        part(0.0f, 0.3f, 0.0f, 0.6f, 0.6f, 0.6f, Color{ 200, 170, 120, 255 }, TEX_FLOOR_WOOD);
+        break;
+    case IT_STOVE:
+        part(0.0f, 0.45f, 0.0f, 0.6f, 0.9f, 0.6f, white, PROP_NO_TEXTURE);
+        part(0.0f, 0.91f, 0.0f, 0.5f, 0.02f, 0.5f, Color{ 30, 30, 30, 255 }, PROP_NO_TEXTURE);
+        break;
+    case IT_TOILET:
+        part(0.0f, 0.2f, 0.05f, 0.4f, 0.4f, 0.5f, white, PROP_NO_TEXTURE);
+        part(0.0f, 0.55f, -0.25f, 0.4f, 0.5f, 0.15f, white, PROP_NO_TEXTURE);
+        break;
+    case IT_LOCKER:
+        part(0.0f, 0.9f, 0.0f, 0.5f, 1.8f, 0.5f, Color{ 110, 130, 150, 255 }, TEX_WALL_METAL);
+        break;
+    case IT_MEDCABINET:
+        part(0.0f, 1.4f, -0.35f, 0.5f, 0.6f, 0.2f, white, PROP_NO_TEXTURE);
+        part(0.0f, 1.4f, -0.24f, 0.3f, 0.08f, 0.02f, Color{ 200, 40, 40, 255 }, PROP_NO_TEXTURE);
+        part(0.0f, 1.4f, -0.24f, 0.08f, 0.3f, 0.02f, Color{ 200, 40, 40, 255 }, PROP_NO_TEXTURE);
+        break;
+    case IT_ARMORRACK:
+        part(0.0f, 0.8f, -0.25f, 0.8f, 1.6f, 0.1f, darkMetal, TEX_WALL_METAL);
+        part(0.0f, 0.05f, 0.0f, 0.8f, 0.1f, 0.5f, darkMetal, TEX_WALL_METAL);
+        part(0.0f, 1.1f, -0.05f, 0.7f, 0.05f, 0.3f, darkMetal, TEX_WALL_METAL);
+        break;
+    case IT_TABLE:
+        part(0.0f, 0.74f, 0.0f, 0.9f, 0.06f, 0.9f, wood, TEX_FLOOR_WOOD);
+        part(0.0f, 0.36f, 0.0f, 0.1f, 0.7f, 0.1f, darkMetal, PROP_NO_TEXTURE);
+        part(0.0f, 0.02f, 0.0f, 0.5f, 0.04f, 0.5f, darkMetal, PROP_NO_TEXTURE);
+        break;
+    case IT_CHAIR:
+        part(0.0f, 0.45f, 0.0f, 0.45f, 0.05f, 0.45f, wood, TEX_FLOOR_WOOD);
+        part(0.0f, 0.72f, -0.2f, 0.45f, 0.5f, 0.05f, wood, TEX_FLOOR_WOOD);
+        part(0.0f, 0.22f, 0.0f, 0.08f, 0.44f, 0.08f, darkMetal, PROP_NO_TEXTURE);
+        break;
+    case IT_CONSOLE:
+        part(0.0f, 0.4f, 0.0f, 0.6f, 0.8f, 0.6f, Color{ 80, 120, 160, 255 }, PROP_NO_TEXTURE);
+        part(0.0f, 0.95f, -0.15f, 0.5f, 0.3f, 0.05f, darkMetal, PROP_NO_TEXTURE);
+        part(0.0f, 0.95f, -0.12f, 0.42f, 0.22f, 0.02f, Color{ 60, 220, 120, 255 }, PROP_NO_TEXTURE);
+        break;
+    case IT_PIPE:
+        part(0.0f, CEILING_HEIGHT / 2.0f, 0.0f, 0.2f, CEILING_HEIGHT, 0.2f, metal, TEX_WALL_METAL);
+        break;
+    case IT_CRYOPOD_BROKEN:
+        part(0.0f, 0.1f, 0.0f, 0.8f, 0.2f, 0.8f, darkMetal, TEX_WALL_METAL);
+        part(0.0f, 0.6f, 0.0f, 0.7f, 0.8f, 0.7f, Color{ 100, 150, 200, 255 }, PROP_NO_TEXTURE);
+        break;
+    case IT_CRYOPOD_INTACT:
+        part(0.0f, 0.1f, 0.0f, 0.8f, 0.2f, 0.8f, darkMetal, TEX_WALL_METAL);
+        part(0.0f, 1.0f, 0.0f, 0.7f, 1.6f, 0.7f, Color{ 150, 200, 235, 255 }, PROP_NO_TEXTURE);
+        part(0.0f, 1.85f, 0.0f, 0.8f, 0.1f, 0.8f, darkMetal, TEX_WALL_METAL);
+        break;
+    case IT_VENT:
+        part(0.0f, 0.03f, 0.0f, 0.6f, 0.02f, 0.6f, darkMetal, TEX_WALL_METAL);
+        break;
+    case IT_SERVER_RACK:
+        part(0.0f, 1.0f, 0.0f, 0.6f, 2.0f, 0.8f, Color{ 40, 40, 45, 255 }, PROP_NO_TEXTURE);
+        part(0.0f, 1.0f, 0.41f, 0.4f, 1.6f, 0.02f, Color{ 60, 200, 90, 255 }, PROP_NO_TEXTURE);
+        break;
+    case IT_FRIDGE:
+        part(0.0f, 0.9f, 0.0f, 0.7f, 1.8f, 0.7f, white, PROP_NO_TEXTURE);
+        part(0.25f, 1.1f, 0.36f, 0.04f, 0.5f, 0.04f, metal, PROP_NO_TEXTURE);
+        break;
+    case IT_CABINET:
+        part(0.0f, 0.45f, 0.0f, 0.8f, 0.9f, 0.5f, wood, TEX_FLOOR_WOOD);
+        break;
+    case IT_BENCH:
+        part(0.0f, 0.45f, 0.0f, 0.8f, 0.08f, 0.4f, Color{ 140, 120, 100, 255 }, TEX_FLOOR_WOOD);
+        part(-0.35f, 0.2f, 0.0f, 0.06f, 0.42f, 0.35f, darkMetal, PROP_NO_TEXTURE);
+        part(0.35f, 0.2f, 0.0f, 0.06f, 0.42f, 0.35f, darkMetal, PROP_NO_TEXTURE);
+        break;
+    case IT_BROKEN_GLASS:
+        part(-0.15f, 0.03f, 0.1f, 0.2f, 0.01f, 0.12f, Color{ 190, 220, 230, 255 }, PROP_NO_TEXTURE);
+        part(0.12f, 0.03f, -0.1f, 0.15f, 0.01f, 0.2f, Color{ 190, 220, 230, 255 }, PROP_NO_TEXTURE);
+        part(0.2f, 0.03f, 0.2f, 0.1f, 0.01f, 0.08f, Color{ 190, 220, 230, 255 }, PROP_NO_TEXTURE);
+        break;
+    case IT_WARNING_LIGHT:
+        part(0.0f, CEILING_HEIGHT - 0.15f, 0.0f, 0.3f, 0.2f, 0.3f, Color{ 255, 120, 20, 255 }, PROP_NO_TEXTURE);
+        break;
+    case IT_COOLANT_PUDDLE:
+        part(0.0f, 0.03f, 0.0f, 0.8f, 0.01f, 0.8f, Color{ 60, 200, 220, 255 }, PROP_NO_TEXTURE);
+        break;
+    default:
+        part(0.0f, 0.25f, 0.0f, 0.5f, 0.5f, 0.5f, Color{ 255, 0, 255, 255 }, PROP_NO_TEXTURE);
+        break;
+    }
+
+    return builder.Build();
+}
+
+// =============================================================================
+// INSTANCE LISTS
+// =============================================================================
+
+void PropRenderer::BakeInteriors(const MapData& mapData) {
+    propSets.clear();
+    for (const auto& pair : mapData.interiors) {
+        propSets[pair.first] = BuildPropSet(pair.second);
+    }
+}
+
+PropRenderer::PropSet PropRenderer::BuildPropSet(const Interior& interior) {
+    PropSet set;
+    set.instanceCount = 0;
+
+    // Cells come from the interior shell's portal graph, so props hide with their room
+    const PortalGraph* graph = nullptr;
+    if (g_WorldGeometry) graph = &g_WorldGeometry->GetInteriorShell(interior)->graph;
+
+    for (int i = 0; i < (int)interior.tiles.size(); i++) {
+        int tile = interior.tiles[i];
+        if (!IsPropTile(tile)) continue;
+
+        int x = i % interior.width;
+        int y = i / interior.width;
+        int type = tile - PROP_FIRST_TILE;
+        PropBatch& batch = set.batches[type];
+
+        batch.transforms.push_back(MatrixTranslate((float)x, 0.0f, (float)y));
+        batch.cells.push_back(graph ? graph->GetCellAt(x, y) : -1);
+
+        const BoundingBox& local = meshBounds[type];
+        batch.bounds.Add(BoundingBox{
+            Vector3{ local.min.x + x, local.min.y, local.min.z + y },
+            Vector3{ local.max.x + x, local.max.y, local.max.z + y } });
+        set.instanceCount++;
+    }
+
+    return set;
+}
+
+void PropRenderer::DrawInterior(const Interior& interior, const PortalGraph* graph,
+    const std::vector<unsigned char>* visibleCells) {
+    stats = { 0, 0, 0 };
+    if (!initialized) return;
+
+    auto it = propSets.find(interior.id);
+    if (it == propSets.end()) {
+        // Interior added after the map bake - gather it on first use
+        it = propSets.emplace(interior.id, BuildPropSet(interior)).first;
+    }
+    PropSet& set = it->second;
+    stats.instances = set.instanceCount;
+
+    // Props are decoration: first to go when the draw budget runs out
+    RenderImportanceScope importance(RENDER_IMPORTANCE_LOW);
+    RenderStatPassScope statPass(STAT_PASS_PROPS);
+
+    for (int type = 0; type < PROP_TYPE_COUNT; type++) {
+        PropBatch& batch = set.batches[type];
+        batch.visible.clear();
+        if (batch.transforms.empty()) continue;
+
+        if (g_FrustumCuller) g_FrustumCuller->CullBoxes(batch.bounds, visibility);
+        else visibility.assign(batch.transforms.size(), 1);
+
+        for (size_t i = 0; i < batch.transforms.size(); i++) {
+            if (!visibility[i]) continue;
+            int cell = batch.cells[i];
+            if (graph && visibleCells && cell >= 0 && cell < (int)visibleCells->size() && !(*visibleCells)[cell]) continue;
+            batch.visible.push_back(batch.transforms[i]);
+        }
+        if (batch.visible.empty()) continue;
+        stats.drawn += (int)batch.visible.size();
+
+        if (instanced) {
+            QueueMeshInstanced(meshes[type], material, batch.visible.data(), (int)batch.visible.size());
+            stats.drawCalls++;
+        }
+        else {
+            for (const Matrix& transform : batch.visible) {
+                QueueMesh(meshes[type], material, transform);
+            }
+            stats.drawCalls += (int)batch.visible.size();
+        }
+    }
+
+    if (g_RenderStats) g_RenderStats->RecordObjects(STAT_PASS_PROPS, stats.drawn, stats.instances - stats.drawn);
+}
+
+int PropRenderer::DrawInteriorShadowCasters(const Interior& interior, const Material& depthMaterial,
+    const Material& depthInstancedMaterial) {
+    if (!initialized) return 0;
+
+    auto it = propSets.find(interior.id);
+    if (it == propSets.end()) {
+        it = propSets.emplace(interior.id, BuildPropSet(interior)).first;
+    }
+    PropSet& set = it->second;
+
+    int drawCalls = 0;
+    for (int type = 0; type < PROP_TYPE_COUNT; type++) {
+        const PropBatch& batch = set.batches[type];
+        if (batch.transforms.empty()) continue;
+        int count = (int)batch.transforms.size();
+
+        if (instanced) {
+            DrawMeshInstanced(meshes[type], depthInstancedMaterial, batch.transforms.data(), count);
+            drawCalls++;
+            if (g_RenderStats) g_RenderStats->RecordDraw(STAT_PASS_SHADOWS, 1,
+                meshes[type].vertexCount * count, meshes[type].triangleCount * count);
+        }
+        else {
+            for (const Matrix& transform : batch.transforms) {
+                DrawMesh(meshes[type], depthMaterial, transform);
+            }
+            drawCalls += count;
+            if (g_RenderStats) g_RenderStats->RecordDraw(STAT_PASS_SHADOWS, count,
+                meshes[type].vertexCount * count, meshes[type].triangleCount * count);
+        }
+    }
+    return drawCalls;
+}
+
+void PropRenderer::Unload() {
+    propSets.clear();
+
+    for (int i = 0; i < PROP_TYPE_COUNT; i++) {
+        if (meshes[i].vertexCount > 0) UnloadMesh(meshes[i]);
+        meshes[i] = { 0 };
+    }
+
+    // The shader and atlas belong to the managers; only free the map array
+    if (initialized) {
+        RL_FREE(material.maps);
+        material = { 0 };
+        initialized = false;
+    }
+}
+
+// Global initialization
+void InitializePropSystem() {
+    g_PropRenderer = new PropRenderer();
+    g_PropRenderer->Initialize();
+    TraceLog(LOG_INFO, "Prop system initialized");
+}
+
+void CleanupPropSystem() {
+    if (g_PropRenderer) {
+        delete g_PropRenderer;
+        g_PropRenderer = nullptr;
+    }
+    TraceLog(LOG_INFO, "Prop system cleaned up");
+}
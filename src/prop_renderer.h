@@ -0,0 +1,94 @@
+#pragma once
+#include "globals.h"
+#include "map.h"
+#include "culling.h"
+#include "portal_graph.h"
+#include <vector>
+#include <unordered_map>
+#include <string>
+
+// Interior tiles that are props: IT_BED .. IT_COOLANT_PUDDLE
+#define PROP_FIRST_TILE IT_BED
+#define PROP_TYPE_COUNT (IT_COOLANT_PUDDLE - IT_BED + 1)
+
+// Per-frame counters
+struct PropStats {
+    int instances;    // Props in the current interior
+    int drawn;        // Props that passed portal and frustum culling
+    int drawCalls;
+};
+
+// Prop renderer class
+// Every prop tile type gets one small mesh built from boxes at startup. The
+// prop tiles of an interior are gathered into per-type instance lists once
+// (cached by Interior::id like the interior shells), and each frame the visible
+// instances of a type go out in a single DrawMeshInstanced call. Without the
+// instanced shader the same meshes are queued one instance at a time.
+class PropRenderer {
+public:
+    PropRenderer();
+    ~PropRenderer();
+
+    // Build the prop meshes and material (needs the texture and shader managers)
+    void Initialize();
+
+    // Gather the prop instances of every interior in a freshly generated map
+    void BakeInteriors(const MapData& mapData);
+
+    // Draw the props of an interior. With a portal graph, only props in cells
+    // marked in visibleCells are drawn.
+    void DrawInterior(const Interior& interior, const PortalGraph* graph,
+        const std::vector<unsigned char>* visibleCells);
+
+    // Draw every prop of an interior straight away with the given depth materials
+    // (shadow pass: no culling, no render queue). Returns the number of draw calls.
+    int DrawInteriorShadowCasters(const Interior& interior, const Material& depthMaterial,
+        const Material& depthInstancedMaterial);
+
+    // True if a tile id has a prop mesh
+    static bool IsPropTile(int tile) { return tile >= PROP_FIRST_TILE && tile < PROP_FIRST_TILE + PROP_TYPE_COUNT; }
+
+    const PropStats& GetStats() const { return stats; }
+
+    // Release meshes and cached instance lists
+    void Unload();
+
+private:
+    // All instances of one prop type in one interior
+    struct PropBatch {
+        std::vector<Matrix> transforms;
+        std::vector<int> cells;           // Portal cell per instance (-1 = none)
+        CullBoxList bounds;
+        std::vector<Matrix> visible;      // Rebuilt every frame, read by the render queue at flush
+    };
+
+    struct PropSet {
+        PropBatch batches[PROP_TYPE_COUNT];
+        int instanceCount;
+    };
+
+    Mesh meshes[PROP_TYPE_COUNT];
+    BoundingBox meshBounds[PROP_TYPE_COUNT];
+    Material material;
+    bool initialized;
+    bool instanced;
+
+    std::unordered_map<std::string, PropSet> propSets;
+    std::vector<unsigned char> visibility;
+    PropStats stats;
+
+    // Build the box mesh for one prop type (layer >= 0 parts need surface textures)
+    Mesh BuildPropMesh(int tile, bool layered);
+
+    // Gather an interior's props into per-type batches
+    PropSet BuildPropSet(const Interior& interior);
+};
+
+// Global prop renderer instance
+extern PropRenderer* g_PropRenderer;
+
+// Initialize prop renderer
+void InitializePropSystem();
+
+// Cleanup prop renderer
+void CleanupPropSystem();
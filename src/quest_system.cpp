@@ -1,6 +1,84 @@
 #include "quest_system.h"
+#include "ui_cache.h"
+#include <algorithm>
 
 // Global instance definitions
 PlayerProgression g_PlayerProgression;
 QuestManager g_QuestManager;
-SkillTree g_SkillTree;
\ No newline at end of file
+SkillTree g_SkillTree;
+
+void QuestManager::DrawQuestTrackerCompact(int screenW, int screenH) {
+    // Only the first active quest is shown; count the rest without building a list
+    const Quest* quest = nullptr;
+    int activeCount = 0;
+    for (const auto& q : quests) {
+        if (q.isActive && !q.isCompleted) {
+            if (!quest) quest = &q;
+            activeCount++;
+        }
+    }
+    if (!quest) return;
+
+    // Find first incomplete objective
+    const QuestObjective* currentObj = nullptr;
+    int currentIndex = -1;
+    for (size_t i = 0; i < quest->objectives.size(); i++) {
+        if (quest->objectives[i].currentCount < quest->objectives[i].targetCount) {
+            currentObj = &quest->objectives[i];
+            currentIndex = (int)i;
+            break;
+        }
+    }
+
+    int trackerX = 10; // Left side
+    int trackerY = 60;
+    int trackerW = 350;
+    int yOffset = 30;
+
+    // Calculate height needed
+    int questH = 50;
+    if (currentObj) questH += 25;
+
+    UiKey key;
+    key.Add(quest->id).Add(activeCount).Add(currentIndex);
+    if (currentObj) key.Add(currentObj->currentCount).Add(currentObj->targetCount);
+
+    // The boxes stay trackerW wide; the panel also covers text that runs past them
+    int panelW = std::max(trackerW, 8 + MeasureText(quest->name.c_str(), 16));
+    panelW = std::max(panelW, 8 + MeasureText(TextFormat("Reward: %d XP", quest->xpReward), 12));
+    if (currentObj) {
+        panelW = std::max(panelW, 8 + MeasureText(TextFormat("[%d/%d] %s", currentObj->currentCount,
+            currentObj->targetCount, currentObj->description.c_str()), 13));
+    }
+
+    DrawRetainedPanel(UI_PANEL_QUEST_TRACKER, trackerX, trackerY, panelW, yOffset + questH + 20, key,
+        [&](int x, int y) {
+            // Header background
+            DrawRectangle(x, y, trackerW, 25, Color{ 0, 0, 0, 180 });
+            DrawText("ACTIVE QUEST", x + 8, y + 6, 14, PIPBOY_GREEN);
+
+            DrawRectangle(x, y + yOffset, trackerW, questH, Color{ 0, 0, 0, 160 });
+            DrawRectangleLines(x, y + yOffset, trackerW, questH, PIPBOY_GREEN);
+
+            // Quest name
+            DrawText(quest->name.c_str(), x + 8, y + yOffset + 5, 16, PIPBOY_GREEN);
+
+            // XP reward
+            DrawText(TextFormat("Reward: %d XP", quest->xpReward), x + 8, y + yOffset + 25, 12, PIPBOY_DIM);
+
+            // Show current objective
+            if (currentObj) {
+                Color objColor = (currentObj->currentCount >= currentObj->targetCount) ?
+                    Color{ 50, 255, 50, 255 } : PIPBOY_GREEN;
+
+                DrawText(TextFormat("[%d/%d] %s", currentObj->currentCount, currentObj->targetCount,
+                    currentObj->description.c_str()),
+                    x + 8, y + yOffset + 45, 13, objColor);
+            }
+
+            // Show if more quests exist
+            if (activeCount > 1) {
+                DrawText(TextFormat("+%d more", activeCount - 1), x + 8, y + yOffset + questH + 5, 11, PIPBOY_DIM);
+            }
+        });
+}
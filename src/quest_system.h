@@ -163,64 +163,8 @@ public:
     }
 
     // NEW: Compact HUD tracker - shows only one objective per quest on left side
-    void DrawQuestTrackerCompact(int screenW, int screenH) {
-        auto activeQuests = GetActiveQuests();
-        if (activeQuests.empty()) return;
-
-        int trackerX = 10; // Left side
-        int trackerY = 60;
-        int trackerW = 350;
-
-        // Header background
-        DrawRectangle(trackerX, trackerY, trackerW, 25, Color{ 0, 0, 0, 180 });
-        DrawText("ACTIVE QUEST", trackerX + 8, trackerY + 6, 14, PIPBOY_GREEN);
-
-        int yOffset = 30;
-
-        // Show only the first active quest with first incomplete objective
-        if (!activeQuests.empty()) {
-            const Quest* quest = activeQuests[0];
-
-            // Find first incomplete objective
-            const QuestObjective* currentObj = nullptr;
-            for (const auto& obj : quest->objectives) {
-                if (obj.currentCount < obj.targetCount) {
-                    currentObj = &obj;
-                    break;
-                }
-            }
-
-            // Calculate height needed
-            int questH = 50;
-            if (currentObj) questH += 25;
-
-            DrawRectangle(trackerX, trackerY + yOffset, trackerW, questH, Color{ 0, 0, 0, 160 });
-            DrawRectangleLines(trackerX, trackerY + yOffset, trackerW, questH, PIPBOY_GREEN);
-
-            // Quest name
-            DrawText(quest->name.c_str(), trackerX + 8, trackerY + yOffset + 5, 16, PIPBOY_GREEN);
-
-            // XP reward
-            DrawText(TextFormat("Reward: %d XP", quest->xpReward),
-                trackerX + 8, trackerY + yOffset + 25, 12, PIPBOY_DIM);
-
-            // Show current objective
-            if (currentObj) {
-                Color objColor = (currentObj->currentCount >= currentObj->targetCount) ?
-                    Color{ 50, 255, 50, 255 } : PIPBOY_GREEN;
-
-                DrawText(TextFormat("[%d/%d] %s", currentObj->currentCount, currentObj->targetCount,
-                    currentObj->description.c_str()),
-                    trackerX + 8, trackerY + yOffset + 45, 13, objColor);
-            }
-
-            // Show if more quests exist
-            if (activeQuests.size() > 1) {
-                DrawText(TextFormat("+%d more", (int)activeQuests.size() - 1),
-                    trackerX + 8, trackerY + yOffset + questH + 5, 11, PIPBOY_DIM);
-            }
-        }
-    }
+    // (retained panel, repainted when the tracked quest or its progress changes)
+    void DrawQuestTrackerCompact(int screenW, int screenH);
 
 private:
     std::vector<Quest> quests;
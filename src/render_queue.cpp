@@ -0,0 +1,499 @@
+#include "render_queue.h"
+#include "profiler.h"
+#include "texture_manager.h"
+#include "geometry_streamer.h"
+#include "raymath.h"
+#include "rlgl.h"
+#include <algorithm>
+#include <cstring>
+#include <cfloat>
+
+// Global instance
+RenderQueue* g_RenderQueue = nullptr;
+
+// Helper to draw textured cubes (defined in main.cpp)
+void DrawCubeTexture(Texture2D texture, Vector3 position, float width, float height, float length, Color color);
+
+// Primitive codes for the sort key; rlgl starts a new batch draw whenever the mode changes
+enum {
+    PRIM_QUADS = 0,
+    PRIM_TRIANGLES = 1,
+    PRIM_LINES = 2,
+    PRIM_MESH = 3
+};
+
+// rlgl default batch limits (RL_DEFAULT_BATCH_BUFFER_ELEMENTS quads, RL_DEFAULT_BATCH_DRAWCALLS)
+static const int RLGL_BATCH_VERTICES = 8192 * 4;
+static const int RLGL_BATCH_DRAWS = 256;
+
+// Surface materials carry the full-feature shader; draws use this frame's variant
+static Material SelectShaderVariant(const Material& material) {
+    Material selected = material;
+    if (g_ShaderManager) selected.shader = g_ShaderManager->SelectVariant(material.shader);
+    return selected;
+}
+
+// Hand untextured shapes to the geometry streamer; false if it cannot take them
+static bool StreamCommand(const RenderCommand& cmd) {
+    switch (cmd.type) {
+    case RCMD_CUBE: return g_GeometryStreamer->AddCube(cmd.position, cmd.size, cmd.color);
+    case RCMD_SPHERE: return g_GeometryStreamer->AddSphere(cmd.position, cmd.size.x, cmd.color);
+    case RCMD_LINE: return g_GeometryStreamer->AddLine(cmd.position, cmd.size, cmd.color);
+    default: return false;
+    }
+}
+
+static bool IsStreamable(RenderCommandType type) {
+    return type == RCMD_CUBE || type == RCMD_SPHERE || type == RCMD_LINE;
+}
+
+// Priority multiplier per RenderImportance (CRITICAL is never skipped)
+static const float IMPORTANCE_WEIGHT[RENDER_IMPORTANCE_COUNT] = { 0.25f, 1.0f, 4.0f, 0.0f };
+
+RenderQueue::RenderQueue() {
+    viewPosition = Vector3{ 0.0f, 0.0f, 0.0f };
+    currentPass = RENDER_PASS_OPAQUE;
+    currentImportance = RENDER_IMPORTANCE_NORMAL;
+    budget = 0;
+    recording = false;
+    defaultShaderId = 0;
+    defaultTextureId = 0;
+    lastStats = { 0, 0, 0, 0 };
+    commands.reserve(4096);
+    order.reserve(4096);
+}
+
+uint64_t RenderQueue::MakeKey(RenderPass pass, unsigned int shaderId, int primitive, unsigned int textureId, float depth) {
+    // Non-negative floats keep their order when compared as integers
+    uint32_t depthBits = 0;
+    if (depth > 0.0f) memcpy(&depthBits, &depth, sizeof(depthBits));
+    if (pass == RENDER_PASS_TRANSPARENT) {
+        // Depth leads so blending is back to front across shaders and textures
+        depthBits = 0xFFFFFFFFu - depthBits;
+        return ((uint64_t)(pass & 0xF) << 60) |
+            ((uint64_t)depthBits << 28) |
+            ((uint64_t)(shaderId & 0x3FF) << 18) |
+            ((uint64_t)(primitive & 0x3) << 16) |
+            (uint64_t)(textureId & 0xFFFF);
+    }
+
+    return ((uint64_t)(pass & 0xF) << 60) |
+        ((uint64_t)(shaderId & 0x3FF) << 50) |
+        ((uint64_t)(primitive & 0x3) << 48) |
+        ((uint64_t)(textureId & 0xFFFF) << 32) |
+        (uint64_t)depthBits;
+}
+
+uint32_t RenderQueue::GetKeyState(uint64_t key) {
+    uint32_t pass = (uint32_t)(key >> 60);
+    if (pass == RENDER_PASS_TRANSPARENT) return (pass << 28) | (uint32_t)(key & 0x0FFFFFFF);
+    return (pass << 28) | (uint32_t)((key >> 32) & 0x0FFFFFFF);
+}
+
+void RenderQueue::Begin(const Camera3D& camera) {
+    commands.clear();
+    viewPosition = camera.position;
+    currentPass = RENDER_PASS_OPAQUE;
+    currentImportance = RENDER_IMPORTANCE_NORMAL;
+    defaultShaderId = rlGetShaderIdDefault();
+    defaultTextureId = rlGetTextureIdDefault();
+    recording = true;
+}
+
+RenderPass RenderQueue::ResolvePass(Color color) const {
+    if (currentPass == RENDER_PASS_OPAQUE && color.a < 255) return RENDER_PASS_TRANSPARENT;
+    return currentPass;
+}
+
+RenderQueue::MeshExtent RenderQueue::GetMeshExtent(const Mesh& mesh) {
+    auto it = meshExtents.find(mesh.vaoId);
+    if (mesh.vaoId > 0 && it != meshExtents.end() && it->second.vertexCount == mesh.vertexCount) return it->second;
+
+    // raylib keeps the CPU copy of uploaded meshes, so the bounds can be computed once
+    BoundingBox box = GetMeshBoundingBox(mesh);
+    MeshExtent extent;
+    extent.center = Vector3Scale(Vector3Add(box.min, box.max), 0.5f);
+    extent.radius = Vector3Distance(box.min, box.max) * 0.5f;
+    extent.vertexCount = mesh.vertexCount;
+    if (mesh.vaoId > 0) meshExtents[mesh.vaoId] = extent;
+    return extent;
+}
+
+void RenderQueue::Push(RenderCommand& cmd, RenderPass pass, unsigned int shaderId, int primitive, unsigned int textureId, Vector3 sortPosition, float radius) {
+    if (pass == RENDER_PASS_VIEWMODEL) {
+        // View model pieces overlap each other; keep submission order within a state group
+        cmd.key = MakeKey(pass, shaderId, primitive, textureId, 0.0f) | (uint64_t)commands.size();
+    }
+    else {
+        cmd.key = MakeKey(pass, shaderId, primitive, textureId, Vector3DistanceSqr(viewPosition, sortPosition));
+    }
+
+    // Budget priority: roughly the projected size, scaled by gameplay importance
+    if (pass == RENDER_PASS_VIEWMODEL || currentImportance == RENDER_IMPORTANCE_CRITICAL) {
+        cmd.priority = FLT_MAX;
+    }
+    else {
+        float distance = fmaxf(Vector3Distance(viewPosition, sortPosition) - radius, 0.5f);
+        cmd.priority = IMPORTANCE_WEIGHT[currentImportance] * radius / distance;
+    }
+
+    if (pass == RENDER_PASS_VIEWMODEL) cmd.statPass = STAT_PASS_VIEWMODEL;
+    else cmd.statPass = g_RenderStats ? g_RenderStats->GetPass() : STAT_PASS_OTHER;
+    commands.push_back(cmd);
+}
+
+void RenderQueue::SubmitCube(Vector3 position, Vector3 size, Color color) {
+    RenderCommand cmd = {};
+    cmd.type = RCMD_CUBE;
+    cmd.position = position;
+    cmd.size = size;
+    cmd.color = color;
+    Push(cmd, ResolvePass(color), defaultShaderId, PRIM_TRIANGLES, defaultTextureId, position, Vector3Length(size) * 0.5f);
+}
+
+void RenderQueue::SubmitCubeTexture(Texture2D texture, Vector3 position, Vector3 size, Color color) {
+    RenderCommand cmd = {};
+    cmd.type = RCMD_CUBE_TEXTURED;
+    cmd.position = position;
+    cmd.size = size;
+    cmd.color = color;
+    cmd.texture = texture;
+    Push(cmd, ResolvePass(color), defaultShaderId, PRIM_QUADS, texture.id, position, Vector3Length(size) * 0.5f);
+}
+
+void RenderQueue::SubmitSphere(Vector3 center, float radius, Color color) {
+    RenderCommand cmd = {};
+    cmd.type = RCMD_SPHERE;
+    cmd.position = center;
+    cmd.size = Vector3{ radius, radius, radius };
+    cmd.color = color;
+    Push(cmd, ResolvePass(color), defaultShaderId, PRIM_TRIANGLES, defaultTextureId, center, radius);
+}
+
+void RenderQueue::SubmitLine(Vector3 start, Vector3 end, Color color) {
+    RenderCommand cmd = {};
+    cmd.type = RCMD_LINE;
+    cmd.position = start;
+    cmd.size = end;
+    cmd.color = color;
+    Push(cmd, ResolvePass(color), defaultShaderId, PRIM_LINES, defaultTextureId,
+        Vector3Lerp(start, end, 0.5f), Vector3Distance(start, end) * 0.5f);
+}
+
+void RenderQueue::SubmitMesh(const Mesh& mesh, const Material& material, Matrix transform) {
+    RenderCommand cmd = {};
+    cmd.type = RCMD_MESH;
+    cmd.mesh = mesh;
+    cmd.material = SelectShaderVariant(material);
+    cmd.transform = transform;
+    cmd.color = WHITE;
+    // Baked world meshes use an identity transform, so sort by the bounds center
+    MeshExtent extent = GetMeshExtent(mesh);
+    Vector3 center = Vector3Transform(extent.center, transform);
+    Push(cmd, currentPass, cmd.material.shader.id, PRIM_MESH, material.maps[MATERIAL_MAP_DIFFUSE].texture.id, center, extent.radius);
+}
+
+void RenderQueue::SubmitModel(const Model& model, Matrix transform, Color tint) {
+    // Same transform order as DrawModelEx
+    Matrix world = MatrixMultiply(model.transform, transform);
+
+    for (int i = 0; i < model.meshCount; i++) {
+        const Material& material = model.materials[model.meshMaterial[i]];
+
+        RenderCommand cmd = {};
+        cmd.type = RCMD_MESH;
+        cmd.mesh = model.meshes[i];
+        cmd.material = SelectShaderVariant(material);
+        cmd.transform = world;
+        cmd.color = tint;
+        MeshExtent extent = GetMeshExtent(model.meshes[i]);
+        Vector3 center = Vector3Transform(extent.center, world);
+        Push(cmd, ResolvePass(tint), cmd.material.shader.id, PRIM_MESH, material.maps[MATERIAL_MAP_DIFFUSE].texture.id, center, extent.radius);
+    }
+}
+
+void RenderQueue::SubmitMeshInstanced(const Mesh& mesh, const Material& material, const Matrix* transforms, int instances) {
+    if (instances <= 0) return;
+
+    RenderCommand cmd = {};
+    cmd.type = RCMD_MESH_INSTANCED;
+    cmd.mesh = mesh;
+    cmd.material = SelectShaderVariant(material);
+    cmd.color = WHITE;
+    cmd.instances = transforms;
+    cmd.instanceCount = instances;
+    // Sort by the first instance; a batch spans a whole interior so depth is only a hint
+    MeshExtent extent = GetMeshExtent(mesh);
+    Vector3 origin = Vector3Transform(extent.center, transforms[0]);
+    Push(cmd, currentPass, cmd.material.shader.id, PRIM_MESH, material.maps[MATERIAL_MAP_DIFFUSE].texture.id, origin, extent.radius);
+}
+
+void RenderQueue::Execute(const RenderCommand& cmd) {
+    switch (cmd.type) {
+    case RCMD_CUBE:
+        DrawCubeV(cmd.position, cmd.size, cmd.color);
+        break;
+    case RCMD_CUBE_TEXTURED:
+        DrawCubeTexture(cmd.texture, cmd.position, cmd.size.x, cmd.size.y, cmd.size.z, cmd.color);
+        break;
+    case RCMD_SPHERE:
+        DrawSphere(cmd.position, cmd.size.x, cmd.color);
+        break;
+    case RCMD_LINE:
+        DrawLine3D(cmd.position, cmd.size, cmd.color);
+        break;
+    case RCMD_MESH: {
+        // Apply tint the way DrawModelEx does, restoring the shared material afterwards
+        Color& diffuse = cmd.material.maps[MATERIAL_MAP_DIFFUSE].color;
+        Color original = diffuse;
+        diffuse = Color{
+            (unsigned char)(((int)original.r * (int)cmd.color.r) / 255),
+            (unsigned char)(((int)original.g * (int)cmd.color.g) / 255),
+            (unsigned char)(((int)original.b * (int)cmd.color.b) / 255),
+            (unsigned char)(((int)original.a * (int)cmd.color.a) / 255)
+        };
+        DrawMesh(cmd.mesh, cmd.material, cmd.transform);
+        diffuse = original;
+        break;
+    }
+    case RCMD_MESH_INSTANCED:
+        DrawMeshInstanced(cmd.mesh, cmd.material, cmd.instances, cmd.instanceCount);
+        break;
+    }
+}
+
+void RenderQueue::ApplyBudget() {
+    lastStats.budget = budget;
+    lastStats.skipped = 0;
+    if (budget <= 0 || (int)commands.size() <= budget) return;
+
+    // Keep the highest priority commands; the rest are counted as overflow
+    std::nth_element(commands.begin(), commands.begin() + budget, commands.end(),
+        [](const RenderCommand& a, const RenderCommand& b) { return a.priority > b.priority; });
+
+    // Critical commands always draw, even past the budget
+    auto end = std::partition(commands.begin() + budget, commands.end(),
+        [](const RenderCommand& cmd) { return cmd.priority == FLT_MAX; });
+
+    lastStats.skipped = (int)(commands.end() - end);
+    commands.erase(end, commands.end());
+}
+
+void RenderQueue::RecordStats() {
+    if (!g_RenderStats) return;
+    g_RenderStats->RecordBudget((int)commands.size(), lastStats.budget, lastStats.skipped);
+
+    // Immediate-mode primitives share rlgl's batch: a new draw starts whenever the
+    // primitive or texture changes, and the batch is flushed when its vertex buffer
+    // or draw list fills up, plus once at EndMode3D. Meshes are one draw each.
+    // Streamed shapes are one draw per consecutive run of triangles or lines, and
+    // each run flushes whatever rlgl had batched before it.
+    bool streaming = g_GeometryStreamer && g_GeometryStreamer->IsReady();
+    int batchVertices = 0;
+    int batchDraws = 0;
+    uint32_t lastImmediateState = ~0u;
+    int lastStreamMode = -1;
+    unsigned int lastShader = ~0u;
+    unsigned int lastTexture = ~0u;
+
+    for (const SortEntry& entry : order) {
+        const RenderCommand& cmd = commands[entry.index];
+        uint32_t state = GetKeyState(cmd.key);
+        unsigned int shader = (state >> 18) & 0x3FF;
+        unsigned int texture = state & 0xFFFF;
+        if (shader != lastShader) g_RenderStats->RecordShaderBind();
+        if (texture != lastTexture) g_RenderStats->RecordTextureBind();
+        lastShader = shader;
+        lastTexture = texture;
+
+        int vertices = 0;
+        int triangles = 0;
+        switch (cmd.type) {
+        case RCMD_CUBE: vertices = 36; triangles = 12; break;
+        case RCMD_CUBE_TEXTURED: vertices = 24; triangles = 12; break;
+        case RCMD_SPHERE:
+            // DrawSphere tessellates (16 + 2) rings x 16 slices per call; the streamer's
+            // template has 16 x 16 quads, two triangles each
+            vertices = streaming ? STREAM_SPHERE_VERTICES : 1728;
+            triangles = streaming ? STREAM_SPHERE_VERTICES / 3 : 576;
+            break;
+        case RCMD_LINE: vertices = 2; break;
+        case RCMD_MESH:
+            g_RenderStats->RecordDraw(cmd.statPass, 1, cmd.mesh.vertexCount, cmd.mesh.triangleCount);
+            lastImmediateState = ~0u;
+            lastStreamMode = -1;
+            continue;
+        case RCMD_MESH_INSTANCED:
+            g_RenderStats->RecordDraw(cmd.statPass, 1, cmd.mesh.vertexCount * cmd.instanceCount,
+                cmd.mesh.triangleCount * cmd.instanceCount);
+            lastImmediateState = ~0u;
+            lastStreamMode = -1;
+            continue;
+        }
+
+        if (streaming && IsStreamable(cmd.type)) {
+            int mode = (cmd.type == RCMD_LINE) ? 1 : 0;
+            int draws = (mode != lastStreamMode) ? 1 : 0;
+            if (draws && batchVertices > 0) {
+                g_RenderStats->RecordBatchFlushes(1);
+                batchVertices = 0;
+                batchDraws = 0;
+            }
+            lastStreamMode = mode;
+            lastImmediateState = ~0u;
+            g_RenderStats->RecordDraw(cmd.statPass, draws, vertices, triangles);
+            continue;
+        }
+        lastStreamMode = -1;
+
+        int draws = 0;
+        if (state != lastImmediateState) {
+            draws = 1;
+            lastImmediateState = state;
+            if (++batchDraws >= RLGL_BATCH_DRAWS) {
+                g_RenderStats->RecordBatchFlushes(1);
+                batchDraws = 0;
+                batchVertices = 0;
+            }
+        }
+        batchVertices += vertices;
+        if (batchVertices >= RLGL_BATCH_VERTICES) {
+            g_RenderStats->RecordBatchFlushes(1);
+            batchVertices = 0;
+            batchDraws = 0;
+        }
+        g_RenderStats->RecordDraw(cmd.statPass, draws, vertices, triangles);
+    }
+    if (batchVertices > 0) g_RenderStats->RecordBatchFlushes(1);
+}
+
+void RenderQueue::Flush() {
+    PROFILE_SCOPE("RenderQueue::Flush");
+    recording = false;
+
+    ApplyBudget();
+
+    order.resize(commands.size());
+    for (size_t i = 0; i < commands.size(); i++) {
+        order[i].key = commands[i].key;
+        order[i].index = (uint32_t)i;
+    }
+    std::sort(order.begin(), order.end(),
+        [](const SortEntry& a, const SortEntry& b) { return a.key < b.key; });
+    RecordStats();
+
+    lastStats.commands = (int)commands.size();
+    lastStats.stateChanges = 0;
+
+    // Untextured shapes go through the streaming buffer; anything else first draws the
+    // pending run so the sorted order is kept
+    bool streaming = g_GeometryStreamer && g_GeometryStreamer->IsReady();
+    if (streaming) g_GeometryStreamer->BeginFrame();
+
+    uint32_t lastState = ~0u;
+    for (const SortEntry& entry : order) {
+        const RenderCommand& cmd = commands[entry.index];
+        uint32_t state = GetKeyState(cmd.key);
+        if (state != lastState) {
+            lastStats.stateChanges++;
+            lastState = state;
+        }
+        if (streaming) {
+            if (StreamCommand(cmd)) continue;
+            g_GeometryStreamer->Draw();
+        }
+        Execute(cmd);
+    }
+
+    if (streaming) g_GeometryStreamer->EndFrame();
+    commands.clear();
+    order.clear();
+}
+
+RenderImportanceScope::RenderImportanceScope(RenderImportance importance) {
+    previous = g_RenderQueue ? g_RenderQueue->GetImportance() : RENDER_IMPORTANCE_NORMAL;
+    if (g_RenderQueue) g_RenderQueue->SetImportance(importance);
+}
+
+RenderImportanceScope::~RenderImportanceScope() {
+    if (g_RenderQueue) g_RenderQueue->SetImportance(previous);
+}
+
+// =============================================================================
+// SUBMIT HELPERS
+// =============================================================================
+
+void QueueCube(Vector3 position, float width, float height, float length, Color color) {
+    QueueCubeV(position, Vector3{ width, height, length }, color);
+}
+
+void QueueCubeV(Vector3 position, Vector3 size, Color color) {
+    if (g_RenderQueue && g_RenderQueue->IsRecording()) g_RenderQueue->SubmitCube(position, size, color);
+    else DrawCubeV(position, size, color);
+}
+
+void QueueCubeTexture(Texture2D texture, Vector3 position, float width, float height, float length, Color color) {
+    if (g_RenderQueue && g_RenderQueue->IsRecording()) {
+        g_RenderQueue->SubmitCubeTexture(texture, position, Vector3{ width, height, length }, color);
+    }
+    else {
+        DrawCubeTexture(texture, position, width, height, length, color);
+    }
+}
+
+void QueueSphere(Vector3 center, float radius, Color color) {
+    if (g_RenderQueue && g_RenderQueue->IsRecording()) g_RenderQueue->SubmitSphere(center, radius, color);
+    else DrawSphere(center, radius, color);
+}
+
+void QueueLine3D(Vector3 start, Vector3 end, Color color) {
+    if (g_RenderQueue && g_RenderQueue->IsRecording()) g_RenderQueue->SubmitLine(start, end, color);
+    else DrawLine3D(start, end, color);
+}
+
+void QueueMesh(const Mesh& mesh, const Material& material, Matrix transform) {
+    if (g_RenderQueue && g_RenderQueue->IsRecording()) g_RenderQueue->SubmitMesh(mesh, material, transform);
+    else DrawMesh(mesh, SelectShaderVariant(material), transform);
+}
+
+void QueueModel(const Model& model, Matrix transform, Color tint) {
+    if (g_RenderQueue && g_RenderQueue->IsRecording()) {
+        g_RenderQueue->SubmitModel(model, transform, tint);
+    }
+    else {
+        // DrawModel reads the shared materials, so swap in the variants for the draw
+        std::vector<Shader> shaders(model.materialCount);
+        for (int i = 0; i < model.materialCount; i++) {
+            shaders[i] = model.materials[i].shader;
+            model.materials[i].shader = SelectShaderVariant(model.materials[i]).shader;
+        }
+        rlPushMatrix();
+        rlMultMatrixf(MatrixToFloat(transform));
+        DrawModel(model, Vector3{ 0.0f, 0.0f, 0.0f }, 1.0f, tint);
+        rlPopMatrix();
+        for (int i = 0; i < model.materialCount; i++) model.materials[i].shader = shaders[i];
+    }
+}
+
+void QueueMeshInstanced(const Mesh& mesh, const Material& material, const Matrix* transforms, int instances) {
+    if (g_RenderQueue && g_RenderQueue->IsRecording()) {
+        g_RenderQueue->SubmitMeshInstanced(mesh, material, transforms, instances);
+    }
+    else if (instances > 0) {
+        DrawMeshInstanced(mesh, SelectShaderVariant(material), transforms, instances);
+    }
+}
+
+// Global initialization
+void InitializeRenderQueue() {
+    g_RenderQueue = new RenderQueue();
+    TraceLog(LOG_INFO, "Render queue initialized");
+}
+
+void CleanupRenderQueue() {
+    if (g_RenderQueue) {
+        delete g_RenderQueue;
+        g_RenderQueue = nullptr;
+    }
+    TraceLog(LOG_INFO, "Render queue cleaned up");
+}
@@ -0,0 +1,171 @@
+#pragma once
+// NOTE: only raylib here - waypoints.h (pulled in by globals.h) submits into the queue
+#include "raylib.h"
+#include "render_stats.h"
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+// Render passes, drawn in this order
+enum RenderPass {
+    RENDER_PASS_OPAQUE = 0,       // World geometry, front to back
+    RENDER_PASS_TRANSPARENT,      // Alpha-blended world geometry, back to front
+    RENDER_PASS_VIEWMODEL,        // Weapons and hands, drawn last in submission order
+    RENDER_PASS_COUNT
+};
+
+// Gameplay weight of following submissions when the draw budget is exceeded
+enum RenderImportance {
+    RENDER_IMPORTANCE_LOW = 0,    // Decoration (props)
+    RENDER_IMPORTANCE_NORMAL,     // World geometry
+    RENDER_IMPORTANCE_HIGH,       // Things the player interacts with (doors, waypoints)
+    RENDER_IMPORTANCE_CRITICAL,   // Never skipped (view model)
+    RENDER_IMPORTANCE_COUNT
+};
+
+// What a queued command draws
+enum RenderCommandType {
+    RCMD_CUBE,
+    RCMD_CUBE_TEXTURED,
+    RCMD_SPHERE,
+    RCMD_LINE,
+    RCMD_MESH,
+    RCMD_MESH_INSTANCED
+};
+
+// One deferred draw. Sort key layout (most significant first):
+//   opaque, viewmodel: [63..60] pass  [59..50] shader  [49..48] primitive  [47..32] texture  [31..0] depth
+//   transparent:       [63..60] pass  [59..28] inverted depth  [27..18] shader  [17..16] primitive  [15..0] texture
+// so transparent draws are back to front across the whole pass, state groups only break ties.
+struct RenderCommand {
+    uint64_t key;
+    RenderCommandType type;
+    Vector3 position;   // Cube/sphere center, line start
+    Vector3 size;       // Cube size, sphere radius in x, line end
+    Color color;
+    Texture2D texture;
+    Mesh mesh;
+    Material material;
+    Matrix transform;
+    const Matrix* instances;   // Instanced meshes: transforms, owned by the submitter until Flush
+    int instanceCount;
+    float priority;            // Importance weight x projected size; higher survives the budget
+    RenderStatPass statPass;   // Where the draw is counted in the render stats
+};
+
+// Per-flush counters
+struct RenderQueueStats {
+    int commands;       // Commands drawn
+    int stateChanges;   // Number of shader/primitive/texture switches while flushing
+    int skipped;        // Commands dropped by the draw budget
+    int budget;         // Budget in effect (0 = unlimited)
+};
+
+// Render queue class
+// Collects 3D draws for a frame, sorts them by state and depth, then issues them
+// in one pass so rlgl can keep batching instead of flushing on every texture swap.
+// Every command counts as one submission against the per-frame draw budget
+// (GraphicsSettings::maxDrawCalls); when a frame goes over, the lowest priority
+// commands are skipped and counted instead of drawn.
+class RenderQueue {
+public:
+    RenderQueue();
+
+    // Start recording; the camera position is used for depth sorting
+    void Begin(const Camera3D& camera);
+
+    // Sort and draw everything recorded since Begin (call before EndMode3D)
+    void Flush();
+
+    // True between Begin and Flush
+    bool IsRecording() const { return recording; }
+
+    // Pass used for following submissions (alpha colors in the opaque pass go to transparent)
+    void SetPass(RenderPass pass) { currentPass = pass; }
+
+    // Importance used for following submissions (reset to NORMAL by Begin)
+    void SetImportance(RenderImportance importance) { currentImportance = importance; }
+    RenderImportance GetImportance() const { return currentImportance; }
+
+    // Maximum commands drawn per flush (0 = unlimited)
+    void SetDrawBudget(int maxCommands) { budget = maxCommands; }
+
+    void SubmitCube(Vector3 position, Vector3 size, Color color);
+    void SubmitCubeTexture(Texture2D texture, Vector3 position, Vector3 size, Color color);
+    void SubmitSphere(Vector3 center, float radius, Color color);
+    void SubmitLine(Vector3 start, Vector3 end, Color color);
+    void SubmitMesh(const Mesh& mesh, const Material& material, Matrix transform);
+    void SubmitModel(const Model& model, Matrix transform, Color tint);
+    void SubmitMeshInstanced(const Mesh& mesh, const Material& material, const Matrix* transforms, int instances);
+
+    const RenderQueueStats& GetLastStats() const { return lastStats; }
+
+    // Build a sort key from its fields
+    static uint64_t MakeKey(RenderPass pass, unsigned int shaderId, int primitive, unsigned int textureId, float depth);
+
+    // Pass, shader, primitive and texture of a key, packed the same way for either layout
+    static uint32_t GetKeyState(uint64_t key);
+
+private:
+    // Sorting moves these instead of whole commands
+    struct SortEntry {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    std::vector<RenderCommand> commands;
+    std::vector<SortEntry> order;   // Commands in draw order, rebuilt at Flush
+    Vector3 viewPosition;
+    RenderPass currentPass;
+    RenderImportance currentImportance;
+    int budget;
+    bool recording;
+    unsigned int defaultShaderId;
+    unsigned int defaultTextureId;
+    RenderQueueStats lastStats;
+
+    // Local bounding sphere per uploaded mesh, keyed by VAO id
+    struct MeshExtent {
+        Vector3 center;
+        float radius;
+        int vertexCount;   // Guards against a recycled VAO id
+    };
+    std::unordered_map<unsigned int, MeshExtent> meshExtents;
+
+    RenderPass ResolvePass(Color color) const;
+    MeshExtent GetMeshExtent(const Mesh& mesh);
+    void Push(RenderCommand& cmd, RenderPass pass, unsigned int shaderId, int primitive, unsigned int textureId, Vector3 sortPosition, float radius);
+    void ApplyBudget();
+    void RecordStats();
+    void Execute(const RenderCommand& cmd);
+};
+
+// Global render queue instance
+extern RenderQueue* g_RenderQueue;
+
+// Sets the queue importance for the lifetime of the object, then restores it
+class RenderImportanceScope {
+public:
+    explicit RenderImportanceScope(RenderImportance importance);
+    ~RenderImportanceScope();
+
+private:
+    RenderImportance previous;
+};
+
+// Submit helpers: queue the draw while a frame is recording, otherwise draw immediately
+void QueueCube(Vector3 position, float width, float height, float length, Color color);
+void QueueCubeV(Vector3 position, Vector3 size, Color color);
+void QueueCubeTexture(Texture2D texture, Vector3 position, float width, float height, float length, Color color);
+void QueueSphere(Vector3 center, float radius, Color color);
+void QueueLine3D(Vector3 start, Vector3 end, Color color);
+void QueueMesh(const Mesh& mesh, const Material& material, Matrix transform);
+void QueueModel(const Model& model, Matrix transform, Color tint);
+// The transforms must stay valid until the queue is flushed
+void QueueMeshInstanced(const Mesh& mesh, const Material& material, const Matrix* transforms, int instances);
+
+// Initialize render queue
+void InitializeRenderQueue();
+
+// Cleanup render queue
+void CleanupRenderQueue();
@@ -0,0 +1,147 @@
+#include "render_stats.h"
+#include "globals.h"
+#include <cstdio>
+
+// Global instance
+RenderStats* g_RenderStats = nullptr;
+
+static const char* PASS_NAMES[STAT_PASS_COUNT] = {
+    "Ground",
+    "Buildings",
+    "Interior",
+    "Props",
+    "Doors",
+    "Viewmodel",
+    "Shadows",
+    "UI",
+    "Other"
+};
+
+PassStats FrameRenderStats::Total() const {
+    PassStats total = { 0, 0, 0, 0, 0 };
+    for (int i = 0; i < STAT_PASS_COUNT; i++) {
+        total.drawCalls += passes[i].drawCalls;
+        total.vertices += passes[i].vertices;
+        total.triangles += passes[i].triangles;
+        total.drawn += passes[i].drawn;
+        total.culled += passes[i].culled;
+    }
+    return total;
+}
+
+RenderStats::RenderStats() {
+    frame = {};
+    last = {};
+    currentPass = STAT_PASS_OTHER;
+    uiStart = 0.0;
+    expanded = false;
+}
+
+void RenderStats::BeginFrame() {
+    last = frame;
+    frame = {};
+    currentPass = STAT_PASS_OTHER;
+    // Outside gameplay the whole frame is UI
+    uiStart = GetTime();
+}
+
+void RenderStats::RecordDraw(RenderStatPass pass, int drawCalls, int vertices, int triangles) {
+    PassStats& stats = frame.passes[pass];
+    stats.drawCalls += drawCalls;
+    stats.vertices += vertices;
+    stats.triangles += triangles;
+}
+
+void RenderStats::RecordObjects(RenderStatPass pass, int drawn, int culled) {
+    frame.passes[pass].drawn += drawn;
+    frame.passes[pass].culled += culled;
+}
+
+void RenderStats::BeginUi() {
+    uiStart = GetTime();
+}
+
+void RenderStats::EndUi() {
+    frame.uiMs = (float)((GetTime() - uiStart) * 1000.0);
+}
+
+const char* RenderStats::GetPassName(RenderStatPass pass) {
+    return (pass >= 0 && pass < STAT_PASS_COUNT) ? PASS_NAMES[pass] : "?";
+}
+
+int RenderStats::DrawOverlay(int x, int y) const {
+    const int lineHeight = 18;
+    PassStats total = last.Total();
+
+    // The budget limits queued commands, so it is shown next to the draw calls they became
+    char budgetText[64] = "";
+    if (last.budget > 0) {
+        snprintf(budgetText, sizeof(budgetText), " (queued %d / %d budget, %d skipped)", last.queued, last.budget, last.skipped);
+    }
+    DrawText(TextFormat("Draws: %d%s  Verts: %d  Tris: %d  Flushes: %d  Tex: %d  Shader: %d",
+        total.drawCalls, budgetText, total.vertices, total.triangles, last.batchFlushes, last.textureBinds, last.shaderBinds),
+        x, y, 16, last.skipped > 0 ? RED : PIPBOY_GREEN);
+    if (!expanded) return lineHeight;
+
+    // Fixed columns: the default font is proportional
+    static const char* headers[6] = { "Pass", "Draws", "Verts", "Tris", "Drawn", "Culled" };
+    static const int columns[6] = { 0, 100, 160, 240, 320, 380 };
+    int row = y + lineHeight + 4;
+    for (int c = 0; c < 6; c++) DrawText(headers[c], x + columns[c], row, 16, PIPBOY_DIM);
+    row += lineHeight;
+
+    for (int i = 0; i < STAT_PASS_COUNT; i++) {
+        const PassStats& p = last.passes[i];
+        DrawText(PASS_NAMES[i], x, row, 16, PIPBOY_GREEN);
+        if (i == STAT_PASS_UI) {
+            DrawText(TextFormat("%.2fms", last.uiMs), x + columns[1], row, 16, PIPBOY_GREEN);
+        }
+        else {
+            int values[5] = { p.drawCalls, p.vertices, p.triangles, p.drawn, p.culled };
+            for (int c = 0; c < 5; c++) {
+                DrawText(TextFormat("%d", values[c]), x + columns[c + 1], row, 16, PIPBOY_GREEN);
+            }
+        }
+        row += lineHeight;
+    }
+    return row - y;
+}
+
+void RenderStats::AppendReport(std::vector<std::string>& lines) const {
+    for (int i = 0; i < STAT_PASS_COUNT; i++) {
+        const PassStats& p = last.passes[i];
+        if (i == STAT_PASS_UI) {
+            lines.push_back(TextFormat("%s: %.2fms", PASS_NAMES[i], last.uiMs));
+            continue;
+        }
+        lines.push_back(TextFormat("%s: %d draws, %d verts, %d tris, %d drawn, %d culled",
+            PASS_NAMES[i], p.drawCalls, p.vertices, p.triangles, p.drawn, p.culled));
+    }
+
+    PassStats total = last.Total();
+    lines.push_back(TextFormat("Total: %d draws, %d verts, %d tris, %d flushes, %d texture binds, %d shader binds, %d skipped",
+        total.drawCalls, total.vertices, total.triangles, last.batchFlushes, last.textureBinds, last.shaderBinds, last.skipped));
+}
+
+RenderStatPassScope::RenderStatPassScope(RenderStatPass pass) {
+    previous = g_RenderStats ? g_RenderStats->GetPass() : STAT_PASS_OTHER;
+    if (g_RenderStats) g_RenderStats->SetPass(pass);
+}
+
+RenderStatPassScope::~RenderStatPassScope() {
+    if (g_RenderStats) g_RenderStats->SetPass(previous);
+}
+
+// Global initialization
+void InitializeRenderStats() {
+    g_RenderStats = new RenderStats();
+    TraceLog(LOG_INFO, "Render stats initialized");
+}
+
+void CleanupRenderStats() {
+    if (g_RenderStats) {
+        delete g_RenderStats;
+        g_RenderStats = nullptr;
+    }
+    TraceLog(LOG_INFO, "Render stats cleaned up");
+}
@@ -0,0 +1,118 @@
+#pragma once
+// NOTE: only raylib here - render_queue.h tags its commands with a stat pass
+#include "raylib.h"
+#include <vector>
+#include <string>
+
+// What a draw is counted under
+enum RenderStatPass {
+    STAT_PASS_GROUND = 0,
+    STAT_PASS_BUILDINGS,
+    STAT_PASS_INTERIOR,
+    STAT_PASS_PROPS,
+    STAT_PASS_DOORS,
+    STAT_PASS_VIEWMODEL,
+    STAT_PASS_SHADOWS,      // Shadow map depth passes
+    STAT_PASS_UI,
+    STAT_PASS_OTHER,        // Waypoints and anything untagged
+    STAT_PASS_COUNT
+};
+
+// Counters for one pass
+struct PassStats {
+    int drawCalls;
+    int vertices;
+    int triangles;
+    int drawn;      // Objects that passed culling
+    int culled;     // Objects rejected by frustum, portal or occlusion culling
+};
+
+// Everything counted during one frame
+struct FrameRenderStats {
+    PassStats passes[STAT_PASS_COUNT];
+    int batchFlushes;    // rlgl batch submissions (estimated from the batch limits)
+    int textureBinds;
+    int shaderBinds;
+    int queued;          // Commands drawn by the render queue
+    int budget;          // Draw budget in effect (0 = unlimited)
+    int skipped;         // Commands dropped by the draw budget
+    float uiMs;          // CPU time spent building the 2D overlay
+
+    PassStats Total() const;
+};
+
+// Render statistics class
+// Collects per-frame counters from the render queue (draws, vertices, binds)
+// and from the cullers (drawn vs culled objects), tagged by pass. The last
+// complete frame is shown by the FPS overlay (F3 expands it to a per-pass
+// table) and printed by the "stats" console command.
+class RenderStats {
+public:
+    RenderStats();
+
+    // Publish the previous frame and start counting a new one
+    void BeginFrame();
+
+    // Pass that following queue submissions are counted under
+    void SetPass(RenderStatPass pass) { currentPass = pass; }
+    RenderStatPass GetPass() const { return currentPass; }
+
+    void RecordDraw(RenderStatPass pass, int drawCalls, int vertices, int triangles);
+    void RecordObjects(RenderStatPass pass, int drawn, int culled);
+    void RecordBatchFlushes(int count) { frame.batchFlushes += count; }
+    void RecordTextureBind() { frame.textureBinds++; }
+    void RecordShaderBind() { frame.shaderBinds++; }
+    void RecordBudget(int queued, int budget, int skipped) {
+        frame.queued += queued;
+        frame.budget = budget;
+        frame.skipped += skipped;
+    }
+
+    // Bracket the 2D overlay drawing to time it
+    void BeginUi();
+    void EndUi();
+
+    // Last complete frame
+    const FrameRenderStats& GetLast() const { return last; }
+
+    // Frame being counted (complete once its draws are flushed)
+    const FrameRenderStats& GetCurrent() const { return frame; }
+
+    bool IsExpanded() const { return expanded; }
+    void ToggleExpanded() { expanded = !expanded; }
+
+    // Draw the overlay at (x, y): a summary line, or the per-pass table when expanded.
+    // Returns the height used.
+    int DrawOverlay(int x, int y) const;
+
+    // One line per pass plus totals, for the console
+    void AppendReport(std::vector<std::string>& lines) const;
+
+    static const char* GetPassName(RenderStatPass pass);
+
+private:
+    FrameRenderStats frame;
+    FrameRenderStats last;
+    RenderStatPass currentPass;
+    double uiStart;
+    bool expanded;
+};
+
+// Global render stats instance
+extern RenderStats* g_RenderStats;
+
+// Sets the stat pass for the lifetime of the object, then restores it
+class RenderStatPassScope {
+public:
+    explicit RenderStatPassScope(RenderStatPass pass);
+    ~RenderStatPassScope();
+
+private:
+    RenderStatPass previous;
+};
+
+// Initialize render stats
+void InitializeRenderStats();
+
+// Cleanup render stats
+void CleanupRenderStats();
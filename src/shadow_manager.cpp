@@ -0,0 +1,467 @@
+#include "shadow_manager.h"
+#include "world_geometry.h"
+#include "prop_renderer.h"
+#include "render_stats.h"
+#include "profiler.h"
+#include "raymath.h"
+#include "rlgl.h"
+#include "external/glad.h"
+#include <cmath>
+#include <cstddef>
+
+// Global instance
+ShadowManager* g_ShadowManager = nullptr;
+
+// Slope-scaled depth bias while rendering casters (keeps acne off lit faces)
+static const float SHADOW_OFFSET_FACTOR = 2.0f;
+static const float SHADOW_OFFSET_UNITS = 4.0f;
+
+// Tallest caster we expect (buildings); pads the caster search for long sun shadows
+static const float SHADOW_CASTER_HEIGHT = 12.0f;
+
+ShadowManager::ShadowManager() {
+    ready = false;
+    spotStatic = { 0, 0, 0, 0 };
+    spotFinal = { 0, 0, 0, 0 };
+    sunStatic = { 0, 0, 0, 0 };
+    sunFinal = { 0, 0, 0, 0 };
+    spotTexture = 0;
+    sunTexture = 0;
+    depthShader = { 0 };
+    depthInstancedShader = { 0 };
+    depthMaterial = { 0 };
+    depthInstancedMaterial = { 0 };
+    pcfKernel = 0;
+    spotActive = false;
+    sunActive = false;
+    spotValid = false;
+    spotPosition = Vector3{ 0.0f, 0.0f, 0.0f };
+    spotDirection = Vector3{ 0.0f, 0.0f, 1.0f };
+    spotView = MatrixIdentity();
+    spotProjection = MatrixIdentity();
+    spotMatrix = MatrixIdentity();
+    for (int c = 0; c < SHADOW_CASCADES; c++) {
+        cascadeValid[c] = false;
+        cascadeCenter[c] = Vector3{ 0.0f, 0.0f, 0.0f };
+        cascadeProjections[c] = MatrixIdentity();
+        cascadeMatrices[c] = MatrixIdentity();
+    }
+    sunView = MatrixIdentity();
+    stats = { 0, 0, 0 };
+    savedProjection = MatrixIdentity();
+    savedModelview = MatrixIdentity();
+    savedFramebuffer = 0;
+    for (int i = 0; i < 4; i++) savedViewport[i] = 0;
+}
+
+ShadowManager::~ShadowManager() {
+    Unload();
+}
+
+bool ShadowManager::CreateTarget(DepthTarget& target, int width, int height) {
+    target = { 0, 0, width, height };
+    glGenTextures(1, &target.texture);
+    glBindTexture(GL_TEXTURE_2D, target.texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+    // Hardware depth compare with bilinear filtering: every PCF tap is already a 2x2 blend
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    GLint previous = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previous);
+    glGenFramebuffers(1, &target.framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, target.framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, target.texture, 0);
+    // Depth only
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)previous);
+
+    return target.texture != 0 && target.framebuffer != 0 && complete;
+}
+
+void ShadowManager::DestroyTarget(DepthTarget& target) {
+    if (target.framebuffer) glDeleteFramebuffers(1, &target.framebuffer);
+    if (target.texture) glDeleteTextures(1, &target.texture);
+    target = { 0, 0, 0, 0 };
+}
+
+bool ShadowManager::Initialize() {
+    TraceLog(LOG_INFO, "Initializing Shadow Manager...");
+
+    // The world shaders declare ShadowBlock either way; with shadows unavailable it stays all off
+    if (shadowBlock.Create("ShadowBlock", UNIFORM_BINDING_SHADOW, (int)sizeof(ShadowUniforms))) {
+        Vector3 sun = Vector3Normalize(SHADOW_SUN_DIRECTION);
+        shadowBlock.Set(offsetof(ShadowUniforms, sunDirection), Vector4{ sun.x, sun.y, sun.z, 0.45f });
+        shadowBlock.Set(offsetof(ShadowUniforms, cascadeSplits),
+            Vector4{ SHADOW_CASCADE_SPLITS[0], SHADOW_CASCADE_SPLITS[1], SHADOW_CASCADE_SPLITS[2], 0.0f });
+        shadowBlock.Upload();
+    }
+
+    if (!FileExists("assets/shaders/shadow_depth.vs") || !FileExists("assets/shaders/shadow_depth_instanced.vs") ||
+        !FileExists("assets/shaders/shadow_depth.fs")) {
+        TraceLog(LOG_WARNING, "Shadow depth shaders not found, shadows disabled");
+        return false;
+    }
+
+    depthShader = LoadShader("assets/shaders/shadow_depth.vs", "assets/shaders/shadow_depth.fs");
+    depthInstancedShader = LoadShader("assets/shaders/shadow_depth_instanced.vs", "assets/shaders/shadow_depth.fs");
+    if (depthShader.id == 0 || depthShader.id == rlGetShaderIdDefault() ||
+        depthInstancedShader.id == 0 || depthInstancedShader.id == rlGetShaderIdDefault()) {
+        TraceLog(LOG_WARNING, "Shadow depth shaders failed to compile, shadows disabled");
+        Unload();
+        return false;
+    }
+    // DrawMeshInstanced streams the transforms into the model matrix attribute
+    depthInstancedShader.locs[SHADER_LOC_MATRIX_MODEL] = GetShaderLocationAttrib(depthInstancedShader, "instanceTransform");
+
+    depthMaterial = LoadMaterialDefault();
+    depthMaterial.shader = depthShader;
+    depthInstancedMaterial = LoadMaterialDefault();
+    depthInstancedMaterial.shader = depthInstancedShader;
+
+    bool created = CreateTarget(spotStatic, SHADOW_SPOT_SIZE, SHADOW_SPOT_SIZE) &&
+        CreateTarget(spotFinal, SHADOW_SPOT_SIZE, SHADOW_SPOT_SIZE) &&
+        CreateTarget(sunStatic, SHADOW_CASCADE_SIZE * SHADOW_CASCADES, SHADOW_CASCADE_SIZE) &&
+        CreateTarget(sunFinal, SHADOW_CASCADE_SIZE * SHADOW_CASCADES, SHADOW_CASCADE_SIZE);
+    if (!created) {
+        TraceLog(LOG_WARNING, "Shadow framebuffers incomplete, shadows disabled");
+        Unload();
+        return false;
+    }
+
+    // The sun never moves: one light rotation, cascades only shift their ortho window
+    Vector3 sunDirection = Vector3Normalize(SHADOW_SUN_DIRECTION);
+    sunView = MatrixLookAt(Vector3Scale(sunDirection, SHADOW_SUN_DISTANCE), Vector3{ 0.0f, 0.0f, 0.0f }, Vector3{ 0.0f, 1.0f, 0.0f });
+
+    ready = true;
+    TraceLog(LOG_INFO, TextFormat("Shadows: %dpx spot, %d x %dpx sun cascades", SHADOW_SPOT_SIZE, SHADOW_CASCADES, SHADOW_CASCADE_SIZE));
+    return true;
+}
+
+void ShadowManager::Invalidate() {
+    spotValid = false;
+    for (int c = 0; c < SHADOW_CASCADES; c++) cascadeValid[c] = false;
+}
+
+// =============================================================================
+// LIGHT PASSES
+// =============================================================================
+
+void ShadowManager::BeginLightPass(const DepthTarget& target, int x, int y, int size, const Matrix& view, const Matrix& projection) {
+    // Anything still batched belongs to the main view
+    rlDrawRenderBatchActive();
+
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &savedFramebuffer);
+    glGetIntegerv(GL_VIEWPORT, savedViewport);
+    savedProjection = rlGetMatrixProjection();
+    savedModelview = rlGetMatrixModelview();
+
+    glBindFramebuffer(GL_FRAMEBUFFER, target.framebuffer);
+    rlViewport(x, y, size, size);
+    rlSetMatrixProjection(projection);
+    rlSetMatrixModelview(view);
+
+    // Casters are drawn from both sides: baked shells are single-sided
+    rlEnableDepthTest();
+    rlDisableBackfaceCulling();
+    glEnable(GL_POLYGON_OFFSET_FILL);
+    glPolygonOffset(SHADOW_OFFSET_FACTOR, SHADOW_OFFSET_UNITS);
+}
+
+void ShadowManager::EndLightPass() {
+    rlDrawRenderBatchActive();
+
+    glDisable(GL_POLYGON_OFFSET_FILL);
+    rlEnableBackfaceCulling();
+    rlDisableDepthTest();
+
+    glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)savedFramebuffer);
+    rlViewport(savedViewport[0], savedViewport[1], savedViewport[2], savedViewport[3]);
+    rlSetMatrixProjection(savedProjection);
+    rlSetMatrixModelview(savedModelview);
+}
+
+void ShadowManager::ClearRegion(int x, int y, int size) {
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(x, y, size, size);
+    glClear(GL_DEPTH_BUFFER_BIT);
+    glDisable(GL_SCISSOR_TEST);
+}
+
+void ShadowManager::CopyTarget(const DepthTarget& from, const DepthTarget& to) {
+    GLint previous = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previous);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, from.framebuffer);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, to.framebuffer);
+    glBlitFramebuffer(0, 0, from.width, from.height, 0, 0, to.width, to.height, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)previous);
+}
+
+// =============================================================================
+// CASTERS
+// =============================================================================
+
+void ShadowManager::RecordDraw(const Mesh& mesh, int instances) {
+    if (g_RenderStats) {
+        g_RenderStats->RecordDraw(STAT_PASS_SHADOWS, 1, mesh.vertexCount * instances, mesh.triangleCount * instances);
+    }
+}
+
+void ShadowManager::DrawStaticInterior(const MapData& mapData, const std::string& interiorId) {
+    const Interior* interior = GetInterior(mapData, interiorId);
+    if (!interior || !g_WorldGeometry) return;
+
+    // Whole shell, not just the cells visible from the camera: the light sees other rooms
+    const InteriorShell* shell = g_WorldGeometry->GetInteriorShell(*interior);
+    if (shell) {
+        for (int i = 0; i < shell->model.meshCount; i++) {
+            DrawMesh(shell->model.meshes[i], depthMaterial, MatrixIdentity());
+            RecordDraw(shell->model.meshes[i], 1);
+            stats.staticDraws++;
+        }
+    }
+    if (g_PropRenderer) {
+        stats.staticDraws += g_PropRenderer->DrawInteriorShadowCasters(*interior, depthMaterial, depthInstancedMaterial);
+    }
+}
+
+void ShadowManager::DrawStaticBuildings(Vector3 center, float radius, bool coarse) {
+    if (!g_WorldGeometry) return;
+    for (const BakedBuilding& building : g_WorldGeometry->GetBuildings()) {
+        if (!CheckCollisionBoxSphere(building.bounds, center, radius)) continue;
+        // Outer cascades only need the footprint box with its roof
+        const Model& model = (coarse && building.farModel.meshCount > 0) ? building.farModel : building.model;
+        for (int i = 0; i < model.meshCount; i++) {
+            DrawMesh(model.meshes[i], depthMaterial, model.transform);
+            RecordDraw(model.meshes[i], 1);
+            stats.staticDraws++;
+        }
+    }
+}
+
+int ShadowManager::CountDynamicDoors(bool interiorDoors, Vector3 center, float radius) const {
+    int count = 0;
+    for (const Door& door : doors) {
+        if (door.isOpen || door.isInteriorDoor != interiorDoors) continue;
+        if (CheckCollisionBoxSphere(GetDoorBounds(door), center, radius)) count++;
+    }
+    return count;
+}
+
+int ShadowManager::DrawDynamicDoors(bool interiorDoors, Vector3 center, float radius) {
+    // Same slab and frame as the visible door; the default shader writes depth just fine
+    int drawn = 0;
+    for (const Door& door : doors) {
+        if (door.isOpen || door.isInteriorDoor != interiorDoors) continue;
+        if (!CheckCollisionBoxSphere(GetDoorBounds(door), center, radius)) continue;
+        DrawCube(Vector3{ door.position.x, DOOR_HEIGHT / 2.0f, door.position.z }, 0.2f, DOOR_HEIGHT, 1.0f, WHITE);
+        DrawCube(Vector3{ door.position.x, DOOR_HEIGHT + 0.1f, door.position.z }, 0.3f, 0.2f, 1.2f, WHITE);
+        drawn++;
+    }
+    if (drawn > 0 && g_RenderStats) g_RenderStats->RecordDraw(STAT_PASS_SHADOWS, 1, drawn * 48, drawn * 24);
+    return drawn;
+}
+
+// =============================================================================
+// PER-FRAME UPDATE
+// =============================================================================
+
+void ShadowManager::RenderSpot(const MapData& mapData, const MapPlayerState& playerState, Vector3 position, Vector3 direction) {
+    // Cached layer stays valid while the flashlight is close to where it was rendered from
+    bool moved = !spotValid ||
+        Vector3Distance(position, spotPosition) > SHADOW_SPOT_MOVE ||
+        Vector3DotProduct(direction, spotDirection) < cosf(SHADOW_SPOT_TURN * DEG2RAD);
+
+    if (moved) {
+        spotPosition = position;
+        spotDirection = direction;
+        Vector3 up = fabsf(direction.y) > 0.99f ? Vector3{ 1.0f, 0.0f, 0.0f } : Vector3{ 0.0f, 1.0f, 0.0f };
+        spotView = MatrixLookAt(position, Vector3Add(position, direction), up);
+        spotProjection = MatrixPerspective(SHADOW_SPOT_FOV * DEG2RAD, 1.0, SHADOW_SPOT_NEAR, SHADOW_SPOT_FAR);
+        spotMatrix = MatrixMultiply(spotView, spotProjection);
+
+        BeginLightPass(spotStatic, 0, 0, SHADOW_SPOT_SIZE, spotView, spotProjection);
+        ClearRegion(0, 0, SHADOW_SPOT_SIZE);
+        if (playerState.insideInterior) DrawStaticInterior(mapData, playerState.currentInteriorId);
+        else DrawStaticBuildings(position, SHADOW_SPOT_FAR, false);
+        EndLightPass();
+
+        spotValid = true;
+        stats.staticRenders++;
+    }
+
+    // Dynamic casters go on a copy so the cached layer stays clean
+    bool inside = playerState.insideInterior;
+    if (CountDynamicDoors(inside, spotPosition, SHADOW_SPOT_FAR) > 0) {
+        CopyTarget(spotStatic, spotFinal);
+        BeginLightPass(spotFinal, 0, 0, SHADOW_SPOT_SIZE, spotView, spotProjection);
+        stats.dynamicDraws += DrawDynamicDoors(inside, spotPosition, SHADOW_SPOT_FAR);
+        EndLightPass();
+        spotTexture = spotFinal.texture;
+    }
+    else {
+        spotTexture = spotStatic.texture;
+    }
+}
+
+void ShadowManager::RenderSun(Vector3 viewPos) {
+    Vector3 lightSpace = Vector3Transform(viewPos, sunView);
+    float largestExtent = 0.0f;
+
+    for (int c = 0; c < SHADOW_CASCADES; c++) {
+        float radius = SHADOW_CASCADE_SPLITS[c];
+        float extent = radius * (1.0f + SHADOW_CASCADE_PADDING);
+        largestExtent = fmaxf(largestExtent, extent);
+        if (cascadeValid[c] && Vector3Distance(viewPos, cascadeCenter[c]) < radius * SHADOW_CASCADE_PADDING) continue;
+
+        // Recentre on the camera, snapped to whole texels so a redraw doesn't shift the shadow edges
+        float texel = 2.0f * extent / SHADOW_CASCADE_SIZE;
+        float cx = floorf(lightSpace.x / texel) * texel;
+        float cy = floorf(lightSpace.y / texel) * texel;
+        float depth = -lightSpace.z;
+        cascadeProjections[c] = MatrixOrtho(cx - extent, cx + extent, cy - extent, cy + extent,
+            depth - SHADOW_SUN_DISTANCE, depth + SHADOW_SUN_DISTANCE);
+        cascadeMatrices[c] = MatrixMultiply(sunView, cascadeProjections[c]);
+        cascadeCenter[c] = viewPos;
+
+        int x = c * SHADOW_CASCADE_SIZE;
+        BeginLightPass(sunStatic, x, 0, SHADOW_CASCADE_SIZE, sunView, cascadeProjections[c]);
+        ClearRegion(x, 0, SHADOW_CASCADE_SIZE);
+        DrawStaticBuildings(viewPos, extent * 1.42f + SHADOW_CASTER_HEIGHT, c > 0);
+        EndLightPass();
+
+        cascadeValid[c] = true;
+        stats.staticRenders++;
+    }
+
+    if (CountDynamicDoors(false, viewPos, largestExtent) > 0) {
+        CopyTarget(sunStatic, sunFinal);
+        for (int c = 0; c < SHADOW_CASCADES; c++) {
+            float extent = SHADOW_CASCADE_SPLITS[c] * (1.0f + SHADOW_CASCADE_PADDING);
+            BeginLightPass(sunFinal, c * SHADOW_CASCADE_SIZE, 0, SHADOW_CASCADE_SIZE, sunView, cascadeProjections[c]);
+            stats.dynamicDraws += DrawDynamicDoors(false, cascadeCenter[c], extent * 1.42f);
+            EndLightPass();
+        }
+        sunTexture = sunFinal.texture;
+    }
+    else {
+        sunTexture = sunStatic.texture;
+    }
+}
+
+void ShadowManager::Render(const MapData& mapData, const MapPlayerState& playerState, Vector3 viewPos,
+    bool flashlightOn, Vector3 flashlightPos, Vector3 flashlightDir, int kernel) {
+    stats = { 0, 0, 0 };
+    pcfKernel = kernel;
+    spotActive = false;
+    sunActive = false;
+    if (!ready || pcfKernel <= 0) {
+        UploadUniforms();
+        return;
+    }
+    PROFILE_SCOPE("Shadows");
+
+    // Entering or leaving a building swaps every caster
+    std::string key = playerState.insideInterior ? playerState.currentInteriorId : std::string();
+    if (key != cacheKey) {
+        cacheKey = key;
+        Invalidate();
+    }
+
+    if (flashlightOn) {
+        RenderSpot(mapData, playerState, flashlightPos, Vector3Normalize(flashlightDir));
+        spotActive = true;
+    }
+
+    // No sun indoors
+    if (!playerState.insideInterior) {
+        RenderSun(viewPos);
+        sunActive = true;
+    }
+    UploadUniforms();
+}
+
+void ShadowManager::UploadUniforms() {
+    // Matrices are only written while their map is in use, so a parked light uploads nothing
+    if (spotActive) shadowBlock.Set(offsetof(ShadowUniforms, spotMatrix), MatrixToFloatV(spotMatrix));
+    if (sunActive) {
+        for (int c = 0; c < SHADOW_CASCADES; c++) {
+            shadowBlock.Set(offsetof(ShadowUniforms, sunMatrices) + c * 16 * (int)sizeof(float), MatrixToFloatV(cascadeMatrices[c]));
+        }
+    }
+    int flags[4] = { spotActive ? 1 : 0, sunActive ? 1 : 0, pcfKernel / 2, 0 };
+    shadowBlock.Write(offsetof(ShadowUniforms, flags), flags, (int)sizeof(flags));
+    shadowBlock.Upload();
+}
+
+void ShadowManager::BindTextures() const {
+    if (!ready) return;
+    glActiveTexture(GL_TEXTURE0 + SHADOW_SPOT_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_2D, spotTexture ? spotTexture : spotStatic.texture);
+    glActiveTexture(GL_TEXTURE0 + SHADOW_SUN_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_2D, sunTexture ? sunTexture : sunStatic.texture);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void ShadowManager::AppendReport(std::vector<std::string>& lines) const {
+    if (!ready) {
+        lines.push_back("Shadows not available.");
+        return;
+    }
+    if (pcfKernel <= 0) {
+        lines.push_back("Shadows off (Graphics Settings).");
+        return;
+    }
+    lines.push_back(TextFormat("Shadows: PCF %dx%d, spot %s, sun %s", pcfKernel, pcfKernel,
+        spotActive ? "on" : "off", sunActive ? "on" : "off"));
+    lines.push_back(TextFormat("Static layers redrawn: %d (%d draws), dynamic casters: %d",
+        stats.staticRenders, stats.staticDraws, stats.dynamicDraws));
+}
+
+void ShadowManager::Unload() {
+    DestroyTarget(spotStatic);
+    DestroyTarget(spotFinal);
+    DestroyTarget(sunStatic);
+    DestroyTarget(sunFinal);
+    spotTexture = 0;
+    sunTexture = 0;
+
+    // Materials only borrow the shaders and the default texture
+    if (depthMaterial.maps) RL_FREE(depthMaterial.maps);
+    if (depthInstancedMaterial.maps) RL_FREE(depthInstancedMaterial.maps);
+    depthMaterial = { 0 };
+    depthInstancedMaterial = { 0 };
+
+    if (depthShader.id > 0 && depthShader.id != rlGetShaderIdDefault()) UnloadShader(depthShader);
+    if (depthInstancedShader.id > 0 && depthInstancedShader.id != rlGetShaderIdDefault()) UnloadShader(depthInstancedShader);
+    depthShader = { 0 };
+    depthInstancedShader = { 0 };
+
+    ready = false;
+    Invalidate();
+}
+
+// =============================================================================
+// GLOBAL INITIALIZATION
+// =============================================================================
+
+void InitializeShadowSystem() {
+    if (!g_ShadowManager) {
+        g_ShadowManager = new ShadowManager();
+        g_ShadowManager->Initialize();
+    }
+}
+
+void CleanupShadowSystem() {
+    if (g_ShadowManager) {
+        delete g_ShadowManager;
+        g_ShadowManager = nullptr;
+    }
+}
@@ -0,0 +1,176 @@
+#pragma once
+#include "globals.h"
+#include "map.h"
+#include "uniform_buffer.h"
+#include <vector>
+#include <string>
+
+// Depth map sizes
+#define SHADOW_SPOT_SIZE 1024
+#define SHADOW_CASCADE_SIZE 1024
+#define SHADOW_CASCADES 3                  // Side by side in one atlas
+
+// Texture units above the light cluster units
+#define SHADOW_SPOT_TEXTURE_UNIT 12
+#define SHADOW_SUN_TEXTURE_UNIT 13
+
+// Flashlight shadow frustum: beam outer cone plus room to turn before a re-render
+#define SHADOW_SPOT_FOV 50.0f              // Degrees (beam is 35)
+#define SHADOW_SPOT_NEAR 0.05f
+#define SHADOW_SPOT_FAR 25.0f
+#define SHADOW_SPOT_MOVE 0.3f              // Re-render static casters past this offset (metres)
+#define SHADOW_SPOT_TURN 6.0f              // ... or this rotation (degrees)
+
+// Sun cascades: each covers a sphere of its split radius around the camera, padded
+// by half again so the camera can walk that far before the static layer is redrawn
+#define SHADOW_CASCADE_PADDING 0.5f
+#define SHADOW_SUN_DISTANCE 120.0f
+
+// Toward the sun; fixed so cached cascades stay valid
+static const Vector3 SHADOW_SUN_DIRECTION = { 0.48f, 0.78f, 0.40f };
+static const float SHADOW_CASCADE_SPLITS[SHADOW_CASCADES] = { 12.0f, 35.0f, 90.0f };
+
+// PCF kernel widths offered in the graphics menu (0 = shadows off)
+static const int SHADOW_PCF_KERNELS[] = { 0, 1, 3, 5, 7 };
+static const int SHADOW_PCF_KERNEL_COUNT = 5;
+
+// Per-frame shadow counters
+struct ShadowStats {
+    int staticRenders;     // Static layers redrawn this frame (spot + cascades)
+    int staticDraws;
+    int dynamicDraws;
+};
+
+// Shadow manager class
+// Renders a spot shadow map for the flashlight and a cascaded shadow map for
+// the sun. Both keep a cached depth layer holding only static casters (baked
+// interior shells, props and building shells); it is redrawn only when the
+// light moves past a threshold (flashlight) or the camera walks out of the
+// padded cascade (sun). Each frame the cached layer is copied and the
+// dynamic casters (closed doors) are drawn on top, or the cached layer is
+// sampled as-is when no dynamic caster is in range. The surface and tilemap
+// shaders filter the maps with a PCF kernel from GraphicsSettings.
+class ShadowManager {
+public:
+    ShadowManager();
+    ~ShadowManager();
+
+    // Create depth maps, framebuffers and depth shaders. Returns false if unsupported.
+    bool Initialize();
+
+    bool IsReady() const { return ready; }
+
+    // Drop every cached layer (new map)
+    void Invalidate();
+
+    // Update the shadow maps for this frame (call before BeginMode3D, outside any render texture).
+    // pcfKernel 0 disables shadows.
+    void Render(const MapData& mapData, const MapPlayerState& playerState, Vector3 viewPos,
+        bool flashlightOn, Vector3 flashlightPos, Vector3 flashlightDir, int pcfKernel);
+
+    // Bind the shadow maps to their units
+    void BindTextures() const;
+
+    // Sampling state for the shaders
+    bool HasSpotShadow() const { return spotActive; }
+    bool HasSunShadow() const { return sunActive; }
+    const Matrix& GetSpotMatrix() const { return spotMatrix; }
+    const Matrix* GetCascadeMatrices() const { return cascadeMatrices; }
+    int GetPcfRadius() const { return pcfKernel / 2; }
+
+    const ShadowStats& GetStats() const { return stats; }
+
+    // Console report
+    void AppendReport(std::vector<std::string>& lines) const;
+
+    void Unload();
+
+private:
+    // A depth texture and the framebuffer it is attached to
+    struct DepthTarget {
+        unsigned int texture;
+        unsigned int framebuffer;
+        int width;
+        int height;
+    };
+
+    bool ready;
+    DepthTarget spotStatic;
+    DepthTarget spotFinal;
+    DepthTarget sunStatic;
+    DepthTarget sunFinal;
+    unsigned int spotTexture;    // What the shaders sample this frame
+    unsigned int sunTexture;
+
+    Shader depthShader;
+    Shader depthInstancedShader;
+    Material depthMaterial;
+    Material depthInstancedMaterial;
+
+    int pcfKernel;
+    bool spotActive;
+    bool sunActive;
+    std::string cacheKey;        // Interior id, or empty outdoors; a change drops the caches
+
+    // Flashlight cache
+    bool spotValid;
+    Vector3 spotPosition;
+    Vector3 spotDirection;
+    Matrix spotView;
+    Matrix spotProjection;
+    Matrix spotMatrix;           // view * projection, for the shaders
+
+    // Sun cascades
+    Matrix sunView;
+    bool cascadeValid[SHADOW_CASCADES];
+    Vector3 cascadeCenter[SHADOW_CASCADES];
+    Matrix cascadeProjections[SHADOW_CASCADES];
+    Matrix cascadeMatrices[SHADOW_CASCADES];
+
+    ShadowStats stats;
+
+    // ShadowBlock in the world shaders (std140); outlives Unload so binding 1 always has a buffer
+    struct ShadowUniforms {
+        float spotMatrix[16];
+        float sunMatrices[SHADOW_CASCADES * 16];
+        Vector4 sunDirection;      // w = shadow strength
+        Vector4 cascadeSplits;
+        int flags[4];              // spot on, sun on, PCF radius
+    };
+    UniformBuffer shadowBlock;
+    void UploadUniforms();
+
+    bool CreateTarget(DepthTarget& target, int width, int height);
+    void DestroyTarget(DepthTarget& target);
+
+    // Bind a target and point rlgl at a light; EndLightPass restores the main view
+    void BeginLightPass(const DepthTarget& target, int x, int y, int size, const Matrix& view, const Matrix& projection);
+    void EndLightPass();
+    void ClearRegion(int x, int y, int size);
+    void CopyTarget(const DepthTarget& from, const DepthTarget& to);
+
+    // Casters
+    void DrawStaticInterior(const MapData& mapData, const std::string& interiorId);
+    void DrawStaticBuildings(Vector3 center, float radius, bool coarse);
+    int DrawDynamicDoors(bool interiorDoors, Vector3 center, float radius);
+    int CountDynamicDoors(bool interiorDoors, Vector3 center, float radius) const;
+    void RecordDraw(const Mesh& mesh, int instances);
+
+    void RenderSpot(const MapData& mapData, const MapPlayerState& playerState, Vector3 position, Vector3 direction);
+    void RenderSun(Vector3 viewPos);
+
+    // Saved main-view state while a light pass is active
+    Matrix savedProjection;
+    Matrix savedModelview;
+    int savedFramebuffer;
+    int savedViewport[4];
+};
+
+// Global shadow manager instance
+extern ShadowManager* g_ShadowManager;
+
+// Initialize shadow system
+void InitializeShadowSystem();
+
+// Cleanup shadow system
+void CleanupShadowSystem();
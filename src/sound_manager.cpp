@@ -1,4 +1,5 @@
 #include "sound_manager.h"
+#include "profiler.h"
 
 // Global instance
 SoundManager* g_SoundManager = nullptr;
@@ -57,6 +58,7 @@ SoundManager::~SoundManager() {
 }
 
 void SoundManager::Initialize() {
+    PROFILE_SCOPE("LoadSounds");
     TraceLog(LOG_INFO, "Initializing Sound Manager...");
 
     InitAudioDevice();
@@ -0,0 +1,203 @@
+#include "spatial_index.h"
+#include <cfloat>
+#include <cmath>
+
+// Split until a node holds this few items, or the depth limit is reached
+static const int QUADTREE_LEAF_ITEMS = 8;
+static const int QUADTREE_MAX_DEPTH = 10;
+
+static BoundingBox EmptyBounds() {
+    return BoundingBox{ Vector3{ FLT_MAX, FLT_MAX, FLT_MAX }, Vector3{ -FLT_MAX, -FLT_MAX, -FLT_MAX } };
+}
+
+static void GrowBounds(BoundingBox& box, const BoundingBox& other) {
+    box.min.x = fminf(box.min.x, other.min.x);
+    box.min.y = fminf(box.min.y, other.min.y);
+    box.min.z = fminf(box.min.z, other.min.z);
+    box.max.x = fmaxf(box.max.x, other.max.x);
+    box.max.y = fmaxf(box.max.y, other.max.y);
+    box.max.z = fmaxf(box.max.z, other.max.z);
+}
+
+static bool OverlapsXZ(const BoundingBox& box, float minX, float minZ, float maxX, float maxZ) {
+    return box.max.x >= minX && box.min.x <= maxX && box.max.z >= minZ && box.min.z <= maxZ;
+}
+
+// Squared XZ distance from a point to a box (0 when inside)
+static float DistanceSqrXZ(const BoundingBox& box, float x, float z) {
+    float dx = fmaxf(fmaxf(box.min.x - x, 0.0f), x - box.max.x);
+    float dz = fmaxf(fmaxf(box.min.z - z, 0.0f), z - box.max.z);
+    return dx * dx + dz * dz;
+}
+
+SpatialIndex::SpatialIndex() {
+    depth = 0;
+}
+
+void SpatialIndex::Clear() {
+    pending.clear();
+    items.clear();
+    nodes.clear();
+    depth = 0;
+}
+
+void SpatialIndex::Add(int type, int index, const BoundingBox& bounds) {
+    pending.push_back(SpatialItem{ bounds, type, index });
+}
+
+void SpatialIndex::Build() {
+    items.clear();
+    nodes.clear();
+    depth = 0;
+    if (pending.empty()) return;
+
+    // Root covers every item, squared up so quadrants stay square
+    BoundingBox extent = EmptyBounds();
+    for (const auto& item : pending) GrowBounds(extent, item.bounds);
+    float size = fmaxf(extent.max.x - extent.min.x, extent.max.z - extent.min.z);
+
+    items.reserve(pending.size());
+    nodes.push_back(QuadNode{});
+    BuildNode(0, extent.min.x, extent.min.z, extent.min.x + size, extent.min.z + size, pending, 0);
+    pending.clear();
+
+    TraceLog(LOG_INFO, "Spatial index built: %d items, %d nodes, depth %d",
+        (int)items.size(), (int)nodes.size(), depth);
+}
+
+void SpatialIndex::BuildNode(int nodeIndex, float x0, float z0, float x1, float z1,
+    std::vector<SpatialItem>& list, int level) {
+    if (level > depth) depth = level;
+
+    float mx = (x0 + x1) * 0.5f;
+    float mz = (z0 + z1) * 0.5f;
+
+    // Hand each item to the quadrant that fully contains it; the rest stay here
+    std::vector<SpatialItem> stay;
+    std::vector<SpatialItem> children[4];
+    bool split = (int)list.size() > QUADTREE_LEAF_ITEMS && level < QUADTREE_MAX_DEPTH;
+    for (const auto& item : list) {
+        int quadrant = -1;
+        if (split) {
+            bool left = item.bounds.max.x <= mx, right = item.bounds.min.x >= mx;
+            bool near = item.bounds.max.z <= mz, far = item.bounds.min.z >= mz;
+            if ((left || right) && (near || far)) quadrant = (right ? 1 : 0) + (far ? 2 : 0);
+        }
+        if (quadrant < 0) stay.push_back(item);
+        else children[quadrant].push_back(item);
+    }
+    // Nothing moved down: splitting further would only add empty nodes
+    if (split && stay.size() == list.size()) split = false;
+
+    QuadNode node;
+    node.bounds = EmptyBounds();
+    node.firstChild = -1;
+    node.firstItem = (int)items.size();
+    node.itemCount = (int)stay.size();
+    node.subtreeCount = (int)list.size();
+    node.typeMask = 0;
+    for (const auto& item : stay) {
+        items.push_back(item);
+        GrowBounds(node.bounds, item.bounds);
+        node.typeMask |= item.type;
+    }
+
+    if (split) {
+        node.firstChild = (int)nodes.size();
+        nodes.resize(nodes.size() + 4);
+        for (int q = 0; q < 4; q++) {
+            float cx0 = (q & 1) ? mx : x0, cx1 = (q & 1) ? x1 : mx;
+            float cz0 = (q & 2) ? mz : z0, cz1 = (q & 2) ? z1 : mz;
+            BuildNode(node.firstChild + q, cx0, cz0, cx1, cz1, children[q], level + 1);
+
+            const QuadNode& child = nodes[node.firstChild + q];
+            if (child.subtreeCount > 0) GrowBounds(node.bounds, child.bounds);
+            node.typeMask |= child.typeMask;
+        }
+    }
+
+    nodes[nodeIndex] = node;
+}
+
+int SpatialIndex::GetItemCount(int typeMask) const {
+    int count = 0;
+    for (const auto& item : items) {
+        if (item.type & typeMask) count++;
+    }
+    return count;
+}
+
+void SpatialIndex::CollectSubtree(int nodeIndex, int typeMask, std::vector<SpatialItem>& out) const {
+    const QuadNode& node = nodes[nodeIndex];
+    if (node.subtreeCount == 0 || !(node.typeMask & typeMask)) return;
+
+    for (int i = node.firstItem; i < node.firstItem + node.itemCount; i++) {
+        if (items[i].type & typeMask) out.push_back(items[i]);
+    }
+    if (node.firstChild >= 0) {
+        for (int q = 0; q < 4; q++) CollectSubtree(node.firstChild + q, typeMask, out);
+    }
+}
+
+void SpatialIndex::QueryFrustumNode(int nodeIndex, const Frustum& frustum, int typeMask, std::vector<SpatialItem>& out) const {
+    const QuadNode& node = nodes[nodeIndex];
+    if (node.subtreeCount == 0 || !(node.typeMask & typeMask)) return;
+
+    int result = frustum.ClassifyBox(node.bounds.min, node.bounds.max);
+    if (result == FRUSTUM_OUTSIDE) return;
+    if (result == FRUSTUM_INSIDE) {
+        // Everything below is visible - no further plane tests
+        CollectSubtree(nodeIndex, typeMask, out);
+        return;
+    }
+
+    for (int i = node.firstItem; i < node.firstItem + node.itemCount; i++) {
+        const SpatialItem& item = items[i];
+        if ((item.type & typeMask) && frustum.ContainsBox(item.bounds.min, item.bounds.max)) {
+            out.push_back(item);
+        }
+    }
+    if (node.firstChild >= 0) {
+        for (int q = 0; q < 4; q++) QueryFrustumNode(node.firstChild + q, frustum, typeMask, out);
+    }
+}
+
+void SpatialIndex::QueryFrustum(const Frustum& frustum, int typeMask, std::vector<SpatialItem>& out) const {
+    out.clear();
+    if (!nodes.empty()) QueryFrustumNode(0, frustum, typeMask, out);
+}
+
+void SpatialIndex::QueryRegion(float minX, float minZ, float maxX, float maxZ, int typeMask, std::vector<SpatialItem>& out) const {
+    out.clear();
+    if (nodes.empty()) return;
+
+    // Iterative walk; the tree is shallow so a small stack is enough
+    int stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const QuadNode& node = nodes[stack[--top]];
+        if (node.subtreeCount == 0 || !(node.typeMask & typeMask)) continue;
+        if (!OverlapsXZ(node.bounds, minX, minZ, maxX, maxZ)) continue;
+
+        for (int i = node.firstItem; i < node.firstItem + node.itemCount; i++) {
+            const SpatialItem& item = items[i];
+            if ((item.type & typeMask) && OverlapsXZ(item.bounds, minX, minZ, maxX, maxZ)) out.push_back(item);
+        }
+        if (node.firstChild >= 0) {
+            for (int q = 0; q < 4; q++) stack[top++] = node.firstChild + q;
+        }
+    }
+}
+
+void SpatialIndex::QueryRadius(Vector3 center, float radius, int typeMask, std::vector<SpatialItem>& out) const {
+    // Rectangle pass, then trim to the circle
+    QueryRegion(center.x - radius, center.z - radius, center.x + radius, center.z + radius, typeMask, out);
+
+    float radiusSqr = radius * radius;
+    size_t kept = 0;
+    for (size_t i = 0; i < out.size(); i++) {
+        if (DistanceSqrXZ(out[i].bounds, center.x, center.z) <= radiusSqr) out[kept++] = out[i];
+    }
+    out.resize(kept);
+}
@@ -0,0 +1,77 @@
+#pragma once
+// NOTE: only raylib and culling here - map.h embeds the index in MapData
+#include "raylib.h"
+#include "culling.h"
+#include <vector>
+
+// Item categories stored in the index (combine as a mask for queries)
+enum SpatialItemType {
+    SPATIAL_GROUND = 1 << 0,     // WorldGeometry ground chunk
+    SPATIAL_BUILDING = 1 << 1,   // MapData::buildings entry
+    SPATIAL_DOOR = 1 << 2,       // Exterior entry in the global doors list
+    SPATIAL_ALL = 0x7
+};
+
+// One indexed object: its bounds plus its position in the owning list
+struct SpatialItem {
+    BoundingBox bounds;
+    int type;
+    int index;
+};
+
+// Quadtree node. Children are stored as four consecutive nodes; items that
+// straddle a split stay in the parent. Bounds are refit to the content.
+struct QuadNode {
+    BoundingBox bounds;
+    int firstChild;     // -1 for leaves
+    int firstItem;
+    int itemCount;
+    int subtreeCount;   // Items in this node and all descendants
+    int typeMask;       // Union of item types in the subtree
+};
+
+// Spatial index class
+// Static quadtree over the XZ plane, rebuilt once per generated map. Culling
+// rejects or accepts whole subtrees against the frustum, and gameplay queries
+// (nearest door, nearby walls) only visit the nodes around the query area.
+class SpatialIndex {
+public:
+    SpatialIndex();
+
+    // Drop all items and nodes
+    void Clear();
+
+    // Queue an item; call Build once everything has been added
+    void Add(int type, int index, const BoundingBox& bounds);
+
+    // Build the tree over the queued items
+    void Build();
+
+    bool IsBuilt() const { return !nodes.empty(); }
+
+    // Number of indexed items matching a type mask
+    int GetItemCount(int typeMask = SPATIAL_ALL) const;
+
+    int GetNodeCount() const { return (int)nodes.size(); }
+    int GetDepth() const { return depth; }
+
+    // Items whose bounds intersect the frustum
+    void QueryFrustum(const Frustum& frustum, int typeMask, std::vector<SpatialItem>& out) const;
+
+    // Items overlapping an XZ rectangle (y is ignored)
+    void QueryRegion(float minX, float minZ, float maxX, float maxZ, int typeMask, std::vector<SpatialItem>& out) const;
+
+    // Items within radius of a point on the XZ plane (y is ignored)
+    void QueryRadius(Vector3 center, float radius, int typeMask, std::vector<SpatialItem>& out) const;
+
+private:
+    std::vector<SpatialItem> pending;
+    std::vector<SpatialItem> items;   // Grouped by node, in node order
+    std::vector<QuadNode> nodes;      // nodes[0] is the root
+    int depth;
+
+    void BuildNode(int nodeIndex, float x0, float z0, float x1, float z1,
+        std::vector<SpatialItem>& list, int level);
+    void CollectSubtree(int nodeIndex, int typeMask, std::vector<SpatialItem>& out) const;
+    void QueryFrustumNode(int nodeIndex, const Frustum& frustum, int typeMask, std::vector<SpatialItem>& out) const;
+};
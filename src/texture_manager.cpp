@@ -1,5 +1,11 @@
 #include "texture_manager.h"
+#include "light_manager.h"
+#include "shadow_manager.h"
+#include "lightmap_baker.h"
+#include "profiler.h"
 #include "rlgl.h"
+#include "external/glad.h"
+#include <cstddef>
 
 // Global instances
 TextureManager* g_TextureManager = nullptr;
@@ -30,12 +36,42 @@ static const char* TEXTURE_PATHS[TEX_COUNT] = {
     "assets/textures/sky.png"
 };
 
+// Textures packed into the surface set, in layer order
+static const TextureID SURFACE_TEXTURES[] = {
+    TEX_WALL_CONCRETE,
+    TEX_WALL_BRICK,
+    TEX_WALL_METAL,
+    TEX_FLOOR_TILE,
+    TEX_FLOOR_CONCRETE,
+    TEX_FLOOR_WOOD,
+    TEX_FLOOR_CARPET,
+    TEX_CEILING_TILE,
+    TEX_DOOR_WOOD,
+    TEX_DOOR_METAL,
+    TEX_ROAD_ASPHALT,
+    TEX_GRASS,
+    TEX_DIRT,
+    TEX_BUILDING_EXTERIOR,
+    TEX_ROOF_SHINGLES
+};
+static const int SURFACE_TEXTURE_COUNT = sizeof(SURFACE_TEXTURES) / sizeof(SURFACE_TEXTURES[0]);
+
 // =============================================================================
 // TEXTURE MANAGER IMPLEMENTATION
 // =============================================================================
 
 TextureManager::TextureManager() {
     fallbackTexture = { 0 };
+    for (int i = 0; i < TEX_COUNT; i++) {
+        textures[i] = { 0 };
+        loadedStatus[i] = false;
+        surfaceLayers[i] = -1;
+    }
+    surfaceArrayId = 0;
+    surfaceAtlas = { 0 };
+    surfaceLayerCount = 0;
+    surfaceAtlasColumns = 1;
+    surfaceAtlasRows = 1;
 }
 
 TextureManager::~TextureManager() {
@@ -43,6 +79,7 @@ TextureManager::~TextureManager() {
 }
 
 void TextureManager::Initialize() {
+    PROFILE_SCOPE("LoadTextures");
     TraceLog(LOG_INFO, "Initializing Texture Manager...");
     
     // Create fallback texture first
@@ -63,8 +100,14 @@ void TextureManager::Initialize() {
         }
     }
     
+    int loadedCount = 0;
+    for (int i = 0; i < TEX_COUNT; i++) {
+        if (loadedStatus[i]) loadedCount++;
+    }
     TraceLog(LOG_INFO, "Texture Manager initialized. Loaded %d/%d textures from files.", 
-             (int)loadedStatus.size(), TEX_COUNT);
+             loadedCount, TEX_COUNT);
+    
+    BuildSurfaceTextures();
 }
 
 bool TextureManager::LoadTextureFile(TextureID id, const char* filename) {
@@ -217,14 +260,8 @@ Texture2D TextureManager::CreateProceduralTexture(TextureID id) {
     return tex;
 }
 
-Texture2D TextureManager::GetTexture(TextureID id) {
-    if (textures.find(id) != textures.end() && textures[id].id > 0) {
-        return textures[id];
-    }
-    return fallbackTexture;
-}
-
 bool TextureManager::IsLoaded(TextureID id) {
+    if (id < 0 || id >= TEX_COUNT) return false;
     return loadedStatus[id];
 }
 
@@ -238,13 +275,15 @@ void TextureManager::Reload() {
 }
 
 void TextureManager::Unload() {
-    for (auto& pair : textures) {
-        if (pair.second.id > 0) {
-            UnloadTexture(pair.second);
+    UnloadSurfaceTextures();
+    
+    for (int i = 0; i < TEX_COUNT; i++) {
+        if (textures[i].id > 0) {
+            UnloadTexture(textures[i]);
         }
+        textures[i] = { 0 };
+        loadedStatus[i] = false;
     }
-    textures.clear();
-    loadedStatus.clear();
     
     if (fallbackTexture.id > 0) {
         UnloadTexture(fallbackTexture);
@@ -252,13 +291,177 @@ void TextureManager::Unload() {
     }
 }
 
+// =============================================================================
+// SURFACE TEXTURE SET
+// =============================================================================
+
+void TextureManager::BuildSurfaceTextures() {
+    PROFILE_SCOPE("BuildSurfaceTextures");
+    UnloadSurfaceTextures();
+    
+    const int size = SURFACE_LAYER_SIZE;
+    
+    // Read every surface texture back once so files and procedural fallbacks
+    // are packed the same way, at a common size and format
+    std::vector<Image> layers;
+    for (int i = 0; i < SURFACE_TEXTURE_COUNT && i < MAX_SURFACE_LAYERS; i++) {
+        Image img = LoadImageFromTexture(GetTexture(SURFACE_TEXTURES[i]));
+        ImageFormat(&img, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        if (img.width != size || img.height != size) {
+            ImageResize(&img, size, size);
+        }
+        surfaceLayers[SURFACE_TEXTURES[i]] = (int)layers.size();
+        layers.push_back(img);
+    }
+    surfaceLayerCount = (int)layers.size();
+    
+    // Texture array: one bind for every world material, mips generated once here
+    if (rlGetVersion() >= RL_OPENGL_33) {
+        glGetError(); // Clear stale errors
+        glGenTextures(1, &surfaceArrayId);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, surfaceArrayId);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, size, size, surfaceLayerCount, 0,
+                     GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        for (int i = 0; i < surfaceLayerCount; i++) {
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, i, size, size, 1,
+                            GL_RGBA, GL_UNSIGNED_BYTE, layers[i].data);
+        }
+        glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        
+        if (glGetError() != GL_NO_ERROR) {
+            TraceLog(LOG_WARNING, "Surface texture array creation failed, using atlas");
+            glDeleteTextures(1, &surfaceArrayId);
+            surfaceArrayId = 0;
+        }
+    }
+    
+    // Atlas fallback: square-ish grid of layers, shaders wrap UVs inside each cell
+    if (surfaceArrayId == 0 && surfaceLayerCount > 0) {
+        surfaceAtlasColumns = (int)ceilf(sqrtf((float)surfaceLayerCount));
+        surfaceAtlasRows = (surfaceLayerCount + surfaceAtlasColumns - 1) / surfaceAtlasColumns;
+        
+        Image atlas = GenImageColor(surfaceAtlasColumns * size, surfaceAtlasRows * size, BLANK);
+        for (int i = 0; i < surfaceLayerCount; i++) {
+            Rectangle src = { 0, 0, (float)size, (float)size };
+            Rectangle dst = { (float)((i % surfaceAtlasColumns) * size), (float)((i / surfaceAtlasColumns) * size),
+                              (float)size, (float)size };
+            ImageDraw(&atlas, layers[i], src, dst, WHITE);
+        }
+        surfaceAtlas = LoadTextureFromImage(atlas);
+        UnloadImage(atlas);
+        GenTextureMipmaps(&surfaceAtlas);
+        SetTextureFilter(surfaceAtlas, TEXTURE_FILTER_TRILINEAR);
+        SetTextureWrap(surfaceAtlas, TEXTURE_WRAP_CLAMP);
+    }
+    
+    for (auto& img : layers) {
+        UnloadImage(img);
+    }
+    
+    BindSurfaceTextures();
+    
+    TraceLog(LOG_INFO, "Surface textures packed: %d layers (%s)", surfaceLayerCount,
+             surfaceArrayId > 0 ? "texture array" : "atlas");
+}
+
+Vector4 TextureManager::GetSurfaceAtlasRect(int layer) const {
+    if (layer < 0 || layer >= surfaceLayerCount) return Vector4{ 0.0f, 0.0f, 1.0f, 1.0f };
+    float w = 1.0f / surfaceAtlasColumns;
+    float h = 1.0f / surfaceAtlasRows;
+    return Vector4{ (layer % surfaceAtlasColumns) * w, (layer / surfaceAtlasColumns) * h, w, h };
+}
+
+void TextureManager::BindSurfaceTextures() const {
+    if (surfaceArrayId == 0) return;
+    glActiveTexture(GL_TEXTURE0 + SURFACE_ARRAY_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, surfaceArrayId);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void TextureManager::UnloadSurfaceTextures() {
+    if (surfaceArrayId > 0) {
+        glDeleteTextures(1, &surfaceArrayId);
+        surfaceArrayId = 0;
+    }
+    if (surfaceAtlas.id > 0) {
+        UnloadTexture(surfaceAtlas);
+        surfaceAtlas = { 0 };
+    }
+    for (int i = 0; i < TEX_COUNT; i++) {
+        surfaceLayers[i] = -1;
+    }
+    surfaceLayerCount = 0;
+}
+
 // =============================================================================
 // SHADER MANAGER IMPLEMENTATION
 // =============================================================================
 
+// Source files per program (vertex, fragment)
+static const char* PROGRAM_FILES[SHADER_PROGRAM_COUNT][2] = {
+    { "assets/shaders/lighting.vs", "assets/shaders/lighting.fs" },
+    { "assets/shaders/surface.vs", "assets/shaders/surface.fs" }
+};
+static const char* PROGRAM_NAMES[SHADER_PROGRAM_COUNT] = { "lighting", "surface" };
+
+// Features each program reads; the rest are masked off so they share a variant
+static const unsigned int PROGRAM_FEATURES[SHADER_PROGRAM_COUNT] = {
+    SHADER_FEATURE_FLASHLIGHT | SHADER_FEATURE_FOG | SHADER_FEATURE_INSTANCING,
+    SHADER_FEATURE_FLASHLIGHT | SHADER_FEATURE_SHADOWS | SHADER_FEATURE_LIGHTMAP |
+        SHADER_FEATURE_POINT_LIGHTS | SHADER_FEATURE_INSTANCING
+};
+
+// Define and report name per feature bit
+static const char* FEATURE_DEFINES[SHADER_FEATURE_COUNT] = {
+    "FEATURE_FLASHLIGHT", "FEATURE_FOG", "FEATURE_SHADOWS", "FEATURE_LIGHTMAP", "FEATURE_POINT_LIGHTS", "FEATURE_INSTANCING"
+};
+static const char* FEATURE_NAMES[SHADER_FEATURE_COUNT] = {
+    "flashlight", "fog", "shadows", "lightmap", "lights", "instanced"
+};
+
+// Insert the feature defines after the #version line (GLSL requires it first)
+static std::string AddFeatureDefines(const std::string& source, unsigned int features) {
+    std::string defines;
+    for (int i = 0; i < SHADER_FEATURE_COUNT; i++) {
+        if (features & (1u << i)) defines += std::string("#define ") + FEATURE_DEFINES[i] + "\n";
+    }
+    
+    size_t insertAt = 0;
+    if (source.compare(0, 8, "#version") == 0) {
+        size_t lineEnd = source.find('\n');
+        insertAt = (lineEnd == std::string::npos) ? source.size() : lineEnd + 1;
+    }
+    std::string result = source;
+    result.insert(insertAt, defines);
+    return result;
+}
+
+static std::string DescribeFeatures(unsigned int features) {
+    std::string text;
+    for (int i = 0; i < SHADER_FEATURE_COUNT; i++) {
+        if (!(features & (1u << i))) continue;
+        if (!text.empty()) text += " ";
+        text += FEATURE_NAMES[i];
+    }
+    return text.empty() ? "none" : text;
+}
+
 ShaderManager::ShaderManager() {
     lightingShader = { 0 };
     shaderLoaded = false;
+    tilemapShader = { 0 };
+    tilemapLoaded = false;
+    surfaceShader = { 0 };
+    surfaceLoaded = false;
+    surfaceInstancedShader = { 0 };
+    surfaceInstancedLoaded = false;
+    frameFeatures = SHADER_FEATURE_FOG;
+    lightmapTiles = Vector2{ 1.0f, 1.0f };
 }
 
 ShaderManager::~ShaderManager() {
@@ -266,11 +469,25 @@ ShaderManager::~ShaderManager() {
 }
 
 void ShaderManager::Initialize() {
+    PROFILE_SCOPE("LoadShaders");
     TraceLog(LOG_INFO, "Initializing Shader Manager...");
     
-    // Try to load custom shaders
-    if (FileExists("assets/shaders/lighting.vs") && FileExists("assets/shaders/lighting.fs")) {
-        lightingShader = LoadShader("assets/shaders/lighting.vs", "assets/shaders/lighting.fs");
+    // Shared frame block: the constant parts are written once here
+    if (frameBlock.Create("FrameBlock", UNIFORM_BINDING_FRAME, (int)sizeof(FrameUniforms))) {
+        frameBlock.Set(offsetof(FrameUniforms, lightColor), Vector4{ 1.0f, 0.95f, 0.8f, 0.6f });
+        frameBlock.Set(offsetof(FrameUniforms, ambientColor), Vector4{ 0.2f, 0.2f, 0.3f, 0.3f });
+        frameBlock.Set(offsetof(FrameUniforms, fogColor), Vector4{ 0.02f, 0.04f, 0.06f, 0.8f });
+        frameBlock.Set(offsetof(FrameUniforms, fogRange), Vector4{ 15.0f, 50.0f, 0.0f, 0.0f });
+        frameBlock.Set(offsetof(FrameUniforms, flashlightDir), Vector4{ 0.0f, -1.0f, 0.0f, 0.0f });
+        frameBlock.Set(offsetof(FrameUniforms, flashlightColor), Vector4{ 1.0f, 0.95f, 0.8f, 0.0f });
+        frameBlock.Set(offsetof(FrameUniforms, flashlightCone),
+            Vector4{ cosf(12.5f * DEG2RAD), cosf(17.5f * DEG2RAD), 0.0f, 0.0f });
+        frameBlock.Upload();
+    }
+    
+    // Try to load custom shaders (the full-feature variant checks the source compiles)
+    if (LoadProgramSource(SHADER_PROGRAM_LIGHTING)) {
+        lightingShader = GetVariant(SHADER_PROGRAM_LIGHTING, PROGRAM_FEATURES[SHADER_PROGRAM_LIGHTING] & ~SHADER_FEATURE_INSTANCING);
         
         if (lightingShader.id > 0) {
             shaderLoaded = true;
@@ -285,85 +502,289 @@ void ShaderManager::Initialize() {
         shaderLoaded = false;
     }
     
-    if (shaderLoaded && lightingShader.id > 0) {
-        // Get uniform locations
-        viewPosLoc = GetShaderLocation(lightingShader, "viewPos");
-        lightPosLoc = GetShaderLocation(lightingShader, "lightPos");
-        lightColorLoc = GetShaderLocation(lightingShader, "lightColor");
-        lightIntensityLoc = GetShaderLocation(lightingShader, "lightIntensity");
-        ambientColorLoc = GetShaderLocation(lightingShader, "ambientColor");
-        ambientIntensityLoc = GetShaderLocation(lightingShader, "ambientIntensity");
-        flashlightPosLoc = GetShaderLocation(lightingShader, "flashlightPos");
-        flashlightDirLoc = GetShaderLocation(lightingShader, "flashlightDir");
-        flashlightColorLoc = GetShaderLocation(lightingShader, "flashlightColor");
-        flashlightIntensityLoc = GetShaderLocation(lightingShader, "flashlightIntensity");
-        flashlightCutoffLoc = GetShaderLocation(lightingShader, "flashlightCutoff");
-        flashlightOuterCutoffLoc = GetShaderLocation(lightingShader, "flashlightOuterCutoff");
-        flashlightEnabledLoc = GetShaderLocation(lightingShader, "flashlightEnabled");
-        fogColorLoc = GetShaderLocation(lightingShader, "fogColor");
-        fogDensityLoc = GetShaderLocation(lightingShader, "fogDensity");
-        fogStartLoc = GetShaderLocation(lightingShader, "fogStart");
-        fogEndLoc = GetShaderLocation(lightingShader, "fogEnd");
-        
-        // Set default lighting values
-        Vector3 ambientColor = { 0.2f, 0.2f, 0.3f };
-        float ambientIntensity = 0.3f;
-        Vector3 lightColor = { 1.0f, 0.95f, 0.8f };
-        float lightIntensity = 0.6f;
-        Vector3 fogColor = { 0.02f, 0.04f, 0.06f };
-        float fogDensity = 0.8f;
-        float fogStart = 15.0f;
-        float fogEnd = 50.0f;
+    // Both world shaders sample the packed surface set, so they need it to exist
+    bool haveSurfaces = g_TextureManager && g_TextureManager->HasSurfaceTextures();
+    
+    // Ground tilemap shader (no fallback - the world renderer draws per-tile cubes instead)
+    if (haveSurfaces && FileExists("assets/shaders/tilemap.vs") && FileExists("assets/shaders/tilemap.fs")) {
+        tilemapShader = LoadShader("assets/shaders/tilemap.vs", "assets/shaders/tilemap.fs");
         
-        SetShaderValue(lightingShader, ambientColorLoc, &ambientColor, SHADER_UNIFORM_VEC3);
-        SetShaderValue(lightingShader, ambientIntensityLoc, &ambientIntensity, SHADER_UNIFORM_FLOAT);
-        SetShaderValue(lightingShader, lightColorLoc, &lightColor, SHADER_UNIFORM_VEC3);
-        SetShaderValue(lightingShader, lightIntensityLoc, &lightIntensity, SHADER_UNIFORM_FLOAT);
-        SetShaderValue(lightingShader, fogColorLoc, &fogColor, SHADER_UNIFORM_VEC3);
-        SetShaderValue(lightingShader, fogDensityLoc, &fogDensity, SHADER_UNIFORM_FLOAT);
-        SetShaderValue(lightingShader, fogStartLoc, &fogStart, SHADER_UNIFORM_FLOAT);
-        SetShaderValue(lightingShader, fogEndLoc, &fogEnd, SHADER_UNIFORM_FLOAT);
+        if (tilemapShader.id > 0 && tilemapShader.id != rlGetShaderIdDefault()) {
+            tilemapLoaded = true;
+            
+            // The tile index texture is bound through a spare material map slot
+            tilemapShader.locs[SHADER_LOC_MAP_ROUGHNESS] = GetShaderLocation(tilemapShader, "tileMap");
+            SetSurfaceUniforms(tilemapShader);
+            AttachSharedBlocks(tilemapShader);
+            SetSceneLightUniforms(tilemapShader, SHADER_FEATURE_SHADOWS);
+            TraceLog(LOG_INFO, "Loaded tilemap ground shader");
+        }
+    }
+    
+    if (!tilemapLoaded) {
+        TraceLog(LOG_WARNING, "Tilemap shader not available, ground uses per-tile rendering");
+    }
+    
+    // Surface shader for baked building and interior meshes (texture layer in texcoord2),
+    // and its instanced variant for props. Materials keep these full-feature variants.
+    if (haveSurfaces && LoadProgramSource(SHADER_PROGRAM_SURFACE)) {
+        unsigned int allFeatures = PROGRAM_FEATURES[SHADER_PROGRAM_SURFACE] & ~SHADER_FEATURE_INSTANCING;
+        surfaceShader = GetVariant(SHADER_PROGRAM_SURFACE, allFeatures);
+        surfaceLoaded = surfaceShader.id > 0;
+        if (surfaceLoaded) TraceLog(LOG_INFO, "Loaded surface shader");
         
-        // Flashlight defaults
-        float cutoff = cosf(12.5f * DEG2RAD);
-        float outerCutoff = cosf(17.5f * DEG2RAD);
-        SetShaderValue(lightingShader, flashlightCutoffLoc, &cutoff, SHADER_UNIFORM_FLOAT);
-        SetShaderValue(lightingShader, flashlightOuterCutoffLoc, &outerCutoff, SHADER_UNIFORM_FLOAT);
+        surfaceInstancedShader = GetVariant(SHADER_PROGRAM_SURFACE, allFeatures | SHADER_FEATURE_INSTANCING);
+        surfaceInstancedLoaded = surfaceInstancedShader.id > 0;
+        if (surfaceInstancedLoaded) TraceLog(LOG_INFO, "Loaded instanced surface shader");
+    }
+    
+    if (!surfaceLoaded) {
+        TraceLog(LOG_WARNING, "Surface shader not available, baked meshes use one material per texture");
+    }
+    
+    if (!surfaceInstancedLoaded) {
+        TraceLog(LOG_WARNING, "Instanced surface shader not available, props are drawn one mesh at a time");
     }
 }
 
-Shader ShaderManager::GetLightingShader() {
-    return lightingShader;
+bool ShaderManager::LoadProgramSource(ShaderProgram program) {
+    const char* vsFile = PROGRAM_FILES[program][0];
+    const char* fsFile = PROGRAM_FILES[program][1];
+    if (!FileExists(vsFile) || !FileExists(fsFile)) return false;
+    
+    char* vsText = LoadFileText(vsFile);
+    char* fsText = LoadFileText(fsFile);
+    if (vsText && fsText) {
+        programSource[program][0] = vsText;
+        programSource[program][1] = fsText;
+    }
+    if (vsText) UnloadFileText(vsText);
+    if (fsText) UnloadFileText(fsText);
+    return !programSource[program][0].empty() && !programSource[program][1].empty();
 }
 
-void ShaderManager::UpdateLighting(const Camera3D& camera, Vector3 lightPos, bool flashlightOn, Vector3 flashlightPos, Vector3 flashlightDir, float flashlightIntensity) {
-    if (!shaderLoaded || lightingShader.id == 0) return;
+Shader ShaderManager::GetVariant(ShaderProgram program, unsigned int features) {
+    return FetchVariant(program, features).shader;
+}
+
+ShaderManager::ShaderVariant& ShaderManager::FetchVariant(ShaderProgram program, unsigned int features) {
+    features &= PROGRAM_FEATURES[program];
+    unsigned int key = ((unsigned int)program << 16) | features;
+    
+    auto it = variants.find(key);
+    if (it != variants.end()) return it->second;
     
-    // Update camera position
-    SetShaderValue(lightingShader, viewPosLoc, &camera.position, SHADER_UNIFORM_VEC3);
+    ShaderVariant& variant = variants[key];
+    variant.shader = { 0 };
+    variant.features = features;
+    variant.lightmapTiles = -1;
+    variant.compileMs = 0.0f;
+    if (programSource[program][0].empty()) return variant;
     
-    // Update main light position (sun/moon)
-    SetShaderValue(lightingShader, lightPosLoc, &lightPos, SHADER_UNIFORM_VEC3);
+    // Compiled on first use; a new combination costs one compile, then it is cached
+    PROFILE_SCOPE("CompileShaderVariant");
+    double start = GetTime();
+    std::string vs = AddFeatureDefines(programSource[program][0], features);
+    std::string fs = AddFeatureDefines(programSource[program][1], features);
+    Shader shader = LoadShaderFromMemory(vs.c_str(), fs.c_str());
+    variant.compileMs = (float)((GetTime() - start) * 1000.0);
+    
+    if (shader.id == 0 || shader.id == rlGetShaderIdDefault()) {
+        TraceLog(LOG_WARNING, TextFormat("Shader variant %s [%s] failed to compile",
+            PROGRAM_NAMES[program], DescribeFeatures(features).c_str()));
+        return variant;
+    }
     
-    // Update flashlight
-    int enabled = flashlightOn ? 1 : 0;
-    SetShaderValue(lightingShader, flashlightEnabledLoc, &enabled, SHADER_UNIFORM_INT);
+    variant.shader = shader;
+    SetupVariant(program, variant);
+    TraceLog(LOG_INFO, TextFormat("Compiled shader variant %s [%s] in %.1f ms",
+        PROGRAM_NAMES[program], DescribeFeatures(features).c_str(), variant.compileMs));
+    return variant;
+}
+
+void ShaderManager::SetupVariant(ShaderProgram program, ShaderVariant& variant) {
+    Shader shader = variant.shader;
+    AttachSharedBlocks(shader);
+    
+    // DrawMeshInstanced streams the transforms into the model matrix attribute
+    if (variant.features & SHADER_FEATURE_INSTANCING) {
+        shader.locs[SHADER_LOC_MATRIX_MODEL] = GetShaderLocationAttrib(shader, "instanceTransform");
+    }
     
+    variant.uniforms.Reset(shader);
+    if (program != SHADER_PROGRAM_SURFACE) return;
+    
+    SetSurfaceUniforms(shader);
+    if (variant.features & SHADER_FEATURE_POINT_LIGHTS) SetPointLightUniforms(shader);
+    SetSceneLightUniforms(shader, variant.features);
+    if (variant.features & SHADER_FEATURE_LIGHTMAP) variant.lightmapTiles = variant.uniforms.Add("lightmapTiles");
+}
+
+Shader ShaderManager::SelectVariant(Shader shader) {
+    unsigned int instancing = 0;
+    if (surfaceLoaded && shader.id == surfaceShader.id) instancing = 0;
+    else if (surfaceInstancedLoaded && shader.id == surfaceInstancedShader.id) instancing = SHADER_FEATURE_INSTANCING;
+    else return shader;
+    
+    ShaderVariant& variant = FetchVariant(SHADER_PROGRAM_SURFACE, frameFeatures | instancing);
+    if (variant.shader.id == 0) return shader;
+    
+    // The only runtime uniform left; cached, so only the first draw after a change uploads
+    if (variant.lightmapTiles >= 0) variant.uniforms.SetVec2(variant.lightmapTiles, lightmapTiles);
+    return variant.shader;
+}
+
+void ShaderManager::SetSurfaceUniforms(Shader shader) {
+    int unit = SURFACE_ARRAY_TEXTURE_UNIT;
+    int useAtlas = g_TextureManager->IsSurfaceAtlas() ? 1 : 0;
+    SetShaderValue(shader, GetShaderLocation(shader, "surfaceArray"), &unit, SHADER_UNIFORM_INT);
+    SetShaderValue(shader, GetShaderLocation(shader, "useAtlas"), &useAtlas, SHADER_UNIFORM_INT);
+    
+    if (useAtlas) {
+        Vector4 rects[MAX_SURFACE_LAYERS];
+        for (int i = 0; i < MAX_SURFACE_LAYERS; i++) {
+            rects[i] = g_TextureManager->GetSurfaceAtlasRect(i);
+        }
+        SetShaderValueV(shader, GetShaderLocation(shader, "atlasRects"), rects, SHADER_UNIFORM_VEC4, MAX_SURFACE_LAYERS);
+    }
+}
+
+void ShaderManager::SetPointLightUniforms(Shader shader) {
+    int clusterUnit = LIGHT_CLUSTER_TEXTURE_UNIT;
+    int indexUnit = LIGHT_INDEX_TEXTURE_UNIT;
+    int dataUnit = LIGHT_DATA_TEXTURE_UNIT;
+    Vector3 clusterSize = { (float)CLUSTER_X, (float)CLUSTER_Y, (float)CLUSTER_Z };
+    Vector2 clusterDepth = { CLUSTER_NEAR, CLUSTER_Z / logf(CLUSTER_FAR / CLUSTER_NEAR) };
+    SetShaderValue(shader, GetShaderLocation(shader, "lightClusters"), &clusterUnit, SHADER_UNIFORM_INT);
+    SetShaderValue(shader, GetShaderLocation(shader, "lightIndices"), &indexUnit, SHADER_UNIFORM_INT);
+    SetShaderValue(shader, GetShaderLocation(shader, "lightData"), &dataUnit, SHADER_UNIFORM_INT);
+    SetShaderValue(shader, GetShaderLocation(shader, "clusterSize"), &clusterSize, SHADER_UNIFORM_VEC3);
+    SetShaderValue(shader, GetShaderLocation(shader, "clusterDepth"), &clusterDepth, SHADER_UNIFORM_VEC2);
+}
+
+void ShaderManager::SetSceneLightUniforms(Shader shader, unsigned int features) {
+    if (features & SHADER_FEATURE_SHADOWS) {
+        int spotUnit = SHADOW_SPOT_TEXTURE_UNIT;
+        int sunUnit = SHADOW_SUN_TEXTURE_UNIT;
+        SetShaderValue(shader, GetShaderLocation(shader, "spotShadowMap"), &spotUnit, SHADER_UNIFORM_INT);
+        SetShaderValue(shader, GetShaderLocation(shader, "sunShadowMap"), &sunUnit, SHADER_UNIFORM_INT);
+    }
+    if (features & SHADER_FEATURE_LIGHTMAP) {
+        int lightmapUnit = LIGHTMAP_TEXTURE_UNIT;
+        float lightmapRange = LIGHTMAP_RANGE;
+        float wallHeight = WALL_HEIGHT;
+        SetShaderValue(shader, GetShaderLocation(shader, "lightmap"), &lightmapUnit, SHADER_UNIFORM_INT);
+        SetShaderValue(shader, GetShaderLocation(shader, "lightmapRange"), &lightmapRange, SHADER_UNIFORM_FLOAT);
+        SetShaderValue(shader, GetShaderLocation(shader, "lightmapWallHeight"), &wallHeight, SHADER_UNIFORM_FLOAT);
+    }
+}
+
+void ShaderManager::AttachSharedBlocks(Shader shader) {
+    AttachUniformBlock(shader, "FrameBlock", UNIFORM_BINDING_FRAME);
+    AttachUniformBlock(shader, "ShadowBlock", UNIFORM_BINDING_SHADOW);
+}
+
+void ShaderManager::SetLightmap(bool enabled, int tilesX, int tilesY) {
+    if (enabled) {
+        frameFeatures |= SHADER_FEATURE_LIGHTMAP;
+        lightmapTiles = Vector2{ (float)tilesX, (float)tilesY };
+    }
+    else {
+        frameFeatures &= ~SHADER_FEATURE_LIGHTMAP;
+    }
+}
+
+Shader ShaderManager::GetLightingShader() {
+    if (!shaderLoaded) return lightingShader;
+    Shader variant = GetVariant(SHADER_PROGRAM_LIGHTING, frameFeatures & ~SHADER_FEATURE_INSTANCING);
+    return variant.id > 0 ? variant : lightingShader;
+}
+
+Shader ShaderManager::GetTilemapShader() {
+    return tilemapShader;
+}
+
+Shader ShaderManager::GetSurfaceShader() {
+    return surfaceShader;
+}
+
+Shader ShaderManager::GetSurfaceInstancedShader() {
+    return surfaceInstancedShader;
+}
+
+void ShaderManager::UpdateLighting(const Camera3D& camera, Vector3 lightPos, bool flashlightOn, Vector3 flashlightPos, Vector3 flashlightDir, float flashlightIntensity) {
+    // Once per frame, before anything writes uniforms for it
+    BeginUniformFrame();
+    
+    // Camera, sun and flashlight for every shader declaring FrameBlock; only changed bytes go up
+    // (the beam is parked at zero intensity while off so the block stops changing)
+    Vector4 flashPos = { 0.0f, 0.0f, 0.0f, 0.0f };
+    Vector4 flashDir = { 0.0f, -1.0f, 0.0f, 0.0f };
     if (flashlightOn) {
-        Vector3 flashColor = { 1.0f, 0.95f, 0.8f };
-        SetShaderValue(lightingShader, flashlightPosLoc, &flashlightPos, SHADER_UNIFORM_VEC3);
-        SetShaderValue(lightingShader, flashlightDirLoc, &flashlightDir, SHADER_UNIFORM_VEC3);
-        SetShaderValue(lightingShader, flashlightColorLoc, &flashColor, SHADER_UNIFORM_VEC3);
-        SetShaderValue(lightingShader, flashlightIntensityLoc, &flashlightIntensity, SHADER_UNIFORM_FLOAT);
+        flashPos = Vector4{ flashlightPos.x, flashlightPos.y, flashlightPos.z, 1.0f };
+        flashDir = Vector4{ flashlightDir.x, flashlightDir.y, flashlightDir.z, flashlightIntensity };
+    }
+    frameBlock.Set(offsetof(FrameUniforms, viewPos), Vector4{ camera.position.x, camera.position.y, camera.position.z, 1.0f });
+    frameBlock.Set(offsetof(FrameUniforms, lightPos), Vector4{ lightPos.x, lightPos.y, lightPos.z, 1.0f });
+    frameBlock.Set(offsetof(FrameUniforms, flashlightPos), flashPos);
+    frameBlock.Set(offsetof(FrameUniforms, flashlightDir), flashDir);
+    frameBlock.Set(offsetof(FrameUniforms, frameTime), Vector4{ (float)GetTime(), 0.0f, 0.0f, 0.0f });
+    frameBlock.Upload();
+    
+    // Pick this frame's variants: features that are off are compiled out, not branched over.
+    // The lightmap bit is owned by SetLightmap.
+    unsigned int features = SHADER_FEATURE_FOG | (frameFeatures & SHADER_FEATURE_LIGHTMAP);
+    if (flashlightOn) features |= SHADER_FEATURE_FLASHLIGHT;
+    if (g_ShadowManager && (g_ShadowManager->HasSpotShadow() || g_ShadowManager->HasSunShadow())) {
+        features |= SHADER_FEATURE_SHADOWS;
     }
+    if (g_LightManager && g_LightManager->HasLights()) features |= SHADER_FEATURE_POINT_LIGHTS;
+    frameFeatures = features;
 }
 
-void ShaderManager::Unload() {
-    if (lightingShader.id > 0) {
-        UnloadShader(lightingShader);
-        lightingShader = { 0 };
+void ShaderManager::AppendVariantReport(std::vector<std::string>& lines) const {
+    lines.push_back(TextFormat("Shader variants: %d cached, frame features: %s",
+        (int)variants.size(), DescribeFeatures(frameFeatures).c_str()));
+    for (const auto& pair : variants) {
+        const ShaderVariant& variant = pair.second;
+        int program = (int)(pair.first >> 16);
+        if (variant.shader.id > 0) {
+            lines.push_back(TextFormat("  %s [%s] %.1f ms", PROGRAM_NAMES[program],
+                DescribeFeatures(variant.features).c_str(), variant.compileMs));
+        }
+        else {
+            lines.push_back(TextFormat("  %s [%s] failed", PROGRAM_NAMES[program], DescribeFeatures(variant.features).c_str()));
+        }
     }
+}
+
+void ShaderManager::Unload() {
+    // The default shader fallback belongs to rlgl; custom lighting is one of the variants
+    lightingShader = { 0 };
     shaderLoaded = false;
+    
+    if (tilemapLoaded) {
+        UnloadShader(tilemapShader);
+    }
+    tilemapShader = { 0 };
+    tilemapLoaded = false;
+    
+    for (auto& pair : variants) {
+        if (pair.second.shader.id > 0) UnloadShader(pair.second.shader);
+    }
+    variants.clear();
+    for (int i = 0; i < SHADER_PROGRAM_COUNT; i++) {
+        programSource[i][0].clear();
+        programSource[i][1].clear();
+    }
+    
+    surfaceShader = { 0 };
+    surfaceLoaded = false;
+    surfaceInstancedShader = { 0 };
+    surfaceInstancedLoaded = false;
+    frameFeatures = SHADER_FEATURE_FOG;
+    
+    frameBlock.Unload();
 }
 
 // =============================================================================
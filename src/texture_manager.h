@@ -1,7 +1,9 @@
 #pragma once
 #include "globals.h"
+#include "uniform_buffer.h"
 #include <map>
 #include <string>
+#include <vector>
 
 // Texture IDs for different surface types
 enum TextureID {
@@ -29,6 +31,11 @@ enum TextureID {
     TEX_COUNT
 };
 
+// Surface texture set (world materials packed for a single bind)
+#define SURFACE_LAYER_SIZE 256
+#define MAX_SURFACE_LAYERS 16
+#define SURFACE_ARRAY_TEXTURE_UNIT 8   // Reserved unit, above the material map slots DrawMesh uses
+
 // Texture manager class
 class TextureManager {
 public:
@@ -38,8 +45,12 @@ public:
     // Initialize and load all textures
     void Initialize();
     
-    // Get a texture by ID (returns fallback if missing)
-    Texture2D GetTexture(TextureID id);
+    // Get a texture by ID (returns fallback if missing).
+    // TextureID is a direct index into a flat table, so this is safe to call per draw.
+    Texture2D GetTexture(TextureID id) const {
+        if (id >= 0 && id < TEX_COUNT && textures[id].id > 0) return textures[id];
+        return fallbackTexture;
+    }
     
     // Check if a texture is loaded
     bool IsLoaded(TextureID id);
@@ -53,11 +64,47 @@ public:
     // Get fallback texture
     Texture2D GetFallbackTexture();
     
+    // Pack the world surface textures (walls, floors, road, grass, doors, roofs)
+    // into one GL_TEXTURE_2D_ARRAY with mipmaps, or a grid atlas if arrays fail
+    void BuildSurfaceTextures();
+    
+    // Check if the surface set is available (array or atlas)
+    bool HasSurfaceTextures() const { return surfaceArrayId > 0 || surfaceAtlas.id > 0; }
+    
+    // True when the surface set fell back to the atlas
+    bool IsSurfaceAtlas() const { return surfaceArrayId == 0 && surfaceAtlas.id > 0; }
+    
+    // Layer of a texture in the surface set (-1 if not packed)
+    int GetSurfaceLayer(TextureID id) const {
+        return (id >= 0 && id < TEX_COUNT) ? surfaceLayers[id] : -1;
+    }
+    
+    int GetSurfaceLayerCount() const { return surfaceLayerCount; }
+    
+    // Atlas texture (id 0 when the texture array is in use)
+    Texture2D GetSurfaceAtlas() const { return surfaceAtlas; }
+    
+    // Normalized atlas rectangle of a layer (x, y, width, height)
+    Vector4 GetSurfaceAtlasRect(int layer) const;
+    
+    // Bind the surface texture array to SURFACE_ARRAY_TEXTURE_UNIT
+    void BindSurfaceTextures() const;
+    
 private:
-    std::map<TextureID, Texture2D> textures;
-    std::map<TextureID, bool> loadedStatus;
+    Texture2D textures[TEX_COUNT];
+    bool loadedStatus[TEX_COUNT];
     Texture2D fallbackTexture;
     
+    // Surface set
+    unsigned int surfaceArrayId;
+    Texture2D surfaceAtlas;
+    int surfaceLayers[TEX_COUNT];
+    int surfaceLayerCount;
+    int surfaceAtlasColumns;
+    int surfaceAtlasRows;
+    
+    void UnloadSurfaceTextures();
+    
     // Create procedural fallback texture
     void CreateFallbackTexture();
     
@@ -71,7 +118,30 @@ private:
 // Global texture manager instance
 extern TextureManager* g_TextureManager;
 
+// Shader programs compiled as feature variants
+enum ShaderProgram {
+    SHADER_PROGRAM_LIGHTING = 0,    // lighting.vs / lighting.fs (debug grid)
+    SHADER_PROGRAM_SURFACE,         // surface.vs / surface.fs (baked world meshes and props)
+    SHADER_PROGRAM_COUNT
+};
+
+// Feature flags, compiled in as FEATURE_<name> defines
+enum ShaderFeature {
+    SHADER_FEATURE_FLASHLIGHT = 1 << 0,
+    SHADER_FEATURE_FOG = 1 << 1,
+    SHADER_FEATURE_SHADOWS = 1 << 2,
+    SHADER_FEATURE_LIGHTMAP = 1 << 3,
+    SHADER_FEATURE_POINT_LIGHTS = 1 << 4,
+    SHADER_FEATURE_INSTANCING = 1 << 5      // Per-instance transform attribute (DrawMeshInstanced)
+};
+#define SHADER_FEATURE_COUNT 6
+
 // Shader manager class
+// World shaders are built from one source per program with #define feature
+// flags, so a fragment only runs the lighting it needs this frame. Variants
+// are compiled the first time a feature combination is requested and kept
+// until Unload. Materials hold the full-feature variant; draws are switched
+// to the variant for the current frame features through SelectVariant.
 class ShaderManager {
 public:
     ShaderManager();
@@ -80,37 +150,111 @@ public:
     // Initialize and load shaders
     void Initialize();
     
-    // Get the lighting shader
+    // Get the lighting shader variant for this frame's features
     Shader GetLightingShader();
     
-    // Update shader uniforms
+    // Get the ground tilemap shader (id 0 if it failed to load)
+    Shader GetTilemapShader();
+    
+    // Check if the tilemap shader is available
+    bool IsTilemapShaderLoaded() const { return tilemapLoaded; }
+    
+    // Get the shader for baked world meshes sampling the surface texture set (full-feature variant)
+    Shader GetSurfaceShader();
+    
+    // Check if the surface shader is available
+    bool IsSurfaceShaderLoaded() const { return surfaceLoaded; }
+    
+    // Surface shader taking a per-instance transform attribute, for DrawMeshInstanced
+    Shader GetSurfaceInstancedShader();
+    
+    // Check if the instanced surface shader is available
+    bool IsSurfaceInstancedShaderLoaded() const { return surfaceInstancedLoaded; }
+    
+    // Get (compiling on first use) the variant of a program for a feature mask.
+    // Features the program does not use are ignored. Returns id 0 if it cannot compile.
+    Shader GetVariant(ShaderProgram program, unsigned int features);
+    
+    // Map a material's full-feature shader to the variant for this frame; other shaders pass through
+    Shader SelectVariant(Shader shader);
+    
+    // Features on this frame (set by UpdateLighting and SetLightmap)
+    unsigned int GetFrameFeatures() const { return frameFeatures; }
+    
+    // Sample the bound interior lightmap on the surface shaders (tiles = interior size)
+    void SetLightmap(bool enabled, int tilesX, int tilesY);
+    
+    // Point a shader's FrameBlock / ShadowBlock at the shared buffers (any shader may declare them)
+    void AttachSharedBlocks(Shader shader);
+    
+    // Update the shared frame block and pick this frame's features
     void UpdateLighting(const Camera3D& camera, Vector3 lightPos, bool flashlightOn, Vector3 flashlightPos, Vector3 flashlightDir, float flashlightIntensity);
     
+    // Console report of compiled variants
+    void AppendVariantReport(std::vector<std::string>& lines) const;
+    
     // Unload shaders
     void Unload();
     
 private:
-    Shader lightingShader;
+    Shader lightingShader;       // Full-feature variant, or the default shader as fallback
     bool shaderLoaded;
+    Shader tilemapShader;
+    bool tilemapLoaded;
+    Shader surfaceShader;
+    bool surfaceLoaded;
+    Shader surfaceInstancedShader;
+    bool surfaceInstancedLoaded;
+    
+    // A compiled feature combination
+    struct ShaderVariant {
+        Shader shader;
+        unsigned int features;
+        ShaderUniforms uniforms;     // Runtime uniforms, cached locations and values
+        int lightmapTiles;
+        float compileMs;
+    };
+    
+    // Variant cache keyed by program and feature mask; failed compiles are kept (id 0)
+    std::map<unsigned int, ShaderVariant> variants;
+    std::string programSource[SHADER_PROGRAM_COUNT][2];   // Vertex, fragment
+    
+    unsigned int frameFeatures;
+    Vector2 lightmapTiles;
+    
+    // Cached variant for a feature mask, compiled on first request
+    ShaderVariant& FetchVariant(ShaderProgram program, unsigned int features);
+    
+    // Read a program's sources; false if either file is missing
+    bool LoadProgramSource(ShaderProgram program);
+    
+    // Set the load-time uniforms of a freshly compiled variant
+    void SetupVariant(ShaderProgram program, ShaderVariant& variant);
+    
+    // Point a shader at the surface texture set (array unit or atlas rectangles)
+    void SetSurfaceUniforms(Shader shader);
+    
+    // Point a surface shader at the light cluster textures
+    void SetPointLightUniforms(Shader shader);
+    
+    // Shared per-frame block (FrameBlock in the shaders, std140)
+    struct FrameUniforms {
+        Vector4 viewPos;
+        Vector4 lightPos;
+        Vector4 lightColor;        // w = intensity
+        Vector4 ambientColor;      // w = intensity
+        Vector4 fogColor;          // w = density
+        Vector4 fogRange;          // x = start, y = end
+        Vector4 flashlightPos;     // w = 1 when on
+        Vector4 flashlightDir;     // w = intensity
+        Vector4 flashlightColor;
+        Vector4 flashlightCone;    // x = cos(inner), y = cos(outer)
+        Vector4 frameTime;         // x = seconds
+    };
+    UniformBuffer frameBlock;
     
-    // Shader uniform locations
-    int viewPosLoc;
-    int lightPosLoc;
-    int lightColorLoc;
-    int lightIntensityLoc;
-    int ambientColorLoc;
-    int ambientIntensityLoc;
-    int flashlightPosLoc;
-    int flashlightDirLoc;
-    int flashlightColorLoc;
-    int flashlightIntensityLoc;
-    int flashlightCutoffLoc;
-    int flashlightOuterCutoffLoc;
-    int flashlightEnabledLoc;
-    int fogColorLoc;
-    int fogDensityLoc;
-    int fogStartLoc;
-    int fogEndLoc;
+    // Shadow and lightmap samplers and constants, set once at load
+    void SetSceneLightUniforms(Shader shader, unsigned int features);
 };
 
 // Global shader manager instance
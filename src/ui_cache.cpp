@@ -0,0 +1,115 @@
+#include "ui_cache.h"
+#include "rlgl.h"
+
+// Global instance
+UiCache* g_UiCache = nullptr;
+
+UiCache::UiCache() {
+    for (int i = 0; i < UI_PANEL_COUNT; i++) {
+        panels[i].target = { 0 };
+        panels[i].key = 0;
+        panels[i].valid = false;
+    }
+    enabled = true;
+    stats = { 0, 0 };
+    lastStats = stats;
+}
+
+UiCache::~UiCache() {
+    Unload();
+}
+
+bool UiCache::BeginPanel(UiPanel panel, int width, int height, uint64_t key) {
+    if (panel < 0 || panel >= UI_PANEL_COUNT || width <= 0 || height <= 0) return false;
+    PanelTexture& entry = panels[panel];
+
+    bool sized = entry.target.id > 0 && entry.target.texture.width == width && entry.target.texture.height == height;
+    if (sized && entry.valid && entry.key == key) {
+        stats.hits++;
+        return false;
+    }
+
+    if (!sized) {
+        if (entry.target.id > 0) UnloadRenderTexture(entry.target);
+        entry.target = LoadRenderTexture(width, height);
+        entry.valid = false;
+        if (entry.target.id == 0) return false;
+    }
+
+    BeginTextureMode(entry.target);
+    ClearBackground(BLANK);
+    // Colour blends as usual; alpha accumulates coverage, leaving premultiplied colour in the texture
+    rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+
+    entry.key = key;
+    entry.valid = true;
+    stats.redraws++;
+    return true;
+}
+
+void UiCache::EndPanel() {
+    EndBlendMode();
+    EndTextureMode();
+}
+
+bool UiCache::DrawPanel(UiPanel panel, int x, int y) {
+    if (panel < 0 || panel >= UI_PANEL_COUNT) return false;
+    const PanelTexture& entry = panels[panel];
+    if (entry.target.id == 0 || !entry.valid) return false;
+
+    float width = (float)entry.target.texture.width;
+    float height = (float)entry.target.texture.height;
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    DrawTextureRec(entry.target.texture, Rectangle{ 0, 0, width, -height }, Vector2{ (float)x, (float)y }, WHITE);
+    EndBlendMode();
+    return true;
+}
+
+void UiCache::Invalidate() {
+    for (int i = 0; i < UI_PANEL_COUNT; i++) panels[i].valid = false;
+}
+
+void UiCache::BeginFrame() {
+    lastStats = stats;
+    stats = { 0, 0 };
+}
+
+void UiCache::AppendReport(std::vector<std::string>& lines) const {
+    int allocated = 0;
+    int bytes = 0;
+    for (int i = 0; i < UI_PANEL_COUNT; i++) {
+        if (panels[i].target.id == 0) continue;
+        allocated++;
+        bytes += panels[i].target.texture.width * panels[i].target.texture.height * 4;
+    }
+    lines.push_back(TextFormat("UI cache %s: %d panel textures (%.1f KB)",
+        enabled ? "on" : "off", allocated, bytes / 1024.0f));
+    lines.push_back(TextFormat("Last frame: %d panels reused, %d repainted", lastStats.hits, lastStats.redraws));
+}
+
+void UiCache::Unload() {
+    for (int i = 0; i < UI_PANEL_COUNT; i++) {
+        if (panels[i].target.id > 0) UnloadRenderTexture(panels[i].target);
+        panels[i].target = { 0 };
+        panels[i].valid = false;
+    }
+}
+
+// =============================================================================
+// GLOBAL INITIALIZATION
+// =============================================================================
+
+void InitializeUiCacheSystem() {
+    if (!g_UiCache) {
+        g_UiCache = new UiCache();
+        TraceLog(LOG_INFO, "UI cache initialized");
+    }
+}
+
+void CleanupUiCacheSystem() {
+    if (g_UiCache) {
+        delete g_UiCache;
+        g_UiCache = nullptr;
+    }
+}
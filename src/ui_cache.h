@@ -0,0 +1,112 @@
+#pragma once
+#include "globals.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+
+// Retained UI panels, one cached texture each
+enum UiPanel {
+    UI_PANEL_HUD_BARS = 0,      // Health / stamina / hunger / thirst
+    UI_PANEL_HUD_BATTERY,       // Flashlight battery
+    UI_PANEL_HUD_ITEM,          // Equipped item box
+    UI_PANEL_QUEST_TRACKER,
+    UI_PANEL_MENU,              // Main / pause menu
+    UI_PANEL_COUNT
+};
+
+// Panel counters for the last full frame
+struct UiCacheStats {
+    int hits;           // Panels drawn from their texture unchanged
+    int redraws;        // Panels repainted because their key changed
+};
+
+// FNV-1a hash of everything a panel shows; a panel is repainted only when it changes
+class UiKey {
+public:
+    UiKey() : hash(1469598103934665603ull) {}
+
+    UiKey& Add(int value) { return AddBytes(&value, sizeof(value)); }
+    UiKey& Add(const char* text) { return AddBytes(text, text ? strlen(text) : 0); }
+
+    uint64_t Value() const { return hash; }
+
+private:
+    uint64_t hash;
+
+    UiKey& AddBytes(const void* data, size_t size) {
+        const unsigned char* bytes = (const unsigned char*)data;
+        for (size_t i = 0; i < size; i++) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+        return *this;
+    }
+};
+
+// UI cache class
+// Each panel is painted into its own render texture together with the key it
+// was painted for, and later frames draw that texture as one quad until the
+// key changes. Panels are painted with premultiplied alpha so translucent
+// backgrounds composite exactly as if they were drawn straight to the screen.
+class UiCache {
+public:
+    UiCache();
+    ~UiCache();
+
+    void SetEnabled(bool value) { enabled = value; }
+    bool IsEnabled() const { return enabled; }
+
+    // Start repainting a panel (at local 0,0) if its key or size changed; false if it is current
+    bool BeginPanel(UiPanel panel, int width, int height, uint64_t key);
+    void EndPanel();
+
+    // Draw the cached panel; false if it has no texture
+    bool DrawPanel(UiPanel panel, int x, int y);
+
+    // Force every panel to repaint
+    void Invalidate();
+
+    void BeginFrame();
+    const UiCacheStats& GetStats() const { return lastStats; }
+
+    // Console report
+    void AppendReport(std::vector<std::string>& lines) const;
+
+    void Unload();
+
+private:
+    struct PanelTexture {
+        RenderTexture2D target;
+        uint64_t key;
+        bool valid;
+    };
+
+    PanelTexture panels[UI_PANEL_COUNT];
+    bool enabled;
+    UiCacheStats stats;
+    UiCacheStats lastStats;
+};
+
+// Global UI cache instance
+extern UiCache* g_UiCache;
+
+// Draw a panel at (x, y). drawFn(originX, originY) paints it; with the cache it
+// only runs when the key changes, otherwise it draws straight to the screen.
+template <typename DrawFn>
+void DrawRetainedPanel(UiPanel panel, int x, int y, int width, int height, const UiKey& key, DrawFn drawFn) {
+    if (g_UiCache && g_UiCache->IsEnabled()) {
+        if (g_UiCache->BeginPanel(panel, width, height, key.Value())) {
+            drawFn(0, 0);
+            g_UiCache->EndPanel();
+        }
+        if (g_UiCache->DrawPanel(panel, x, y)) return;
+    }
+    drawFn(x, y);
+}
+
+// Initialize UI cache
+void InitializeUiCacheSystem();
+
+// Cleanup UI cache
+void CleanupUiCacheSystem();
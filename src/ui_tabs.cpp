@@ -1,5 +1,6 @@
 #include "ui_tabs.h"
 #include "quest_system.h"
+#include "input.h"
 
 // Static selection tracking
 static int skillSelection = 0;
@@ -36,10 +37,10 @@ void DrawSkillsScreen(int screenW, int screenH, int contentX, int contentY, int
     const auto& skills = g_SkillTree.GetSkills();
     
     // Navigation
-    if (IsKeyPressed(KEY_UP) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_UP))) {
+    if (InputIsKeyPressed(KEY_UP) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_UP))) {
         skillSelection = (skillSelection - 1 + (int)skills.size()) % (int)skills.size();
     }
-    if (IsKeyPressed(KEY_DOWN) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_DOWN))) {
+    if (InputIsKeyPressed(KEY_DOWN) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_DOWN))) {
         skillSelection = (skillSelection + 1) % (int)skills.size();
     }
     
@@ -87,8 +88,8 @@ void DrawSkillsScreen(int screenW, int screenH, int contentX, int contentY, int
         }
         
         // Mouse selection
-        Vector2 mousePos = GetMousePosition();
-        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) &&
+        Vector2 mousePos = InputGetMousePosition();
+        if (InputIsMouseButtonPressed(MOUSE_LEFT_BUTTON) &&
             mousePos.x >= skillX && mousePos.x <= skillX + contentW - 40 &&
             mousePos.y >= skillY && mousePos.y <= skillY + skillH) {
             skillSelection = (int)i;
@@ -102,8 +103,8 @@ void DrawSkillsScreen(int screenW, int screenH, int contentX, int contentY, int
              contentX + 20, contentY + contentH - 40, 16, PIPBOY_DIM);
     
     // Upgrade action
-    bool upgradePressed = IsKeyPressed(KEY_SPACE) || 
-                         (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_DOWN));
+    bool upgradePressed = InputIsKeyPressed(KEY_SPACE) || 
+                         (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_DOWN));
     
     if (upgradePressed && skillSelection >= 0 && skillSelection < (int)skills.size()) {
         const Skill& skill = skills[skillSelection];
@@ -132,10 +133,10 @@ void DrawQuestsScreen(int screenW, int screenH, int contentX, int contentY, int
     }
     
     // Navigation
-    if (IsKeyPressed(KEY_UP) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_UP))) {
+    if (InputIsKeyPressed(KEY_UP) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_UP))) {
         questSelection = (questSelection - 1 + (int)activeQuests.size()) % (int)activeQuests.size();
     }
-    if (IsKeyPressed(KEY_DOWN) || (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_DOWN))) {
+    if (InputIsKeyPressed(KEY_DOWN) || (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_DPAD_DOWN))) {
         questSelection = (questSelection + 1) % (int)activeQuests.size();
     }
     
@@ -206,8 +207,8 @@ void DrawQuestsScreen(int screenW, int screenH, int contentX, int contentY, int
             DrawRectangle(btnX, btnY, btnW, btnH, PIPBOY_GREEN);
             DrawText("COMPLETE QUEST (E)", btnX + 20, btnY + 8, 16, BLACK);
             
-            bool completePressed = IsKeyPressed(KEY_E) || 
-                                  (useController && IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_DOWN));
+            bool completePressed = InputIsKeyPressed(KEY_E) || 
+                                  (useController && InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_FACE_DOWN));
             
             if (completePressed && isSelected) {
                 g_QuestManager.CompleteQuest(quest->id, g_PlayerProgression);
@@ -215,8 +216,8 @@ void DrawQuestsScreen(int screenW, int screenH, int contentX, int contentY, int
         }
         
         // Mouse selection
-        Vector2 mousePos = GetMousePosition();
-        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) &&
+        Vector2 mousePos = InputGetMousePosition();
+        if (InputIsMouseButtonPressed(MOUSE_LEFT_BUTTON) &&
             mousePos.x >= questX && mousePos.x <= questX + questW &&
             mousePos.y >= questY && mousePos.y <= questY + questH) {
             questSelection = (int)i;
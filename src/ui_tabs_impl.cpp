@@ -1,5 +1,6 @@
 #include "ui_tabs.h"
 #include "globals.h"
+#include "input.h"
 
 
 // Global TabManager instance definition
@@ -32,8 +33,8 @@ void TabManager::DrawTabBar(int screenW, int screenH, int menuX, int menuY, int
         DrawText(tabKeys[i], tabX + (tabWidth - keyW) / 2, menuY + 28, 12, 
                  isSelected ? PIPBOY_GREEN : Color{100, 150, 100, 255});
         
-        Vector2 mousePos = GetMousePosition();
-        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) &&
+        Vector2 mousePos = InputGetMousePosition();
+        if (InputIsMouseButtonPressed(MOUSE_LEFT_BUTTON) &&
             mousePos.x >= tabX && mousePos.x <= tabX + tabWidth - 2 &&
             mousePos.y >= menuY && mousePos.y <= menuY + tabHeight) {
             currentTab = (UITab)i;
@@ -48,17 +49,17 @@ void TabManager::DrawTabBar(int screenW, int screenH, int menuX, int menuY, int
 
 // TabManager::HandleTabInput implementation
 void TabManager::HandleTabInput(bool useController) {
-    if (IsKeyPressed(KEY_I)) currentTab = TAB_INVENTORY;
-    if (IsKeyPressed(KEY_C)) currentTab = TAB_CRAFTING;
-    if (IsKeyPressed(KEY_M)) currentTab = TAB_MAP;
-    if (IsKeyPressed(KEY_L)) currentTab = TAB_SKILLS;
-    if (IsKeyPressed(KEY_Q)) currentTab = TAB_QUESTS;
+    if (InputIsKeyPressed(KEY_I)) currentTab = TAB_INVENTORY;
+    if (InputIsKeyPressed(KEY_C)) currentTab = TAB_CRAFTING;
+    if (InputIsKeyPressed(KEY_M)) currentTab = TAB_MAP;
+    if (InputIsKeyPressed(KEY_L)) currentTab = TAB_SKILLS;
+    if (InputIsKeyPressed(KEY_Q)) currentTab = TAB_QUESTS;
     
-    if (useController && IsGamepadAvailable(0)) {
-        if (IsGamepadButtonPressed(0, GAMEPAD_BUTTON_LEFT_TRIGGER_1)) {
+    if (useController && InputIsGamepadAvailable(0)) {
+        if (InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_LEFT_TRIGGER_1)) {
             currentTab = (UITab)(((int)currentTab - 1 + TAB_COUNT) % TAB_COUNT);
         }
-        if (IsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_TRIGGER_1)) {
+        if (InputIsGamepadButtonPressed(0, GAMEPAD_BUTTON_RIGHT_TRIGGER_1)) {
             currentTab = (UITab)(((int)currentTab + 1) % TAB_COUNT);
         }
     }
@@ -0,0 +1,163 @@
+#include "uniform_buffer.h"
+#include "rlgl.h"
+#include "external/glad.h"
+#include <cstring>
+
+// Counters for the frame in progress and the last finished one
+static UniformStats currentStats = { 0, 0, 0, 0 };
+static UniformStats lastStats = { 0, 0, 0, 0 };
+
+// Byte size of a SetShaderValue type
+static int UniformTypeSize(int uniformType) {
+    switch (uniformType) {
+    case SHADER_UNIFORM_FLOAT: return 4;
+    case SHADER_UNIFORM_VEC2: return 8;
+    case SHADER_UNIFORM_VEC3: return 12;
+    case SHADER_UNIFORM_VEC4: return 16;
+    case SHADER_UNIFORM_INT: return 4;
+    case SHADER_UNIFORM_IVEC2: return 8;
+    case SHADER_UNIFORM_IVEC3: return 12;
+    case SHADER_UNIFORM_IVEC4: return 16;
+    case SHADER_UNIFORM_SAMPLER2D: return 4;
+    default: return 0;
+    }
+}
+
+void AttachUniformBlock(Shader shader, const char* blockName, unsigned int binding) {
+    if (shader.id == 0) return;
+    unsigned int index = glGetUniformBlockIndex(shader.id, blockName);
+    if (index != GL_INVALID_INDEX) glUniformBlockBinding(shader.id, index, binding);
+}
+
+void BeginUniformFrame() {
+    lastStats = currentStats;
+    currentStats = { 0, 0, 0, 0 };
+}
+
+const UniformStats& GetUniformStats() {
+    return lastStats;
+}
+
+void AppendUniformReport(std::vector<std::string>& lines) {
+    lines.push_back(TextFormat("Uniforms last frame: %d block uploads (%d bytes), %d value uploads, %d unchanged skipped",
+        lastStats.blockUploads, lastStats.blockBytes, lastStats.valueUploads, lastStats.skipped));
+}
+
+// =============================================================================
+// UNIFORM BUFFER
+// =============================================================================
+
+UniformBuffer::UniformBuffer() {
+    binding = 0;
+    buffer = 0;
+    dirtyBegin = 0;
+    dirtyEnd = 0;
+}
+
+UniformBuffer::~UniformBuffer() {
+    Unload();
+}
+
+bool UniformBuffer::Create(const char* blockName, unsigned int bindingPoint, int size) {
+    Unload();
+    name = blockName;
+    binding = bindingPoint;
+    data.assign(size, 0);
+
+    glGenBuffers(1, &buffer);
+    if (buffer == 0) {
+        TraceLog(LOG_WARNING, TextFormat("Uniform block %s could not be created", blockName));
+        return false;
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    glBufferData(GL_UNIFORM_BUFFER, size, data.data(), GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, binding, buffer);
+
+    dirtyBegin = dirtyEnd = 0;
+    return true;
+}
+
+void UniformBuffer::Write(int offset, const void* value, int size) {
+    if (offset < 0 || offset + size > (int)data.size()) return;
+    if (memcmp(&data[offset], value, size) == 0) {
+        currentStats.skipped++;
+        return;
+    }
+    memcpy(&data[offset], value, size);
+    if (dirtyBegin == dirtyEnd) {
+        dirtyBegin = offset;
+        dirtyEnd = offset + size;
+    }
+    else {
+        if (offset < dirtyBegin) dirtyBegin = offset;
+        if (offset + size > dirtyEnd) dirtyEnd = offset + size;
+    }
+}
+
+void UniformBuffer::Upload() {
+    if (buffer == 0 || dirtyBegin == dirtyEnd) return;
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, dirtyBegin, dirtyEnd - dirtyBegin, &data[dirtyBegin]);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    currentStats.blockUploads++;
+    currentStats.blockBytes += dirtyEnd - dirtyBegin;
+    dirtyBegin = dirtyEnd = 0;
+}
+
+void UniformBuffer::Attach(Shader shader) const {
+    AttachUniformBlock(shader, name.c_str(), binding);
+}
+
+void UniformBuffer::Unload() {
+    if (buffer != 0) glDeleteBuffers(1, &buffer);
+    buffer = 0;
+    data.clear();
+    dirtyBegin = dirtyEnd = 0;
+}
+
+// =============================================================================
+// SHADER UNIFORMS
+// =============================================================================
+
+ShaderUniforms::ShaderUniforms() {
+    shader = { 0 };
+}
+
+void ShaderUniforms::Reset(Shader newShader) {
+    shader = newShader;
+    slots.clear();
+}
+
+int ShaderUniforms::Add(const char* uniformName) {
+    Slot slot;
+    slot.location = shader.id > 0 ? GetShaderLocation(shader, uniformName) : -1;
+    slot.size = 0;
+    slot.valid = false;
+    slots.push_back(slot);
+    return (int)slots.size() - 1;
+}
+
+void ShaderUniforms::Set(int slotIndex, const void* value, int uniformType) {
+    if (slotIndex < 0 || slotIndex >= (int)slots.size()) return;
+    Slot& slot = slots[slotIndex];
+    if (slot.location < 0) return;
+
+    int size = UniformTypeSize(uniformType);
+    if (size == 0) return;
+    if (slot.valid && slot.size == size && memcmp(slot.value, value, size) == 0) {
+        currentStats.skipped++;
+        return;
+    }
+
+    SetShaderValue(shader, slot.location, value, uniformType);
+    memcpy(slot.value, value, size);
+    slot.size = size;
+    slot.valid = true;
+    currentStats.valueUploads++;
+}
+
+void ShaderUniforms::Invalidate() {
+    for (Slot& slot : slots) slot.valid = false;
+}
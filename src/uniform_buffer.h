@@ -0,0 +1,99 @@
+#pragma once
+#include "globals.h"
+#include <vector>
+#include <string>
+
+// Binding points shared by every shader that declares the block
+#define UNIFORM_BINDING_FRAME 0     // FrameBlock: camera, sun, fog, flashlight (ShaderManager)
+#define UNIFORM_BINDING_SHADOW 1    // ShadowBlock: shadow matrices and filter (ShadowManager)
+
+// Largest plain uniform value tracked by ShaderUniforms (one mat4)
+#define UNIFORM_VALUE_MAX_BYTES 64
+
+// Upload counters, reset by BeginUniformFrame
+struct UniformStats {
+    int blockUploads;      // glBufferSubData calls
+    int blockBytes;
+    int valueUploads;      // glUniform calls through ShaderUniforms
+    int skipped;           // Writes that matched what the GPU already has
+};
+
+// std140 uniform buffer with a CPU copy of its contents. Writes compare
+// against the copy and only widen the dirty range when bytes change, so
+// Upload sends one glBufferSubData for whatever actually changed (or none).
+class UniformBuffer {
+public:
+    UniformBuffer();
+    ~UniformBuffer();
+
+    // Create the buffer (zero-filled) and attach it to its binding point
+    bool Create(const char* blockName, unsigned int binding, int size);
+
+    bool IsReady() const { return buffer != 0; }
+
+    // Copy bytes into the block at a std140 offset
+    void Write(int offset, const void* data, int size);
+
+    template <typename T>
+    void Set(int offset, const T& value) { Write(offset, &value, (int)sizeof(T)); }
+
+    // Send the dirty range, if any
+    void Upload();
+
+    // Point a shader's block of this name at the binding point
+    void Attach(Shader shader) const;
+
+    void Unload();
+
+private:
+    std::string name;
+    unsigned int binding;
+    unsigned int buffer;
+    std::vector<unsigned char> data;
+    int dirtyBegin;
+    int dirtyEnd;
+};
+
+// Plain uniforms of one shader: locations are looked up once at load and the
+// last value sent to each is kept, so setting an unchanged value is free.
+class ShaderUniforms {
+public:
+    ShaderUniforms();
+
+    // Start over for a (re)loaded shader
+    void Reset(Shader shader);
+
+    // Register a uniform at load time; returns its slot (the location may be -1)
+    int Add(const char* uniformName);
+
+    // Upload through SetShaderValue if the value differs from the last upload
+    void Set(int slot, const void* value, int uniformType);
+    void SetInt(int slot, int value) { Set(slot, &value, SHADER_UNIFORM_INT); }
+    void SetFloat(int slot, float value) { Set(slot, &value, SHADER_UNIFORM_FLOAT); }
+    void SetVec2(int slot, Vector2 value) { Set(slot, &value, SHADER_UNIFORM_VEC2); }
+    void SetVec3(int slot, Vector3 value) { Set(slot, &value, SHADER_UNIFORM_VEC3); }
+
+    // Drop the cached values (e.g. after something else wrote the uniforms)
+    void Invalidate();
+
+private:
+    struct Slot {
+        int location;
+        int size;
+        bool valid;
+        unsigned char value[UNIFORM_VALUE_MAX_BYTES];
+    };
+
+    Shader shader;
+    std::vector<Slot> slots;
+};
+
+// Point a shader's uniform block at a binding point (no-op if it has no such block)
+void AttachUniformBlock(Shader shader, const char* blockName, unsigned int binding);
+
+// Frame counters
+void BeginUniformFrame();
+const UniformStats& GetUniformStats();
+
+// Console report (last full frame)
+void AppendUniformReport(std::vector<std::string>& lines);
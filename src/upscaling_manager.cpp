@@ -1,4 +1,5 @@
 #include "upscaling_manager.h"
+#include "profiler.h"
 #include "rlgl.h"
 
 // Global instance
@@ -25,6 +26,7 @@ UpscalingManager::UpscalingManager() {
     currentDisplayHeight = 0;
     renderTarget = { 0 };
     upscaleShader = { 0 };
+    sharpnessSlot = inputSizeSlot = outputSizeSlot = -1;
 }
 
 UpscalingManager::~UpscalingManager() {
@@ -74,6 +76,11 @@ bool UpscalingManager::LoadFSRShader() {
         upscaleShader = LoadShader("assets/shaders/fsr.vs", "assets/shaders/fsr.fs");
         if (upscaleShader.id > 0) {
             shaderLoaded = true;
+            fsrUniforms.Reset(upscaleShader);
+            sharpnessSlot = fsrUniforms.Add("sharpness");
+            inputSizeSlot = fsrUniforms.Add("inputSize");
+            outputSizeSlot = fsrUniforms.Add("outputSize");
+            AttachUniformBlock(upscaleShader, "FrameBlock", UNIFORM_BINDING_FRAME);
             return true;
         }
     }
@@ -146,6 +153,7 @@ void UpscalingManager::BeginUpscaledRender() {
 }
 
 void UpscalingManager::EndUpscaledRender(int displayWidth, int displayHeight) {
+    PROFILE_SCOPE("Upscale");
     if (currentMode != UPSCALING_NONE && renderTarget.id > 0) {
         EndTextureMode();
         
@@ -176,17 +184,10 @@ void UpscalingManager::ApplyFSR(int displayWidth, int displayHeight) {
         // Use FSR shader with sharpening
         BeginShaderMode(upscaleShader);
         
-        // Set shader uniforms
-        int sharpnessLoc = GetShaderLocation(upscaleShader, "sharpness");
-        SetShaderValue(upscaleShader, sharpnessLoc, &sharpness, SHADER_UNIFORM_FLOAT);
-        
-        int inputSizeLoc = GetShaderLocation(upscaleShader, "inputSize");
-        float inputSize[2] = { (float)currentRenderWidth, (float)currentRenderHeight };
-        SetShaderValue(upscaleShader, inputSizeLoc, inputSize, SHADER_UNIFORM_VEC2);
-        
-        int outputSizeLoc = GetShaderLocation(upscaleShader, "outputSize");
-        float outputSize[2] = { (float)displayWidth, (float)displayHeight };
-        SetShaderValue(upscaleShader, outputSizeLoc, outputSize, SHADER_UNIFORM_VEC2);
+        // Set shader uniforms (only sent when they change)
+        fsrUniforms.SetFloat(sharpnessSlot, sharpness);
+        fsrUniforms.SetVec2(inputSizeSlot, Vector2{ (float)currentRenderWidth, (float)currentRenderHeight });
+        fsrUniforms.SetVec2(outputSizeSlot, Vector2{ (float)displayWidth, (float)displayHeight });
         
         // Draw upscaled texture
         DrawTexturePro(
@@ -226,6 +227,7 @@ void UpscalingManager::Unload() {
     if (shaderLoaded && upscaleShader.id > 0) {
         UnloadShader(upscaleShader);
         upscaleShader = { 0 };
+        fsrUniforms.Reset(upscaleShader);
         shaderLoaded = false;
     }
 }
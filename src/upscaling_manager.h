@@ -1,5 +1,6 @@
 #pragma once
 #include "globals.h"
+#include "uniform_buffer.h"
 
 // Forward declarations (enums already defined in globals.h)
 class UpscalingManager;
@@ -49,6 +50,10 @@ private:
     RenderTexture2D renderTarget;
     Shader upscaleShader;
     bool shaderLoaded;
+    ShaderUniforms fsrUniforms;     // Locations looked up once at load
+    int sharpnessSlot;
+    int inputSizeSlot;
+    int outputSizeSlot;
 
     int currentRenderWidth;
     int currentRenderHeight;
@@ -1,5 +1,7 @@
 #pragma once
 #include "globals.h"
+#include "render_queue.h"
+#include "culling.h"
 #include <vector>
 #include <string>
 
@@ -71,19 +73,27 @@ public:
     
     // Draw waypoints in 3D world
     void DrawIn3D(Vector3 playerPos, float maxDistance = 100.0f) {
+        RenderImportanceScope importance(RENDER_IMPORTANCE_HIGH);
         for (const auto& wp : waypoints) {
             if (!wp.isActive) continue;
             
             float distance = Vector3Distance(playerPos, wp.position);
             if (distance > maxDistance) continue;
             
+            // Beam and marker together
+            BoundingBox bounds = {
+                Vector3{ wp.position.x - 0.5f, wp.position.y - 0.5f, wp.position.z - 0.5f },
+                Vector3{ wp.position.x + 0.5f, wp.position.y + 50.0f, wp.position.z + 0.5f }
+            };
+            if (!IsBoxInView(bounds)) continue;
+            
             // Draw vertical beam
             Vector3 beamTop = wp.position;
             beamTop.y += 50.0f;
-            DrawLine3D(wp.position, beamTop, wp.color);
+            QueueLine3D(wp.position, beamTop, wp.color);
             
             // Draw marker at waypoint location
-            DrawSphere(wp.position, 0.5f, wp.color);
+            QueueSphere(wp.position, 0.5f, wp.color);
         }
     }
     
@@ -1,5 +1,6 @@
 #include "weapons.h"
 #include "model_manager.h"
+#include "render_queue.h"
 #include "rlgl.h"
 
 // Global instances
@@ -24,7 +25,7 @@ void DrawEnhancedPistol(Vector3 basePos, Vector3 forward, Vector3 right, Vector3
         g_ModelManager->DrawModel(MODEL_PISTOL, adjustedPos, forward, right, up, WHITE);
     } else {
         // Fallback to simple cube
-        DrawCube(basePos, 0.05f, 0.05f, 0.15f, Color{60, 60, 65, 255});
+        QueueCube(basePos, 0.05f, 0.05f, 0.15f, Color{60, 60, 65, 255});
     }
 }
 
@@ -38,7 +39,7 @@ void DrawM16Rifle(Vector3 basePos, Vector3 forward, Vector3 right, Vector3 up, c
         g_ModelManager->DrawModel(MODEL_M16, adjustedPos, forward, right, up, WHITE);
     } else {
         // Fallback to simple cube
-        DrawCube(basePos, 0.05f, 0.08f, 0.25f, Color{40, 40, 45, 255});
+        QueueCube(basePos, 0.05f, 0.08f, 0.25f, Color{40, 40, 45, 255});
     }
 }
 
@@ -61,19 +62,19 @@ void DrawLeftHandOnWeapon(Vector3 weaponPos, Vector3 forward, Vector3 right, Vec
     }
 
     // Palm
-    DrawCubeV(handPos, Vector3{ 0.03f, 0.04f, 0.06f }, Color{ 210, 180, 140, 255 });
+    QueueCubeV(handPos, Vector3{ 0.03f, 0.04f, 0.06f }, Color{ 210, 180, 140, 255 });
 
     // Fingers
     for (int i = 0; i < 4; i++) {
         Vector3 fingerPos = Vector3Add(handPos, Vector3Scale(forward, 0.04f + i * 0.008f));
         fingerPos = Vector3Add(fingerPos, Vector3Scale(right, -0.015f + i * 0.008f));
-        DrawCubeV(fingerPos, Vector3{ 0.008f, 0.008f, 0.025f }, Color{ 200, 170, 130, 255 });
+        QueueCubeV(fingerPos, Vector3{ 0.008f, 0.008f, 0.025f }, Color{ 200, 170, 130, 255 });
     }
 
     // Thumb
     Vector3 thumbPos = Vector3Add(handPos, Vector3Scale(right, 0.02f));
     thumbPos = Vector3Add(thumbPos, Vector3Scale(forward, 0.02f));
-    DrawCubeV(thumbPos, Vector3{ 0.01f, 0.01f, 0.02f }, Color{ 200, 170, 130, 255 });
+    QueueCubeV(thumbPos, Vector3{ 0.01f, 0.01f, 0.02f }, Color{ 200, 170, 130, 255 });
 }
 
 // Draw idle hands when no weapon equipped
@@ -93,14 +94,14 @@ void DrawIdleHands(const Camera3D& camera, float time) {
     rightHandPos = Vector3Add(rightHandPos, Vector3Scale(up, -0.2f + bobAmount));
 
     // Right palm
-    DrawCubeV(rightHandPos, Vector3{ 0.035f, 0.045f, 0.07f }, Color{ 210, 180, 140, 255 });
+    QueueCubeV(rightHandPos, Vector3{ 0.035f, 0.045f, 0.07f }, Color{ 210, 180, 140, 255 });
 
     // Right fingers (relaxed)
     for (int i = 0; i < 4; i++) {
         Vector3 fingerPos = Vector3Add(rightHandPos, Vector3Scale(forward, 0.04f));
         fingerPos = Vector3Add(fingerPos, Vector3Scale(right, -0.02f + i * 0.01f));
         fingerPos = Vector3Add(fingerPos, Vector3Scale(up, -0.01f * i));
-        DrawCubeV(fingerPos, Vector3{ 0.009f, 0.009f, 0.028f }, Color{ 200, 170, 130, 255 });
+        QueueCubeV(fingerPos, Vector3{ 0.009f, 0.009f, 0.028f }, Color{ 200, 170, 130, 255 });
     }
 
     // Left hand (mirrored and slightly different)
@@ -110,13 +111,13 @@ void DrawIdleHands(const Camera3D& camera, float time) {
     leftHandPos = Vector3Add(leftHandPos, Vector3Scale(up, -0.22f + bobAmount * 0.8f));
 
     // Left palm
-    DrawCubeV(leftHandPos, Vector3{ 0.035f, 0.045f, 0.07f }, Color{ 210, 180, 140, 255 });
+    QueueCubeV(leftHandPos, Vector3{ 0.035f, 0.045f, 0.07f }, Color{ 210, 180, 140, 255 });
 
     // Left fingers
     for (int i = 0; i < 4; i++) {
         Vector3 fingerPos = Vector3Add(leftHandPos, Vector3Scale(forward, 0.04f));
         fingerPos = Vector3Add(fingerPos, Vector3Scale(right, 0.02f - i * 0.01f));
         fingerPos = Vector3Add(fingerPos, Vector3Scale(up, -0.01f * i));
-        DrawCubeV(fingerPos, Vector3{ 0.009f, 0.009f, 0.028f }, Color{ 200, 170, 130, 255 });
+        QueueCubeV(fingerPos, Vector3{ 0.009f, 0.009f, 0.028f }, Color{ 200, 170, 130, 255 });
     }
 }
\ No newline at end of file
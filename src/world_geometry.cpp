@@ -0,0 +1,592 @@
+#include "world_geometry.h"
+#include "mesh_builder.h"
+#include "texture_manager.h"
+#include "render_queue.h"
+#include "profiler.h"
+
+// Global instance
+WorldGeometry* g_WorldGeometry = nullptr;
+
+// Colors matching the immediate-mode building path
+static const Color BUILDING_WALL_FALLBACK_COLOR = { 120, 120, 130, 255 };
+static const Color BUILDING_ROOF_COLOR = { 80, 50, 50, 255 };
+static const float ROOF_THICKNESS = 0.2f;
+
+// Top of the old per-tile ground slabs (0.05 tall, centred on y = 0)
+static const float GROUND_TOP = 0.025f;
+
+// Size of the tileLayer uniform array in tilemap.fs
+static const int TILE_LAYER_SLOTS = 8;
+
+// LOD switch distances (from the closest point of the bounds)
+static const LodBands BUILDING_LOD_BANDS = { { 60.0f }, 1 };
+
+// Interior surfaces matching the immediate-mode interior path
+static const Color INTERIOR_WALL_FALLBACK_COLOR = { 180, 180, 185, 255 };
+static const Color INTERIOR_CEILING_COLOR = { 240, 240, 240, 255 };
+static const float INTERIOR_CEILING_THICKNESS = 0.1f;
+
+WorldGeometry::WorldGeometry() {
+    tileIndexTexture = { 0 };
+    groundMaterial = { 0 };
+    groundMaterialLoaded = false;
+}
+
+WorldGeometry::~WorldGeometry() {
+    Unload();
+}
+
+// Baked meshes go through the surface shader when the packed texture set exists:
+// every surface is one layer, so a building or interior is a single mesh and draw
+static bool UseSurfaceTextures() {
+    return g_TextureManager && g_TextureManager->HasSurfaceTextures() &&
+        g_ShaderManager && g_ShaderManager->IsSurfaceShaderLoaded();
+}
+
+// Assign the surface shader (and the atlas, when arrays are unavailable) to a material
+static void ApplySurfaceMaterial(Material& material, Shader shader) {
+    material.shader = shader;
+    if (g_TextureManager->IsSurfaceAtlas()) {
+        material.maps[MATERIAL_MAP_ALBEDO].texture = g_TextureManager->GetSurfaceAtlas();
+    }
+}
+
+void WorldGeometry::BakeBuildings(const MapData& mapData) {
+    PROFILE_SCOPE("BakeBuildings");
+    UnloadBuildings();
+
+    Texture2D wallTex = g_TextureManager ? g_TextureManager->GetTexture(TEX_BUILDING_EXTERIOR) : Texture2D{ 0 };
+    int wallLayer = UseSurfaceTextures() ? g_TextureManager->GetSurfaceLayer(TEX_BUILDING_EXTERIOR) : -1;
+
+    int totalVertices = 0;
+    buildingLookup.assign(mapData.buildings.size(), -1);
+    for (size_t b = 0; b < mapData.buildings.size(); b++) {
+        BakedBuilding baked = BakeBuilding(mapData.buildings[b], wallTex, wallLayer);
+        if (baked.model.meshCount > 0) {
+            buildingLookup[b] = (int)buildingModels.size();
+            for (int i = 0; i < baked.model.meshCount; i++) {
+                totalVertices += baked.model.meshes[i].vertexCount;
+            }
+            buildingModels.push_back(baked);
+            buildingBounds.Add(baked.bounds);
+        }
+    }
+
+    TraceLog(LOG_INFO, "World geometry baked: %d buildings, %d vertices",
+        (int)buildingModels.size(), totalVertices);
+}
+
+BakedBuilding WorldGeometry::BakeBuilding(const Building& building, Texture2D wallTexture, int wallLayer) {
+    BakedBuilding baked;
+    baked.buildingId = building.id;
+    baked.model = { 0 };
+    baked.farModel = { 0 };
+    baked.lodLevel = 0;
+
+    const BuildingRect& fp = building.footprint;
+    Color wallColor = wallTexture.id > 0 ? WHITE : BUILDING_WALL_FALLBACK_COLOR;
+
+    // One texture repeat per tile horizontally and one over the wall height,
+    // matching the per-tile cubes this replaces
+    Vector2 wallUV = { 1.0f, 1.0f / WALL_HEIGHT };
+
+    // Walls sit on the ground, so their bottom faces are never visible
+    int wallFaces = BOX_FACE_ALL & ~BOX_FACE_BOTTOM;
+
+    MeshBuilder walls;
+    if (wallLayer >= 0) walls.SetLayer(wallLayer);
+
+    // Merge contiguous perimeter tiles into one box per run, splitting at the entrance
+    auto emitRow = [&](int z, int x0, int x1) {
+        int runStart = -1;
+        for (int x = x0; x <= x1 + 1; x++) {
+            bool solid = x <= x1 && !(x == building.entranceX && z == building.entranceY);
+            if (solid && runStart < 0) runStart = x;
+            if (!solid && runStart >= 0) {
+                int len = x - runStart;
+                walls.AddBox(Vector3{ runStart + (len - 1) / 2.0f, WALL_HEIGHT / 2.0f, (float)z },
+                    Vector3{ (float)len, WALL_HEIGHT, 1.0f }, wallUV, wallColor, wallFaces);
+                runStart = -1;
+            }
+        }
+    };
+    auto emitColumn = [&](int x, int z0, int z1) {
+        int runStart = -1;
+        for (int z = z0; z <= z1 + 1; z++) {
+            bool solid = z <= z1 && !(x == building.entranceX && z == building.entranceY);
+            if (solid && runStart < 0) runStart = z;
+            if (!solid && runStart >= 0) {
+                int len = z - runStart;
+                walls.AddBox(Vector3{ (float)x, WALL_HEIGHT / 2.0f, runStart + (len - 1) / 2.0f },
+                    Vector3{ 1.0f, WALL_HEIGHT, (float)len }, wallUV, wallColor, wallFaces);
+                runStart = -1;
+            }
+        }
+    };
+
+    int xMax = fp.x + fp.w - 1;
+    int zMax = fp.y + fp.h - 1;
+    emitRow(fp.y, fp.x, xMax);
+    if (zMax > fp.y) emitRow(zMax, fp.x, xMax);
+    if (zMax - fp.y > 1) {
+        emitColumn(fp.x, fp.y + 1, zMax - 1);
+        if (xMax > fp.x) emitColumn(xMax, fp.y + 1, zMax - 1);
+    }
+
+    Vector3 roofCenter = { fp.x + fp.w / 2.0f, CEILING_HEIGHT, fp.y + fp.h / 2.0f };
+    Vector3 roofSize = { (float)fp.w, ROOF_THICKNESS, (float)fp.h };
+
+    if (walls.IsEmpty()) return baked;
+
+    // Far LOD: the whole perimeter as one box with the same wall tiling, no entrance gap
+    MeshBuilder shell;
+    if (wallLayer >= 0) shell.SetLayer(wallLayer);
+    shell.AddBox(Vector3{ fp.x - 0.5f + fp.w / 2.0f, WALL_HEIGHT / 2.0f, fp.y - 0.5f + fp.h / 2.0f },
+        Vector3{ (float)fp.w, WALL_HEIGHT, (float)fp.h }, wallUV, wallColor,
+        BOX_FACE_FRONT | BOX_FACE_BACK | BOX_FACE_LEFT | BOX_FACE_RIGHT);
+
+    auto finishModel = [&](MeshBuilder& sides) {
+        Model model;
+        if (wallLayer >= 0) {
+            // Single mesh: the untextured roof rides along as layer -1
+            sides.SetLayer(-1);
+            sides.AddBox(roofCenter, roofSize, Vector2{ 1.0f, 1.0f }, BUILDING_ROOF_COLOR);
+
+            Mesh mesh = sides.Build();
+            model = LoadModelFromMeshes(&mesh, 1);
+            ApplySurfaceMaterial(model.materials[0], g_ShaderManager->GetSurfaceShader());
+        }
+        else {
+            MeshBuilder roof;
+            roof.AddBox(roofCenter, roofSize, Vector2{ 1.0f, 1.0f }, BUILDING_ROOF_COLOR);
+
+            Mesh meshes[2] = { sides.Build(), roof.Build() };
+            model = LoadModelFromMeshes(meshes, 2);
+            if (wallTexture.id > 0) {
+                model.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = wallTexture;
+            }
+        }
+        return model;
+    };
+
+    baked.model = finishModel(walls);
+    baked.farModel = finishModel(shell);
+
+    baked.bounds = GetModelBoundingBox(baked.model);
+    return baked;
+}
+
+const Model& WorldGeometry::SelectBuildingModel(BakedBuilding& building) {
+    if (!g_LodSystem || building.farModel.meshCount == 0) return building.model;
+    int level = g_LodSystem->SelectBox(&building.lodLevel, building.bounds, BUILDING_LOD_BANDS);
+    return level > 0 ? building.farModel : building.model;
+}
+
+void WorldGeometry::DrawBuildings() {
+    RenderStatPassScope statPass(STAT_PASS_BUILDINGS);
+    int drawn = (int)buildingModels.size();
+    if (g_FrustumCuller) drawn = g_FrustumCuller->CullBoxes(buildingBounds, visibility);
+    else visibility.assign(buildingModels.size(), 1);
+    if (g_RenderStats) g_RenderStats->RecordObjects(STAT_PASS_BUILDINGS, drawn, (int)buildingModels.size() - drawn);
+
+    for (size_t i = 0; i < buildingModels.size(); i++) {
+        if (visibility[i]) QueueModel(SelectBuildingModel(buildingModels[i]), MatrixIdentity(), WHITE);
+    }
+}
+
+bool WorldGeometry::DrawBuilding(int buildingIndex) {
+    if (buildingIndex < 0 || buildingIndex >= (int)buildingLookup.size()) return false;
+    int baked = buildingLookup[buildingIndex];
+    if (baked < 0) return false;
+
+    RenderStatPassScope statPass(STAT_PASS_BUILDINGS);
+    QueueModel(SelectBuildingModel(buildingModels[baked]), MatrixIdentity(), WHITE);
+    return true;
+}
+
+void WorldGeometry::BakeGround(const MapData& mapData) {
+    PROFILE_SCOPE("BakeGround");
+    UnloadGround();
+
+    if (!g_ShaderManager || !g_ShaderManager->IsTilemapShaderLoaded()) return;
+    if (!g_TextureManager || !g_TextureManager->HasSurfaceTextures()) return;
+    if (mapData.width <= 0 || mapData.height <= 0) return;
+
+    // Tile index texture: one 8-bit texel per tile, sampled with texelFetch
+    Image tileImage = GenImageColor(mapData.width, mapData.height, BLACK);
+    ImageFormat(&tileImage, PIXELFORMAT_UNCOMPRESSED_GRAYSCALE);
+    unsigned char* pixels = (unsigned char*)tileImage.data;
+    for (int i = 0; i < mapData.width * mapData.height; i++) {
+        pixels[i] = (unsigned char)mapData.tiles[i];
+    }
+    tileIndexTexture = LoadTextureFromImage(tileImage);
+    UnloadImage(tileImage);
+    SetTextureFilter(tileIndexTexture, TEXTURE_FILTER_POINT);
+    SetTextureWrap(tileIndexTexture, TEXTURE_WRAP_CLAMP);
+
+    // Ground surfaces come from the packed texture set; only the tile index map is a material map
+    Shader tilemapShader = g_ShaderManager->GetTilemapShader();
+    groundMaterial = LoadMaterialDefault();
+    ApplySurfaceMaterial(groundMaterial, tilemapShader);
+    groundMaterial.maps[MATERIAL_MAP_ROUGHNESS].texture = tileIndexTexture;
+    groundMaterialLoaded = true;
+
+    // WorldTile id -> surface layer: grass everywhere, road/concrete asphalt, water grass (as before)
+    int grassLayer = g_TextureManager->GetSurfaceLayer(TEX_GRASS);
+    int roadLayer = g_TextureManager->GetSurfaceLayer(TEX_ROAD_ASPHALT);
+    int tileLayer[TILE_LAYER_SLOTS];
+    for (int i = 0; i < TILE_LAYER_SLOTS; i++) tileLayer[i] = grassLayer;
+    tileLayer[WT_ROAD] = roadLayer;
+    tileLayer[WT_CONCRETE] = roadLayer;
+    tileLayer[WT_WATER] = grassLayer;
+    int mapSize[2] = { mapData.width, mapData.height };
+    SetShaderValueV(tilemapShader, GetShaderLocation(tilemapShader, "tileLayer"),
+        tileLayer, SHADER_UNIFORM_INT, TILE_LAYER_SLOTS);
+    SetShaderValue(tilemapShader, GetShaderLocation(tilemapShader, "mapSize"), mapSize, SHADER_UNIFORM_IVEC2);
+
+    // One quad per chunk; tiles are centred on integer coordinates
+    for (int cz = 0; cz < mapData.height; cz += GROUND_CHUNK_SIZE) {
+        for (int cx = 0; cx < mapData.width; cx += GROUND_CHUNK_SIZE) {
+            int w = std::min(GROUND_CHUNK_SIZE, mapData.width - cx);
+            int h = std::min(GROUND_CHUNK_SIZE, mapData.height - cz);
+            float x0 = cx - 0.5f, x1 = cx + w - 0.5f;
+            float z0 = cz - 0.5f, z1 = cz + h - 0.5f;
+
+            MeshBuilder quad;
+            quad.AddQuad(Vector3{ x0, GROUND_TOP, z1 }, Vector3{ x1, GROUND_TOP, z1 },
+                Vector3{ x1, GROUND_TOP, z0 }, Vector3{ x0, GROUND_TOP, z0 },
+                Vector3{ 0.0f, 1.0f, 0.0f }, Vector2{ 0.0f, 0.0f }, Vector2{ (float)w, (float)h });
+
+            GroundChunk chunk;
+            chunk.mesh = quad.Build();
+            chunk.bounds = BoundingBox{ Vector3{ x0, -0.025f, z0 }, Vector3{ x1, GROUND_TOP, z1 } };
+            groundChunks.push_back(chunk);
+            groundBounds.Add(chunk.bounds);
+        }
+    }
+
+    TraceLog(LOG_INFO, "World geometry ground: %dx%d tiles in %d chunks",
+        mapData.width, mapData.height, (int)groundChunks.size());
+}
+
+void WorldGeometry::DrawGround() {
+    RenderStatPassScope statPass(STAT_PASS_GROUND);
+    int drawn = (int)groundChunks.size();
+    if (g_FrustumCuller) drawn = g_FrustumCuller->CullBoxes(groundBounds, visibility);
+    else visibility.assign(groundChunks.size(), 1);
+    if (g_RenderStats) g_RenderStats->RecordObjects(STAT_PASS_GROUND, drawn, (int)groundChunks.size() - drawn);
+
+    for (size_t i = 0; i < groundChunks.size(); i++) {
+        if (visibility[i]) QueueMesh(groundChunks[i].mesh, groundMaterial, MatrixIdentity());
+    }
+}
+
+void WorldGeometry::DrawGroundChunk(int chunkIndex) {
+    if (chunkIndex < 0 || chunkIndex >= (int)groundChunks.size()) return;
+    RenderStatPassScope statPass(STAT_PASS_GROUND);
+    QueueMesh(groundChunks[chunkIndex].mesh, groundMaterial, MatrixIdentity());
+}
+
+// =============================================================================
+// INTERIOR MESHING
+// =============================================================================
+
+void WorldGeometry::BakeInteriors(const MapData& mapData) {
+    PROFILE_SCOPE("BakeInteriors");
+    UnloadInteriors();
+    for (const auto& pair : mapData.interiors) {
+        interiorShells[pair.first] = BakeInterior(pair.second);
+    }
+}
+
+const InteriorShell* WorldGeometry::GetInteriorShell(const Interior& interior) {
+    auto it = interiorShells.find(interior.id);
+    if (it == interiorShells.end()) {
+        // Interior added after the map bake - mesh it on first use
+        it = interiorShells.emplace(interior.id, BakeInterior(interior)).first;
+    }
+    return &it->second;
+}
+
+bool WorldGeometry::DrawInterior(const Interior& interior, const std::vector<unsigned char>* visibleCells) {
+    const InteriorShell* shell = GetInteriorShell(interior);
+    if (shell->model.meshCount == 0) return false;
+
+    RenderStatPassScope statPass(STAT_PASS_INTERIOR);
+    const Model& model = shell->model;
+    for (int i = 0; i < model.meshCount; i++) {
+        // Shared geometry (cell == cell count) is always drawn
+        int cell = shell->meshCell[i];
+        if (visibleCells && cell < (int)visibleCells->size() && !(*visibleCells)[cell]) continue;
+        QueueMesh(model.meshes[i], model.materials[model.meshMaterial[i]], MatrixIdentity());
+    }
+    return true;
+}
+
+InteriorShell WorldGeometry::BakeInterior(const Interior& interior) {
+    InteriorShell shell;
+    shell.model = { 0 };
+    shell.graph.Build(interior);
+
+    Texture2D wallTex = g_TextureManager ? g_TextureManager->GetTexture(TEX_WALL_CONCRETE) : Texture2D{ 0 };
+    Texture2D floorTex = g_TextureManager ? g_TextureManager->GetTexture(TEX_FLOOR_TILE) : Texture2D{ 0 };
+
+    const int W = interior.width;
+    const int H = interior.height;
+    const PortalGraph& graph = shell.graph;
+    auto tileAt = [&](int x, int y) { return interior.tiles[y * W + x]; };
+    // Out-of-bounds counts as solid: the player never sees the outside of an interior
+    auto isSolid = [&](int x, int y) {
+        return x < 0 || y < 0 || x >= W || y >= H || tileAt(x, y) == IT_WALL;
+    };
+    auto isFloor = [&](int x, int y) {
+        int t = tileAt(x, y);
+        return t != IT_EMPTY && t != IT_WALL;
+    };
+
+    // Geometry is bucketed by portal cell so hidden rooms can be skipped.
+    // The extra last bucket holds surfaces no cell owns and is always drawn.
+    const int sharedBucket = graph.GetCellCount();
+    const int bucketCount = sharedBucket + 1;
+    auto bucketOf = [&](int x, int y) {
+        int cell = graph.GetCellAt(x, y);
+        return cell >= 0 ? cell : sharedBucket;
+    };
+
+    // With the surface set everything goes into one builder per bucket, switching layers per surface
+    bool layered = UseSurfaceTextures();
+    int wallLayer = layered ? g_TextureManager->GetSurfaceLayer(TEX_WALL_CONCRETE) : -1;
+    int floorLayer = layered ? g_TextureManager->GetSurfaceLayer(TEX_FLOOR_TILE) : -1;
+
+    std::vector<MeshBuilder> wallBuilders(bucketCount);
+    std::vector<MeshBuilder> floorBuilders(layered ? 0 : bucketCount);
+    std::vector<MeshBuilder> ceilingBuilders(layered ? 0 : bucketCount);
+    auto wallsFor = [&](int bucket) -> MeshBuilder& {
+        MeshBuilder& builder = wallBuilders[bucket];
+        if (layered) builder.SetLayer(wallLayer);
+        return builder;
+    };
+    auto floorFor = [&](int bucket) -> MeshBuilder& {
+        MeshBuilder& builder = layered ? wallBuilders[bucket] : floorBuilders[bucket];
+        if (layered) builder.SetLayer(floorLayer);
+        return builder;
+    };
+    auto ceilingFor = [&](int bucket) -> MeshBuilder& {
+        MeshBuilder& builder = layered ? wallBuilders[bucket] : ceilingBuilders[bucket];
+        if (layered) builder.SetLayer(-1);
+        return builder;
+    };
+
+    // Walls: only faces bordering an open tile, merged into runs along each row/column.
+    // Each face belongs to the cell it faces. Tops are hidden by the ceiling and
+    // bottoms by the floor, so only sides are emitted.
+    Color wallColor = (wallTex.id > 0 || layered) ? WHITE : INTERIOR_WALL_FALLBACK_COLOR;
+    Vector2 uvZero = { 0.0f, 0.0f };
+
+    for (int dir = -1; dir <= 1; dir += 2) {
+        // Faces pointing along +/-Z: runs along X
+        for (int y = 0; y < H; y++) {
+            float zf = y + dir * 0.5f;
+            int runStart = -1;
+            int runBucket = -1;
+            for (int x = 0; x <= W; x++) {
+                bool face = x < W && !isSolid(x, y + dir) && isSolid(x, y);
+                int bucket = face ? bucketOf(x, y + dir) : -1;
+                if (runStart >= 0 && bucket != runBucket) {
+                    float x0 = runStart - 0.5f, x1 = x - 0.5f;
+                    Vector2 uvMax = { (float)(x - runStart), 1.0f };
+                    MeshBuilder& walls = wallsFor(runBucket);
+                    if (dir > 0) {
+                        walls.AddQuad(Vector3{ x0, 0.0f, zf }, Vector3{ x1, 0.0f, zf },
+                            Vector3{ x1, WALL_HEIGHT, zf }, Vector3{ x0, WALL_HEIGHT, zf },
+                            Vector3{ 0.0f, 0.0f, 1.0f }, uvZero, uvMax, wallColor);
+                    }
+                    else {
+                        walls.AddQuad(Vector3{ x1, 0.0f, zf }, Vector3{ x0, 0.0f, zf },
+                            Vector3{ x0, WALL_HEIGHT, zf }, Vector3{ x1, WALL_HEIGHT, zf },
+                            Vector3{ 0.0f, 0.0f, -1.0f }, uvZero, uvMax, wallColor);
+                    }
+                    runStart = -1;
+                }
+                if (face && runStart < 0) {
+                    runStart = x;
+                    runBucket = bucket;
+                }
+            }
+        }
+
+        // Faces pointing along +/-X: runs along Z
+        for (int x = 0; x < W; x++) {
+            float xf = x + dir * 0.5f;
+            int runStart = -1;
+            int runBucket = -1;
+            for (int y = 0; y <= H; y++) {
+                bool face = y < H && !isSolid(x + dir, y) && isSolid(x, y);
+                int bucket = face ? bucketOf(x + dir, y) : -1;
+                if (runStart >= 0 && bucket != runBucket) {
+                    float z0 = runStart - 0.5f, z1 = y - 0.5f;
+                    Vector2 uvMax = { (float)(y - runStart), 1.0f };
+                    MeshBuilder& walls = wallsFor(runBucket);
+                    if (dir > 0) {
+                        walls.AddQuad(Vector3{ xf, 0.0f, z1 }, Vector3{ xf, 0.0f, z0 },
+                            Vector3{ xf, WALL_HEIGHT, z0 }, Vector3{ xf, WALL_HEIGHT, z1 },
+                            Vector3{ 1.0f, 0.0f, 0.0f }, uvZero, uvMax, wallColor);
+                    }
+                    else {
+                        walls.AddQuad(Vector3{ xf, 0.0f, z0 }, Vector3{ xf, 0.0f, z1 },
+                            Vector3{ xf, WALL_HEIGHT, z1 }, Vector3{ xf, WALL_HEIGHT, z0 },
+                            Vector3{ -1.0f, 0.0f, 0.0f }, uvZero, uvMax, wallColor);
+                    }
+                    runStart = -1;
+                }
+                if (face && runStart < 0) {
+                    runStart = y;
+                    runBucket = bucket;
+                }
+            }
+        }
+    }
+
+    // Floor and ceiling: greedy rectangles over the open tiles of each cell.
+    // The ceiling sits where the old ceiling slab's underside was.
+    std::vector<bool> used(W * H, false);
+    float cy = CEILING_HEIGHT - INTERIOR_CEILING_THICKNESS / 2.0f;
+    for (int y = 0; y < H; y++) {
+        for (int x = 0; x < W; x++) {
+            if (used[y * W + x] || !isFloor(x, y)) continue;
+
+            int bucket = bucketOf(x, y);
+            auto canGrow = [&](int gx, int gy) {
+                return !used[gy * W + gx] && isFloor(gx, gy) && bucketOf(gx, gy) == bucket;
+            };
+
+            int rw = 1;
+            while (x + rw < W && canGrow(x + rw, y)) rw++;
+
+            int rh = 1;
+            while (y + rh < H) {
+                bool rowOk = true;
+                for (int xx = x; xx < x + rw && rowOk; xx++) {
+                    rowOk = canGrow(xx, y + rh);
+                }
+                if (!rowOk) break;
+                rh++;
+            }
+
+            for (int yy = y; yy < y + rh; yy++) {
+                for (int xx = x; xx < x + rw; xx++) used[yy * W + xx] = true;
+            }
+
+            float x0 = x - 0.5f, x1 = x + rw - 0.5f;
+            float z0 = y - 0.5f, z1 = y + rh - 0.5f;
+            if (floorTex.id > 0 || layered) {
+                floorFor(bucket).AddQuad(Vector3{ x0, GROUND_TOP, z1 }, Vector3{ x1, GROUND_TOP, z1 },
+                    Vector3{ x1, GROUND_TOP, z0 }, Vector3{ x0, GROUND_TOP, z0 },
+                    Vector3{ 0.0f, 1.0f, 0.0f }, uvZero, Vector2{ (float)rw, (float)rh });
+            }
+            ceilingFor(bucket).AddQuad(Vector3{ x0, cy, z0 }, Vector3{ x1, cy, z0 },
+                Vector3{ x1, cy, z1 }, Vector3{ x0, cy, z1 },
+                Vector3{ 0.0f, -1.0f, 0.0f }, uvZero, Vector2{ 1.0f, 1.0f }, INTERIOR_CEILING_COLOR);
+        }
+    }
+
+    std::vector<Mesh> meshes;
+    std::vector<Texture2D> textures;
+    for (int bucket = 0; bucket < bucketCount; bucket++) {
+        if (!wallBuilders[bucket].IsEmpty()) {
+            meshes.push_back(wallBuilders[bucket].Build());
+            textures.push_back(wallTex);
+            shell.meshCell.push_back(bucket);
+        }
+        if (layered) continue;
+        if (!floorBuilders[bucket].IsEmpty()) {
+            meshes.push_back(floorBuilders[bucket].Build());
+            textures.push_back(floorTex);
+            shell.meshCell.push_back(bucket);
+        }
+        if (!ceilingBuilders[bucket].IsEmpty()) {
+            meshes.push_back(ceilingBuilders[bucket].Build());
+            textures.push_back(Texture2D{ 0 });
+            shell.meshCell.push_back(bucket);
+        }
+    }
+    if (meshes.empty()) return shell;
+
+    shell.model = LoadModelFromMeshes(meshes.data(), (int)meshes.size());
+    int vertexCount = 0;
+    for (int i = 0; i < shell.model.meshCount; i++) {
+        if (layered) ApplySurfaceMaterial(shell.model.materials[i], g_ShaderManager->GetSurfaceShader());
+        else if (textures[i].id > 0) shell.model.materials[i].maps[MATERIAL_MAP_DIFFUSE].texture = textures[i];
+        vertexCount += shell.model.meshes[i].vertexCount;
+    }
+
+    // Compare against the 24-vertex cubes the per-tile path submits
+    int perTileVertices = 24;
+    for (int t : interior.tiles) {
+        if (t != IT_EMPTY) perTileVertices += 24;
+        if (t == IT_WALL) perTileVertices += 24;
+    }
+    TraceLog(LOG_INFO, "Interior '%s' meshed: %d vertices in %d cells, %d portals (per-tile path: %d)",
+        interior.id.c_str(), vertexCount, graph.GetCellCount(), graph.GetPortalCount(), perTileVertices);
+
+    return shell;
+}
+
+void WorldGeometry::UnloadInteriors() {
+    for (auto& pair : interiorShells) {
+        if (pair.second.model.meshCount > 0) UnloadModel(pair.second.model);
+    }
+    interiorShells.clear();
+}
+
+void WorldGeometry::UnloadBuildings() {
+    // UnloadModel frees meshes and material maps but leaves the shared
+    // TextureManager textures alone
+    for (auto& baked : buildingModels) {
+        UnloadModel(baked.model);
+        if (baked.farModel.meshCount > 0) UnloadModel(baked.farModel);
+    }
+    buildingModels.clear();
+    buildingBounds.Clear();
+    buildingLookup.clear();
+}
+
+void WorldGeometry::UnloadGround() {
+    for (auto& chunk : groundChunks) {
+        UnloadMesh(chunk.mesh);
+    }
+    groundChunks.clear();
+    groundBounds.Clear();
+
+    // The shader and ground textures belong to the managers; only free the map array
+    if (groundMaterialLoaded) {
+        RL_FREE(groundMaterial.maps);
+        groundMaterial = { 0 };
+        groundMaterialLoaded = false;
+    }
+
+    if (tileIndexTexture.id > 0) {
+        UnloadTexture(tileIndexTexture);
+        tileIndexTexture = { 0 };
+    }
+}
+
+void WorldGeometry::Unload() {
+    UnloadBuildings();
+    UnloadGround();
+    UnloadInteriors();
+}
+
+// Global initialization
+void InitializeWorldGeometrySystem() {
+    g_WorldGeometry = new WorldGeometry();
+    TraceLog(LOG_INFO, "World geometry system initialized");
+}
+
+void CleanupWorldGeometrySystem() {
+    if (g_WorldGeometry) {
+        delete g_WorldGeometry;
+        g_WorldGeometry = nullptr;
+    }
+    TraceLog(LOG_INFO, "World geometry system cleaned up");
+}
@@ -0,0 +1,130 @@
+#pragma once
+#include "globals.h"
+#include "map.h"
+#include "culling.h"
+#include "portal_graph.h"
+#include "lod.h"
+#include <vector>
+#include <unordered_map>
+#include <string>
+
+// Static building shell baked once per generated map
+struct BakedBuilding {
+    int buildingId;
+    Model model;          // one layered mesh, or mesh 0 = walls, mesh 1 = roof
+    Model farModel;       // LOD 1: footprint box with roof, same mesh layout as model
+    BoundingBox bounds;
+    int lodLevel;
+};
+
+// One square block of ground tiles drawn as a single quad
+struct GroundChunk {
+    Mesh mesh;
+    BoundingBox bounds;
+};
+
+// Interior walls, floor and ceiling, split by portal cell
+struct InteriorShell {
+    Model model;
+    std::vector<int> meshCell;   // Cell of each mesh; graph.GetCellCount() = shared, always drawn
+    PortalGraph graph;
+};
+
+// Ground chunk edge length in tiles
+#define GROUND_CHUNK_SIZE 32
+
+// World geometry class
+// Converts building shells into GPU meshes after map generation so the exterior
+// is drawn with one DrawModel per building instead of a cube per wall tile.
+// The ground is a handful of chunk quads whose fragment shader looks up the
+// tile type from an index texture. Interior shells are greedy-meshed once per
+// Interior::id and shared by every building that uses that layout, with one
+// mesh per room so rooms hidden behind walls are skipped. With the packed
+// surface textures each room is a single mesh sampled by texture layer.
+// With LOD enabled distant buildings drop to a single box; the ground needs no
+// LOD since each chunk is already one quad with one tile fetch per pixel.
+class WorldGeometry {
+public:
+    WorldGeometry();
+    ~WorldGeometry();
+
+    // Rebuild the building meshes for a freshly generated map
+    void BakeBuildings(const MapData& mapData);
+
+    // Draw the baked building shells inside the view frustum
+    void DrawBuildings();
+
+    // Draw one baked building by its MapData::buildings index (false if it has no mesh)
+    bool DrawBuilding(int buildingIndex);
+
+    // Upload the world tile map and build ground chunks (needs the tilemap shader)
+    void BakeGround(const MapData& mapData);
+
+    // Draw the ground chunks inside the view frustum
+    void DrawGround();
+
+    // Draw a single ground chunk (already known to be visible)
+    void DrawGroundChunk(int chunkIndex);
+
+    // True when the GPU tilemap ground is ready to draw
+    bool HasGround() const { return !groundChunks.empty(); }
+
+    const std::vector<GroundChunk>& GetGroundChunks() const { return groundChunks; }
+
+    // True once BakeBuildings produced geometry
+    bool HasBuildings() const { return !buildingModels.empty(); }
+
+    const std::vector<BakedBuilding>& GetBuildings() const { return buildingModels; }
+
+    // Mesh the walls, floor and ceiling of every interior in the map
+    void BakeInteriors(const MapData& mapData);
+
+    // Cached shell and portal graph for an interior (meshes it on first use)
+    const InteriorShell* GetInteriorShell(const Interior& interior);
+
+    // Draw the cached shell for an interior, optionally only the cells marked visible.
+    // Returns false if nothing could be built so the caller can fall back.
+    bool DrawInterior(const Interior& interior, const std::vector<unsigned char>* visibleCells = nullptr);
+
+    // Release all GPU meshes
+    void Unload();
+
+private:
+    std::vector<BakedBuilding> buildingModels;
+    std::vector<GroundChunk> groundChunks;
+    Texture2D tileIndexTexture;
+    Material groundMaterial;
+    bool groundMaterialLoaded;
+
+    std::unordered_map<std::string, InteriorShell> interiorShells;
+
+    // Bounds in culling layout, parallel to groundChunks / buildingModels
+    CullBoxList groundBounds;
+    CullBoxList buildingBounds;
+    std::vector<int> buildingLookup;   // MapData::buildings index -> buildingModels index, -1 if none
+    std::vector<unsigned char> visibility;
+
+    void UnloadBuildings();
+    void UnloadGround();
+    void UnloadInteriors();
+
+    // Build walls (entrance excluded) and roof for a single building.
+    // wallLayer >= 0 bakes a single surface-textured mesh instead of two materials.
+    BakedBuilding BakeBuilding(const Building& building, Texture2D wallTexture, int wallLayer);
+
+    // Pick the model for the current view distance (updates the stored level)
+    const Model& SelectBuildingModel(BakedBuilding& building);
+
+    // Build the portal graph, then greedy-mesh visible wall faces, floor and
+    // ceiling rectangles of one interior, bucketed by cell
+    InteriorShell BakeInterior(const Interior& interior);
+};
+
+// Global world geometry instance
+extern WorldGeometry* g_WorldGeometry;
+
+// Initialize world geometry system
+void InitializeWorldGeometrySystem();
+
+// Cleanup world geometry system
+void CleanupWorldGeometrySystem();